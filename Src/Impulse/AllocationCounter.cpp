@@ -0,0 +1,49 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(IMPULSE_COUNT_ALLOCATIONS)
+
+namespace {
+    std::atomic<uint64_t> gAllocationCount = 0;
+}
+
+// Array and nothrow forms forward to these by default.
+auto operator new (size_t size) -> void*
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto ptr = std::malloc(size != 0 ? size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+auto operator delete (void* ptr) noexcept -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete (void* ptr, size_t) noexcept -> void
+{
+    std::free(ptr);
+}
+
+#endif
+
+namespace Impulse {
+
+auto AllocationCount () -> uint64_t
+{
+#if defined(IMPULSE_COUNT_ALLOCATIONS)
+    return gAllocationCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+} // namespace Impulse
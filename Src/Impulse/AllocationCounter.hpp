@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Impulse {
+
+// Number of heap allocations made through global operator new. Counting is
+// compiled in only when IMPULSE_COUNT_ALLOCATIONS is defined (Debug builds
+// and tests), otherwise always returns 0.
+auto AllocationCount () -> uint64_t;
+
+} // namespace Impulse
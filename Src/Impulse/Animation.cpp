@@ -0,0 +1,244 @@
+#include "Animation.hpp"
+
+#include <algorithm>
+
+namespace {
+
+auto Ease (Impulse::Easing easing, float t) -> float
+{
+    switch (easing)
+    {
+    case Impulse::Easing::EaseOut:
+        return 1.0f - (1.0f - t) * (1.0f - t);
+
+    case Impulse::Easing::EaseInOut:
+        return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+
+    case Impulse::Easing::Linear:
+    default:
+        return t;
+    }
+}
+
+}
+
+namespace Impulse {
+
+#pragma region Animation
+
+////////////////////////////////////////////////////////////////////////////////
+
+Animation::~Animation ()
+{
+    Stop();
+}
+
+auto Animation::Stop () -> void
+{
+    if (mScheduler)
+    {
+        mScheduler->Stop(this);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma endregion
+
+#pragma region SteppedProgress
+
+////////////////////////////////////////////////////////////////////////////////
+
+auto StepProgress (AnimationClock::duration remaining, AnimationClock::duration total, int steps) -> SteppedProgress
+{
+    const auto zero = AnimationClock::duration::zero();
+    if (total <= zero || steps <= 0)
+    {
+        return SteppedProgress{};
+    }
+
+    remaining = std::clamp(remaining, zero, total);
+
+    // Integer math, float rounding would put wake up a little before step
+    // changes and cost a wasted wake up per step.
+    const auto ticks = remaining.count();
+    const auto step  = ticks * steps / total.count();
+
+    // Last step ends with the countdown.
+    if (step == 0)
+    {
+        return SteppedProgress{ 0, ticks > 0 ? remaining : AnimationClock::duration::max() };
+    }
+
+    // Step drops once remaining * steps < step * total.
+    const auto boundary = (step * total.count() + steps - 1) / steps;
+
+    return SteppedProgress{
+        static_cast<int>(step),
+        AnimationClock::duration(ticks - boundary + 1)
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma endregion
+
+#pragma region AnimatedValue
+
+////////////////////////////////////////////////////////////////////////////////
+
+auto AnimatedValue::Step (AnimationClock::time_point now) -> bool
+{
+    const auto elapsed = now - mStart;
+    if (elapsed >= mDuration)
+    {
+        mValue = mTo;
+        return false;
+    }
+
+    const auto t = std::chrono::duration<float>(elapsed) / std::chrono::duration<float>(mDuration);
+    mValue = mFrom + (mTo - mFrom) * Ease(mEasing, std::max(t, 0.0f));
+
+    return true;
+}
+
+auto AnimatedValue::Set (float value) -> void
+{
+    Stop();
+
+    mFrom  = value;
+    mTo    = value;
+    mValue = value;
+}
+
+auto AnimatedValue::AnimateTo (
+    float                     target,
+    std::chrono::milliseconds duration,
+    AnimationScheduler*       scheduler,
+    Easing                    easing
+) -> void
+{
+    if (!scheduler || duration <= std::chrono::milliseconds(0))
+    {
+        Set(target);
+        return;
+    }
+
+    if (target == mTo && IsActive())
+    {
+        return;
+    }
+
+    // Start from current value, so interrupted animation doesn't jump.
+    mFrom     = mValue;
+    mTo       = target;
+    mEasing   = easing;
+    mStart    = scheduler->Now();
+    mDuration = duration;
+
+    scheduler->Start(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma endregion
+
+#pragma region AnimationScheduler
+
+////////////////////////////////////////////////////////////////////////////////
+
+AnimationScheduler::AnimationScheduler ()
+{
+    // Steady state must not allocate when animations start and stop.
+    mAnimations.reserve(32);
+}
+
+AnimationScheduler::~AnimationScheduler ()
+{
+    for (auto animation : mAnimations)
+    {
+        animation->mScheduler = nullptr;
+    }
+}
+
+auto AnimationScheduler::Start (Animation* animation) -> void
+{
+    if (animation->mScheduler == this)
+    {
+        return;
+    }
+
+    animation->Stop();
+    animation->mScheduler = this;
+    mAnimations.push_back(animation);
+
+    // Hasn't stepped yet, doesn't know when it needs a frame.
+    mWakeTime = AnimationClock::time_point::min();
+}
+
+auto AnimationScheduler::Stop (Animation* animation) -> void
+{
+    auto it = std::find(mAnimations.begin(), mAnimations.end(), animation);
+    if (it != mAnimations.end())
+    {
+        *it = mAnimations.back();
+        mAnimations.pop_back();
+    }
+
+    animation->mScheduler = nullptr;
+}
+
+auto AnimationScheduler::Tick () -> bool
+{
+    if (mAnimations.empty())
+    {
+        return false;
+    }
+
+    return Tick(Now());
+}
+
+auto AnimationScheduler::Tick (AnimationClock::time_point now) -> bool
+{
+    if (mAnimations.empty())
+    {
+        return false;
+    }
+
+    // Finished animations still need one frame to show their final value.
+    auto redraw = false;
+    auto i      = size_t{0};
+
+    mWakeTime = AnimationClock::time_point::max();
+
+    while (i < mAnimations.size())
+    {
+        auto animation = mAnimations[i];
+        if (animation->Step(now))
+        {
+            redraw   |= animation->Changed();
+            mWakeTime = std::min(mWakeTime, animation->WakeTime());
+            ++i;
+        }
+        else
+        {
+            redraw = true;
+            animation->mScheduler = nullptr;
+            mAnimations[i] = mAnimations.back();
+            mAnimations.pop_back();
+        }
+    }
+
+    if (redraw)
+    {
+        mFrameRequests += 1;
+    }
+
+    return redraw;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma endregion
+
+} // namespace Impulse
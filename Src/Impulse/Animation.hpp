@@ -0,0 +1,139 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Impulse {
+
+using AnimationClock = std::chrono::steady_clock;
+
+enum class Easing : unsigned char
+{
+    Linear,
+    EaseOut,
+    EaseInOut
+};
+
+class AnimationScheduler;
+
+// Anything that needs frames while it is running. Animation is registered
+// in scheduler only while active, idle animations cost nothing.
+class Animation
+{
+    friend class AnimationScheduler;
+
+    AnimationScheduler* mScheduler = nullptr;
+
+    Animation            (const Animation&) = delete;
+    Animation& operator= (const Animation&) = delete;
+
+protected:
+    // Advance animation to @now, return false when finished.
+    virtual auto Step (AnimationClock::time_point now) -> bool = 0;
+
+    // Whether last Step() changed anything visible. Long running animations
+    // can skip frames that wouldn't move a pixel.
+    virtual auto Changed () const -> bool { return true; }
+
+    // When next Step() will have something to show, as of last Step().
+    // Default is next frame. Animations that change rarely let the loop
+    // sleep until then instead of stepping every frame.
+    virtual auto WakeTime () const -> AnimationClock::time_point { return AnimationClock::time_point::min(); }
+
+public:
+    Animation () = default;
+    virtual ~Animation ();
+
+    auto IsActive () const { return mScheduler != nullptr; }
+    auto Stop     () -> void;
+};
+
+// Progress shown in discrete steps, e.g. ring drawn in segments.
+struct SteppedProgress
+{
+    int                      step = 0;                                  // floor(remaining / total * steps)
+    AnimationClock::duration next = AnimationClock::duration::max();   // until step changes or countdown ends
+};
+
+// Step of @remaining out of @total, while @remaining keeps counting down.
+auto StepProgress (AnimationClock::duration remaining, AnimationClock::duration total, int steps) -> SteppedProgress;
+
+// Float property interpolated over time.
+class AnimatedValue : public Animation
+{
+    float                      mFrom     = 0.0f;
+    float                      mTo       = 0.0f;
+    float                      mValue    = 0.0f;
+    Easing                     mEasing   = Easing::EaseOut;
+    AnimationClock::time_point mStart    = AnimationClock::time_point();
+    AnimationClock::duration   mDuration = AnimationClock::duration::zero();
+
+protected:
+    virtual auto Step (AnimationClock::time_point now) -> bool override;
+
+public:
+    AnimatedValue (float value = 0.0f)
+        : mFrom  (value)
+        , mTo    (value)
+        , mValue (value)
+    {
+    }
+
+    auto Value  () const { return mValue; }
+    auto Target () const { return mTo; }
+
+    // Jump to @value without animating.
+    auto Set (float value) -> void;
+
+    // Animate from current value to @target. With null @scheduler value is
+    // set immediately.
+    auto AnimateTo (
+        float                     target,
+        std::chrono::milliseconds duration,
+        AnimationScheduler*       scheduler,
+        Easing                    easing = Easing::EaseOut
+    ) -> void;
+};
+
+// Drives active animations. Frames are requested only while at least one
+// animation is running, otherwise the scheduler is idle.
+class AnimationScheduler
+{
+    using TimeSource = std::function<AnimationClock::time_point ()>;
+
+    std::vector<Animation*>    mAnimations;
+    TimeSource                 mTimeSource    = []{ return AnimationClock::now(); };
+    AnimationClock::time_point mWakeTime      = AnimationClock::time_point::max();
+    uint64_t                   mFrameRequests = 0;
+
+    AnimationScheduler            (const AnimationScheduler&) = delete;
+    AnimationScheduler& operator= (const AnimationScheduler&) = delete;
+
+public:
+    AnimationScheduler  ();
+    ~AnimationScheduler ();
+
+    // Replace time source (e.g. with virtual clock).
+    auto SetTimeSource (TimeSource timeSource) { mTimeSource = std::move(timeSource); }
+    auto Now           () const                { return mTimeSource(); }
+
+    auto Start (Animation* animation) -> void;
+    auto Stop  (Animation* animation) -> void;
+
+    // Advance all active animations, return true when frame should be drawn.
+    // Scheduler can be active and still not request a frame.
+    auto Tick () -> bool;
+    auto Tick (AnimationClock::time_point now) -> bool;
+
+    // Earliest WakeTime() of active animations as of last Tick(), max when
+    // idle. Loop that got no frame from Tick() can sleep until then.
+    auto WakeTime () const { return mAnimations.empty() ? AnimationClock::time_point::max() : mWakeTime; }
+
+    auto IsIdle        () const { return mAnimations.empty(); }
+    auto ActiveCount   () const { return mAnimations.size(); }
+    auto FrameRequests () const { return mFrameRequests; }
+};
+
+} // namespace Impulse
@@ -0,0 +1,349 @@
+#include "AsyncLogSink.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Impulse {
+
+AsyncLogSink::~AsyncLogSink ()
+{
+    Stop();
+}
+
+auto AsyncLogSink::TryPush (const spdlog::details::log_msg& msg) -> bool
+{
+    auto position = mEnqueue.load(std::memory_order_relaxed);
+    auto slot     = static_cast<Slot*>(nullptr);
+
+    for (;;)
+    {
+        slot = &mSlots[position & mMask];
+
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (diff == 0)
+        {
+            if (mEnqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Consumer is a whole lap behind, queue is full.
+            return false;
+        }
+        else
+        {
+            position = mEnqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto& message = slot->message;
+
+    message.time     = msg.time;
+    message.threadId = msg.thread_id;
+    message.level    = msg.level;
+    message.name     = static_cast<uint8_t>(std::min(msg.logger_name.size(), NAME_SIZE));
+    message.length   = static_cast<uint16_t>(std::min(msg.payload.size(), TEXT_SIZE));
+
+    std::memcpy(message.loggerName, msg.logger_name.data(), message.name);
+    std::memcpy(message.text,       msg.payload.data(),     message.length);
+
+    if (message.length < msg.payload.size())
+    {
+        mTruncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+auto AsyncLogSink::TryPop (Message& message) -> bool
+{
+    auto position = mDequeue.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto& slot = mSlots[position & mMask];
+
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+        if (diff == 0)
+        {
+            if (mDequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                message = slot.message;
+
+                // Free for producer of next lap.
+                slot.sequence.store(position + mMask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = mDequeue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+auto AsyncLogSink::Write (const Message& message) -> void
+{
+    auto msg = spdlog::details::log_msg(
+        message.time,
+        spdlog::source_loc(),
+        spdlog::string_view_t(message.loggerName, message.name),
+        message.level,
+        spdlog::string_view_t(message.text, message.length)
+    );
+
+    msg.thread_id = message.threadId;
+
+    WriteDirect(msg);
+}
+
+auto AsyncLogSink::WriteDirect (const spdlog::details::log_msg& msg) -> void
+{
+    for (const auto& sink : mSinks)
+    {
+        if (sink->should_log(msg.level))
+        {
+            sink->log(msg);
+        }
+    }
+
+    mWritten.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto AsyncLogSink::ReportDrops () -> void
+{
+    // Drain() may run alongside writer, each drop is reported once.
+    const auto dropped  = mDropped.load();
+    const auto reported = mReported.exchange(dropped);
+
+    if (dropped <= reported)
+    {
+        return;
+    }
+
+    const auto text = fmt::format("{} log messages dropped, queue was full", dropped - reported);
+    const auto msg  = spdlog::details::log_msg("log", spdlog::level::warn, text);
+
+    for (const auto& sink : mSinks)
+    {
+        if (sink->should_log(msg.level))
+        {
+            sink->log(msg);
+        }
+    }
+}
+
+auto AsyncLogSink::Wake () -> void
+{
+    // Taking the lock orders notification after writer started waiting.
+    {
+        auto guard = std::lock_guard<std::mutex>(mMutex);
+    }
+
+    mWake.notify_one();
+}
+
+auto AsyncLogSink::Worker () -> void
+{
+    auto message = Message();
+
+    for (;;)
+    {
+        while (TryPop(message))
+        {
+            Write(message);
+        }
+
+        ReportDrops();
+
+        if (mFlush.exchange(false))
+        {
+            for (const auto& sink : mSinks)
+            {
+                sink->flush();
+            }
+        }
+
+        auto lock = std::unique_lock<std::mutex>(mMutex);
+        if (mStop)
+        {
+            break;
+        }
+
+        // Producer either sees mSleeping or its message is seen here.
+        mSleeping = true;
+        if (mEnqueue.load() == mDequeue.load() && !mFlush)
+        {
+            mWake.wait_for(lock, std::chrono::seconds(1));
+        }
+        mSleeping = false;
+    }
+}
+
+auto AsyncLogSink::log (const spdlog::details::log_msg& msg) -> void
+{
+    // Counted before mStopped is read, Stop() waits for callers that saw
+    // writer still running, their message is queued before its last Drain().
+    mPushing.fetch_add(1);
+
+    if (mStopped)
+    {
+        mPushing.fetch_sub(1);
+        WriteDirect(msg);
+        return;
+    }
+
+    while (!TryPush(msg))
+    {
+        switch (mOverflow)
+        {
+        case LogOverflow::Block:
+            // Writer is gone while queue is full, nobody makes room.
+            if (mStopped)
+            {
+                mPushing.fetch_sub(1);
+                WriteDirect(msg);
+                return;
+            }
+
+            Wake();
+            std::this_thread::yield();
+            break;
+
+        case LogOverflow::DropNewest:
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            mPushing.fetch_sub(1);
+            return;
+
+        case LogOverflow::DropOldest:
+        {
+            auto oldest = Message();
+            if (TryPop(oldest))
+            {
+                mDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+        }
+    }
+
+    mPushing.fetch_sub(1);
+
+    // Pairs with writer setting mSleeping before it looks at queue.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mSleeping.load(std::memory_order_relaxed))
+    {
+        Wake();
+    }
+}
+
+auto AsyncLogSink::flush () -> void
+{
+    if (mStopped)
+    {
+        for (const auto& sink : mSinks)
+        {
+            sink->flush();
+        }
+
+        return;
+    }
+
+    mFlush = true;
+    Wake();
+}
+
+auto AsyncLogSink::set_pattern (const std::string& pattern) -> void
+{
+    for (const auto& sink : mSinks)
+    {
+        sink->set_pattern(pattern);
+    }
+}
+
+auto AsyncLogSink::set_formatter (std::unique_ptr<spdlog::formatter> formatter) -> void
+{
+    for (const auto& sink : mSinks)
+    {
+        sink->set_formatter(formatter->clone());
+    }
+}
+
+auto AsyncLogSink::Drain () -> void
+{
+    auto message = Message();
+    while (TryPop(message))
+    {
+        Write(message);
+    }
+
+    ReportDrops();
+
+    for (const auto& sink : mSinks)
+    {
+        sink->flush();
+    }
+}
+
+auto AsyncLogSink::Stop () -> void
+{
+    if (!mThread.joinable())
+    {
+        return;
+    }
+
+    {
+        auto guard = std::lock_guard<std::mutex>(mMutex);
+        mStop = true;
+    }
+
+    mWake.notify_one();
+    mThread.join();
+
+    // Whatever came in after writer's last look. Callers past their check
+    // of mStopped may still be pushing, queue is final once they're done.
+    mStopped = true;
+    while (mPushing.load() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    Drain();
+}
+
+auto AsyncLogSink::Start (Desc desc) -> std::unique_ptr<AsyncLogSink>
+{
+    auto capacity = size_t(2);
+    while (capacity < desc.capacity)
+    {
+        capacity *= 2;
+    }
+
+    auto sink = std::make_unique<AsyncLogSink>();
+
+    sink->mSinks    = std::move(desc.sinks);
+    sink->mOverflow = desc.overflow;
+    sink->mSlots    = std::make_unique<Slot[]>(capacity);
+    sink->mMask     = capacity - 1;
+
+    for (auto i = size_t(0); i < capacity; ++i)
+    {
+        sink->mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    sink->mThread = std::thread(&AsyncLogSink::Worker, sink.get());
+    return sink;
+}
+
+} // namespace Impulse
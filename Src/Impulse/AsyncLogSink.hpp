@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/sinks/sink.h>
+
+namespace Impulse {
+
+// What caller does when queue is full.
+enum class LogOverflow : unsigned char
+{
+    Block,      // waits for writer to make room
+    DropNewest, // message being logged is lost
+    DropOldest  // oldest queued message is lost
+};
+
+// spdlog sink that only copies message into a bounded lock-free queue,
+// formatting and disk access happen on writer thread. Callers never take
+// a lock while writer is busy; when it sleeps, first message wakes it.
+//
+// Message text longer than a slot is cut short. Logger name is copied too,
+// loggers may go away before their messages are written.
+class AsyncLogSink : public spdlog::sinks::sink
+{
+public:
+    struct Desc
+    {
+        std::vector<spdlog::sink_ptr> sinks;                           // written on writer thread
+        size_t                        capacity = 4096;                 // messages, rounded up to power of two
+        LogOverflow                   overflow = LogOverflow::DropNewest;
+    };
+
+private:
+    static constexpr auto NAME_SIZE = size_t(24);
+    static constexpr auto TEXT_SIZE = size_t(472);
+
+    struct Message
+    {
+        spdlog::log_clock::time_point time;
+        size_t                        threadId = 0;
+        spdlog::level::level_enum     level    = spdlog::level::off;
+        uint16_t                      length   = 0;
+        uint8_t                       name     = 0; // logger name length
+        char                          loggerName[NAME_SIZE];
+        char                          text[TEXT_SIZE];
+    };
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        Message             message;
+    };
+
+    std::vector<spdlog::sink_ptr>     mSinks;
+    LogOverflow                       mOverflow = LogOverflow::DropNewest;
+
+    // Bounded MPMC queue (Vyukov). Slot sequence tells whose turn it is:
+    // == position free for producer, == position + 1 filled for consumer.
+    // Positions sit on cache lines of their own, producers and writer
+    // don't invalidate each other's.
+    std::unique_ptr<Slot[]>           mSlots;
+    size_t                            mMask      = 0;
+    alignas(64) std::atomic<size_t>   mEnqueue   = 0;
+    alignas(64) std::atomic<size_t>   mDequeue   = 0;
+    alignas(64) std::atomic<uint64_t> mWritten   = 0;
+    std::atomic<uint64_t>             mDropped   = 0;
+    std::atomic<uint64_t>             mTruncated = 0;
+    std::atomic<uint64_t>             mReported  = 0;     // drops already logged
+
+    std::thread                       mThread;
+    std::mutex                        mMutex;             // only for writer going to sleep
+    std::condition_variable           mWake;
+    std::atomic<bool>                 mSleeping  = false;
+    std::atomic<bool>                 mFlush     = false;
+    std::atomic<bool>                 mStop      = false;
+    std::atomic<bool>                 mStopped   = false; // writer is gone, log() writes itself
+    std::atomic<uint32_t>             mPushing   = 0;     // log() calls that may still queue a message
+
+    auto TryPush     (const spdlog::details::log_msg& msg) -> bool;
+    auto TryPop      (Message& message) -> bool;
+    auto Write       (const Message& message) -> void;
+    auto WriteDirect (const spdlog::details::log_msg& msg) -> void;
+    auto ReportDrops () -> void;
+    auto Wake        () -> void;
+    auto Worker      () -> void;
+
+    AsyncLogSink            (const AsyncLogSink& rhs) = delete;
+    AsyncLogSink& operator= (const AsyncLogSink& rhs) = delete;
+
+public:
+    AsyncLogSink  () = default;
+    ~AsyncLogSink ();
+
+    virtual auto log           (const spdlog::details::log_msg& msg) -> void override;
+    virtual auto flush         () -> void override; // doesn't wait, writer flushes once queue is empty
+    virtual auto set_pattern   (const std::string& pattern) -> void override;
+    virtual auto set_formatter (std::unique_ptr<spdlog::formatter> formatter) -> void override;
+
+    // Writes whatever is queued on calling thread and flushes sinks. Safe
+    // alongside writer thread, meant for crash handler.
+    auto Drain () -> void;
+
+    // Writes queue out and ends writer thread, later messages are written
+    // directly. Called by destructor.
+    auto Stop () -> void;
+
+    auto Written   () const -> uint64_t { return mWritten; }
+    auto Dropped   () const -> uint64_t { return mDropped; }
+    auto Truncated () const -> uint64_t { return mTruncated; }
+
+    static auto Start (Desc desc) -> std::unique_ptr<AsyncLogSink>;
+};
+
+} // namespace Impulse
@@ -0,0 +1,150 @@
+#include "AtomicFile.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+#include "Utility.hpp"
+#else
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse {
+
+#if defined(_WIN32)
+
+auto WriteFileAtomic (const std::filesystem::path& path, std::string_view data) -> bool
+{
+    // Same directory, rename must not cross volumes to stay atomic.
+    auto temp = path;
+    temp += L".tmp";
+
+    auto file = CreateFileW(
+        temp.c_str(),
+        GENERIC_WRITE,
+        0,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        spdlog::error("CreateFileW() failed for '{}': {}", temp.string(), GetLastErrorMessage());
+        return false;
+    }
+
+    auto written = DWORD(0);
+    auto r       = WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr)
+                && written == data.size();
+    if (!r)
+    {
+        spdlog::error("WriteFile() failed for '{}': {}", temp.string(), GetLastErrorMessage());
+    }
+
+    // Content must be on disk before rename makes it visible.
+    if (r && !FlushFileBuffers(file))
+    {
+        spdlog::error("FlushFileBuffers() failed for '{}': {}", temp.string(), GetLastErrorMessage());
+        r = false;
+    }
+
+    CloseHandle(file);
+
+    if (!r)
+    {
+        DeleteFileW(temp.c_str());
+        return false;
+    }
+
+    if (!MoveFileExW(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        spdlog::error("MoveFileExW() failed for '{}': {}", path.string(), GetLastErrorMessage());
+        DeleteFileW(temp.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+#else
+
+auto WriteFileAtomic (const std::filesystem::path& path, std::string_view data) -> bool
+{
+    auto temp = path;
+    temp += ".tmp";
+
+    const auto file = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file < 0)
+    {
+        spdlog::error("open() failed for '{}': {}", temp.string(), std::strerror(errno));
+        return false;
+    }
+
+    auto r = true;
+    for (auto offset = size_t(0); r && offset < data.size();)
+    {
+        const auto written = ::write(file, data.data() + offset, data.size() - offset);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (written <= 0)
+        {
+            spdlog::error("write() failed for '{}': {}", temp.string(), std::strerror(errno));
+            r = false;
+            break;
+        }
+
+        offset += static_cast<size_t>(written);
+    }
+
+    if (r && ::fsync(file) != 0)
+    {
+        spdlog::error("fsync() failed for '{}': {}", temp.string(), std::strerror(errno));
+        r = false;
+    }
+
+    ::close(file);
+
+    if (!r)
+    {
+        ::unlink(temp.c_str());
+        return false;
+    }
+
+    if (::rename(temp.c_str(), path.c_str()) != 0)
+    {
+        spdlog::error("rename() failed for '{}': {}", path.string(), std::strerror(errno));
+        ::unlink(temp.c_str());
+        return false;
+    }
+
+    // Rename itself is durable only once directory entry is flushed.
+    auto parent = path.parent_path();
+    if (parent.empty())
+    {
+        parent = ".";
+    }
+
+    const auto dir = ::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir >= 0)
+    {
+        ::fsync(dir);
+        ::close(dir);
+    }
+
+    return true;
+}
+
+#endif
+
+} // namespace Impulse
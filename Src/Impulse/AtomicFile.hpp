@@ -0,0 +1,13 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+namespace Impulse {
+
+// Replace @path with @data so that after a crash file holds either old or
+// new content, never a mix. Data goes to a temporary file next to @path,
+// is flushed to disk and then renamed over @path.
+auto WriteFileAtomic (const std::filesystem::path& path, std::string_view data) -> bool;
+
+} // namespace Impulse
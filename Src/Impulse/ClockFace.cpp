@@ -0,0 +1,21 @@
+#include "ClockFace.hpp"
+
+namespace Impulse {
+
+auto ClockFace::Format (const PomodoroEngine& engine, std::chrono::milliseconds duration) -> void
+{
+    mTimerText.Clear();
+    AppendMinutesSeconds(mTimerText, std::chrono::duration_cast<std::chrono::seconds>(duration));
+
+    mBottomText.Clear();
+    mBottomText.AppendNumber(engine.WorkShiftCount());
+    mBottomText.Append(L'/');
+    mBottomText.AppendNumber(engine.Config().longBreakAfter);
+}
+
+auto ClockFace::Progress (const PomodoroEngine& engine, AnimationClock::duration remaining) -> SteppedProgress
+{
+    return StepProgress(remaining, engine.PhaseDuration(), RING_SEGMENTS * RING_SUBSTEPS);
+}
+
+} // namespace Impulse
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Animation.hpp"
+#include "FixedString.hpp"
+#include "PomodoroEngine.hpp"
+
+#include <chrono>
+#include <string_view>
+
+namespace Impulse {
+
+// What the clock shows, apart from drawing it: texts inside the ring and
+// step of progress ring. Texts are formatted into inline buffers, so a
+// steady state frame doesn't allocate.
+class ClockFace
+{
+public:
+    // Progress ring is split into this many segments, each of them into
+    // RING_SUBSTEPS steps.
+    static constexpr auto RING_SEGMENTS = 120;
+    static constexpr auto RING_SUBSTEPS = 16;
+
+private:
+    FixedWString<16> mTimerText;
+    FixedWString<16> mBottomText;
+
+public:
+    // Minutes and seconds of @duration, work shifts done out of those
+    // before long break.
+    auto Format (const PomodoroEngine& engine, std::chrono::milliseconds duration) -> void;
+
+    auto TimerText  () const -> std::wstring_view { return mTimerText.view(); }
+    auto BottomText () const -> std::wstring_view { return mBottomText.view(); }
+
+    // Ring step for part of current phase that remains, and time until it
+    // moves to the next one.
+    static auto Progress (const PomodoroEngine& engine, AnimationClock::duration remaining) -> SteppedProgress;
+};
+
+} // namespace Impulse
@@ -0,0 +1,774 @@
+#include "ColumnarHistory.hpp"
+#include "Crc32.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+using Impulse::ColumnarBlock;
+using Impulse::ColumnarHeader;
+using Impulse::HistoryColumns;
+using Impulse::HistoryEvent;
+using Impulse::HistoryRecord;
+using Impulse::ImpulseState;
+
+constexpr auto STATE_BITS = 3u;
+
+// Width byte of column stored as zigzag varints, values too far apart
+// to bit-pack.
+constexpr auto VARINT_COLUMN = uint8_t(0xFF);
+constexpr auto MAX_PACKED    = 32u;
+
+static_assert(static_cast<unsigned>(ImpulseState::Paused) < (1u << STATE_BITS), "ImpulseState fits STATE_BITS");
+static_assert(static_cast<unsigned>(HistoryEvent::Stop)   < (1u << STATE_BITS), "HistoryEvent fits STATE_BITS");
+
+// Bits needed to store dictionary index, 0 when there is one task only.
+auto IndexBits (uint32_t tasks) -> unsigned
+{
+    auto bits = 0u;
+    while (bits < 32 && (uint64_t(1) << bits) < tasks)
+    {
+        bits += 1;
+    }
+
+    return bits;
+}
+
+auto ZigZag (int64_t value) -> uint64_t
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+auto UnZigZag (uint64_t value) -> int64_t
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+auto PutVarint (std::string& out, uint64_t value) -> void
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+
+    out.push_back(static_cast<char>(value));
+}
+
+// Bits needed to store @value.
+auto WidthOf (uint64_t value) -> unsigned
+{
+    auto bits = 0u;
+    while (bits < 64 && (value >> bits) != 0)
+    {
+        bits += 1;
+    }
+
+    return bits;
+}
+
+// Appends values to byte aligned run of @bits wide fields, low bits first.
+class BitWriter
+{
+    std::string& mOut;
+    uint64_t     mBits  = 0;
+    unsigned     mCount = 0;
+
+public:
+    BitWriter (std::string& out)
+        : mOut (out)
+    {
+    }
+
+    auto Put (uint32_t value, unsigned bits) -> void
+    {
+        mBits  |= uint64_t(value) << mCount;
+        mCount += bits;
+
+        while (mCount >= 8)
+        {
+            mOut.push_back(static_cast<char>(mBits));
+            mBits  >>= 8;
+            mCount -= 8;
+        }
+    }
+
+    auto Flush () -> void
+    {
+        if (mCount > 0)
+        {
+            mOut.push_back(static_cast<char>(mBits));
+            mBits  = 0;
+            mCount = 0;
+        }
+    }
+};
+
+// Column as frame of reference: bit width, zigzag varint of smallest
+// value, then every value less smallest bit-packed. Decoding doesn't
+// branch on length of each value the way it does for varints.
+auto PutPacked (std::string& out, const std::vector<int64_t>& values) -> void
+{
+    const auto [min, max] = std::minmax_element(values.begin(), values.end());
+    const auto base       = values.empty() ? 0 : *min;
+    const auto width      = values.empty() ? 0 : WidthOf(static_cast<uint64_t>(*max) - static_cast<uint64_t>(base));
+
+    if (width > MAX_PACKED)
+    {
+        out.push_back(static_cast<char>(VARINT_COLUMN));
+        for (const auto value : values)
+        {
+            PutVarint(out, ZigZag(value));
+        }
+
+        return;
+    }
+
+    out.push_back(static_cast<char>(width));
+    PutVarint(out, ZigZag(base));
+
+    auto bits = BitWriter(out);
+    for (const auto value : values)
+    {
+        bits.Put(static_cast<uint32_t>(static_cast<uint64_t>(value) - static_cast<uint64_t>(base)), width);
+    }
+    bits.Flush();
+}
+
+// Reads what PutVarint(), BitWriter and PutPacked() wrote, never past
+// @end. Running out of bytes or overlong varint sets Failed().
+class BlockReader
+{
+    const uint8_t* mData;
+    const uint8_t* mEnd;
+    bool           mFailed = false;
+
+public:
+    BlockReader (const uint8_t* data, const uint8_t* end)
+        : mData (data)
+        , mEnd  (end)
+    {
+    }
+
+    auto Failed () const { return mFailed; }
+    auto AtEnd  () const { return mData == mEnd; }
+
+    auto Byte () -> uint8_t
+    {
+        if (mData == mEnd)
+        {
+            mFailed = true;
+            return 0;
+        }
+
+        return *mData++;
+    }
+
+    auto Varint () -> uint64_t
+    {
+        // Most deltas fit one byte.
+        if (mData != mEnd && *mData < 0x80)
+        {
+            return *mData++;
+        }
+
+        auto value = uint64_t(0);
+
+        for (auto shift = 0u; shift < 64; shift += 7)
+        {
+            if (mData == mEnd)
+            {
+                break;
+            }
+
+            const auto byte = *mData++;
+            value |= uint64_t(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+
+        mFailed = true;
+        return 0;
+    }
+
+    // Column written by PutPacked(), @count values passed to @put(i, value).
+    template <typename Put>
+    auto Packed (size_t count, Put&& put) -> void
+    {
+        const auto width = Byte();
+        if (width == VARINT_COLUMN)
+        {
+            for (auto i = size_t(0); i < count; ++i)
+            {
+                put(i, UnZigZag(Varint()));
+            }
+
+            return;
+        }
+
+        if (width > MAX_PACKED)
+        {
+            mFailed = true;
+            return;
+        }
+
+        const auto base = static_cast<uint64_t>(UnZigZag(Varint()));
+
+        Bits(count, width, [&](size_t i, uint32_t value)
+        {
+            put(i, static_cast<int64_t>(base + value));
+        });
+    }
+
+    // Run of @count fields, @bits wide each, passed to @put(i, value).
+    template <typename Put>
+    auto Bits (size_t count, unsigned bits, Put&& put) -> void
+    {
+        const auto bytes = (count * bits + 7) / 8;
+        if (static_cast<size_t>(mEnd - mData) < bytes)
+        {
+            mFailed = true;
+            return;
+        }
+
+        if (bits == 0)
+        {
+            for (auto i = size_t(0); i < count; ++i)
+            {
+                put(i, 0);
+            }
+
+            return;
+        }
+
+        const auto mask = (uint64_t(1) << bits) - 1;
+
+        // Every field is one unaligned 8 byte load and a shift, as long as
+        // the load stays in block. Fields are at most 32 bits wide, so a
+        // field starting anywhere in first byte fits.
+        const auto loads = bytes >= 8 ? ((bytes - 8) * 8) / bits + 1 : 0;
+        const auto fast  = std::min(count, loads);
+
+        for (auto i = size_t(0); i < fast; ++i)
+        {
+            const auto bit = i * bits;
+
+            auto word = uint64_t(0);
+            std::memcpy(&word, mData + bit / 8, sizeof(word));
+
+            put(i, static_cast<uint32_t>((word >> (bit % 8)) & mask));
+        }
+
+        for (auto i = fast; i < count; ++i)
+        {
+            const auto bit = i * bits;
+
+            auto word = uint64_t(0);
+            for (auto byte = bit / 8; byte < bytes && byte < bit / 8 + 8; ++byte)
+            {
+                word |= uint64_t(mData[byte]) << (8 * (byte - bit / 8));
+            }
+
+            put(i, static_cast<uint32_t>((word >> (bit % 8)) & mask));
+        }
+
+        mData += bytes;
+    }
+};
+
+auto EncodeBlock (
+    const HistoryRecord*           records,
+    size_t                         count,
+    const std::vector<uint32_t>&   dictionary,
+    unsigned                       indexBits,
+    std::string&                   out,
+    std::vector<uint32_t>&         blockTasks,
+    ColumnarBlock&                 block
+) -> void
+{
+    block.count         = static_cast<uint32_t>(count);
+    block.firstSequence = records[0].sequence;
+    block.minTime       = records[0].time;
+    block.maxTime       = records[0].time;
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        block.minTime = std::min(block.minTime, records[i].time);
+        block.maxTime = std::max(block.maxTime, records[i].time);
+    }
+
+    const auto start = out.size();
+
+    auto values = std::vector<int64_t>(count);
+
+    auto time = block.minTime;
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        values[i] = records[i].time - time;
+        time      = records[i].time;
+    }
+    PutPacked(out, values);
+
+    auto sequence = block.firstSequence - 1;
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        PutVarint(out, ZigZag(static_cast<int64_t>(records[i].sequence) - sequence - 1));
+        sequence = records[i].sequence;
+    }
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        values[i] = records[i].duration;
+    }
+    PutPacked(out, values);
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        values[i] = records[i].workShift;
+    }
+    PutPacked(out, values);
+
+    auto bits = BitWriter(out);
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        const auto states =
+            static_cast<uint32_t>(records[i].event) |
+            static_cast<uint32_t>(records[i].from) << STATE_BITS |
+            static_cast<uint32_t>(records[i].to)   << (2 * STATE_BITS);
+
+        bits.Put(states, 3 * STATE_BITS);
+    }
+    bits.Flush();
+
+    block.firstTask = static_cast<uint32_t>(blockTasks.size());
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        const auto index = static_cast<uint32_t>(std::lower_bound(dictionary.begin(), dictionary.end(), records[i].task) - dictionary.begin());
+
+        bits.Put(index, indexBits);
+        blockTasks.push_back(index);
+    }
+    bits.Flush();
+
+    const auto tasks = blockTasks.begin() + block.firstTask;
+    std::sort(tasks, blockTasks.end());
+    blockTasks.erase(std::unique(tasks, blockTasks.end()), blockTasks.end());
+    block.taskCount = static_cast<uint32_t>(blockTasks.size() - block.firstTask);
+
+    // Offset rarely changes, usually whole block is one run.
+    auto runs = std::vector<std::pair<uint32_t, uint8_t>>();
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        if (runs.empty() || runs.back().second != records[i].utcOffset)
+        {
+            runs.emplace_back(0, records[i].utcOffset);
+        }
+
+        runs.back().first += 1;
+    }
+
+    PutVarint(out, runs.size());
+    for (const auto& [length, utcOffset] : runs)
+    {
+        PutVarint(out, length);
+        out.push_back(static_cast<char>(utcOffset));
+    }
+
+    block.size = static_cast<uint32_t>(out.size() - start);
+    block.crc  = Impulse::Crc32c(out.data() + start, block.size);
+}
+
+}
+
+namespace Impulse {
+
+auto HistoryColumns::Resize (size_t count) -> void
+{
+    time.resize(count);
+    sequence.resize(count);
+    task.resize(count);
+    duration.resize(count);
+    workShift.resize(count);
+    event.resize(count);
+    from.resize(count);
+    to.resize(count);
+    utcOffset.resize(count);
+}
+
+auto HistoryColumns::Record (size_t i) const -> HistoryRecord
+{
+    auto record = HistoryRecord();
+
+    record.time      = time[i];
+    record.sequence  = sequence[i];
+    record.task      = task[i];
+    record.duration  = duration[i];
+    record.workShift = workShift[i];
+    record.event     = event[i];
+    record.from      = from[i];
+    record.to        = to[i];
+    record.utcOffset = utcOffset[i];
+
+    Seal(record);
+    return record;
+}
+
+auto ScanHistoryColumns (const HistoryColumns& columns, const HistoryQuery& query) -> FocusTotals
+{
+    const auto count     = columns.Size();
+    const auto time      = columns.time.data();
+    const auto task      = columns.task.data();
+    const auto duration  = columns.duration.data();
+    const auto event     = columns.event.data();
+    const auto from      = columns.from.data();
+    const auto anyTask   = query.allTasks;
+
+    auto focus     = uint64_t(0);
+    auto pause     = uint64_t(0);
+    auto pomodoros = uint32_t(0);
+
+    // Conditions become masks instead of branches, one pass per column
+    // would touch memory more times than it saves.
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        const auto match = uint32_t(query.from <= time[i]) & uint32_t(time[i] < query.to) & uint32_t(anyTask | (task[i] == query.task));
+        const auto work  = match & uint32_t(from[i] == ImpulseState::WorkShift);
+        const auto pa    = match & uint32_t(from[i] == ImpulseState::Paused);
+
+        focus     += uint64_t(duration[i] & (0u - work));
+        pause     += uint64_t(duration[i] & (0u - pa));
+        pomodoros += work & uint32_t(event[i] == HistoryEvent::End);
+    }
+
+    auto totals = FocusTotals();
+
+    totals.focus     = focus;
+    totals.pause     = pause;
+    totals.pomodoros = pomodoros;
+
+    return totals;
+}
+
+auto EncodeColumnarHistory (const HistoryRecord* records, size_t count, uint16_t blockSize) -> std::string
+{
+    blockSize = std::max<uint16_t>(blockSize, 1);
+
+    auto dictionary = std::vector<uint32_t>();
+    dictionary.reserve(64);
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        dictionary.push_back(records[i].task);
+
+        // Few distinct tasks, keep the vector small while collecting.
+        if (dictionary.size() >= dictionary.capacity())
+        {
+            std::sort(dictionary.begin(), dictionary.end());
+            dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+        }
+    }
+
+    std::sort(dictionary.begin(), dictionary.end());
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+
+    const auto blockCount = (count + blockSize - 1) / blockSize;
+    const auto indexBits  = IndexBits(static_cast<uint32_t>(dictionary.size()));
+
+    auto header = ColumnarHeader();
+
+    header.magic         = COLUMNAR_MAGIC;
+    header.version       = COLUMNAR_VERSION;
+    header.blockSize     = blockSize;
+    header.records       = static_cast<uint32_t>(count);
+    header.blocks        = static_cast<uint32_t>(blockCount);
+    header.tasks         = static_cast<uint32_t>(dictionary.size());
+    header.firstSequence = count > 0 ? records[0].sequence : 0;
+
+    // Raw records are 32 bytes, columns usually take less than a quarter.
+    auto data = std::string();
+    data.reserve(count * sizeof(HistoryRecord) / 4);
+
+    // Blocks go after block tasks, whose size is known only once they are
+    // encoded, offsets are moved past metadata below.
+    auto blocks     = std::vector<ColumnarBlock>(blockCount);
+    auto blockTasks = std::vector<uint32_t>();
+
+    for (auto b = size_t(0); b < blockCount; ++b)
+    {
+        const auto first = b * blockSize;
+        const auto size  = std::min<size_t>(blockSize, count - first);
+
+        blocks[b].offset = data.size();
+        EncodeBlock(records + first, size, dictionary, indexBits, data, blockTasks, blocks[b]);
+    }
+
+    const auto directoryBytes  = blockCount * sizeof(ColumnarBlock);
+    const auto dictionaryBytes = dictionary.size() * sizeof(uint32_t);
+    const auto blockTaskBytes  = blockTasks.size() * sizeof(uint32_t);
+    const auto metaBytes       = directoryBytes + dictionaryBytes + blockTaskBytes;
+    const auto dataStart       = sizeof(ColumnarHeader) + metaBytes;
+
+    for (auto& block : blocks)
+    {
+        block.offset += dataStart;
+    }
+
+    auto out  = std::string(dataStart, '\0');
+    auto meta = out.data() + sizeof(ColumnarHeader);
+
+    std::memcpy(meta, blocks.data(), directoryBytes);
+    std::memcpy(meta + directoryBytes, dictionary.data(), dictionaryBytes);
+    std::memcpy(meta + directoryBytes + dictionaryBytes, blockTasks.data(), blockTaskBytes);
+
+    header.directoryCrc = Crc32c(meta, metaBytes);
+    header.crc          = Crc32c(&header, offsetof(ColumnarHeader, crc));
+
+    std::memcpy(out.data(), &header, sizeof(header));
+    out += data;
+    return out;
+}
+
+auto ColumnarHistory::TaskIndex (uint32_t task) const -> int64_t
+{
+    const auto last  = mTasks + mHeader.tasks;
+    const auto found = std::lower_bound(mTasks, last, task);
+
+    return found != last && *found == task ? found - mTasks : -1;
+}
+
+auto ColumnarHistory::Decode (size_t block, HistoryColumns& out) const -> bool
+{
+    const auto& info  = mBlocks[block];
+    const auto  data  = mFile->Data() + info.offset;
+    const auto  count = size_t(info.count);
+
+    if (Crc32c(data, info.size) != info.crc)
+    {
+        spdlog::error("Columnar history block {} is damaged", block);
+        return false;
+    }
+
+    out.Resize(count);
+
+    auto reader = BlockReader(data, data + info.size);
+
+    // Deltas first, summed up in a separate pass.
+    reader.Packed(count, [&](size_t i, int64_t delta)
+    {
+        out.time[i] = delta;
+    });
+
+    auto time = info.minTime;
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        time += out.time[i];
+        out.time[i] = time;
+    }
+
+    auto sequence = info.firstSequence - 1;
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        sequence += static_cast<uint32_t>(UnZigZag(reader.Varint()) + 1);
+        out.sequence[i] = sequence;
+    }
+
+    reader.Packed(count, [&](size_t i, int64_t duration)
+    {
+        out.duration[i] = static_cast<uint32_t>(duration);
+    });
+
+    reader.Packed(count, [&](size_t i, int64_t workShift)
+    {
+        out.workShift[i] = static_cast<uint16_t>(workShift);
+    });
+
+    // Event, from and to of one record are read as a single field.
+    constexpr auto mask = (1u << STATE_BITS) - 1;
+
+    reader.Bits(count, 3 * STATE_BITS, [&](size_t i, uint32_t states)
+    {
+        out.event[i] = static_cast<HistoryEvent>(states & mask);
+        out.from[i]  = static_cast<ImpulseState>((states >> STATE_BITS) & mask);
+        out.to[i]    = static_cast<ImpulseState>(states >> (2 * STATE_BITS));
+    });
+
+    const auto indexBits = IndexBits(mHeader.tasks);
+    auto       badIndex  = false;
+
+    reader.Bits(count, indexBits, [&](size_t i, uint32_t index)
+    {
+        badIndex   |= index >= mHeader.tasks;
+        out.task[i] = mTasks[std::min(index, mHeader.tasks - 1)];
+    });
+
+    // Runs must cover block exactly.
+    const auto runs   = reader.Varint();
+    auto       filled = size_t(0);
+
+    for (auto run = uint64_t(0); run < runs && !reader.Failed(); ++run)
+    {
+        const auto length = reader.Varint();
+        const auto value  = reader.Byte();
+
+        if (length > count - filled)
+        {
+            break;
+        }
+
+        std::fill_n(out.utcOffset.begin() + filled, static_cast<size_t>(length), value);
+        filled += static_cast<size_t>(length);
+    }
+
+    if (reader.Failed() || !reader.AtEnd() || badIndex || filled != count)
+    {
+        spdlog::error("Columnar history block {} doesn't decode", block);
+        return false;
+    }
+
+    return true;
+}
+
+auto ColumnarHistory::Skips (size_t block, const HistoryQuery& query) const -> bool
+{
+    const auto& info = mBlocks[block];
+
+    if (info.maxTime < query.from || query.to <= info.minTime)
+    {
+        return true;
+    }
+
+    if (query.allTasks)
+    {
+        return false;
+    }
+
+    const auto index = TaskIndex(query.task);
+    const auto first = mBlockTasks + info.firstTask;
+
+    return index < 0 || !std::binary_search(first, first + info.taskCount, static_cast<uint32_t>(index));
+}
+
+auto ColumnarHistory::Scan (const HistoryQuery& query) const -> FocusTotals
+{
+    auto totals  = FocusTotals();
+    auto columns = HistoryColumns();
+
+    for (auto b = size_t(0); b < mHeader.blocks; ++b)
+    {
+        if (Skips(b, query))
+        {
+            continue;
+        }
+
+        if (Decode(b, columns))
+        {
+            totals += ScanHistoryColumns(columns, query);
+        }
+    }
+
+    return totals;
+}
+
+auto ColumnarHistory::Open (const std::filesystem::path& path) -> std::unique_ptr<ColumnarHistory>
+{
+    auto file = MappedFile::Open(path);
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    auto header = ColumnarHeader();
+    if (file->Size() < sizeof(header))
+    {
+        spdlog::error("Columnar history {} is too short", path.string());
+        return nullptr;
+    }
+
+    std::memcpy(&header, file->Data(), sizeof(header));
+
+    if (header.magic != COLUMNAR_MAGIC ||
+        header.version != COLUMNAR_VERSION ||
+        header.crc != Crc32c(&header, offsetof(ColumnarHeader, crc)))
+    {
+        spdlog::error("Columnar history {} has invalid header", path.string());
+        return nullptr;
+    }
+
+    // Block tasks come last and their size is sum of taskCount, directory
+    // has to be read before the whole of metadata can be checked.
+    const auto directoryBytes = uint64_t(header.blocks) * sizeof(ColumnarBlock) + uint64_t(header.tasks) * sizeof(uint32_t);
+    if (file->Size() - sizeof(header) < directoryBytes || (header.records > 0 && header.tasks == 0))
+    {
+        spdlog::error("Columnar history {} has invalid block directory", path.string());
+        return nullptr;
+    }
+
+    const auto blocks     = reinterpret_cast<const ColumnarBlock*>(file->Data() + sizeof(header));
+    auto       blockTasks = uint64_t(0);
+
+    for (auto b = size_t(0); b < header.blocks; ++b)
+    {
+        if (blocks[b].firstTask != blockTasks)
+        {
+            spdlog::error("Columnar history {} has invalid block directory", path.string());
+            return nullptr;
+        }
+
+        blockTasks += blocks[b].taskCount;
+    }
+
+    const auto metaBytes = directoryBytes + blockTasks * sizeof(uint32_t);
+    if (file->Size() - sizeof(header) < metaBytes ||
+        header.directoryCrc != Crc32c(file->Data() + sizeof(header), static_cast<size_t>(metaBytes)))
+    {
+        spdlog::error("Columnar history {} has invalid block directory", path.string());
+        return nullptr;
+    }
+
+    auto history = std::make_unique<ColumnarHistory>();
+
+    history->mHeader     = header;
+    history->mBlocks     = blocks;
+    history->mTasks      = reinterpret_cast<const uint32_t*>(blocks + header.blocks);
+    history->mBlockTasks = history->mTasks + header.tasks;
+
+    auto records = uint64_t(0);
+    for (auto b = size_t(0); b < header.blocks; ++b)
+    {
+        const auto& block = blocks[b];
+        const auto  tasks = history->mBlockTasks + block.firstTask;
+
+        records += block.count;
+        if (block.offset > file->Size() || file->Size() - block.offset < block.size)
+        {
+            spdlog::error("Columnar history {} block {} is out of file", path.string(), b);
+            return nullptr;
+        }
+
+        // Skips() binary searches these.
+        if (!std::is_sorted(tasks, tasks + block.taskCount) || (block.taskCount > 0 && tasks[block.taskCount - 1] >= header.tasks))
+        {
+            spdlog::error("Columnar history {} block {} has invalid task list", path.string(), b);
+            return nullptr;
+        }
+    }
+
+    if (records != header.records)
+    {
+        spdlog::error("Columnar history {} has {} records in blocks, header says {}", path.string(), records, header.records);
+        return nullptr;
+    }
+
+    history->mFile = std::move(file);
+    return history;
+}
+
+} // namespace Impulse
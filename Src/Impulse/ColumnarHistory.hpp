@@ -0,0 +1,135 @@
+#pragma once
+
+#include "HistoryRecord.hpp"
+#include "HistoryScan.hpp"
+#include "HistoryStats.hpp"
+#include "MappedFile.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Impulse {
+
+constexpr auto COLUMNAR_MAGIC   = uint32_t(0x41504D49); // "IMPA"
+constexpr auto COLUMNAR_VERSION = uint16_t(2);
+
+// Sealed history stored by column instead of as 32 byte records:
+//
+//     header | block directory | task dictionary | block tasks | blocks
+//
+// Each block holds up to blockSize records, column after column:
+//
+//     time       delta from previous, first from minTime, packed
+//     sequence   zigzag varint of (delta - 1), usually one zero byte
+//     duration   packed
+//     workShift  packed
+//     states     event, from, to, 3 bits each, bit-packed
+//     task       index into dictionary, bit-packed in as few bits as it takes
+//     utcOffset  runs of equal values, varint run count, then varint length
+//                and one byte value per run
+//
+// Packed columns are a width byte, zigzag varint of smallest value, then
+// every value less smallest bit-packed at that width, so decoding doesn't
+// branch on length of each value. Width 0xFF is a column of zigzag
+// varints instead, for values more than 32 bits apart.
+//
+// Directory keeps time range of every block and where its sorted list of
+// distinct dictionary indices starts in block tasks. Scans skip blocks
+// outside query range or without the task without reading them.
+//
+// Not part of the app yet, archives stay in record format until compactor
+// writes this and reader and exporter read it. Built with ImpulseCore for
+// tests and benchmarks only.
+struct ColumnarHeader
+{
+    uint32_t magic         = 0;
+    uint16_t version       = 0;
+    uint16_t blockSize     = 0; // records per block, last one may hold less
+    uint32_t records       = 0;
+    uint32_t blocks        = 0;
+    uint32_t tasks         = 0; // dictionary entries
+    uint32_t firstSequence = 0;
+    uint32_t directoryCrc  = 0; // Crc32c() of directory, dictionary and block tasks
+    uint32_t crc           = 0; // Crc32c() of all bytes before it
+};
+
+struct ColumnarBlock
+{
+    uint64_t offset        = 0; // from start of file
+    uint32_t size          = 0; // bytes
+    uint32_t count         = 0; // records
+    int64_t  minTime       = 0;
+    int64_t  maxTime       = 0;
+    uint32_t firstTask     = 0; // into block tasks, sum of taskCount of blocks before
+    uint32_t taskCount     = 0; // distinct tasks in block
+    uint32_t firstSequence = 0;
+    uint32_t crc           = 0; // Crc32c() of block bytes
+};
+
+static_assert(sizeof(ColumnarHeader) == 32, "ColumnarHeader layout is part of file format");
+static_assert(sizeof(ColumnarBlock)  == 48, "ColumnarBlock layout is part of file format");
+
+// Decoded block, one array per field so loops over a field vectorize.
+// Tasks are TaskId() values, dictionary is already applied.
+struct HistoryColumns
+{
+    std::vector<int64_t>      time;
+    std::vector<uint32_t>     sequence;
+    std::vector<uint32_t>     task;
+    std::vector<uint32_t>     duration;
+    std::vector<uint16_t>     workShift;
+    std::vector<HistoryEvent> event;
+    std::vector<ImpulseState> from;
+    std::vector<ImpulseState> to;
+    std::vector<uint8_t>      utcOffset; // as stored in HistoryRecord
+
+    auto Size () const { return time.size(); }
+
+    auto Resize (size_t count) -> void;
+    auto Record (size_t i) const -> HistoryRecord;
+};
+
+// Totals of decoded records matching @query, same rules as ScanHistory().
+// Branch free over columns, compiler vectorizes it.
+auto ScanHistoryColumns (const HistoryColumns& columns, const HistoryQuery& query) -> FocusTotals;
+
+// Columnar file of @count valid records in sequence order.
+auto EncodeColumnarHistory (const HistoryRecord* records, size_t count, uint16_t blockSize = 4096) -> std::string;
+
+// Read access to columnar file, memory mapped. Blocks are checked against
+// their crc when decoded.
+class ColumnarHistory
+{
+    std::unique_ptr<MappedFile> mFile;
+    ColumnarHeader              mHeader;
+    const ColumnarBlock*        mBlocks     = nullptr;
+    const uint32_t*             mTasks      = nullptr; // sorted TaskId()s
+    const uint32_t*             mBlockTasks = nullptr; // sorted dictionary indices, per block
+
+    // Dictionary index of @task, or -1.
+    auto TaskIndex (uint32_t task) const -> int64_t;
+
+public:
+    auto Records () const { return mHeader.records; }
+    auto Blocks  () const { return mHeader.blocks; }
+    auto Tasks   () const { return mHeader.tasks; }
+    auto Block   (size_t block) const -> const ColumnarBlock& { return mBlocks[block]; }
+    auto Size    () const { return mFile->Size(); }
+
+    // True when no record of @block can match @query, Scan() doesn't
+    // decode it.
+    auto Skips (size_t block, const HistoryQuery& query) const -> bool;
+
+    // False when block is damaged, @out is reused.
+    auto Decode (size_t block, HistoryColumns& out) const -> bool;
+
+    // Decodes only blocks @query can match.
+    auto Scan (const HistoryQuery& query) const -> FocusTotals;
+
+    static auto Open (const std::filesystem::path& path) -> std::unique_ptr<ColumnarHistory>;
+};
+
+} // namespace Impulse
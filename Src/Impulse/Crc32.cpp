@@ -0,0 +1,151 @@
+#include "Crc32.hpp"
+
+#include <array>
+#include <cstring>
+
+#include <immintrin.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+// Rest of the build doesn't assume SSE4.2, GCC and Clang need to be told
+// this function may use it. MSVC takes intrinsics anywhere.
+#if defined(_MSC_VER)
+#define IMPULSE_TARGET_SSE42
+#else
+#define IMPULSE_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+
+namespace {
+
+using Crc32Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+// Slicing-by-8: tables[k][b] is crc of byte b followed by k zero bytes, so
+// eight bytes are folded in with eight independent lookups instead of a
+// chain of eight dependent ones.
+constexpr auto MakeCrc32Tables (uint32_t polynomial)
+{
+    auto tables = Crc32Tables();
+
+    for (auto i = uint32_t(0); i < 256; ++i)
+    {
+        auto crc = i;
+        for (auto bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ polynomial : (crc >> 1);
+        }
+
+        tables[0][i] = crc;
+    }
+
+    for (auto k = size_t(1); k < tables.size(); ++k)
+    {
+        for (auto i = size_t(0); i < 256; ++i)
+        {
+            tables[k][i] = tables[0][tables[k - 1][i] & 0xFF] ^ (tables[k - 1][i] >> 8);
+        }
+    }
+
+    return tables;
+}
+
+constexpr auto CRC32_TABLES  = MakeCrc32Tables(0xEDB88320u);
+constexpr auto CRC32C_TABLES = MakeCrc32Tables(0x82F63B78u);
+
+auto Load32 (const uint8_t* bytes) -> uint32_t
+{
+    // Little endian, as the lookup order below expects.
+    return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+}
+
+auto Slice8 (const Crc32Tables& t, const uint8_t* bytes, size_t size, uint32_t crc) -> uint32_t
+{
+    crc = ~crc;
+
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        const auto lo = Load32(bytes) ^ crc;
+        const auto hi = Load32(bytes + 4);
+
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24]
+            ;;
+    }
+
+    for (; size > 0; --size, ++bytes)
+    {
+        crc = t[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+IMPULSE_TARGET_SSE42
+auto Crc32cSse42 (const uint8_t* bytes, size_t size, uint32_t crc) -> uint32_t
+{
+    crc = ~crc;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    auto wide = uint64_t(crc);
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        auto value = uint64_t(0);
+        std::memcpy(&value, bytes, sizeof(value));
+        wide = _mm_crc32_u64(wide, value);
+    }
+    crc = static_cast<uint32_t>(wide);
+#endif
+
+    for (; size >= 4; size -= 4, bytes += 4)
+    {
+        auto value = uint32_t(0);
+        std::memcpy(&value, bytes, sizeof(value));
+        crc = _mm_crc32_u32(crc, value);
+    }
+
+    for (; size > 0; --size, ++bytes)
+    {
+        crc = _mm_crc32_u8(crc, *bytes);
+    }
+
+    return ~crc;
+}
+
+auto HasSse42 () -> bool
+{
+#if defined(_WIN32)
+    static const auto hasSse42 = IsProcessorFeaturePresent(PF_SSE4_2_INSTRUCTIONS_AVAILABLE) != FALSE;
+#else
+    static const auto hasSse42 = __builtin_cpu_supports("sse4.2") != 0;
+#endif
+    return hasSse42;
+}
+
+}
+
+namespace Impulse {
+
+auto Crc32 (const void* data, size_t size, uint32_t crc) -> uint32_t
+{
+    return Slice8(CRC32_TABLES, static_cast<const uint8_t*>(data), size, crc);
+}
+
+auto Crc32cScalar (const void* data, size_t size, uint32_t crc) -> uint32_t
+{
+    return Slice8(CRC32C_TABLES, static_cast<const uint8_t*>(data), size, crc);
+}
+
+auto Crc32c (const void* data, size_t size, uint32_t crc) -> uint32_t
+{
+    if (!HasSse42())
+    {
+        return Crc32cScalar(data, size, crc);
+    }
+
+    return Crc32cSse42(static_cast<const uint8_t*>(data), size, crc);
+}
+
+} // namespace Impulse
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Impulse {
+
+// CRC-32 (IEEE 802.3, same as zlib). Pass previous result as @crc to
+// continue over more data.
+auto Crc32 (const void* data, size_t size, uint32_t crc = 0) -> uint32_t;
+
+// CRC-32C (Castagnoli), what SSE4.2 computes in hardware. Several times
+// faster than Crc32() where data is checked in bulk, table driven on
+// processors without it.
+auto Crc32c       (const void* data, size_t size, uint32_t crc = 0) -> uint32_t;
+auto Crc32cScalar (const void* data, size_t size, uint32_t crc = 0) -> uint32_t;
+
+} // namespace Impulse
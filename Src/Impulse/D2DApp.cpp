@@ -1,10 +1,24 @@
 #include "PCH.hpp"
 #include "D2DApp.hpp"
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
 
 #include <spdlog/spdlog.h>
+#include <wtsapi32.h>
 
 namespace Impulse {
 
+D2DApp::~D2DApp ()
+{
+    UnwatchOcclusion();
+
+    if (mSessionNotifications)
+    {
+        WTSUnRegisterSessionNotification(Handle());
+    }
+}
+
 auto D2DApp::CreateFactories () -> bool
 {
     // Create D2D1 Factory.
@@ -126,6 +140,12 @@ auto D2DApp::CreateRenderTarget () -> bool
     {
         // Resize
         auto hr = mDXGISwapChain->ResizeBuffers(0, 0, 0, DXGI_FORMAT_B8G8R8A8_UNORM, 0);
+        if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
+        {
+            spdlog::warn("Device lost while resizing SwapChain");
+            mDeviceRecovery.Lost();
+            return false;
+        }
     }
     else
     {
@@ -210,22 +230,133 @@ auto D2DApp::CreateRenderTarget () -> bool
     return true;
 }
 
+auto D2DApp::DiscardDevice () -> void
+{
+    spdlog::debug("Discarding D3D11/D2D1 Device");
+
+    if (mD2DDeviceContext)
+    {
+        OnDeviceLost();
+        mD2DDeviceContext->SetTarget(nullptr);
+    }
+
+    mD2DTargetBitmap  = nullptr;
+    mDXGISwapChain    = nullptr;
+    mD2DDeviceContext = nullptr;
+    mD2DDevice        = nullptr;
+
+    // SwapChain must be really released before creating new one for the same
+    // window, D3D11 defers destruction until context is flushed.
+    if (mD3DDeviceContext)
+    {
+        mD3DDeviceContext->ClearState();
+        mD3DDeviceContext->Flush();
+    }
+
+    mD3DDeviceContext = nullptr;
+    mD3DDevice        = nullptr;
+
+    // Occlusion is reported by Present(), new swap chain will tell again.
+    mVisibility.SwapChainReleased();
+}
+
+auto D2DApp::WatchOcclusion () -> bool
+{
+    if (mOcclusionCookie != 0)
+    {
+        return true;
+    }
+
+    if (!mDXGISwapChain || FAILED(mDXGISwapChain->GetParent(IID_PPV_ARGS(&mOcclusionFactory))))
+    {
+        return false;
+    }
+
+    auto hr = mOcclusionFactory->RegisterOcclusionStatusWindow(
+        Handle(), WM_D2DAPP_OCCLUSION_STATUS, &mOcclusionCookie
+    );
+    if (FAILED(hr))
+    {
+        spdlog::warn("RegisterOcclusionStatusWindow() failed: {}", DX::GetErrorMessage(hr));
+        mOcclusionFactory = nullptr;
+        mOcclusionCookie  = 0;
+        return false;
+    }
+
+    return true;
+}
+
+auto D2DApp::UnwatchOcclusion () -> void
+{
+    if (mOcclusionFactory && mOcclusionCookie != 0)
+    {
+        mOcclusionFactory->UnregisterOcclusionStatus(mOcclusionCookie);
+    }
+
+    mOcclusionFactory = nullptr;
+    mOcclusionCookie  = 0;
+}
+
 auto D2DApp::Draw () -> void
 {
+    // Requests made while hidden are replaced by one catch-up frame.
+    if (!mVisibility.IsVisible())
+    {
+        if (mRedraw)
+        {
+            mRedraw = false;
+            mLoopStats.hiddenFrames += 1;
+        }
+        return;
+    }
+
+    if (!mDeviceRecovery.Recover())
+    {
+        return;
+    }
+
     if (mRedraw && mD2DDeviceContext)
     {
+        // Steady state frame should not allocate.
+        const auto allocations = AllocationCount();
+
         mD2DDeviceContext->BeginDraw();
         mD2DDeviceContext->Clear(D2D1::ColorF(D2D1::ColorF::White));
 
         OnDraw();
 
-        mD2DDeviceContext->EndDraw();
+        auto hr = mD2DDeviceContext->EndDraw();
+        if (SUCCEEDED(hr))
+        {
+            auto parameters = DXGI_PRESENT_PARAMETERS{0};
+            hr = mDXGISwapChain->Present1(1, 0, &parameters);
+            mLoopStats.frames += 1;
 
-        auto parameters = DXGI_PRESENT_PARAMETERS{0};
-        auto hr = mDXGISwapChain->Present1(1, 0, &parameters);
-        if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
+            // Stop drawing until DXGI says window can be seen again. Without
+            // the notification there would be no way back, keep drawing then.
+            mVisibility.Presented(hr == DXGI_STATUS_OCCLUDED);
+        }
+
+        mLoopStats.allocations += AllocationCount() - allocations;
+
+        if (mSimulateDeviceLost)
         {
-        
+            mSimulateDeviceLost = false;
+            hr = DXGI_ERROR_DEVICE_REMOVED;
+        }
+
+        if (hr == DXGI_ERROR_DEVICE_REMOVED
+        ||  hr == DXGI_ERROR_DEVICE_RESET
+        ||  hr == D2DERR_RECREATE_TARGET
+           )
+        {
+            const auto reason = mD3DDevice->GetDeviceRemovedReason();
+            spdlog::warn("Device lost ({}): {}", reason, DX::GetErrorMessage(reason));
+
+            // Recreate right away, frame will be redrawn on next loop iteration.
+            mDeviceRecovery.Lost();
+            mDeviceRecovery.Recover();
+            return;
         }
 
         mRedraw = false;
@@ -234,6 +365,25 @@ auto D2DApp::Draw () -> void
 
 auto D2DApp::Init (D2DApp::Desc desc) -> bool
 {
+    // Window reports minimize while it's being created already.
+    auto visibilityDesc             = VisibilityController::Desc();
+    visibilityDesc.watchOcclusion   = [this] { return WatchOcclusion(); };
+    visibilityDesc.unwatchOcclusion = [this] { UnwatchOcclusion(); };
+    visibilityDesc.catchUp          = [this] { Redraw(); };
+    visibilityDesc.changed          = [this] (bool visible)
+    {
+        mVisible = visible;
+        spdlog::debug("Window {}", visible ? "visible" : "hidden");
+    };
+
+    // Test present doesn't show anything, it only reports occlusion.
+    visibilityDesc.stillOccluded = [this]
+    {
+        return mDXGISwapChain && mDXGISwapChain->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED;
+    };
+
+    mVisibility = VisibilityController(visibilityDesc);
+
     if (!Window::Init(desc.windowDesc))
     {
         return false;
@@ -244,6 +394,13 @@ auto D2DApp::Init (D2DApp::Desc desc) -> bool
         return false;
     }
 
+    auto recoveryDesc     = DeviceRecovery::Desc();
+    recoveryDesc.discard  = [this] { DiscardDevice(); };
+    recoveryDesc.create   = [this] { return CreateD2D() && CreateRenderTarget(); };
+    recoveryDesc.restored = [this] { OnDeviceRestored(); Redraw(); };
+
+    mDeviceRecovery = DeviceRecovery(recoveryDesc);
+
     if (!CreateD2D())
     {
         return false;
@@ -254,6 +411,13 @@ auto D2DApp::Init (D2DApp::Desc desc) -> bool
         return false;
     }
 
+    // Lock screen hides the window without minimizing or occluding it.
+    mSessionNotifications = WTSRegisterSessionNotification(Handle(), NOTIFY_FOR_THIS_SESSION) != FALSE;
+    if (!mSessionNotifications)
+    {
+        spdlog::warn("WTSRegisterSessionNotification() failed");
+    }
+
     return true;
 }
 
@@ -266,6 +430,11 @@ auto D2DApp::GfxLoop () -> int
         {
             if (msg.message == WM_QUIT)
             {
+                spdlog::debug(
+                    "Loop stats: {} wakeups, {} frame requests, {} frames, {} allocations, {} hidden frames",
+                    mLoopStats.wakeups, mLoopStats.frameRequests, mLoopStats.frames,
+                    mLoopStats.allocations, mLoopStats.hiddenFrames
+                );
                 return 0;
             }
             else
@@ -275,11 +444,89 @@ auto D2DApp::GfxLoop () -> int
             }
         }
 
+        OnUpdate();
+
+        // Hidden window doesn't advance animations, they are time based and
+        // catch up on first visible frame.
+        const auto visible        = mVisibility.IsVisible();
+        const auto animationFrame = visible && mAnimations.Tick();
+        if (animationFrame)
+        {
+            Redraw();
+        }
+
         Draw();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        // While something animates Present1() paces the loop to vsync. Active
+        // animation which skipped a frame waits until its WakeTime() instead.
+        // Otherwise sleep until there is a message (input, timer tick, ...).
+        // Hidden window only wakes up for messages.
+        const auto deviceLost = mDeviceRecovery.IsLost();
+        if (!visible || deviceLost || (!animationFrame && !mRedraw))
+        {
+            auto timeout = DWORD{INFINITE};
+            if (visible && deviceLost)
+            {
+                timeout = 250;
+            }
+            else if (visible && !mAnimations.IsIdle())
+            {
+                // Animation that skipped the frame may know when it has
+                // something to show, otherwise check again next frame.
+                const auto now  = mAnimations.Now();
+                const auto wake = mAnimations.WakeTime();
+
+                timeout = 16;
+                if (wake == AnimationClock::time_point::max())
+                {
+                    timeout = INFINITE;
+                }
+                else if (wake > now)
+                {
+                    const auto wait = std::chrono::ceil<std::chrono::milliseconds>(wake - now);
+                    timeout = static_cast<DWORD>(std::min<int64_t>(wait.count(), INFINITE - 1));
+                }
+            }
+
+            // Mouse moves until then are coalesced by message queue, waking
+            // up for each would only mean going back to sleep.
+            auto wakeMask = DWORD{QS_ALLINPUT};
+
+            const auto update = UpdateTime();
+            if (update != AnimationClock::time_point::max())
+            {
+                const auto now  = AnimationClock::now();
+                const auto wait = update > now ? std::chrono::ceil<std::chrono::milliseconds>(update - now).count() : 0;
+
+                timeout  = std::min(timeout, static_cast<DWORD>(std::min<int64_t>(wait, INFINITE - 1)));
+                wakeMask = QS_ALLINPUT & ~QS_MOUSEMOVE;
+            }
+
+            MsgWaitForMultipleObjectsEx(0, nullptr, timeout, wakeMask, MWMO_INPUTAVAILABLE);
+            mLoopStats.wakeups += 1;
+        }
     }
 
     return 0;
 }
 
+auto D2DApp::CustomMessageHandler (UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT
+{
+    switch (message)
+    {
+    case WM_D2DAPP_OCCLUSION_STATUS:
+        mVisibility.OcclusionStatus();
+        return 0;
+
+    case WM_WTSSESSION_CHANGE:
+        if (wParam == WTS_SESSION_LOCK || wParam == WTS_SESSION_UNLOCK)
+        {
+            mVisibility.SessionLocked(wParam == WTS_SESSION_LOCK);
+        }
+        return 0;
+    }
+
+    return Window::CustomMessageHandler(message, wParam, lParam);
+}
+
 } // namespace Impulse
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Animation.hpp"
+#include "DeviceRecovery.hpp"
+#include "Visibility.hpp"
 #include "Window.hpp"
 
 #include "DX.hpp"
@@ -7,6 +10,9 @@
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+#include <atomic>
+#include <chrono>
+
 #include <d2d1_3.h>
 #include <d3d11.h>
 #include <dxgi1_2.h>
@@ -23,11 +29,24 @@ namespace Impulse {
 class D2DApp : public Window
 {
 public:
+    // DXGI posts this when occluded window may be visible again.
+    static constexpr auto WM_D2DAPP_OCCLUSION_STATUS = WM_APP + 1;
+
     struct Desc
     {
         Window::Desc windowDesc = Window::Desc();
     };
 
+    // Loop instrumentation.
+    struct LoopStats
+    {
+        uint64_t wakeups       = 0; // loop woke up from waiting for messages
+        uint64_t frameRequests = 0; // Redraw() calls, including animation frames
+        uint64_t frames        = 0; // frames actually drawn and presented
+        uint64_t allocations   = 0; // heap allocations while drawing, see AllocationCount()
+        uint64_t hiddenFrames  = 0; // frame requests dropped while window wasn't visible
+    };
+
 protected:
     // Direct2D.
     ComPtr<ID2D1Factory6>       mD2DFactory;
@@ -47,16 +66,43 @@ protected:
     ComPtr<IDWriteFactory>      mDWriteFactory;
 
     // 
-    bool mRedraw = true;
+    bool mRedraw             = true;
+    bool mSimulateDeviceLost = false;
+
+    // Rebuilds device after it was removed or reset, see DeviceRecovery.
+    DeviceRecovery        mDeviceRecovery;
+
+    // Animations, loop keeps drawing frames only while some are active.
+    AnimationScheduler    mAnimations;
+    LoopStats             mLoopStats;
+
+    // Nothing is drawn while window is minimized, occluded or session locked.
+    VisibilityController  mVisibility;
+    std::atomic<bool>     mVisible              { true };
+    ComPtr<IDXGIFactory2> mOcclusionFactory;
+    DWORD                 mOcclusionCookie      = 0;
+    bool                  mSessionNotifications = false;
     
 protected:
 
-    auto Redraw () { mRedraw = true; }
+    auto Redraw () { mRedraw = true; mLoopStats.frameRequests += 1; }
+
+    // Make next Draw() behave as if the device was removed (used to exercise
+    // the recovery path without a real driver reset).
+    auto SimulateDeviceLost () { mSimulateDeviceLost = true; }
 
     auto CreateFactories    () -> bool;
     auto CreateD2D          () -> bool;
     auto CreateRenderTarget () -> bool;
 
+    // Release device and swap chain, DeviceRecovery creates them again.
+    // Factories, window and everything on the CPU side are kept.
+    auto DiscardDevice      () -> void;
+
+    // Ask DXGI to post WM_D2DAPP_OCCLUSION_STATUS once window can be seen.
+    auto WatchOcclusion     () -> bool;
+    auto UnwatchOcclusion   () -> void;
+
 protected:
 
     auto GetD2DFactory       () const { return mD2DFactory.Get(); }
@@ -72,6 +118,9 @@ protected:
 
     auto GetDWriteFactory    () const { return mDWriteFactory.Get(); }
 
+    auto GetAnimations       ()       { return &mAnimations; }
+    auto GetLoopStats        () const { return mLoopStats; }
+
 
 protected:
     virtual auto Draw () -> void;
@@ -85,14 +134,39 @@ protected:
         }
     }
 
-    virtual auto OnDraw () -> void {}
+    virtual auto OnMinimize (bool minimized) -> void
+    {
+        mVisibility.Minimized(minimized);
+    }
+
+    virtual auto CustomMessageHandler (UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT;
+
+    // Called once per loop iteration, after pending messages were handled
+    // and before frame is drawn. Input coalesced while handling messages is
+    // resolved here.
+    virtual auto OnUpdate () -> void {}
+    virtual auto OnDraw   () -> void {}
+
+    // Work OnUpdate() put off to a later frame, e.g. coalesced pointer move.
+    // Idle loop wakes up for it, and mouse moves alone don't wake it before.
+    // max() when there is none.
+    virtual auto UpdateTime () const -> AnimationClock::time_point { return AnimationClock::time_point::max(); }
+
+    // Called before the device is released and after it has been recreated.
+    // Device dependent resources (brushes, svg documents, bitmaps) must be
+    // dropped in OnDeviceLost and rebuilt in OnDeviceRestored.
+    virtual auto OnDeviceLost     () -> void {}
+    virtual auto OnDeviceRestored () -> void {}
 
 public:
     D2DApp () = default;
-    virtual ~D2DApp () = default;
+    virtual ~D2DApp ();
 
     auto Init (D2DApp::Desc desc) -> bool;
 
+    // Safe to call from any thread, e.g. to skip redraw requests from timer.
+    auto IsVisible () const { return mVisible.load(); }
+
     auto GfxLoop () -> int;
 };
 
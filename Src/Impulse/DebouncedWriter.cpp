@@ -0,0 +1,167 @@
+#include "DebouncedWriter.hpp"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse {
+
+DebouncedWriter::DebouncedWriter (const DebouncedWriter::Desc& desc)
+    : mPath          (desc.path)
+    , mDelay         (desc.delay)
+    , mMaxDelay      (std::max(desc.maxDelay, desc.delay))
+    , mWrite         (desc.write ? desc.write : Write(WriteFileAtomic))
+    , mRetryDelay    (desc.retryDelay)
+    , mMaxRetryDelay (std::max(desc.maxRetryDelay, desc.retryDelay))
+{
+    mThread = std::thread(&DebouncedWriter::Worker, this);
+}
+
+DebouncedWriter::~DebouncedWriter ()
+{
+    Flush();
+
+    {
+        auto guard = std::lock_guard<std::mutex>(mMutex);
+        mDone = true;
+    }
+
+    mWake.notify_one();
+    mThread.join();
+}
+
+auto DebouncedWriter::Worker () -> void
+{
+    auto lock = std::unique_lock<std::mutex>(mMutex);
+
+    while (true)
+    {
+        if (!mPending)
+        {
+            if (mDone)
+            {
+                return;
+            }
+
+            mWake.wait(lock);
+            continue;
+        }
+
+        // Wait for burst of submissions to settle, and for disk that just
+        // failed to have a chance to come back.
+        auto due = std::min(mLastSubmit + mDelay, mFirstSubmit + mMaxDelay);
+        if (mFailures > 0)
+        {
+            due = std::max(due, mRetryAt);
+        }
+
+        if (!mFlush && !mDone && Clock::now() < due)
+        {
+            mWake.wait_until(lock, due);
+            continue;
+        }
+
+        auto       serialize = std::move(mPending);
+        const auto flushing  = mFlush;
+        mPending = nullptr;
+        mWriting = true;
+
+        // Disk and serialization happen without lock, Submit() never waits
+        // for them.
+        lock.unlock();
+
+        auto       data = serialize();
+        const auto r    = mWrite(mPath, data);
+        if (!r)
+        {
+            spdlog::error("Failed to write '{}'", mPath.string());
+        }
+
+        lock.lock();
+
+        mWriting  = false;
+        mWritten += r ? 1 : 0;
+        mFailed  += r ? 0 : 1;
+
+        if (r)
+        {
+            mLastWritten = std::move(data);
+            mFailures    = 0;
+        }
+        else
+        {
+            // Shutdown gets one more attempt after Flush(), then whatever
+            // is left is lost.
+            if (mDone)
+            {
+                spdlog::error("Giving up on writing '{}'", mPath.string());
+
+                mPending = nullptr;
+                mIdle.notify_all();
+                return;
+            }
+
+            // Newer submission has everything failed one had.
+            if (!mPending)
+            {
+                mPending     = std::move(serialize);
+                mFirstSubmit = Clock::now();
+                mLastSubmit  = mFirstSubmit;
+            }
+
+            const auto shift = std::min<uint32_t>(mFailures, 16);
+            const auto delay = std::min<std::chrono::milliseconds>(mRetryDelay * (int64_t(1) << shift), mMaxRetryDelay);
+
+            mFailures += 1;
+            mRetryAt   = Clock::now() + delay;
+
+            // Flush() waited for this attempt, it doesn't get to spin.
+            if (flushing)
+            {
+                mFlush = false;
+            }
+        }
+
+        if (!mPending)
+        {
+            mFlush = false;
+        }
+
+        mIdle.notify_all();
+    }
+}
+
+auto DebouncedWriter::Submit (Serialize serialize) -> void
+{
+    {
+        auto guard = std::lock_guard<std::mutex>(mMutex);
+
+        const auto now = Clock::now();
+        if (!mPending)
+        {
+            mFirstSubmit = now;
+        }
+
+        mPending     = std::move(serialize);
+        mLastSubmit  = now;
+        mSubmitted  += 1;
+    }
+
+    mWake.notify_one();
+}
+
+auto DebouncedWriter::Flush () -> bool
+{
+    auto lock = std::unique_lock<std::mutex>(mMutex);
+
+    mFlush = true;
+    mWake.notify_one();
+
+    // Failed attempt leaves submission pending and clears mFlush.
+    mIdle.wait(lock, [&] { return !mWriting && (!mPending || !mFlush); });
+    mFlush = false;
+
+    return !mPending && mFailures == 0;
+}
+
+} // namespace Impulse
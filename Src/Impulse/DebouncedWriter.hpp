@@ -0,0 +1,107 @@
+#pragma once
+
+#include "AtomicFile.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace Impulse {
+
+// Writes one file from a background thread. Caller submits a function that
+// produces file content; it runs on the writer thread, so it must own a
+// snapshot of whatever it serializes. Submissions coming in quick
+// succession replace each other and end up as a single write. Failed one
+// stays pending and is tried again later unless a newer one replaces it.
+class DebouncedWriter
+{
+public:
+    using Serialize = std::function<std::string ()>;
+    using Write     = std::function<bool (const std::filesystem::path& path, std::string_view data)>;
+
+    struct Desc
+    {
+        std::filesystem::path     path;
+
+        // Write happens once no new submission came for @delay, but no
+        // later than @maxDelay after first unwritten one.
+        std::chrono::milliseconds delay    = std::chrono::milliseconds(500);
+        std::chrono::milliseconds maxDelay = std::chrono::milliseconds(5000);
+
+        // Replaceable to inject faults, WriteFileAtomic() by default.
+        Write                     write;
+
+        // Pause after failed write, doubles with every further failure up
+        // to @maxRetryDelay.
+        std::chrono::milliseconds retryDelay    = std::chrono::milliseconds(1000);
+        std::chrono::milliseconds maxRetryDelay = std::chrono::milliseconds(60000);
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::filesystem::path     mPath;
+    std::chrono::milliseconds mDelay;
+    std::chrono::milliseconds mMaxDelay;
+    Write                     mWrite;
+    std::chrono::milliseconds mRetryDelay;
+    std::chrono::milliseconds mMaxRetryDelay;
+
+    std::thread               mThread;
+    std::mutex                mMutex;
+    std::condition_variable   mWake;      // new work or shutdown
+    std::condition_variable   mIdle;      // pending write finished
+
+    Serialize                 mPending;
+    std::string               mLastWritten;
+    Clock::time_point         mFirstSubmit;
+    Clock::time_point         mLastSubmit;
+    Clock::time_point         mRetryAt;
+    uint32_t                  mFailures   = 0; // in a row, since last success
+    bool                      mWriting    = false;
+    bool                      mFlush      = false;
+    bool                      mDone       = false;
+
+    uint64_t                  mSubmitted  = 0;
+    uint64_t                  mWritten    = 0;
+    uint64_t                  mFailed     = 0;
+
+    auto Worker () -> void;
+
+    DebouncedWriter            (const DebouncedWriter& rhs) = delete;
+    DebouncedWriter& operator= (const DebouncedWriter& rhs) = delete;
+
+public:
+    explicit DebouncedWriter (const Desc& desc);
+
+    // Flushes pending write.
+    ~DebouncedWriter ();
+
+    // Schedule write, replaces one that hasn't started yet. Never blocks on
+    // disk.
+    auto Submit (Serialize serialize) -> void;
+
+    // Write pending content now and wait until it is on disk. Meant for
+    // shutdown, returns false when it failed, or an earlier write did and
+    // nothing succeeded since.
+    auto Flush () -> bool;
+
+    // True while a submission waits or is being written. Change of the file
+    // seen meanwhile is likely our own write.
+    auto Busy () -> bool { auto guard = std::lock_guard<std::mutex>(mMutex); return mPending || mWriting; }
+
+    // Content of last successful write, empty before first one.
+    auto LastWritten () -> std::string { auto guard = std::lock_guard<std::mutex>(mMutex); return mLastWritten; }
+
+    auto Submitted () { auto guard = std::lock_guard<std::mutex>(mMutex); return mSubmitted; }
+    auto Written   () { auto guard = std::lock_guard<std::mutex>(mMutex); return mWritten;   }
+    auto Failed    () { auto guard = std::lock_guard<std::mutex>(mMutex); return mFailed;    }
+};
+
+} // namespace Impulse
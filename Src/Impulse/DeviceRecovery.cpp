@@ -0,0 +1,71 @@
+#include "DeviceRecovery.hpp"
+
+#include <exception>
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse {
+
+auto DeviceRecovery::Lost () -> void
+{
+    if (mLost)
+    {
+        return;
+    }
+
+    mLost        = true;
+    mNextAttempt = Clock::time_point();
+}
+
+auto DeviceRecovery::Recover () -> bool
+{
+    if (!mLost)
+    {
+        return true;
+    }
+
+    const auto now = mTimeSource();
+    if (now < mNextAttempt)
+    {
+        return false;
+    }
+
+    mNextAttempt  = now + mDesc.retryInterval;
+    mAttempts    += 1;
+
+    spdlog::info("Recovering from device loss");
+
+    mDesc.discard();
+
+    auto created = false;
+    try
+    {
+        created = mDesc.create();
+    }
+    catch (std::exception&)
+    {
+        created = false;
+    }
+
+    if (!created)
+    {
+        spdlog::error("Failed to recreate device, will retry");
+        mDesc.discard();
+        return false;
+    }
+
+    mLost        = false;
+    mRecoveries += 1;
+
+    mDesc.restored();
+
+    const auto elapsed = mTimeSource() - now;
+    spdlog::info(
+        "Device recovered in {} ms",
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+    );
+
+    return true;
+}
+
+} // namespace Impulse
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace Impulse {
+
+// Decides when a lost GPU device is rebuilt. Owner reports loss with Lost()
+// and calls Recover() before every frame. First rebuild runs right away,
+// failed ones are retried once per retry interval, a driver that is still
+// resetting isn't hammered.
+//
+// Knows nothing about D3D, device is released and created through Desc
+// callbacks, so it can be driven by a fake device and a virtual clock.
+class DeviceRecovery
+{
+public:
+    using Clock      = std::chrono::steady_clock;
+    using TimeSource = std::function<Clock::time_point ()>;
+
+    struct Desc
+    {
+        std::function<void ()>    discard       = []{};              // release device and resources created on it
+        std::function<bool ()>    create        = []{ return true; }; // false or exception when it failed
+        std::function<void ()>    restored      = []{};              // rebuild device resources
+        std::chrono::milliseconds retryInterval = std::chrono::milliseconds(250);
+    };
+
+private:
+    Desc              mDesc;
+    TimeSource        mTimeSource  = []{ return Clock::now(); };
+    Clock::time_point mNextAttempt = Clock::time_point();
+    bool              mLost        = false;
+    uint64_t          mAttempts    = 0;
+    uint64_t          mRecoveries  = 0;
+
+public:
+    DeviceRecovery () = default;
+    explicit DeviceRecovery (const Desc& desc)
+        : mDesc (desc)
+    {
+    }
+
+    // Replace time source (e.g. with virtual clock).
+    auto SetTimeSource (TimeSource timeSource) { mTimeSource = std::move(timeSource); }
+
+    // Device was removed or reset. Next Recover() rebuilds it right away,
+    // unless it is already being recovered.
+    auto Lost () -> void;
+
+    // Rebuild lost device when retry interval passed. True when device can
+    // be drawn with.
+    auto Recover () -> bool;
+
+    auto IsLost     () const { return mLost; }
+    auto Attempts   () const { return mAttempts; }
+    auto Recoveries () const { return mRecoveries; }
+};
+
+} // namespace Impulse
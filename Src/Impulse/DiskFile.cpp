@@ -0,0 +1,338 @@
+#include "DiskFile.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+#include "Utility.hpp"
+#else
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+#if defined(_WIN32)
+
+auto ErrorMessage () -> std::string
+{
+    return Impulse::GetLastErrorMessage();
+}
+
+auto Handle (intptr_t file) -> HANDLE
+{
+    return reinterpret_cast<HANDLE>(file);
+}
+
+#else
+
+auto ErrorMessage () -> std::string
+{
+    return std::strerror(errno);
+}
+
+// Makes renames and deletes in @path's directory durable.
+auto FlushDirectory (const std::filesystem::path& path) -> void
+{
+    auto parent = path.parent_path();
+    if (parent.empty())
+    {
+        parent = ".";
+    }
+
+    const auto dir = ::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir >= 0)
+    {
+        ::fsync(dir);
+        ::close(dir);
+    }
+}
+
+#endif
+
+}
+
+namespace Impulse {
+
+#if defined(_WIN32)
+
+DiskFile::~DiskFile ()
+{
+    if (mFile != -1)
+    {
+        CloseHandle(Handle(mFile));
+    }
+}
+
+auto DiskFile::Size (uint64_t& size) -> bool
+{
+    auto fileSize = LARGE_INTEGER{};
+    if (!GetFileSizeEx(Handle(mFile), &fileSize))
+    {
+        spdlog::error("GetFileSizeEx() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    size = static_cast<uint64_t>(fileSize.QuadPart);
+    return true;
+}
+
+auto DiskFile::ReadAt (uint64_t offset, void* data, size_t size) -> bool
+{
+    auto overlapped       = OVERLAPPED{};
+    overlapped.Offset     = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    auto read = DWORD(0);
+    if (!ReadFile(Handle(mFile), data, static_cast<DWORD>(size), &read, &overlapped) || read != size)
+    {
+        spdlog::error("ReadFile() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+auto DiskFile::WriteAt (uint64_t offset, const void* data, size_t size) -> bool
+{
+    auto overlapped       = OVERLAPPED{};
+    overlapped.Offset     = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    auto written = DWORD(0);
+    if (!WriteFile(Handle(mFile), data, static_cast<DWORD>(size), &written, &overlapped) || written != size)
+    {
+        spdlog::error("WriteFile() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+auto DiskFile::Truncate (uint64_t size) -> bool
+{
+    auto position     = LARGE_INTEGER{};
+    position.QuadPart = static_cast<LONGLONG>(size);
+
+    if (!SetFilePointerEx(Handle(mFile), position, nullptr, FILE_BEGIN) || !SetEndOfFile(Handle(mFile)))
+    {
+        spdlog::error("SetEndOfFile() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+auto DiskFile::Flush () -> bool
+{
+    if (!FlushFileBuffers(Handle(mFile)))
+    {
+        spdlog::error("FlushFileBuffers() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+auto DiskFile::Open (const std::filesystem::path& path, DiskFileMode mode) -> std::unique_ptr<DiskFile>
+{
+    const auto file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ,
+        nullptr,
+        mode == DiskFileMode::OpenAlways ? OPEN_ALWAYS : CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        spdlog::error("CreateFileW() failed for '{}': {}", path.string(), ErrorMessage());
+        return nullptr;
+    }
+
+    auto diskFile = std::make_unique<DiskFile>();
+    diskFile->mPath = path;
+    diskFile->mFile = reinterpret_cast<intptr_t>(file);
+
+    return diskFile;
+}
+
+auto RenameDurable (const std::filesystem::path& from, const std::filesystem::path& to, bool replace) -> bool
+{
+    const auto flags = MOVEFILE_WRITE_THROUGH | (replace ? MOVEFILE_REPLACE_EXISTING : 0);
+    if (!MoveFileExW(from.c_str(), to.c_str(), flags))
+    {
+        spdlog::error("MoveFileExW() failed for '{}': {}", to.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+auto RemoveFile (const std::filesystem::path& path) -> bool
+{
+    if (!DeleteFileW(path.c_str()))
+    {
+        spdlog::error("DeleteFileW() failed for '{}': {}", path.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+#else
+
+DiskFile::~DiskFile ()
+{
+    if (mFile != -1)
+    {
+        ::close(static_cast<int>(mFile));
+    }
+}
+
+auto DiskFile::Size (uint64_t& size) -> bool
+{
+    struct stat status = {};
+    if (::fstat(static_cast<int>(mFile), &status) != 0)
+    {
+        spdlog::error("fstat() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    size = static_cast<uint64_t>(status.st_size);
+    return true;
+}
+
+auto DiskFile::ReadAt (uint64_t offset, void* data, size_t size) -> bool
+{
+    auto bytes = static_cast<uint8_t*>(data);
+    while (size > 0)
+    {
+        const auto read = ::pread(static_cast<int>(mFile), bytes, size, static_cast<off_t>(offset));
+        if (read < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (read <= 0)
+        {
+            spdlog::error("pread() failed for '{}': {}", mPath.string(), read < 0 ? ErrorMessage() : "end of file");
+            return false;
+        }
+
+        bytes  += read;
+        offset += static_cast<uint64_t>(read);
+        size   -= static_cast<size_t>(read);
+    }
+
+    return true;
+}
+
+auto DiskFile::WriteAt (uint64_t offset, const void* data, size_t size) -> bool
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    while (size > 0)
+    {
+        const auto written = ::pwrite(static_cast<int>(mFile), bytes, size, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (written <= 0)
+        {
+            spdlog::error("pwrite() failed for '{}': {}", mPath.string(), ErrorMessage());
+            return false;
+        }
+
+        bytes  += written;
+        offset += static_cast<uint64_t>(written);
+        size   -= static_cast<size_t>(written);
+    }
+
+    return true;
+}
+
+auto DiskFile::Truncate (uint64_t size) -> bool
+{
+    if (::ftruncate(static_cast<int>(mFile), static_cast<off_t>(size)) != 0)
+    {
+        spdlog::error("ftruncate() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+auto DiskFile::Flush () -> bool
+{
+    if (::fsync(static_cast<int>(mFile)) != 0)
+    {
+        spdlog::error("fsync() failed for '{}': {}", mPath.string(), ErrorMessage());
+        return false;
+    }
+
+    return true;
+}
+
+auto DiskFile::Open (const std::filesystem::path& path, DiskFileMode mode) -> std::unique_ptr<DiskFile>
+{
+    const auto flags = O_RDWR | O_CREAT | O_CLOEXEC | (mode == DiskFileMode::CreateAlways ? O_TRUNC : 0);
+
+    const auto file = ::open(path.c_str(), flags, 0644);
+    if (file < 0)
+    {
+        spdlog::error("open() failed for '{}': {}", path.string(), ErrorMessage());
+        return nullptr;
+    }
+
+    // New file must survive a crash along with what gets written to it.
+    FlushDirectory(path);
+
+    auto diskFile = std::make_unique<DiskFile>();
+    diskFile->mPath = path;
+    diskFile->mFile = file;
+
+    return diskFile;
+}
+
+auto RenameDurable (const std::filesystem::path& from, const std::filesystem::path& to, bool replace) -> bool
+{
+    // link() fails when @to exists, rename() would replace it.
+    const auto r = replace
+        ? ::rename(from.c_str(), to.c_str()) == 0
+        : ::link(from.c_str(), to.c_str()) == 0 && ::unlink(from.c_str()) == 0;
+
+    if (!r)
+    {
+        spdlog::error("Failed to rename '{}' to '{}': {}", from.string(), to.string(), ErrorMessage());
+        return false;
+    }
+
+    FlushDirectory(to);
+    return true;
+}
+
+auto RemoveFile (const std::filesystem::path& path) -> bool
+{
+    if (::unlink(path.c_str()) != 0)
+    {
+        spdlog::error("unlink() failed for '{}': {}", path.string(), ErrorMessage());
+        return false;
+    }
+
+    FlushDirectory(path);
+    return true;
+}
+
+#endif
+
+} // namespace Impulse
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace Impulse {
+
+enum class DiskFileMode : unsigned char
+{
+    OpenAlways,  // read and write, created when missing
+    CreateAlways // read and write, truncated
+};
+
+// File of history segments and exports. Reads and writes go to given
+// offsets and are complete or fail, Flush() returns once data is on disk.
+// Other processes may read the file while it is open, not write it.
+class DiskFile
+{
+    std::filesystem::path mPath;
+    intptr_t              mFile = -1; // HANDLE on Windows, descriptor elsewhere
+
+    DiskFile            (const DiskFile& rhs) = delete;
+    DiskFile& operator= (const DiskFile& rhs) = delete;
+
+public:
+    DiskFile  () = default;
+    ~DiskFile ();
+
+    auto Path () const -> const std::filesystem::path& { return mPath; }
+
+    // Errors are logged with path of the file.
+    auto Size     (uint64_t& size) -> bool;
+    auto ReadAt   (uint64_t offset, void* data, size_t size) -> bool;
+    auto WriteAt  (uint64_t offset, const void* data, size_t size) -> bool;
+    auto Truncate (uint64_t size) -> bool;
+    auto Flush    () -> bool;
+
+    static auto Open (const std::filesystem::path& path, DiskFileMode mode) -> std::unique_ptr<DiskFile>;
+};
+
+// Rename @from to @to and make it durable. @to is replaced when
+// @replace is set, otherwise rename fails when it exists.
+auto RenameDurable (const std::filesystem::path& from, const std::filesystem::path& to, bool replace) -> bool;
+
+// Delete @path, false with error in log when it couldn't be.
+auto RemoveFile (const std::filesystem::path& path) -> bool;
+
+} // namespace Impulse
@@ -0,0 +1,71 @@
+#include "PCH.hpp"
+#include "DisplayInfo.hpp"
+
+#include <shellapi.h>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+auto ToDisplayRect (const RECT& rect) -> Impulse::DisplayRect
+{
+    return Impulse::DisplayRect{ rect.left, rect.top, rect.right, rect.bottom };
+}
+
+auto ToTaskbarEdge (UINT edge) -> Impulse::TaskbarEdge
+{
+    switch (edge)
+    {
+    case ABE_LEFT:   return Impulse::TaskbarEdge::Left;
+    case ABE_TOP:    return Impulse::TaskbarEdge::Top;
+    case ABE_RIGHT:  return Impulse::TaskbarEdge::Right;
+    case ABE_BOTTOM: return Impulse::TaskbarEdge::Bottom;
+    default:         return Impulse::TaskbarEdge::None;
+    }
+}
+
+}
+
+namespace Impulse {
+
+auto Win32DisplayInfo::Geometry () -> const DisplayGeometry&
+{
+    if (!mDirty)
+    {
+        return mGeometry;
+    }
+
+    mDirty    = false;
+    mQueries += 1;
+    mGeometry = DisplayGeometry();
+
+    // Get primary monitor.
+    auto monitor = MonitorFromPoint(POINT{0, 0}, MONITOR_DEFAULTTOPRIMARY);
+    auto info    = MONITORINFO{ 0 };
+    info.cbSize  = sizeof(MONITORINFO);
+
+    if (!GetMonitorInfoW(monitor, &info))
+    {
+        spdlog::error("GetMonitorInfoW() failed");
+        return mGeometry;
+    }
+
+    mGeometry.valid   = true;
+    mGeometry.monitor = ToDisplayRect(info.rcMonitor);
+
+    auto abd   = APPBARDATA{0};
+    abd.cbSize = sizeof(APPBARDATA);
+    if (SHAppBarMessage(ABM_GETTASKBARPOS, &abd))
+    {
+        mGeometry.taskbarEdge = ToTaskbarEdge(abd.uEdge);
+        mGeometry.taskbar     = ToDisplayRect(abd.rc);
+    }
+    else
+    {
+        spdlog::warn("SHAppBarMessage() failed, ignoring taskbar when positioning window");
+    }
+
+    return mGeometry;
+}
+
+} // namespace Impulse
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Impulse {
+
+enum class TaskbarEdge : unsigned char
+{
+    None, // no taskbar or its position is unknown
+    Left,
+    Top,
+    Right,
+    Bottom
+};
+
+// Rectangle in physical pixels.
+struct DisplayRect
+{
+    long left   = 0;
+    long top    = 0;
+    long right  = 0;
+    long bottom = 0;
+
+    auto Width  () const { return right - left; }
+    auto Height () const { return bottom - top; }
+};
+
+struct DisplayGeometry
+{
+    bool        valid       = false; // monitor geometry is known
+    DisplayRect monitor     = DisplayRect();
+    TaskbarEdge taskbarEdge = TaskbarEdge::None;
+    DisplayRect taskbar     = DisplayRect();
+};
+
+// Source of primary monitor and taskbar geometry. Querying the system is
+// slow, implementations cache the result until Invalidate().
+class DisplayInfo
+{
+public:
+    virtual ~DisplayInfo () = default;
+
+    virtual auto Geometry () -> const DisplayGeometry& = 0;
+
+    // Display or taskbar changed, next Geometry() queries again.
+    virtual auto Invalidate () -> void = 0;
+};
+
+// Asks Win32 (monitor info, shell appbar), see DisplayInfo.cpp.
+class Win32DisplayInfo : public DisplayInfo
+{
+    DisplayGeometry mGeometry;
+    bool            mDirty   = true;
+    uint64_t        mQueries = 0;
+
+public:
+    virtual auto Geometry   () -> const DisplayGeometry& override;
+    virtual auto Invalidate () -> void override { mDirty = true; }
+
+    auto Queries () const { return mQueries; }
+};
+
+// Returns whatever geometry it was given, for running placement code
+// without a display.
+class FakeDisplayInfo : public DisplayInfo
+{
+    DisplayGeometry mGeometry;
+    uint64_t        mInvalidations = 0;
+
+public:
+    FakeDisplayInfo () = default;
+    explicit FakeDisplayInfo (const DisplayGeometry& geometry)
+        : mGeometry (geometry)
+    {
+    }
+
+    auto Set (const DisplayGeometry& geometry) { mGeometry = geometry; }
+
+    virtual auto Geometry   () -> const DisplayGeometry& override { return mGeometry; }
+    virtual auto Invalidate () -> void override { mInvalidations += 1; }
+
+    auto Invalidations () const { return mInvalidations; }
+};
+
+} // namespace Impulse
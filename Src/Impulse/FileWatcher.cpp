@@ -0,0 +1,290 @@
+#include "FileWatcher.hpp"
+
+#include <string_view>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+#include "Utility.hpp"
+#elif defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse {
+
+auto FileWatcher::Create (const std::filesystem::path& path) -> std::unique_ptr<FileWatcher>
+{
+#if defined(_WIN32)
+    return Win32FileWatcher::Create(path);
+#elif defined(__linux__)
+    return InotifyFileWatcher::Create(path);
+#else
+    spdlog::error("Can't watch '{}', no file watcher on this platform", path.string());
+    return nullptr;
+#endif
+}
+
+#if defined(_WIN32)
+
+Win32FileWatcher::~Win32FileWatcher ()
+{
+    if (mThread.joinable())
+    {
+        SetEvent(mStop);
+        mThread.join();
+    }
+
+    if (mStop)
+    {
+        CloseHandle(mStop);
+    }
+
+    if (mDirectory)
+    {
+        CloseHandle(mDirectory);
+    }
+}
+
+auto Win32FileWatcher::Worker () -> void
+{
+    // Notifications are DWORD aligned records.
+    alignas(DWORD) uint8_t buffer[16 * 1024];
+
+    auto changed = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!changed)
+    {
+        spdlog::error("CreateEventW() failed: {}", GetLastErrorMessage());
+        return;
+    }
+
+    while (true)
+    {
+        auto overlapped   = OVERLAPPED{};
+        overlapped.hEvent = changed;
+
+        const auto filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+        if (!ReadDirectoryChangesW(mDirectory, buffer, sizeof(buffer), FALSE, filter, nullptr, &overlapped, nullptr))
+        {
+            spdlog::error("ReadDirectoryChangesW() failed: {}", GetLastErrorMessage());
+            break;
+        }
+
+        const HANDLE handles[] = { changed, mStop };
+        if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+        {
+            // Buffer must stay alive until cancelled read completes.
+            auto ignored = DWORD(0);
+            CancelIo(mDirectory);
+            GetOverlappedResult(mDirectory, &overlapped, &ignored, TRUE);
+            break;
+        }
+
+        auto bytes = DWORD(0);
+        if (!GetOverlappedResult(mDirectory, &overlapped, &bytes, FALSE))
+        {
+            spdlog::error("GetOverlappedResult() failed: {}", GetLastErrorMessage());
+            break;
+        }
+
+        // Nothing returned means buffer overflowed and changes were lost,
+        // our file may be among them.
+        auto match = bytes == 0;
+
+        for (auto offset = DWORD(0); !match && offset < bytes;)
+        {
+            const auto info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+            const auto name = std::wstring_view(info->FileName, info->FileNameLength / sizeof(WCHAR));
+
+            match = CompareStringOrdinal(name.data(), static_cast<int>(name.size()), mName.data(), static_cast<int>(mName.size()), TRUE) == CSTR_EQUAL;
+
+            if (info->NextEntryOffset == 0)
+            {
+                break;
+            }
+
+            offset += info->NextEntryOffset;
+        }
+
+        if (match)
+        {
+            OnChange();
+        }
+    }
+
+    CloseHandle(changed);
+}
+
+auto Win32FileWatcher::Start () -> void
+{
+    mThread = std::thread(&Win32FileWatcher::Worker, this);
+}
+
+auto Win32FileWatcher::Create (const std::filesystem::path& path) -> std::unique_ptr<Win32FileWatcher>
+{
+    auto watcher = std::make_unique<Win32FileWatcher>();
+
+    const auto directory = path.parent_path();
+
+    // Watching directory, file itself is replaced on every save.
+    const auto handle = CreateFileW(
+        directory.c_str(),
+        FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        nullptr
+    );
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        spdlog::error("CreateFileW() failed for '{}': {}", directory.string(), GetLastErrorMessage());
+        return nullptr;
+    }
+
+    watcher->mName      = path.filename().wstring();
+    watcher->mDirectory = handle;
+
+    watcher->mStop = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!watcher->mStop)
+    {
+        spdlog::error("CreateEventW() failed: {}", GetLastErrorMessage());
+        return nullptr;
+    }
+
+    return watcher;
+}
+
+#elif defined(__linux__)
+
+InotifyFileWatcher::~InotifyFileWatcher ()
+{
+    if (mThread.joinable())
+    {
+        const auto one = uint64_t(1);
+        [[maybe_unused]] const auto r = ::write(mStop, &one, sizeof(one));
+        mThread.join();
+    }
+
+    if (mStop != -1)
+    {
+        ::close(mStop);
+    }
+
+    if (mInotify != -1)
+    {
+        ::close(mInotify);
+    }
+}
+
+auto InotifyFileWatcher::Worker () -> void
+{
+    // Room for a good number of events with longest names.
+    alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+
+    while (true)
+    {
+        pollfd fds[] = { { mInotify, POLLIN, 0 }, { mStop, POLLIN, 0 } };
+        if (::poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            spdlog::error("poll() failed: {}", std::strerror(errno));
+            break;
+        }
+
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+
+        const auto bytes = ::read(mInotify, buffer, sizeof(buffer));
+        if (bytes < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+
+            spdlog::error("read() failed for inotify: {}", std::strerror(errno));
+            break;
+        }
+
+        auto match = false;
+
+        for (auto offset = ssize_t(0); !match && offset < bytes;)
+        {
+            const auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+
+            // Queue overflowed and changes were lost, our file may be
+            // among them.
+            match = (event->mask & IN_Q_OVERFLOW) != 0
+                || (event->len > 0 && mName == event->name);
+
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+
+        if (match)
+        {
+            OnChange();
+        }
+    }
+}
+
+auto InotifyFileWatcher::Start () -> void
+{
+    mThread = std::thread(&InotifyFileWatcher::Worker, this);
+}
+
+auto InotifyFileWatcher::Create (const std::filesystem::path& path) -> std::unique_ptr<InotifyFileWatcher>
+{
+    auto watcher = std::make_unique<InotifyFileWatcher>();
+
+    auto directory = path.parent_path();
+    if (directory.empty())
+    {
+        directory = ".";
+    }
+
+    watcher->mName    = path.filename().string();
+    watcher->mInotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher->mInotify < 0)
+    {
+        spdlog::error("inotify_init1() failed: {}", std::strerror(errno));
+        return nullptr;
+    }
+
+    // Watching directory, file itself is replaced on every save.
+    const auto mask = IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM;
+    if (::inotify_add_watch(watcher->mInotify, directory.c_str(), mask) < 0)
+    {
+        spdlog::error("inotify_add_watch() failed for '{}': {}", directory.string(), std::strerror(errno));
+        return nullptr;
+    }
+
+    watcher->mStop = ::eventfd(0, EFD_CLOEXEC);
+    if (watcher->mStop < 0)
+    {
+        spdlog::error("eventfd() failed: {}", std::strerror(errno));
+        return nullptr;
+    }
+
+    return watcher;
+}
+
+#endif
+
+} // namespace Impulse
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace Impulse {
+
+// Reports changes of one file, including it being replaced by rename like
+// WriteFileAtomic() does. Saving usually takes several file system
+// operations, OnChange may fire more than once per save.
+class FileWatcher
+{
+public:
+    // Called on watcher thread.
+    std::function<void ()> OnChange = []{};
+
+public:
+    virtual ~FileWatcher () = default;
+
+    // Set OnChange before calling Start().
+    virtual auto Start () -> void = 0;
+
+    // Watcher for this platform, nullptr with error in log when directory
+    // of @path can't be watched.
+    static auto Create (const std::filesystem::path& path) -> std::unique_ptr<FileWatcher>;
+};
+
+#if defined(_WIN32)
+
+// Watches directory of the file with ReadDirectoryChangesW, see
+// FileWatcher.cpp.
+class Win32FileWatcher : public FileWatcher
+{
+    std::wstring mName;                // file name within directory
+    void*        mDirectory = nullptr; // HANDLE
+    void*        mStop      = nullptr; // event, set by destructor
+    std::thread  mThread;
+
+    auto Worker () -> void;
+
+    Win32FileWatcher            (const Win32FileWatcher& rhs) = delete;
+    Win32FileWatcher& operator= (const Win32FileWatcher& rhs) = delete;
+
+public:
+    Win32FileWatcher  () = default;
+    ~Win32FileWatcher ();
+
+    auto Start () -> void override;
+
+    static auto Create (const std::filesystem::path& path) -> std::unique_ptr<Win32FileWatcher>;
+};
+
+#elif defined(__linux__)
+
+// Watches directory of the file with inotify, see FileWatcher.cpp.
+class InotifyFileWatcher : public FileWatcher
+{
+    std::string mName;          // file name within directory
+    int         mInotify = -1;
+    int         mStop    = -1;  // eventfd, signalled by destructor
+    std::thread mThread;
+
+    auto Worker () -> void;
+
+    InotifyFileWatcher            (const InotifyFileWatcher& rhs) = delete;
+    InotifyFileWatcher& operator= (const InotifyFileWatcher& rhs) = delete;
+
+public:
+    InotifyFileWatcher  () = default;
+    ~InotifyFileWatcher ();
+
+    auto Start () -> void override;
+
+    static auto Create (const std::filesystem::path& path) -> std::unique_ptr<InotifyFileWatcher>;
+};
+
+#endif
+
+} // namespace Impulse
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Impulse {
+
+// Longest prefix of @text of at most @count code units that doesn't end in
+// the middle of a code point: UTF-8 for char, UTF-16 for 2 byte units.
+template <typename CharT>
+auto CodePointPrefix (std::basic_string_view<CharT> text, size_t count) -> size_t
+{
+    if (count >= text.size())
+    {
+        return text.size();
+    }
+
+    if constexpr (sizeof(CharT) == 1)
+    {
+        // Cut before continuation bytes of code point that didn't fit.
+        while (count > 0 && (static_cast<uint8_t>(text[count]) & 0xC0) == 0x80)
+        {
+            count -= 1;
+        }
+    }
+    else if constexpr (sizeof(CharT) == 2)
+    {
+        // Don't keep high surrogate without its pair.
+        const auto last = count > 0 ? static_cast<uint16_t>(text[count - 1]) : 0;
+        if (last >= 0xD800 && last <= 0xDBFF)
+        {
+            count -= 1;
+        }
+    }
+
+    return count;
+}
+
+// String with inline storage of fixed capacity, never allocates. Text that
+// doesn't fit is truncated at a code point boundary.
+template <typename CharT, size_t Capacity>
+class BasicFixedString
+{
+    std::array<CharT, Capacity + 1> mData   = {};
+    size_t                          mLength = 0;
+
+public:
+    using View = std::basic_string_view<CharT>;
+
+    BasicFixedString () = default;
+    BasicFixedString (View text) { Assign(text); }
+
+    auto Assign (View text) -> BasicFixedString&
+    {
+        mLength = CodePointPrefix(text, Capacity);
+        std::copy_n(text.data(), mLength, mData.data());
+        mData[mLength] = CharT(0);
+
+        return *this;
+    }
+
+    auto Append (View text) -> BasicFixedString&
+    {
+        const auto count = CodePointPrefix(text, Capacity - mLength);
+        std::copy_n(text.data(), count, mData.data() + mLength);
+        mLength += count;
+        mData[mLength] = CharT(0);
+
+        return *this;
+    }
+
+    auto Append (CharT c) -> BasicFixedString&
+    {
+        if (mLength < Capacity)
+        {
+            mData[mLength++] = c;
+            mData[mLength]   = CharT(0);
+        }
+
+        return *this;
+    }
+
+    // Append decimal number, left padded with zeros to @minDigits.
+    auto AppendNumber (uint64_t number, size_t minDigits = 1) -> BasicFixedString&
+    {
+        auto digits = std::array<CharT, 20>();
+        auto count  = size_t{0};
+
+        do
+        {
+            digits[count++] = static_cast<CharT>('0' + number % 10);
+            number /= 10;
+        }
+        while (number != 0);
+
+        for (auto i = count; i < minDigits; ++i)
+        {
+            Append(static_cast<CharT>('0'));
+        }
+
+        while (count > 0)
+        {
+            Append(digits[--count]);
+        }
+
+        return *this;
+    }
+
+    auto Clear () -> void
+    {
+        mLength  = 0;
+        mData[0] = CharT(0);
+    }
+
+    auto c_str    () const { return mData.data(); }
+    auto data     () const { return mData.data(); }
+    auto length   () const { return mLength; }
+    auto size     () const { return mLength; }
+    auto empty    () const { return mLength == 0; }
+    auto capacity () const { return Capacity; }
+    auto view     () const { return View(mData.data(), mLength); }
+
+    operator View () const { return view(); }
+
+    auto operator== (View text) const { return view() == text; }
+    auto operator!= (View text) const { return view() != text; }
+};
+
+// Append @duration as [-]MM:SS, minutes go past 59 rather than wrap.
+template <typename CharT, size_t Capacity>
+auto AppendMinutesSeconds (BasicFixedString<CharT, Capacity>& text, std::chrono::seconds duration) -> void
+{
+    if (duration < std::chrono::seconds(0))
+    {
+        text.Append(static_cast<CharT>('-'));
+        duration = -duration;
+    }
+
+    text.AppendNumber(static_cast<uint64_t>(duration.count() / 60), 2);
+    text.Append(static_cast<CharT>(':'));
+    text.AppendNumber(static_cast<uint64_t>(duration.count() % 60), 2);
+}
+
+// String kept inline up to Capacity, longer text moves to heap. Heap buffer
+// is kept when text gets short again, so text changing back and forth
+// allocates only while it grows.
+template <typename CharT, size_t Capacity>
+class BasicSmallString
+{
+    BasicFixedString<CharT, Capacity> mInline;
+    std::basic_string<CharT>          mHeap;
+    bool                              mOnHeap = false;
+
+public:
+    using View = std::basic_string_view<CharT>;
+
+    BasicSmallString () = default;
+    BasicSmallString (View text) { Assign(text); }
+
+    auto Assign (View text) -> BasicSmallString&
+    {
+        mOnHeap = text.size() > Capacity;
+        if (mOnHeap)
+        {
+            mHeap.assign(text.data(), text.size());
+        }
+        else
+        {
+            mInline.Assign(text);
+        }
+
+        return *this;
+    }
+
+    auto c_str  () const { return mOnHeap ? mHeap.c_str() : mInline.c_str(); }
+    auto data   () const { return c_str(); }
+    auto length () const { return mOnHeap ? mHeap.size() : mInline.size(); }
+    auto size   () const { return length(); }
+    auto empty  () const { return length() == 0; }
+    auto view   () const { return View(c_str(), length()); }
+    auto OnHeap () const { return mOnHeap; }
+
+    operator View () const { return view(); }
+
+    auto operator== (View text) const { return view() == text; }
+    auto operator!= (View text) const { return view() != text; }
+};
+
+template <size_t Capacity>
+using FixedString  = BasicFixedString<char, Capacity>;
+
+template <size_t Capacity>
+using FixedWString = BasicFixedString<wchar_t, Capacity>;
+
+template <size_t Capacity>
+using SmallWString = BasicSmallString<wchar_t, Capacity>;
+
+} // namespace Impulse
@@ -0,0 +1,307 @@
+#include "HistoryCompactor.hpp"
+#include "DiskFile.hpp"
+#include "HistoryRecord.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse {
+
+HistoryCompactor::~HistoryCompactor ()
+{
+    if (mThread.joinable())
+    {
+        {
+            auto guard = std::lock_guard<std::mutex>(mMutex);
+            mDone = true;
+        }
+
+        mWake.notify_one();
+        mThread.join();
+    }
+}
+
+auto HistoryCompactor::Cleanup () -> std::vector<HistorySegment>
+{
+    auto segments = std::vector<HistorySegment>();
+
+    auto error = std::error_code();
+    for (const auto& entry : std::filesystem::directory_iterator(mDirectory, error))
+    {
+        const auto& path = entry.path();
+
+        // Archive that never got published, rewritten from scratch below.
+        if (path.extension() == L".tmp" && path.filename().wstring().rfind(L"Archive-", 0) == 0)
+        {
+            spdlog::info("Removing unfinished history archive '{}'", path.string());
+            RemoveFile(path);
+            continue;
+        }
+
+        if (auto segment = ParseHistorySegment(path))
+        {
+            segments.push_back(std::move(*segment));
+        }
+    }
+
+    // Journals whose archive was published before a crash let us delete them.
+    auto covered  = std::vector<HistorySegment>();
+    auto resolved = ResolveHistorySegments(std::move(segments), &covered);
+
+    for (const auto& segment : covered)
+    {
+        spdlog::info("Removing archived history journal '{}'", segment.path.string());
+        RemoveFile(segment.path);
+    }
+
+    return resolved;
+}
+
+auto HistoryCompactor::WriteArchive (
+    const std::vector<HistorySegment>& sources,
+    uint32_t                           first,
+    const std::filesystem::path&       path
+) -> bool
+{
+    auto file = DiskFile::Open(path, DiskFileMode::CreateAlways);
+    if (!file)
+    {
+        return false;
+    }
+
+    auto size    = uint64_t(0);
+    auto chunk   = std::vector<HistoryRecord>();
+    auto dropped = uint64_t(0);
+    auto created = int64_t(0);
+    auto r       = true;
+
+    chunk.reserve(4096);
+
+    // Stopped by fault hook means "crashed": .tmp stays for next round.
+    auto stopped = false;
+    const auto flush = [&]
+    {
+        if (!mOnStep(CompactionStep::WriteArchive))
+        {
+            stopped = true;
+            return false;
+        }
+
+        const auto bytes = chunk.size() * sizeof(HistoryRecord);
+        if (!file->WriteAt(size, chunk.data(), bytes))
+        {
+            return false;
+        }
+
+        size += bytes;
+        chunk.clear();
+        return true;
+    };
+
+    for (auto i = size_t(0); r && i < sources.size(); ++i)
+    {
+        const auto source = MappedFile::Open(sources[i].path);
+
+        auto header = HistoryHeader();
+        if (!source || source->Size() < sizeof(header))
+        {
+            spdlog::error("Can't read history journal '{}'", sources[i].path.string());
+            r = false;
+            break;
+        }
+
+        std::memcpy(&header, source->Data(), sizeof(header));
+        if (!IsValid(header))
+        {
+            // Journal is left alone rather than thrown away with its records.
+            spdlog::error("History journal '{}' has invalid header", sources[i].path.string());
+            r = false;
+            break;
+        }
+
+        // Header of archive carries creation time of its oldest journal.
+        if (i == 0)
+        {
+            created = header.created;
+
+            const auto archive = MakeHistoryHeader(created, first);
+            r = file->WriteAt(0, &archive, sizeof(archive));
+            size = sizeof(archive);
+        }
+
+        const auto records = reinterpret_cast<const HistoryRecord*>(source->Data() + sizeof(header));
+        const auto count   = static_cast<size_t>((source->Size() - sizeof(header)) / sizeof(HistoryRecord));
+
+        for (auto j = size_t(0); r && j < count; ++j)
+        {
+            // Copy, mapping gives no alignment guarantee past the header.
+            auto record = HistoryRecord();
+            std::memcpy(&record, records + j, sizeof(record));
+
+            if (!IsValid(record))
+            {
+                dropped += 1;
+                continue;
+            }
+
+            chunk.push_back(record);
+            if (chunk.size() == chunk.capacity())
+            {
+                r = flush();
+            }
+        }
+    }
+
+    r = r && flush();
+
+    r = r && file->Flush();
+
+    file.reset();
+
+    if (!r)
+    {
+        if (!stopped)
+        {
+            RemoveFile(path);
+        }
+
+        return false;
+    }
+
+    if (dropped > 0)
+    {
+        spdlog::warn("Left {} damaged history records out of '{}'", dropped, path.string());
+    }
+
+    auto guard = std::lock_guard<std::mutex>(mMutex);
+    mDropped += dropped;
+
+    return true;
+}
+
+auto HistoryCompactor::Compact () -> bool
+{
+    auto round = std::lock_guard<std::mutex>(mRound);
+
+    const auto segments = Cleanup();
+
+    // Journals after last archive, newest one is still being appended.
+    auto sources = std::vector<HistorySegment>();
+    for (const auto& segment : segments)
+    {
+        if (segment.kind == HistorySegmentKind::Archive)
+        {
+            sources.clear();
+            continue;
+        }
+
+        sources.push_back(segment);
+    }
+
+    if (sources.size() < mMinSegments + 1)
+    {
+        return true;
+    }
+
+    const auto next = sources.back().first;
+    sources.pop_back();
+
+    // Archive covers everything up to the active journal, records lost in
+    // torn or damaged tails included, so names stay contiguous.
+    const auto first   = sources.front().first;
+    const auto last    = next - 1;
+    const auto archive = mDirectory / ArchiveSegmentName(first, last);
+
+    auto temp = archive;
+    temp.replace_extension(L".tmp");
+
+    spdlog::debug("Compacting {} history journals into '{}'", sources.size(), archive.string());
+
+    if (!WriteArchive(sources, first, temp) || !mOnStep(CompactionStep::PublishArchive))
+    {
+        return false;
+    }
+
+    if (!RenameDurable(temp, archive, false))
+    {
+        RemoveFile(temp);
+        return false;
+    }
+
+    for (const auto& source : sources)
+    {
+        if (!mOnStep(CompactionStep::RemoveSource))
+        {
+            return false;
+        }
+
+        // Not fatal, archive already hides it and next round retries.
+        RemoveFile(source.path);
+    }
+
+    auto guard = std::lock_guard<std::mutex>(mMutex);
+    mRounds += 1;
+    mMerged += sources.size();
+
+    return true;
+}
+
+auto HistoryCompactor::Worker () -> void
+{
+#if defined(_WIN32)
+    // Lowers I/O priority too, merging must not slow down journal flushes.
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+
+    auto lock = std::unique_lock<std::mutex>(mMutex);
+
+    while (true)
+    {
+        mWake.wait(lock, [&] { return mRequested || mDone; });
+        if (mDone)
+        {
+            return;
+        }
+
+        mRequested = false;
+
+        lock.unlock();
+        Compact();
+        lock.lock();
+    }
+}
+
+auto HistoryCompactor::Request () -> void
+{
+    {
+        auto guard = std::lock_guard<std::mutex>(mMutex);
+        mRequested = true;
+    }
+
+    mWake.notify_one();
+}
+
+auto HistoryCompactor::Open (const HistoryCompactor::Desc& desc) -> std::unique_ptr<HistoryCompactor>
+{
+    auto compactor = std::make_unique<HistoryCompactor>();
+
+    compactor->mDirectory   = desc.directory;
+    compactor->mMinSegments = std::max<size_t>(desc.minSegments, 1);
+    compactor->mOnStep      = desc.onStep;
+    compactor->mRequested   = true;
+
+    compactor->mThread = std::thread(&HistoryCompactor::Worker, compactor.get());
+
+    return compactor;
+}
+
+} // namespace Impulse
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "HistorySegments.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Impulse {
+
+enum class CompactionStep : unsigned char
+{
+    WriteArchive,   // before each chunk of records goes to Archive-*.tmp
+    PublishArchive, // before .tmp is renamed to .hist
+    RemoveSource    // before each merged journal is deleted
+};
+
+// Merges sealed journal segments into one archive segment on a background
+// thread. Every step leaves the directory in a state ListHistorySegments()
+// reads correctly:
+//
+//     1. write Archive-<first>-<last>.tmp and flush it, .tmp is ignored
+//     2. rename it to .hist, archive now hides the journals it covers
+//     3. delete the journals
+//
+// Next round deletes whatever a crash left behind, .tmp files and covered
+// journals. Active journal is never touched, appends don't wait for us.
+// Readers keep mapped segments even after they are deleted.
+class HistoryCompactor
+{
+public:
+    struct Desc
+    {
+        std::filesystem::path directory;
+
+        // Sealed journals needed before they are merged.
+        size_t                minSegments = 8;
+
+        // Called before every step, returning false stops the round as if
+        // process died there. For fault injection.
+        std::function<bool (CompactionStep step)> onStep = [](CompactionStep){ return true; };
+    };
+
+private:
+    std::filesystem::path                     mDirectory;
+    size_t                                    mMinSegments = 8;
+    std::function<bool (CompactionStep step)> mOnStep;
+
+    std::thread             mThread;
+    std::mutex              mRound; // one round at a time
+    std::mutex              mMutex;
+    std::condition_variable mWake;
+    bool                    mRequested = false;
+    bool                    mDone      = false;
+    uint64_t                mRounds    = 0;
+    uint64_t                mMerged    = 0; // journals merged into archives
+    uint64_t                mDropped   = 0; // damaged records left out
+
+    auto Cleanup      () -> std::vector<HistorySegment>;
+    auto WriteArchive (const std::vector<HistorySegment>& sources, uint32_t first, const std::filesystem::path& path) -> bool;
+    auto Worker       () -> void;
+
+    HistoryCompactor            (const HistoryCompactor& rhs) = delete;
+    HistoryCompactor& operator= (const HistoryCompactor& rhs) = delete;
+
+public:
+    HistoryCompactor  () = default;
+    ~HistoryCompactor ();
+
+    // Wake worker for a round, e.g. after journal was rotated.
+    auto Request () -> void;
+
+    // One round on caller's thread. False when a step failed or was
+    // stopped by Desc::onStep.
+    auto Compact () -> bool;
+
+    auto Rounds  () { auto guard = std::lock_guard<std::mutex>(mMutex); return mRounds;  }
+    auto Merged  () { auto guard = std::lock_guard<std::mutex>(mMutex); return mMerged;  }
+    auto Dropped () { auto guard = std::lock_guard<std::mutex>(mMutex); return mDropped; }
+
+    // Starts worker, which runs first round right away to clean up after
+    // a crash.
+    static auto Open (const Desc& desc) -> std::unique_ptr<HistoryCompactor>;
+};
+
+} // namespace Impulse
@@ -0,0 +1,367 @@
+#include "HistoryExporter.hpp"
+#include "DiskFile.hpp"
+#include "HistoryReader.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+using Impulse::HistoryEvent;
+using Impulse::ImpulseState;
+
+// Buffer is written out once it holds this much, one record never takes
+// more than a few hundred bytes past it.
+constexpr auto BUFFER_SIZE   = size_t(1) << 20;
+constexpr auto PROGRESS_STEP = uint64_t(1) << 16;
+
+constexpr auto MS_PER_DAY = int64_t(24) * 60 * 60 * 1000;
+
+auto FloorDiv (int64_t a, int64_t b) -> int64_t
+{
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+auto EventName (HistoryEvent event) -> std::string_view
+{
+    switch (event)
+    {
+    case HistoryEvent::Start:  return "Start";
+    case HistoryEvent::End:    return "End";
+    case HistoryEvent::Pause:  return "Pause";
+    case HistoryEvent::Resume: return "Resume";
+    case HistoryEvent::Stop:   return "Stop";
+    default:                   return "Unknown";
+    }
+}
+
+auto StateName (ImpulseState state) -> std::string_view
+{
+    switch (state)
+    {
+    case ImpulseState::Inactive:   return "Inactive";
+    case ImpulseState::WorkShift:  return "WorkShift";
+    case ImpulseState::ShortBreak: return "ShortBreak";
+    case ImpulseState::LongBreak:  return "LongBreak";
+    case ImpulseState::Paused:     return "Paused";
+    default:                       return "Unknown";
+    }
+}
+
+template <typename T>
+auto AppendNumber (T value, std::string& out) -> void
+{
+    char text[24];
+    const auto end = std::to_chars(text, text + sizeof(text), value).ptr;
+    out.append(text, end);
+}
+
+// YYYY-MM-DDTHH:MM:SS.mmmZ, civil calendar arithmetic from Howard
+// Hinnant's date algorithms.
+auto AppendTime (int64_t time, std::string& out) -> void
+{
+    const auto day = FloorDiv(time, MS_PER_DAY);
+    const auto ms  = time - day * MS_PER_DAY;
+
+    const auto days = day + 719468;
+    const auto era  = FloorDiv(days, 146097);
+    const auto doe  = days - era * 146097;
+    const auto yoe  = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const auto doy  = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const auto mp   = (5 * doy + 2) / 153;
+    const auto d    = doy - (153 * mp + 2) / 5 + 1;
+    const auto m    = mp < 10 ? mp + 3 : mp - 9;
+    const auto y    = yoe + era * 400 + (m <= 2 ? 1 : 0);
+
+    char text[] = "0000-00-00T00:00:00.000Z";
+
+    const auto put = [&](size_t at, size_t width, int64_t value)
+    {
+        for (auto i = width; i > 0; --i, value /= 10)
+        {
+            text[at + i - 1] = static_cast<char>('0' + value % 10);
+        }
+    };
+
+    put(0,  4, std::clamp<int64_t>(y, 0, 9999));
+    put(5,  2, m);
+    put(8,  2, d);
+    put(11, 2, ms / 3600000);
+    put(14, 2, ms / 60000 % 60);
+    put(17, 2, ms / 1000 % 60);
+    put(20, 3, ms % 1000);
+
+    out.append(text, sizeof(text) - 1);
+}
+
+auto AppendCsvText (std::string_view text, std::string& out) -> void
+{
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos)
+    {
+        out += text;
+        return;
+    }
+
+    out += '"';
+    for (const auto c : text)
+    {
+        out += c;
+        if (c == '"')
+        {
+            out += '"';
+        }
+    }
+    out += '"';
+}
+
+auto AppendJsonText (std::string_view text, std::string& out) -> void
+{
+    out += '"';
+    for (const auto c : text)
+    {
+        const auto u = static_cast<unsigned char>(c);
+
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (u < 0x20)
+        {
+            constexpr auto HEX = "0123456789abcdef";
+
+            out += "\\u00";
+            out += HEX[u >> 4];
+            out += HEX[u & 15];
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+}
+
+namespace Impulse {
+
+auto FormatHistoryRecord (
+    const HistoryRecord& record,
+    ExportFormat         format,
+    std::string_view     taskName,
+    std::string&         out
+) -> void
+{
+    if (format == ExportFormat::Csv)
+    {
+        AppendNumber(record.sequence, out);
+        out += ',';
+        AppendTime(record.time, out);
+        out += ',';
+        out += EventName(record.event);
+        out += ',';
+        out += StateName(record.from);
+        out += ',';
+        out += StateName(record.to);
+        out += ',';
+        AppendNumber(record.task, out);
+        out += ',';
+        AppendCsvText(taskName, out);
+        out += ',';
+        AppendNumber(record.duration, out);
+        out += ',';
+        AppendNumber(record.workShift, out);
+        out += "\r\n";
+        return;
+    }
+
+    out += "{\"sequence\":";
+    AppendNumber(record.sequence, out);
+    out += ",\"time\":\"";
+    AppendTime(record.time, out);
+    out += "\",\"event\":\"";
+    out += EventName(record.event);
+    out += "\",\"from\":\"";
+    out += StateName(record.from);
+    out += "\",\"to\":\"";
+    out += StateName(record.to);
+    out += "\",\"task\":";
+    AppendNumber(record.task, out);
+    out += ",\"taskName\":";
+    AppendJsonText(taskName, out);
+    out += ",\"duration\":";
+    AppendNumber(record.duration, out);
+    out += ",\"workShift\":";
+    AppendNumber(record.workShift, out);
+    out += "}\n";
+}
+
+auto HistoryExportHeader (ExportFormat format) -> std::string_view
+{
+    return format == ExportFormat::Csv
+        ? "sequence,time,event,from,to,task,taskName,duration,workShift\r\n"
+        : "";
+}
+
+HistoryExporter::~HistoryExporter ()
+{
+    if (mThread.joinable())
+    {
+        mCancel = true;
+        mThread.join();
+    }
+}
+
+auto HistoryExporter::Run (Desc desc) -> bool
+{
+    // Journal writer may still hold records appended before export started.
+    if (!desc.commit(desc.sequence))
+    {
+        spdlog::warn("Exporting history without records that are not on disk yet");
+    }
+
+    // Snapshot of history, compaction may go on meanwhile.
+    const auto reader = HistoryReader::OpenDirectory(desc.directory);
+
+    const auto& query = desc.query;
+    mTotal = reader->Count(query.from, query.to);
+
+    auto temp = desc.path;
+    temp += L".tmp";
+
+    auto file = DiskFile::Open(temp, DiskFileMode::CreateAlways);
+    if (!file)
+    {
+        return false;
+    }
+
+    auto buffer = std::string();
+    buffer.reserve(BUFFER_SIZE + 4096);
+    buffer += HistoryExportHeader(desc.format);
+
+    auto r    = true;
+    auto size = uint64_t(0);
+    auto done = uint64_t(0);
+    auto next = PROGRESS_STEP;
+
+    const auto flush = [&]
+    {
+        if (mCancel)
+        {
+            return false;
+        }
+
+        if (!file->WriteAt(size, buffer.data(), buffer.size()))
+        {
+            return false;
+        }
+
+        size += buffer.size();
+        buffer.clear();
+        return true;
+    };
+
+    reader->Range(query.from, query.to, [&](HistorySpan span)
+    {
+        for (auto record = span.first; r && record != span.last; ++record)
+        {
+            if (query.allTasks || record->task == query.task)
+            {
+                const auto name = desc.taskNames.find(record->task);
+                FormatHistoryRecord(*record, desc.format, name != desc.taskNames.end() ? name->second : "", buffer);
+            }
+
+            if (buffer.size() >= BUFFER_SIZE)
+            {
+                r = flush();
+            }
+
+            // Records skipped by task filter count as well, total is known
+            // from index without reading them.
+            done += 1;
+            if (done == next)
+            {
+                next += PROGRESS_STEP;
+
+                const auto from = std::max(span.first, record + 1 - PROGRESS_STEP);
+                // Exported records are not needed again, resident memory
+                // stays flat however much history is read.
+                ReleaseMappedPages(from, (record + 1 - from) * sizeof(HistoryRecord));
+
+                mDone = done;
+                desc.onProgress(done, mTotal);
+            }
+        }
+
+        return r;
+    });
+
+    r = r && flush();
+
+    r = r && file->Flush();
+
+    file.reset();
+
+    r = r && RenameDurable(temp, desc.path, true);
+
+    if (!r)
+    {
+        RemoveFile(temp);
+
+        if (mCancel)
+        {
+            spdlog::info("History export to '{}' cancelled", desc.path.string());
+        }
+
+        return false;
+    }
+
+    mDone = done;
+    desc.onProgress(done, mTotal);
+
+    spdlog::info("Exported {} history records to '{}'", done, desc.path.string());
+
+    return true;
+}
+
+auto HistoryExporter::Wait () -> bool
+{
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+
+    return mResult;
+}
+
+auto HistoryExporter::Start (Desc desc) -> std::unique_ptr<HistoryExporter>
+{
+    spdlog::debug("Exporting history to '{}'", desc.path.string());
+
+    auto exporter = std::make_unique<HistoryExporter>();
+
+    exporter->mThread = std::thread([exporter = exporter.get(), desc = std::move(desc)]() mutable
+    {
+#if defined(_WIN32)
+        // Export is never urgent, keep disk and CPU free for the app.
+        SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+
+        exporter->mResult   = exporter->Run(std::move(desc));
+        exporter->mFinished = true;
+    });
+
+    return exporter;
+}
+
+} // namespace Impulse
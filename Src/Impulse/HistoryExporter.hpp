@@ -0,0 +1,95 @@
+#pragma once
+
+#include "HistoryRecord.hpp"
+#include "HistoryScan.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace Impulse {
+
+enum class ExportFormat : unsigned char
+{
+    Csv,
+    JsonLines
+};
+
+// Appends one record as a line of @format to @out, time as UTC ISO 8601.
+// @taskName may be empty.
+auto FormatHistoryRecord (
+    const HistoryRecord& record,
+    ExportFormat         format,
+    std::string_view     taskName,
+    std::string&         out
+) -> void;
+
+// First line of CSV export, nothing for JSON Lines.
+auto HistoryExportHeader (ExportFormat format) -> std::string_view;
+
+// Exports history to a text file on its own thread. Records are formatted
+// straight from the mapped segments into a fixed size buffer that is
+// written out whenever it fills, memory use doesn't depend on history
+// size. Output appears under its final name only when export completed.
+class HistoryExporter
+{
+public:
+    struct Desc
+    {
+        std::filesystem::path directory; // history, see HistorySegments.hpp
+        std::filesystem::path path;
+        ExportFormat          format = ExportFormat::Csv;
+        HistoryQuery          query;
+
+        // Records before @sequence must make it to export. @commit is called
+        // with it on export thread and returns once they are on disk, e.g.
+        // HistoryJournal::Commit(). Export goes on without them when it fails.
+        uint32_t                                sequence = 0;
+        std::function<bool (uint32_t sequence)> commit   = [](uint32_t){ return true; };
+
+        // UTF-8 names of known tasks by TaskId(), others export id only.
+        std::unordered_map<uint32_t, std::string> taskNames;
+
+        // Called on export thread with records gone through and records in
+        // time range, task filter doesn't change either. Last call has
+        // @done == @total on success.
+        std::function<void (uint64_t done, uint64_t total)> onProgress = [](uint64_t, uint64_t){};
+    };
+
+private:
+    std::thread           mThread;
+    std::atomic<bool>     mCancel   = false;
+    std::atomic<bool>     mFinished = false;
+    std::atomic<bool>     mResult   = false;
+    std::atomic<uint64_t> mDone     = 0;
+    std::atomic<uint64_t> mTotal    = 0;
+
+    auto Run (Desc desc) -> bool;
+
+    HistoryExporter            (const HistoryExporter& rhs) = delete;
+    HistoryExporter& operator= (const HistoryExporter& rhs) = delete;
+
+public:
+    HistoryExporter  () = default;
+    ~HistoryExporter ();
+
+    // Export stops at next buffer, partial output is deleted.
+    auto Cancel () -> void { mCancel = true; }
+
+    // Blocks until export ends, true when file was written.
+    auto Wait () -> bool;
+
+    auto Finished () const -> bool     { return mFinished; }
+    auto Done     () const -> uint64_t { return mDone; }
+    auto Total    () const -> uint64_t { return mTotal; }
+
+    static auto Start (Desc desc) -> std::unique_ptr<HistoryExporter>;
+};
+
+} // namespace Impulse
@@ -0,0 +1,70 @@
+#include "HistoryIndex.hpp"
+
+#include <algorithm>
+
+namespace Impulse {
+
+HistoryIndex::HistoryIndex (
+    const HistoryRecord*                     records,
+    size_t                                   count,
+    uint32_t                                 stride,
+    const std::function<void (HistorySpan)>& onSampled
+)
+    : mRecords (records)
+    , mCount   (count)
+    , mStride  (std::max<uint32_t>(stride, 1))
+{
+    constexpr auto RUN = size_t(1) << 16;
+
+    mTimes.reserve(count / mStride + 1);
+    for (auto first = size_t(0); first < count; first += RUN)
+    {
+        const auto last = std::min(count, first + RUN);
+
+        // Samples stay on multiples of stride whatever run size is.
+        for (auto i = (first + mStride - 1) / mStride * mStride; i < last; i += mStride)
+        {
+            mTimes.push_back(records[i].time);
+        }
+
+        if (onSampled)
+        {
+            onSampled(HistorySpan{ records + first, records + last });
+        }
+    }
+}
+
+auto HistoryIndex::LowerBound (int64_t time) const -> size_t
+{
+    // Last sampled record before @time starts the block to search in.
+    const auto sample = std::lower_bound(mTimes.begin(), mTimes.end(), time);
+    if (sample == mTimes.begin())
+    {
+        return 0;
+    }
+
+    const auto block = static_cast<size_t>(sample - mTimes.begin()) - 1;
+    const auto first = mRecords + block * mStride;
+    const auto last  = mRecords + std::min(mCount, (block + 1) * mStride);
+
+    const auto it = std::lower_bound(first, last, time,
+        [](const HistoryRecord& record, int64_t t) { return record.time < t; }
+    );
+
+    return static_cast<size_t>(it - mRecords);
+}
+
+auto HistoryIndex::Range (int64_t from, int64_t to) const -> HistorySpan
+{
+    if (to <= from)
+    {
+        return HistorySpan{ mRecords, mRecords };
+    }
+
+    const auto first = LowerBound(from);
+    const auto last  = std::max(first, LowerBound(to));
+
+    return HistorySpan{ mRecords + first, mRecords + last };
+}
+
+} // namespace Impulse
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "HistoryRecord.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Impulse {
+
+// Contiguous run of records, usually straight in mapped file.
+struct HistorySpan
+{
+    const HistoryRecord* first = nullptr;
+    const HistoryRecord* last  = nullptr;
+
+    auto begin () const { return first; }
+    auto end   () const { return last; }
+    auto size  () const { return static_cast<size_t>(last - first); }
+    auto empty () const { return first == last; }
+};
+
+// Sparse time index over records sorted by time. Keeps time of every
+// @stride-th record, so index of 10M records fits in a few hundred KB and
+// lookup touches one or two pages of records. Records stay where they are.
+// Building reads a record from every few pages, @onSampled gets runs of
+// records done with so caller can let their pages go.
+class HistoryIndex
+{
+    const HistoryRecord* mRecords = nullptr;
+    size_t               mCount   = 0;
+    uint32_t             mStride  = 256;
+    std::vector<int64_t> mTimes;
+
+public:
+    HistoryIndex () = default;
+    HistoryIndex (
+        const HistoryRecord*                     records,
+        size_t                                   count,
+        uint32_t                                 stride    = 256,
+        const std::function<void (HistorySpan)>& onSampled = {}
+    );
+
+    // Index of first record with time >= @time. O(log n).
+    auto LowerBound (int64_t time) const -> size_t;
+
+    // Records with time in [@from, @to).
+    auto Range (int64_t from, int64_t to) const -> HistorySpan;
+
+    auto Records () const { return HistorySpan{ mRecords, mRecords + mCount }; }
+    auto Size    () const { return mCount; }
+
+    auto MemoryUsage () const { return mTimes.capacity() * sizeof(int64_t); }
+};
+
+} // namespace Impulse
@@ -0,0 +1,351 @@
+#include "HistoryJournal.hpp"
+#include "HistorySegments.hpp"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+auto UnixTimeMs () -> int64_t
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+}
+
+namespace Impulse {
+
+HistoryJournal::~HistoryJournal ()
+{
+    if (mThread.joinable())
+    {
+        Commit();
+
+        {
+            auto guard = std::lock_guard<std::mutex>(mMutex);
+            mDone = true;
+        }
+
+        mWake.notify_one();
+        mThread.join();
+    }
+}
+
+auto HistoryJournal::Recover (const std::filesystem::path& path, uint32_t firstSequence) -> bool
+{
+    constexpr auto RECORD = uint64_t(sizeof(HistoryRecord));
+
+    mFile = DiskFile::Open(path, DiskFileMode::OpenAlways);
+    if (!mFile)
+    {
+        return false;
+    }
+
+    auto size = uint64_t(0);
+    if (!mFile->Size(size))
+    {
+        return false;
+    }
+
+    // New file, or crash before header made it to disk.
+    if (size < sizeof(HistoryHeader))
+    {
+        const auto header = MakeHistoryHeader(UnixTimeMs(), firstSequence);
+        if (!mFile->Truncate(0) || !mFile->WriteAt(0, &header, sizeof(header)) || !mFile->Flush())
+        {
+            spdlog::error("Failed to write history header");
+            return false;
+        }
+
+        mFileSize     = sizeof(header);
+        mFileCreated  = header.created;
+        mNextSequence = firstSequence;
+        mDurable      = firstSequence;
+        return true;
+    }
+
+    auto header = HistoryHeader();
+    if (!mFile->ReadAt(0, &header, sizeof(header)) || !IsValid(header))
+    {
+        // Not ours or damaged, leave it alone rather than destroy history.
+        spdlog::error("History file has invalid header");
+        return false;
+    }
+
+    // Walk back from the end until a chunk holds a valid record. Only last
+    // group commit can be torn, so this normally reads one chunk.
+    auto chunk = std::vector<HistoryRecord>(1024);
+    auto count = (size - sizeof(header)) / RECORD;
+    auto good  = uint64_t(0);
+    auto last  = HistoryRecord();
+
+    while (count > 0)
+    {
+        const auto n     = std::min<uint64_t>(count, chunk.size());
+        const auto first = count - n;
+
+        if (!mFile->ReadAt(sizeof(header) + first * RECORD, chunk.data(), static_cast<size_t>(n * RECORD)))
+        {
+            spdlog::error("Failed to read history");
+            return false;
+        }
+
+        const auto valid = ValidHistoryPrefix(chunk.data(), static_cast<size_t>(n));
+        if (valid > 0)
+        {
+            good = first + valid;
+            last = chunk[valid - 1];
+            break;
+        }
+
+        count = first;
+    }
+
+    mFileSize     = sizeof(header) + good * RECORD;
+    mFileCreated  = header.created;
+    mNextSequence = good > 0 ? last.sequence + 1 : header.firstSequence;
+    mDurable      = mNextSequence;
+    mRecovered    = size - mFileSize;
+
+    if (mRecovered > 0)
+    {
+        spdlog::warn("Dropping {} bytes of torn history records", mRecovered);
+
+        if (!mFile->Truncate(mFileSize) || !mFile->Flush())
+        {
+            spdlog::error("Failed to truncate history");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+auto HistoryJournal::WriteGroup () -> bool
+{
+    const auto bytes = mGroup.size() * sizeof(HistoryRecord);
+
+    if (mOnWrite() && mFile->WriteAt(mFileSize, mGroup.data(), bytes) && mFile->Flush())
+    {
+        mFileSize += bytes;
+        return true;
+    }
+
+    spdlog::error("Failed to write {} history records", mGroup.size());
+
+    // Don't leave half a group for retry to be appended after.
+    mFile->Truncate(mFileSize);
+    return false;
+}
+
+auto HistoryJournal::Rotate (uint32_t firstSequence) -> bool
+{
+    const auto path = mDirectory / JournalSegmentName(firstSequence);
+
+    // Keep appending to sealed segment until the new one is on disk, a
+    // segment that grows too big is better than lost records.
+    auto file = DiskFile::Open(path, DiskFileMode::CreateAlways);
+    if (!file)
+    {
+        return false;
+    }
+
+    const auto header = MakeHistoryHeader(UnixTimeMs(), firstSequence);
+    if (!file->WriteAt(0, &header, sizeof(header)) || !file->Flush())
+    {
+        spdlog::error("Failed to write history header");
+
+        file.reset();
+        RemoveFile(path);
+        return false;
+    }
+
+    mFile        = std::move(file);
+    mFileSize    = sizeof(header);
+    mFileCreated = header.created;
+
+    spdlog::debug("History rotated to '{}'", path.string());
+
+    return true;
+}
+
+auto HistoryJournal::Worker () -> void
+{
+    auto lock = std::unique_lock<std::mutex>(mMutex);
+
+    while (true)
+    {
+        if (mQueue.empty() && mGroup.empty())
+        {
+            if (mDone)
+            {
+                return;
+            }
+
+            mWake.wait(lock);
+            continue;
+        }
+
+        if (mGroup.empty())
+        {
+            // Give records arriving shortly after the first one a ride.
+            mWake.wait_for(lock, mCommitDelay, [&]
+            {
+                return mCommitNow || mDone || mQueue.size() >= mMaxGroup;
+            });
+
+            std::swap(mQueue, mGroup);
+        }
+        else
+        {
+            // Failed group goes first, records queued since follow it.
+            mGroup.insert(mGroup.end(), mQueue.begin(), mQueue.end());
+            mQueue.clear();
+        }
+
+        const auto durable = mNextSequence;
+
+        lock.unlock();
+
+        const auto r = WriteGroup();
+
+        const auto full    = mFileSize >= mMaxSize;
+        const auto old     = UnixTimeMs() - mFileCreated >= mMaxAge.count();
+        const auto rotated = r && (full || old) && Rotate(durable);
+
+        lock.lock();
+
+        mCommits   += 1;
+        mFailed    += r ? 0 : 1;
+        mRotations += rotated ? 1 : 0;
+
+        if (r)
+        {
+            mGroup.clear();
+            mDurable = durable;
+        }
+
+        if (mQueue.empty() || !r)
+        {
+            mCommitNow = false;
+        }
+
+        mCommitted.notify_all();
+
+        if (rotated)
+        {
+            lock.unlock();
+            OnRotate();
+            lock.lock();
+        }
+
+        if (!r)
+        {
+            // Disk that just failed won't be back right away. Shutdown gets
+            // one more attempt, then whatever is left is lost.
+            if (mDone)
+            {
+                spdlog::error("Giving up on {} history records", mGroup.size());
+
+                mGroup.clear();
+                return;
+            }
+
+            mWake.wait_for(lock, mRetryDelay, [&] { return mCommitNow || mDone; });
+        }
+    }
+}
+
+auto HistoryJournal::Append (HistoryRecord record) -> uint32_t
+{
+    {
+        auto guard = std::lock_guard<std::mutex>(mMutex);
+
+        record.sequence = mNextSequence++;
+        Seal(record);
+
+        mQueue.push_back(record);
+    }
+
+    mWake.notify_one();
+    return record.sequence;
+}
+
+auto HistoryJournal::Commit () -> bool
+{
+    return Commit(Size());
+}
+
+auto HistoryJournal::Commit (uint32_t sequence) -> bool
+{
+    auto lock = std::unique_lock<std::mutex>(mMutex);
+
+    const auto failed = mFailed;
+
+    if (static_cast<int32_t>(mDurable - sequence) < 0)
+    {
+        mCommitNow = true;
+        mWake.notify_one();
+        mCommitted.wait(lock, [&]
+        {
+            return static_cast<int32_t>(mDurable - sequence) >= 0 || mFailed != failed;
+        });
+    }
+
+    return static_cast<int32_t>(mDurable - sequence) >= 0;
+}
+
+auto HistoryJournal::Open (const HistoryJournal::Desc& desc) -> std::unique_ptr<HistoryJournal>
+{
+    spdlog::debug("Opening history journal in '{}'", desc.directory.string());
+
+    auto error = std::error_code();
+    std::filesystem::create_directories(desc.directory, error);
+    if (error)
+    {
+        spdlog::error("Failed to create '{}': {}", desc.directory.string(), error.message());
+        return nullptr;
+    }
+
+    // Newest journal is the active one. When there is none, or compaction
+    // already archived it, continue after last archived record.
+    const auto segments = ListHistorySegments(desc.directory);
+
+    auto path  = desc.directory / JournalSegmentName(0);
+    auto first = uint32_t(0);
+
+    if (!segments.empty())
+    {
+        const auto& last = segments.back();
+
+        first = last.kind == HistorySegmentKind::Journal ? last.first : last.last + 1;
+        path  = last.kind == HistorySegmentKind::Journal ? last.path  : desc.directory / JournalSegmentName(first);
+    }
+
+    auto journal = std::make_unique<HistoryJournal>();
+
+    if (!journal->Recover(path, first))
+    {
+        return nullptr;
+    }
+
+    journal->mDirectory   = desc.directory;
+    journal->mCommitDelay = desc.commitDelay;
+    journal->mMaxGroup    = std::max<size_t>(desc.maxGroup, 1);
+    journal->mRetryDelay  = desc.retryDelay;
+    journal->mOnWrite     = desc.onWrite;
+    journal->mMaxSize     = desc.maxSegmentSize;
+    journal->mMaxAge      = desc.maxSegmentAge;
+    journal->mQueue.reserve(journal->mMaxGroup);
+    journal->mGroup.reserve(journal->mMaxGroup);
+
+    journal->mThread = std::thread(&HistoryJournal::Worker, journal.get());
+
+    spdlog::debug("History journal opened, {} records", journal->mNextSequence);
+
+    return journal;
+}
+
+} // namespace Impulse
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "DiskFile.hpp"
+#include "HistoryRecord.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Impulse {
+
+// Append-only journal of HistoryRecords. Append() only queues a record;
+// writer thread writes everything queued since its last round with one
+// WriteFile and one flush (group commit), so UI thread never waits for
+// disk and flush cost is shared by all records of a round.
+//
+// Records go to the newest journal segment in history directory (see
+// HistorySegments.hpp). Once it grows past size or age limit, writer seals
+// it and starts next one; sealed segments are never written again.
+//
+// Group that failed to write stays queued and is retried ahead of newer
+// records, so journal never has gaps and records are never reordered.
+class HistoryJournal
+{
+public:
+    struct Desc
+    {
+        std::filesystem::path     directory;
+
+        // Writer waits this long after first queued record for others to
+        // join the group, unless @maxGroup records are already waiting.
+        std::chrono::milliseconds commitDelay = std::chrono::milliseconds(200);
+        size_t                    maxGroup    = 4096;
+
+        // Pause between attempts to write a group that failed.
+        std::chrono::milliseconds retryDelay  = std::chrono::milliseconds(1000);
+
+        // Called before every group write, returning false fails it as if
+        // disk did. For fault injection.
+        std::function<bool ()>    onWrite     = []{ return true; };
+
+        // Segment is sealed when either limit is reached.
+        uint64_t                  maxSegmentSize = 4 * 1024 * 1024;
+        std::chrono::hours        maxSegmentAge  = std::chrono::hours(24 * 7);
+    };
+
+private:
+    std::filesystem::path      mDirectory;
+    std::unique_ptr<DiskFile>  mFile;
+    uint64_t                   mFileSize      = 0; // bytes known to be good
+    int64_t                    mFileCreated   = 0; // ms since 1970-01-01 UTC
+    std::chrono::milliseconds  mCommitDelay   = std::chrono::milliseconds(200);
+    size_t                     mMaxGroup      = 4096;
+    std::chrono::milliseconds  mRetryDelay    = std::chrono::milliseconds(1000);
+    std::function<bool ()>     mOnWrite;
+    uint64_t                   mMaxSize       = 4 * 1024 * 1024;
+    std::chrono::milliseconds  mMaxAge        = std::chrono::hours(24 * 7);
+
+    std::thread                mThread;
+    std::mutex                 mMutex;
+    std::condition_variable    mWake;      // records queued or shutdown
+    std::condition_variable    mCommitted; // group is on disk
+
+    std::vector<HistoryRecord> mQueue;     // filled by Append()
+    std::vector<HistoryRecord> mGroup;     // being written or failed, swapped with queue
+    uint32_t                   mNextSequence  = 0;
+    uint32_t                   mDurable       = 0; // records before it are on disk
+    bool                       mCommitNow     = false;
+    bool                       mDone          = false;
+
+    uint64_t                   mCommits       = 0;
+    uint64_t                   mFailed        = 0;
+    uint64_t                   mRotations     = 0;
+    uint64_t                   mRecovered     = 0; // torn bytes cut off at open
+
+    // Open segment starting at @firstSequence, create it when missing.
+    // Sets sequence of next record.
+    auto Recover    (const std::filesystem::path& path, uint32_t firstSequence) -> bool;
+    auto WriteGroup () -> bool;
+    auto Rotate     (uint32_t firstSequence) -> bool;
+    auto Worker     () -> void;
+
+    HistoryJournal            (const HistoryJournal& rhs) = delete;
+    HistoryJournal& operator= (const HistoryJournal& rhs) = delete;
+
+public:
+    // Called on writer thread after a segment was sealed.
+    std::function<void ()> OnRotate = []{};
+
+public:
+    HistoryJournal  () = default;
+    ~HistoryJournal ();
+
+    // Queue @record, sequence and crc are filled in here. O(1), doesn't
+    // wait for disk. Returns sequence given to record.
+    auto Append (HistoryRecord record) -> uint32_t;
+
+    // Write everything appended so far and wait until it is on disk. False
+    // when a write failed meanwhile, records stay queued for next attempt.
+    auto Commit () -> bool;
+
+    // Same for records before @sequence, e.g. from another thread for
+    // records appended up to some point.
+    auto Commit (uint32_t sequence) -> bool;
+
+    auto Size      () { auto guard = std::lock_guard<std::mutex>(mMutex); return mNextSequence; }
+    auto Commits   () { auto guard = std::lock_guard<std::mutex>(mMutex); return mCommits;      }
+    auto Failed    () { auto guard = std::lock_guard<std::mutex>(mMutex); return mFailed;       }
+    auto Rotations () { auto guard = std::lock_guard<std::mutex>(mMutex); return mRotations;    }
+    auto Recovered () const { return mRecovered; }
+
+    // Open or create journal in @desc.directory. Partially written records
+    // at the end of active segment, left by crash or power loss, are cut off.
+    static auto Open (const HistoryJournal::Desc& desc) -> std::unique_ptr<HistoryJournal>;
+};
+
+} // namespace Impulse
@@ -0,0 +1,145 @@
+#include "HistoryReader.hpp"
+#include "HistorySegments.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse {
+
+auto HistoryReader::Count (int64_t from, int64_t to) const -> uint64_t
+{
+    auto count = uint64_t(0);
+    Range(from, to, [&](HistorySpan span)
+    {
+        count += span.size();
+        return true;
+    });
+
+    return count;
+}
+
+auto HistoryReader::FirstTime () const -> int64_t
+{
+    for (const auto& segment : mSegments)
+    {
+        if (segment.index.Size() > 0)
+        {
+            return segment.index.Records().first->time;
+        }
+    }
+
+    return 0;
+}
+
+auto HistoryReader::LastTime () const -> int64_t
+{
+    for (auto it = mSegments.rbegin(); it != mSegments.rend(); ++it)
+    {
+        if (it->index.Size() > 0)
+        {
+            return (it->index.Records().last - 1)->time;
+        }
+    }
+
+    return 0;
+}
+
+auto HistoryReader::MemoryUsage () const -> size_t
+{
+    auto bytes = mSegments.capacity() * sizeof(Segment);
+    for (const auto& segment : mSegments)
+    {
+        bytes += segment.index.MemoryUsage();
+    }
+
+    return bytes;
+}
+
+auto HistoryReader::Open (const std::vector<std::filesystem::path>& paths) -> std::unique_ptr<HistoryReader>
+{
+    auto reader = std::make_unique<HistoryReader>();
+    reader->mSegments.reserve(paths.size());
+
+    for (const auto& path : paths)
+    {
+        auto file = MappedFile::Open(path);
+        if (!file)
+        {
+            continue;
+        }
+
+        auto header = HistoryHeader();
+        if (file->Size() < sizeof(header))
+        {
+            continue;
+        }
+
+        std::memcpy(&header, file->Data(), sizeof(header));
+        if (!IsValid(header))
+        {
+            spdlog::error("History segment '{}' has invalid header", path.string());
+            continue;
+        }
+
+        // Records at the end that fail their crc belong to a commit in
+        // progress or one a crash cut short. Journal only ever has damage
+        // there, compaction leaves damaged records out of archives.
+        const auto records = reinterpret_cast<const HistoryRecord*>(file->Data() + sizeof(header));
+        const auto total   = static_cast<size_t>((file->Size() - sizeof(header)) / sizeof(HistoryRecord));
+        const auto count   = ValidHistoryPrefix(records, total);
+
+        if (count < total)
+        {
+            spdlog::debug("Ignoring {} unfinished records at the end of '{}'", total - count, path.string());
+        }
+
+        // Pages read for the index are dropped as it goes, opening
+        // doesn't leave whole history resident.
+        const auto release = [](HistorySpan span)
+        {
+            ReleaseMappedPages(span.first, span.size() * sizeof(HistoryRecord));
+        };
+
+        auto segment          = Segment();
+        segment.index         = HistoryIndex(records, count, 256, release);
+        segment.firstSequence = header.firstSequence;
+        segment.file          = std::move(file);
+
+        reader->mSize += count;
+        reader->mSegments.push_back(std::move(segment));
+    }
+
+    std::sort(reader->mSegments.begin(), reader->mSegments.end(),
+        [](const Segment& a, const Segment& b) { return a.firstSequence < b.firstSequence; }
+    );
+
+    return reader;
+}
+
+auto HistoryReader::OpenDirectory (const std::filesystem::path& directory) -> std::unique_ptr<HistoryReader>
+{
+    auto reader = std::unique_ptr<HistoryReader>();
+
+    // Compactor may publish an archive and delete its journals between
+    // listing and mapping. Listing again then finds the archive instead.
+    for (auto attempt = 0; attempt < 3; ++attempt)
+    {
+        auto paths = std::vector<std::filesystem::path>();
+        for (const auto& segment : ListHistorySegments(directory))
+        {
+            paths.push_back(segment.path);
+        }
+
+        reader = Open(paths);
+        if (reader->Segments() == paths.size())
+        {
+            break;
+        }
+    }
+
+    return reader;
+}
+
+} // namespace Impulse
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "HistoryIndex.hpp"
+#include "HistoryRecord.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Impulse {
+
+// Read access to history journal files (segments). Every segment is
+// memory mapped and gets a sparse time index; queries hand out spans
+// pointing into the mappings, records are never copied. View is a snapshot
+// of files as they were when opened, without torn records at their ends.
+class HistoryReader
+{
+    struct Segment
+    {
+        std::unique_ptr<MappedFile> file;
+        HistoryIndex                index;
+        uint32_t                    firstSequence = 0;
+    };
+
+    std::vector<Segment> mSegments; // in journal order
+    uint64_t             mSize = 0;
+
+public:
+    // Calls @visit(HistorySpan) for every run of records with time in
+    // [@from, @to), oldest first. Stops early when @visit returns false.
+    template <typename Visit>
+    auto Range (int64_t from, int64_t to, Visit&& visit) const -> void
+    {
+        for (const auto& segment : mSegments)
+        {
+            const auto span = segment.index.Range(from, to);
+            if (!span.empty() && !visit(span))
+            {
+                return;
+            }
+        }
+    }
+
+    // Number of records with time in [@from, @to).
+    auto Count (int64_t from, int64_t to) const -> uint64_t;
+
+    // Every record, segment by segment.
+    template <typename Visit>
+    auto ForEach (Visit&& visit) const -> void
+    {
+        for (const auto& segment : mSegments)
+        {
+            if (!visit(segment.index.Records()))
+            {
+                return;
+            }
+        }
+    }
+
+    // Records with sequence @sequence and later, oldest first. Compaction
+    // leaves damaged records out, so start is found by binary search.
+    template <typename Visit>
+    auto Since (uint32_t sequence, Visit&& visit) const -> void
+    {
+        for (const auto& segment : mSegments)
+        {
+            const auto records = segment.index.Records();
+            const auto first   = std::lower_bound(records.first, records.last, sequence,
+                [](const HistoryRecord& record, uint32_t sequence) { return record.sequence < sequence; }
+            );
+            if (first == records.last)
+            {
+                continue;
+            }
+
+            if (!visit(HistorySpan{ first, records.last }))
+            {
+                return;
+            }
+        }
+    }
+
+    auto Size     () const { return mSize; }
+    auto Segments () const { return mSegments.size(); }
+
+    // Time of first and last record, 0 when history is empty.
+    auto FirstTime () const -> int64_t;
+    auto LastTime  () const -> int64_t;
+
+    // Bytes of heap used by indexes, mapped records don't count.
+    auto MemoryUsage () const -> size_t;
+
+    // Segments that can't be read are skipped with an error in log.
+    static auto Open (const std::vector<std::filesystem::path>& paths) -> std::unique_ptr<HistoryReader>;
+
+    // Segments of history directory, see HistorySegments.hpp. Safe while
+    // compaction runs; once opened, deleted segments stay readable.
+    static auto OpenDirectory (const std::filesystem::path& directory) -> std::unique_ptr<HistoryReader>;
+};
+
+} // namespace Impulse
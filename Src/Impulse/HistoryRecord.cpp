@@ -0,0 +1,115 @@
+#include "HistoryRecord.hpp"
+#include "Crc32.hpp"
+
+#include <algorithm>
+
+namespace Impulse {
+
+auto TaskId (std::wstring_view name) -> uint32_t
+{
+    if (name.empty())
+    {
+        return 0;
+    }
+
+    auto hash = uint32_t(2166136261u);
+    for (const auto c : name)
+    {
+        hash = (hash ^ static_cast<uint16_t>(c)) * 16777619u;
+    }
+
+    // 0 is reserved for no task.
+    return hash != 0 ? hash : 1;
+}
+
+auto HistoryEventOf (ImpulseState from, ImpulseState to) -> HistoryEvent
+{
+    if (to == ImpulseState::Inactive)
+    {
+        return HistoryEvent::Stop;
+    }
+
+    if (to == ImpulseState::Paused)
+    {
+        return HistoryEvent::Pause;
+    }
+
+    switch (from)
+    {
+    case ImpulseState::Inactive: return HistoryEvent::Start;
+    case ImpulseState::Paused:   return HistoryEvent::Resume;
+    default:                     return HistoryEvent::End;
+    }
+}
+
+// 0 means not stored, offsets are kept biased by 128 quarter hours.
+constexpr auto UTC_OFFSET_STEP = int64_t(15) * 60 * 1000;
+constexpr auto UTC_OFFSET_BIAS = 128;
+
+auto SetUtcOffset (HistoryRecord& record, int64_t utcOffset) -> void
+{
+    // Rounded to nearest step, every time zone in use is a whole number of
+    // them.
+    const auto steps = (utcOffset + (utcOffset < 0 ? -UTC_OFFSET_STEP : UTC_OFFSET_STEP) / 2) / UTC_OFFSET_STEP;
+    record.utcOffset = static_cast<uint8_t>(std::clamp<int64_t>(steps, -127, 127) + UTC_OFFSET_BIAS);
+}
+
+auto UtcOffsetOf (const HistoryRecord& record, int64_t fallback) -> int64_t
+{
+    if (record.utcOffset == 0)
+    {
+        return fallback;
+    }
+
+    return (int64_t(record.utcOffset) - UTC_OFFSET_BIAS) * UTC_OFFSET_STEP;
+}
+
+auto Seal (HistoryRecord& record) -> void
+{
+    record.crc = Crc32(&record, offsetof(HistoryRecord, crc));
+}
+
+auto Seal (HistoryHeader& header) -> void
+{
+    header.crc = Crc32(&header, offsetof(HistoryHeader, crc));
+}
+
+auto IsValid (const HistoryRecord& record) -> bool
+{
+    return record.crc == Crc32(&record, offsetof(HistoryRecord, crc));
+}
+
+auto IsValid (const HistoryHeader& header) -> bool
+{
+    return header.magic      == HISTORY_MAGIC
+        && header.version    == HISTORY_VERSION
+        && header.recordSize == sizeof(HistoryRecord)
+        && header.crc        == Crc32(&header, offsetof(HistoryHeader, crc))
+        ;;
+}
+
+auto MakeHistoryHeader (int64_t created, uint32_t firstSequence) -> HistoryHeader
+{
+    auto header = HistoryHeader();
+
+    header.magic         = HISTORY_MAGIC;
+    header.version       = HISTORY_VERSION;
+    header.recordSize    = sizeof(HistoryRecord);
+    header.created       = created;
+    header.firstSequence = firstSequence;
+    Seal(header);
+
+    return header;
+}
+
+auto ValidHistoryPrefix (const HistoryRecord* records, size_t count) -> size_t
+{
+    while (count > 0 && !IsValid(records[count - 1]))
+    {
+        count -= 1;
+    }
+
+    return count;
+}
+
+} // namespace Impulse
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ImpulseState.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Impulse {
+
+enum class HistoryEvent : unsigned char
+{
+    Start,  // Inactive -> WorkShift
+    End,    // phase ran out, next one begins
+    Pause,
+    Resume,
+    Stop    // anything -> Inactive
+};
+
+// One state transition, stored in journal as is (little endian, 32 bytes).
+// Records are never modified, a torn or damaged one fails its crc.
+struct HistoryRecord
+{
+    int64_t      time        = 0; // ms since 1970-01-01 UTC
+    uint32_t     sequence    = 0; // position in journal
+    uint32_t     task        = 0; // TaskId() of current task
+    uint32_t     duration    = 0; // ms spent in @from state
+    uint16_t     workShift   = 0;
+    HistoryEvent event       = HistoryEvent::Start;
+    ImpulseState from        = ImpulseState::Inactive;
+    ImpulseState to          = ImpulseState::Inactive;
+    uint8_t      utcOffset   = 0; // see SetUtcOffset()
+    uint8_t      reserved[2] = {};
+    uint32_t     crc         = 0; // Crc32() of all bytes before it
+};
+
+// First 32 bytes of journal file.
+struct HistoryHeader
+{
+    uint32_t magic         = 0;
+    uint16_t version       = 0;
+    uint16_t recordSize    = 0;
+    int64_t  created       = 0; // ms since 1970-01-01 UTC
+    uint32_t firstSequence = 0;
+    uint8_t  reserved[8]   = {};
+    uint32_t crc           = 0;
+};
+
+static_assert(sizeof(HistoryRecord) == 32, "HistoryRecord layout is part of file format");
+static_assert(sizeof(HistoryHeader) == sizeof(HistoryRecord), "Header occupies one record slot");
+
+constexpr auto HISTORY_MAGIC   = uint32_t(0x48504D49); // "IMPH"
+constexpr auto HISTORY_VERSION = uint16_t(1);
+
+// Tasks are referred to by hash of their name (FNV-1a), 0 means no task.
+auto TaskId (std::wstring_view name) -> uint32_t;
+
+auto HistoryEventOf (ImpulseState from, ImpulseState to) -> HistoryEvent;
+
+// Local UTC offset in ms when record was written, stored in 15 minute
+// steps. Records from versions that didn't store it report @fallback.
+auto SetUtcOffset (HistoryRecord& record, int64_t utcOffset) -> void;
+auto UtcOffsetOf  (const HistoryRecord& record, int64_t fallback) -> int64_t;
+
+// Fill in crc.
+auto Seal (HistoryRecord& record) -> void;
+auto Seal (HistoryHeader& header) -> void;
+
+auto IsValid (const HistoryRecord& record) -> bool;
+auto IsValid (const HistoryHeader& header) -> bool;
+
+auto MakeHistoryHeader (int64_t created, uint32_t firstSequence) -> HistoryHeader;
+
+// Number of leading @records kept after dropping invalid ones at the end,
+// which is what a write cut short by crash or power loss leaves behind.
+auto ValidHistoryPrefix (const HistoryRecord* records, size_t count) -> size_t;
+
+} // namespace Impulse
@@ -0,0 +1,184 @@
+#include "HistoryScan.hpp"
+
+#include <cstddef>
+
+#include <immintrin.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+// Rest of the build doesn't assume AVX2, GCC and Clang need to be told this
+// function may use it. MSVC takes intrinsics anywhere.
+#if defined(_MSC_VER)
+#define IMPULSE_TARGET_AVX2
+#else
+#define IMPULSE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+using Impulse::FocusTotals;
+using Impulse::HistoryQuery;
+using Impulse::HistoryRecord;
+
+// Gathers below address record fields by these offsets.
+static_assert(offsetof(HistoryRecord, time)      == 0,  "time is gathered at offset 0");
+static_assert(offsetof(HistoryRecord, task)      == 12, "task is gathered at offset 12");
+static_assert(offsetof(HistoryRecord, duration)  == 16, "duration is gathered at offset 16");
+static_assert(offsetof(HistoryRecord, workShift) == 20, "event and from are bytes 2, 3 of dword at 20");
+static_assert(offsetof(HistoryRecord, event)     == 22, "event is byte 2 of dword at offset 20");
+static_assert(offsetof(HistoryRecord, from)      == 23, "from is byte 3 of dword at offset 20");
+
+IMPULSE_TARGET_AVX2
+auto ScanAvx2 (const HistoryRecord* records, size_t count, const HistoryQuery& query, FocusTotals& totals) -> size_t
+{
+    constexpr auto RECORD_DWORDS = int(sizeof(HistoryRecord) / 4);
+    constexpr auto RECORD_QWORDS = int(sizeof(HistoryRecord) / 8);
+
+    const auto dwordIndex = _mm256_setr_epi32(
+        0 * RECORD_DWORDS, 1 * RECORD_DWORDS, 2 * RECORD_DWORDS, 3 * RECORD_DWORDS,
+        4 * RECORD_DWORDS, 5 * RECORD_DWORDS, 6 * RECORD_DWORDS, 7 * RECORD_DWORDS
+    );
+    const auto qwordIndexLo = _mm_setr_epi32(0 * RECORD_QWORDS, 1 * RECORD_QWORDS, 2 * RECORD_QWORDS, 3 * RECORD_QWORDS);
+    const auto qwordIndexHi = _mm_setr_epi32(4 * RECORD_QWORDS, 5 * RECORD_QWORDS, 6 * RECORD_QWORDS, 7 * RECORD_QWORDS);
+
+    // Low dword of each qword lane moved to lower half.
+    const auto packLow = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    const auto from      = _mm256_set1_epi64x(query.from);
+    const auto to        = _mm256_set1_epi64x(query.to);
+    const auto task      = _mm256_set1_epi32(static_cast<int>(query.task));
+    const auto anyTask   = _mm256_set1_epi32(query.allTasks ? -1 : 0);
+    const auto workShift = _mm256_set1_epi32(static_cast<int>(Impulse::ImpulseState::WorkShift));
+    const auto paused    = _mm256_set1_epi32(static_cast<int>(Impulse::ImpulseState::Paused));
+    const auto end       = _mm256_set1_epi32(static_cast<int>(Impulse::HistoryEvent::End));
+    const auto byteMask  = _mm256_set1_epi32(0xFF);
+
+    auto focus     = _mm256_setzero_si256();
+    auto pause     = _mm256_setzero_si256();
+    auto pomodoros = _mm256_setzero_si256();
+
+    auto i = size_t(0);
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto base  = reinterpret_cast<const int*>(records + i);
+        const auto base8 = reinterpret_cast<const long long*>(records + i);
+
+        // Time range, two halves of 4 x int64 narrowed to 8 x int32 mask.
+        const auto timeLo = _mm256_i32gather_epi64(base8, qwordIndexLo, 8);
+        const auto timeHi = _mm256_i32gather_epi64(base8, qwordIndexHi, 8);
+        const auto inLo   = _mm256_andnot_si256(_mm256_cmpgt_epi64(from, timeLo), _mm256_cmpgt_epi64(to, timeLo));
+        const auto inHi   = _mm256_andnot_si256(_mm256_cmpgt_epi64(from, timeHi), _mm256_cmpgt_epi64(to, timeHi));
+        const auto inTime = _mm256_inserti128_si256(
+            _mm256_permutevar8x32_epi32(inLo, packLow),
+            _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(inHi, packLow)),
+            1
+        );
+
+        const auto recordTask = _mm256_i32gather_epi32(base + 3, dwordIndex, 4);
+        const auto duration   = _mm256_i32gather_epi32(base + 4, dwordIndex, 4);
+        const auto meta       = _mm256_i32gather_epi32(base + 5, dwordIndex, 4);
+
+        const auto recordFrom  = _mm256_srli_epi32(meta, 24);
+        const auto recordEvent = _mm256_and_si256(_mm256_srli_epi32(meta, 16), byteMask);
+
+        const auto match = _mm256_and_si256(inTime, _mm256_or_si256(anyTask, _mm256_cmpeq_epi32(recordTask, task)));
+        const auto work  = _mm256_and_si256(match, _mm256_cmpeq_epi32(recordFrom, workShift));
+        const auto pa    = _mm256_and_si256(match, _mm256_cmpeq_epi32(recordFrom, paused));
+        const auto done  = _mm256_and_si256(work,  _mm256_cmpeq_epi32(recordEvent, end));
+
+        // Durations widen to 64 bits before summing, years of them overflow 32.
+        const auto workDuration  = _mm256_and_si256(duration, work);
+        const auto pauseDuration = _mm256_and_si256(duration, pa);
+
+        focus = _mm256_add_epi64(focus, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(workDuration)));
+        focus = _mm256_add_epi64(focus, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(workDuration, 1)));
+        pause = _mm256_add_epi64(pause, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(pauseDuration)));
+        pause = _mm256_add_epi64(pause, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(pauseDuration, 1)));
+
+        // Mask lanes are -1, subtracting counts them.
+        pomodoros = _mm256_sub_epi32(pomodoros, done);
+    }
+
+    alignas(32) uint64_t focusLanes[4];
+    alignas(32) uint64_t pauseLanes[4];
+    alignas(32) uint32_t pomodoroLanes[8];
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(focusLanes),    focus);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(pauseLanes),    pause);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(pomodoroLanes), pomodoros);
+
+    for (auto lane = 0; lane < 4; ++lane)
+    {
+        totals.focus += focusLanes[lane];
+        totals.pause += pauseLanes[lane];
+    }
+
+    for (auto lane = 0; lane < 8; ++lane)
+    {
+        totals.pomodoros += pomodoroLanes[lane];
+    }
+
+    return i;
+}
+
+auto HasAvx2 () -> bool
+{
+#if defined(_WIN32)
+    static const auto hasAvx2 = IsProcessorFeaturePresent(PF_AVX2_INSTRUCTIONS_AVAILABLE) != FALSE;
+#else
+    static const auto hasAvx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+    return hasAvx2;
+}
+
+}
+
+namespace Impulse {
+
+auto HistoryScanUsesAvx2 () -> bool
+{
+    return HasAvx2();
+}
+
+auto ScanHistoryScalar (HistorySpan span, const HistoryQuery& query) -> FocusTotals
+{
+    auto totals = FocusTotals();
+
+    for (const auto& record : span)
+    {
+        if (record.time < query.from || query.to <= record.time)
+        {
+            continue;
+        }
+
+        if (!query.allTasks && record.task != query.task)
+        {
+            continue;
+        }
+
+        totals += FocusTotalsOf(record);
+    }
+
+    return totals;
+}
+
+auto ScanHistory (HistorySpan span, const HistoryQuery& query) -> FocusTotals
+{
+    if (!HasAvx2())
+    {
+        return ScanHistoryScalar(span, query);
+    }
+
+    auto totals = FocusTotals();
+
+    const auto done = ScanAvx2(span.first, span.size(), query, totals);
+
+    totals += ScanHistoryScalar(HistorySpan{ span.first + done, span.last }, query);
+    return totals;
+}
+
+} // namespace Impulse
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "HistoryIndex.hpp"
+#include "HistoryStats.hpp"
+
+#include <cstdint>
+#include <limits>
+
+namespace Impulse {
+
+// Filter for ad-hoc queries over raw records.
+struct HistoryQuery
+{
+    int64_t  from     = std::numeric_limits<int64_t>::min(); // time range [from, to)
+    int64_t  to       = std::numeric_limits<int64_t>::max();
+    uint32_t task     = 0;
+    bool     allTasks = true;
+};
+
+// Totals of records in @span matching @query, same rules as HistoryStats.
+// Full scan, uses AVX2 (8 records per step) when processor has it.
+auto ScanHistory (HistorySpan span, const HistoryQuery& query) -> FocusTotals;
+
+// Plain version, also used for what doesn't fill a whole AVX2 step.
+auto ScanHistoryScalar (HistorySpan span, const HistoryQuery& query) -> FocusTotals;
+
+// Whether ScanHistory() takes AVX2 path on this processor.
+auto HistoryScanUsesAvx2 () -> bool;
+
+} // namespace Impulse
@@ -0,0 +1,148 @@
+#include "HistorySegments.hpp"
+
+#include <algorithm>
+#include <cwchar>
+
+namespace {
+
+auto ParseSequence (const std::wstring& text) -> std::optional<uint32_t>
+{
+    if (text.empty() || text.size() > 10 || !std::all_of(text.begin(), text.end(), [](wchar_t c) { return L'0' <= c && c <= L'9'; }))
+    {
+        return std::nullopt;
+    }
+
+    const auto value = std::wcstoull(text.c_str(), nullptr, 10);
+    if (value > UINT32_MAX)
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<uint32_t>(value);
+}
+
+auto FormatSequence (uint32_t sequence) -> std::wstring
+{
+    // Fixed width, names sort like numbers.
+    wchar_t text[16] = {};
+    std::swprintf(text, 16, L"%010u", sequence);
+    return text;
+}
+
+}
+
+namespace Impulse {
+
+auto JournalSegmentName (uint32_t first) -> std::wstring
+{
+    return L"Journal-" + FormatSequence(first) + L".log";
+}
+
+auto ArchiveSegmentName (uint32_t first, uint32_t last) -> std::wstring
+{
+    return L"Archive-" + FormatSequence(first) + L"-" + FormatSequence(last) + L".hist";
+}
+
+auto ParseHistorySegment (const std::filesystem::path& path) -> std::optional<HistorySegment>
+{
+    const auto stem      = path.stem().wstring();
+    const auto extension = path.extension().wstring();
+
+    auto segment = HistorySegment();
+    segment.path = path;
+
+    if (extension == L".log" && stem.rfind(L"Journal-", 0) == 0)
+    {
+        const auto first = ParseSequence(stem.substr(8));
+        if (!first)
+        {
+            return std::nullopt;
+        }
+
+        segment.kind  = HistorySegmentKind::Journal;
+        segment.first = *first;
+        segment.last  = *first;
+        return segment;
+    }
+
+    if (extension == L".hist" && stem.rfind(L"Archive-", 0) == 0)
+    {
+        const auto dash = stem.find(L'-', 8);
+        if (dash == std::wstring::npos)
+        {
+            return std::nullopt;
+        }
+
+        const auto first = ParseSequence(stem.substr(8, dash - 8));
+        const auto last  = ParseSequence(stem.substr(dash + 1));
+        if (!first || !last || *last < *first)
+        {
+            return std::nullopt;
+        }
+
+        segment.kind  = HistorySegmentKind::Archive;
+        segment.first = *first;
+        segment.last  = *last;
+        return segment;
+    }
+
+    return std::nullopt;
+}
+
+auto ResolveHistorySegments (
+    std::vector<HistorySegment>  segments,
+    std::vector<HistorySegment>* covered
+) -> std::vector<HistorySegment>
+{
+    // Archive first when both start at the same sequence.
+    std::sort(segments.begin(), segments.end(), [](const HistorySegment& a, const HistorySegment& b)
+    {
+        return a.first != b.first ? a.first < b.first : a.kind > b.kind;
+    });
+
+    auto resolved = std::vector<HistorySegment>();
+    resolved.reserve(segments.size());
+
+    // Compaction merges whole journals, one starting inside an archive is
+    // entirely in it.
+    auto archived = std::optional<uint32_t>();
+    for (auto& segment : segments)
+    {
+        if (archived && segment.first <= *archived)
+        {
+            if (covered)
+            {
+                covered->push_back(segment);
+            }
+
+            continue;
+        }
+
+        if (segment.kind == HistorySegmentKind::Archive)
+        {
+            archived = segment.last;
+        }
+
+        resolved.push_back(std::move(segment));
+    }
+
+    return resolved;
+}
+
+auto ListHistorySegments (const std::filesystem::path& directory) -> std::vector<HistorySegment>
+{
+    auto segments = std::vector<HistorySegment>();
+
+    auto error = std::error_code();
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (auto segment = ParseHistorySegment(entry.path()))
+        {
+            segments.push_back(std::move(*segment));
+        }
+    }
+
+    return ResolveHistorySegments(std::move(segments));
+}
+
+} // namespace Impulse
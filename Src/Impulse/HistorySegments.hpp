@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Impulse {
+
+// History lives in a directory of segment files, named after sequence
+// numbers of records they hold:
+//
+//     Journal-<first>.log          being appended or sealed, last one active
+//     Archive-<first>-<last>.hist  sealed journals merged by compaction
+enum class HistorySegmentKind : unsigned char
+{
+    Journal,
+    Archive
+};
+
+struct HistorySegment
+{
+    HistorySegmentKind    kind  = HistorySegmentKind::Journal;
+    uint32_t              first = 0;
+    uint32_t              last  = 0; // archives only
+    std::filesystem::path path;
+};
+
+auto JournalSegmentName (uint32_t first) -> std::wstring;
+auto ArchiveSegmentName (uint32_t first, uint32_t last) -> std::wstring;
+
+auto ParseHistorySegment (const std::filesystem::path& path) -> std::optional<HistorySegment>;
+
+// Segments making up history, in sequence order. Journals an archive
+// already covers (compaction stopped before removing them) are left out,
+// so every record is seen once.
+auto ListHistorySegments (const std::filesystem::path& directory) -> std::vector<HistorySegment>;
+
+// Same for a list of names, @covered gets the left out journals.
+auto ResolveHistorySegments (
+    std::vector<HistorySegment>  segments,
+    std::vector<HistorySegment>* covered = nullptr
+) -> std::vector<HistorySegment>;
+
+} // namespace Impulse
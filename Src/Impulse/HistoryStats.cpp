@@ -0,0 +1,214 @@
+#include "HistoryStats.hpp"
+#include "Crc32.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+struct StatsHeader
+{
+    uint32_t magic        = 0;
+    uint16_t version      = 0;
+    uint16_t entrySize    = 0;
+    int64_t  utcOffset    = 0;
+    uint32_t nextSequence = 0;
+    uint32_t count        = 0;
+    uint32_t reserved     = 0;
+    uint32_t crc          = 0; // of header before it and all entries
+};
+
+struct StatsEntry
+{
+    uint64_t              key    = 0;
+    Impulse::FocusTotals  totals;
+};
+
+constexpr auto STATS_MAGIC   = uint32_t(0x53504D49); // "IMPS"
+constexpr auto STATS_VERSION = uint16_t(1);
+
+constexpr auto MS_PER_DAY = int64_t(24) * 60 * 60 * 1000;
+
+auto FloorDiv (int64_t a, int64_t b) -> int64_t
+{
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+// Months since January 1970 of day @days since 1970-01-01, civil calendar
+// arithmetic from Howard Hinnant's date algorithms.
+auto MonthOfDay (int64_t days) -> int64_t
+{
+    days += 719468;
+
+    const auto era = FloorDiv(days, 146097);
+    const auto doe = days - era * 146097;
+    const auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const auto mp  = (5 * doy + 2) / 153;
+    const auto m   = mp < 10 ? mp + 3 : mp - 9;
+    const auto y   = yoe + era * 400 + (m <= 2 ? 1 : 0);
+
+    return (y - 1970) * 12 + (m - 1);
+}
+
+}
+
+namespace Impulse {
+
+auto FocusTotalsOf (const HistoryRecord& record) -> FocusTotals
+{
+    auto totals = FocusTotals();
+
+    switch (record.from)
+    {
+    case ImpulseState::WorkShift:
+        totals.focus     = record.duration;
+        totals.pomodoros = (record.event == HistoryEvent::End) ? 1 : 0;
+        break;
+
+    case ImpulseState::Paused:
+        totals.pause = record.duration;
+        break;
+
+    default:
+        break;
+    }
+
+    return totals;
+}
+
+auto HistoryStats::Key (StatsPeriod period, int32_t index, uint32_t task, bool allTasks) -> uint64_t
+{
+    return (static_cast<uint64_t>(period) << 62)
+         | (static_cast<uint64_t>(allTasks ? 1 : 0) << 61)
+         | (static_cast<uint64_t>(static_cast<uint32_t>(index) & 0x1FFFFFFF) << 32)
+         | task
+         ;;
+}
+
+auto HistoryStats::PeriodOf (StatsPeriod period, int64_t time, int64_t utcOffset) -> int32_t
+{
+    const auto day = FloorDiv(time + utcOffset, MS_PER_DAY);
+
+    switch (period)
+    {
+    // 1970-01-01 was Thursday, Monday before it is day -3.
+    case StatsPeriod::Week:  return static_cast<int32_t>(FloorDiv(day + 3, 7));
+    case StatsPeriod::Month: return static_cast<int32_t>(MonthOfDay(day));
+    case StatsPeriod::Day:
+    default:                 return static_cast<int32_t>(day);
+    }
+}
+
+auto HistoryStats::Add (const HistoryRecord& record) -> void
+{
+    if (record.sequence < mNextSequence)
+    {
+        return;
+    }
+
+    mNextSequence = record.sequence + 1;
+
+    const auto totals = FocusTotalsOf(record);
+    if (totals.focus == 0 && totals.pause == 0 && totals.pomodoros == 0)
+    {
+        return;
+    }
+
+    const auto utcOffset = UtcOffsetOf(record, mUtcOffset);
+
+    for (const auto period : { StatsPeriod::Day, StatsPeriod::Week, StatsPeriod::Month })
+    {
+        const auto index = PeriodOf(period, record.time, utcOffset);
+
+        mRollups[Key(period, index, record.task, false)] += totals;
+        mRollups[Key(period, index, 0, true)]            += totals;
+    }
+}
+
+auto HistoryStats::Totals (StatsPeriod period, int32_t index, uint32_t task) const -> FocusTotals
+{
+    const auto it = mRollups.find(Key(period, index, task, false));
+    return it != mRollups.end() ? it->second : FocusTotals();
+}
+
+auto HistoryStats::AllTasks (StatsPeriod period, int32_t index) const -> FocusTotals
+{
+    const auto it = mRollups.find(Key(period, index, 0, true));
+    return it != mRollups.end() ? it->second : FocusTotals();
+}
+
+auto HistoryStats::Clear () -> void
+{
+    mRollups.clear();
+    mNextSequence = 0;
+}
+
+auto HistoryStats::Serialize () const -> std::string
+{
+    auto header = StatsHeader();
+    header.magic        = STATS_MAGIC;
+    header.version      = STATS_VERSION;
+    header.entrySize    = sizeof(StatsEntry);
+    header.utcOffset    = mUtcOffset;
+    header.nextSequence = mNextSequence;
+    header.count        = static_cast<uint32_t>(mRollups.size());
+
+    auto data = std::string(sizeof(header) + mRollups.size() * sizeof(StatsEntry), '\0');
+
+    auto offset = sizeof(header);
+    for (const auto& [key, totals] : mRollups)
+    {
+        const auto entry = StatsEntry{ key, totals };
+        std::memcpy(data.data() + offset, &entry, sizeof(entry));
+        offset += sizeof(entry);
+    }
+
+    header.crc = Crc32(&header, offsetof(StatsHeader, crc));
+    header.crc = Crc32(data.data() + sizeof(header), data.size() - sizeof(header), header.crc);
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    return data;
+}
+
+auto HistoryStats::Deserialize (std::string_view data) -> bool
+{
+    auto header = StatsHeader();
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (header.magic != STATS_MAGIC || header.version != STATS_VERSION || header.entrySize != sizeof(StatsEntry)
+    ||  data.size() != sizeof(header) + uint64_t(header.count) * sizeof(StatsEntry))
+    {
+        return false;
+    }
+
+    auto crc = Crc32(&header, offsetof(StatsHeader, crc));
+    crc = Crc32(data.data() + sizeof(header), data.size() - sizeof(header), crc);
+    if (crc != header.crc)
+    {
+        return false;
+    }
+
+    mRollups.clear();
+    mRollups.reserve(header.count);
+
+    for (auto i = uint32_t(0); i < header.count; ++i)
+    {
+        auto entry = StatsEntry();
+        std::memcpy(&entry, data.data() + sizeof(header) + i * sizeof(StatsEntry), sizeof(entry));
+
+        mRollups.emplace(entry.key, entry.totals);
+    }
+
+    mUtcOffset    = header.utcOffset;
+    mNextSequence = header.nextSequence;
+
+    return true;
+}
+
+} // namespace Impulse
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "HistoryRecord.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Impulse {
+
+enum class StatsPeriod : unsigned char
+{
+    Day,
+    Week,  // weeks start on Monday
+    Month
+};
+
+// Times are in ms.
+struct FocusTotals
+{
+    uint64_t focus     = 0; // time in work shifts
+    uint64_t pause     = 0; // time paused
+    uint32_t pomodoros = 0; // work shifts that ran out, not stopped
+    uint32_t reserved  = 0;
+
+    auto operator+= (const FocusTotals& rhs) -> FocusTotals&
+    {
+        focus     += rhs.focus;
+        pause     += rhs.pause;
+        pomodoros += rhs.pomodoros;
+        return *this;
+    }
+};
+
+// What a single record adds to totals.
+auto FocusTotalsOf (const HistoryRecord& record) -> FocusTotals;
+
+// Day, week and month totals per task, kept up to date one record at a
+// time. Stats view reads them directly and never goes through history.
+// Record counts into period in which it was written (its interval ends).
+//
+// Periods are local time at UTC offset stored in each record, so a time
+// zone or daylight saving change only moves records written after it and
+// nothing has to be rebuilt. Records without an offset use the one stats
+// were created with, it is saved with them.
+class HistoryStats
+{
+    int64_t                                   mUtcOffset    = 0; // ms, local = utc + offset, for old records
+    uint32_t                                  mNextSequence = 0;
+    std::unordered_map<uint64_t, FocusTotals> mRollups;
+
+    static auto Key (StatsPeriod period, int32_t index, uint32_t task, bool allTasks) -> uint64_t;
+
+public:
+    explicit HistoryStats (int64_t utcOffset = 0)
+        : mUtcOffset (utcOffset)
+    {
+    }
+
+    // Days since 1970-01-01, weeks since the Monday before it, or months
+    // since January 1970, all in local time.
+    static auto PeriodOf (StatsPeriod period, int64_t time, int64_t utcOffset) -> int32_t;
+    auto        PeriodOf (StatsPeriod period, int64_t time) const { return PeriodOf(period, time, mUtcOffset); }
+
+    // Records must come in journal order, ones already counted are skipped.
+    auto Add (const HistoryRecord& record) -> void;
+
+    // Totals of @task in period @index, all tasks together with AllTasks().
+    auto Totals    (StatsPeriod period, int32_t index, uint32_t task) const -> FocusTotals;
+    auto AllTasks  (StatsPeriod period, int32_t index) const -> FocusTotals;
+
+    auto Clear () -> void;
+
+    // Offset of records that don't store one, restored by Deserialize().
+    auto UtcOffset    () const { return mUtcOffset; }
+    auto NextSequence () const { return mNextSequence; }
+    auto Size         () const { return mRollups.size(); }
+
+    // Compact binary form with crc, see Impulse.stats.
+    auto Serialize   () const -> std::string;
+    auto Deserialize (std::string_view data) -> bool;
+};
+
+} // namespace Impulse
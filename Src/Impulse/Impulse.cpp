@@ -1,180 +1,78 @@
 ﻿#include "PCH.hpp"
 #include "Impulse.hpp"
+#include "FixedString.hpp"
+#include "HistoryReader.hpp"
+#include "HistorySegments.hpp"
+#include "SettingsDiff.hpp"
+#include "SettingsFile.hpp"
+#include "TaskImporter.hpp"
 #include "Resource.h"
 #include "Utility.hpp"
+#include "WindowPlacement.hpp"
 
 #include <chrono>
 #include <fstream>
-#include <tuple>
-
-#include <shellapi.h>
 
 namespace {
 
-auto CalculateWindowPositionAndSize (
-    Impulse::WindowPosition windowPosition,
-    float originalWidth,
-    float originalHeight,
-    float originalPadding,
-    float dpi = 96.f
-) -> std::tuple<D2D1_POINT_2L, D2D1_SIZE_U>
-{
-    // Get primary monitor.
-    auto monitor = MonitorFromPoint(POINT{0, 0}, MONITOR_DEFAULTTOPRIMARY);
-    auto info    = MONITORINFO{ 0 };
-    info.cbSize  = sizeof(MONITORINFO);
-    
-    if (!GetMonitorInfoW(monitor, &info))
+// Offset of local time from UTC in ms, daylight saving included.
+auto LocalUtcOffset () -> int64_t
+{
+    auto timeZone = TIME_ZONE_INFORMATION();
+
+    auto bias = LONG(0);
+    switch (GetTimeZoneInformation(&timeZone))
     {
-        spdlog::error("GetMonitorInfoW() failed");
-        return std::tuple(
-            D2D1::Point2L(originalPadding, originalPadding),
-            D2D1::SizeU(originalWidth, originalHeight)
-        );
+    case TIME_ZONE_ID_DAYLIGHT: bias = timeZone.Bias + timeZone.DaylightBias; break;
+    case TIME_ZONE_ID_STANDARD: bias = timeZone.Bias + timeZone.StandardBias; break;
+    case TIME_ZONE_ID_UNKNOWN:  bias = timeZone.Bias;                         break;
+    default:                    return 0;
     }
 
-    // Re-calculate with dpi in mind.
-    const auto windowWidth   = ceil(originalWidth * dpi / 96.f);
-    const auto windowHeight  = ceil(originalHeight * dpi / 96.f);
-    const auto windowPadding = ceil(originalPadding * dpi / 96.f);
-    
-    const auto monitorWidth  = info.rcMonitor.right - info.rcMonitor.left;
-    const auto monitorHeight = info.rcMonitor.bottom - info.rcMonitor.top;
-
-    auto x = monitorWidth - windowWidth - windowPadding;
-    auto y = monitorHeight - windowHeight - windowPadding;
+    return -int64_t(bias) * 60 * 1000;
+}
 
-    auto includeTaskbar = false;
+// Refresh period of monitor @window is on, 60 Hz when it's not known.
+auto DisplayFrameInterval (HWND window) -> std::chrono::steady_clock::duration
+{
+    auto info   = MONITORINFOEXW();
+    info.cbSize = sizeof(info);
 
-    auto abd   = APPBARDATA{0};
-    abd.cbSize = sizeof(PAPPBARDATA);
-    if (SHAppBarMessage(ABM_GETTASKBARPOS, &abd))
-    {
-        // Detect window position basing on taskbar position.
-        if (windowPosition == Impulse::WindowPosition::Auto)
-        {
-            switch (abd.uEdge)
-            {
-            case ABE_LEFT:
-                windowPosition = Impulse::WindowPosition::LeftBottom;
-                break;
-            
-            case ABE_TOP:
-                windowPosition = Impulse::WindowPosition::RightTop;
-                break;
-
-            case ABE_RIGHT:
-                windowPosition = Impulse::WindowPosition::RightBottom;
-                break;
-            
-            case ABE_BOTTOM:
-                windowPosition = Impulse::WindowPosition::RightBottom;
-                break;
-            }
-        }
+    auto mode   = DEVMODEW();
+    mode.dmSize = sizeof(mode);
 
-        includeTaskbar = true;
-    }
-    else
+    // Frequency 0 and 1 both mean hardware default.
+    const auto monitor = MonitorFromWindow(window, MONITOR_DEFAULTTONEAREST);
+    if (!GetMonitorInfoW(monitor, &info)
+    ||  !EnumDisplaySettingsW(info.szDevice, ENUM_CURRENT_SETTINGS, &mode)
+    ||  mode.dmDisplayFrequency <= 1)
     {
-        spdlog::warn("SHAppBarMessage() failed, ignoring taskbar when positioning window");
+        return std::chrono::microseconds(16667);
     }
 
-    switch (windowPosition)
+    return std::chrono::microseconds(1000000 / mode.dmDisplayFrequency);
+}
+
+// Single file history of older versions becomes first journal segment.
+auto MigrateHistory (const std::filesystem::path& directory) -> void
+{
+    const auto legacy = directory.parent_path() / "Impulse.history";
+
+    auto error = std::error_code();
+    if (!std::filesystem::exists(legacy, error) || std::filesystem::exists(directory, error))
     {
-    case Impulse::WindowPosition::Auto:
-        // Fallback to right-bottom.
-        x = monitorWidth - windowWidth - windowPadding;
-        y = monitorHeight - windowHeight - windowPadding;
-        break;
-    case Impulse::WindowPosition::LeftTop:
-        x = windowPadding;
-        y = windowPadding;
-        break;
-    case Impulse::WindowPosition::LeftEdge:
-        x = windowPadding;
-        y = (monitorHeight - windowHeight) / 2;
-        break;
-    case Impulse::WindowPosition::LeftBottom:
-        x = windowPadding;
-        y = monitorHeight - windowHeight - windowPadding;
-        break;
-    case Impulse::WindowPosition::CenterTop:
-        x = (monitorWidth - windowWidth) / 2;
-        y = windowPadding;
-        break;
-    case Impulse::WindowPosition::Center:
-        x = (monitorWidth - windowWidth) / 2;
-        y = (monitorHeight - windowHeight) / 2;
-        break;
-    case Impulse::WindowPosition::CenterBottom:
-        x = (monitorWidth - windowWidth) / 2;
-        y = monitorHeight - windowHeight - windowPadding;
-        break;
-    case Impulse::WindowPosition::RightTop:
-        x = monitorWidth - windowWidth - windowPadding;
-        y = windowPadding;
-        break;
-    case Impulse::WindowPosition::RightEdge:
-        x = monitorWidth - windowWidth - windowPadding;
-        y = (monitorHeight - windowHeight) / 2;
-        break;
-    case Impulse::WindowPosition::RightBottom:
-        x = monitorWidth - windowWidth - windowPadding;
-        y = monitorHeight - windowHeight - windowPadding;
-        break;
+        return;
     }
 
-    if (includeTaskbar)
+    std::filesystem::create_directories(directory, error);
+    std::filesystem::rename(legacy, directory / Impulse::JournalSegmentName(0), error);
+    if (error)
     {
-        const auto dx = abd.rc.right - abd.rc.left;
-        const auto dy = abd.rc.bottom - abd.rc.top;
-
-        switch (abd.uEdge)
-        {
-        case ABE_LEFT:
-            if (windowPosition == Impulse::WindowPosition::LeftTop
-            ||  windowPosition == Impulse::WindowPosition::LeftEdge
-            ||  windowPosition == Impulse::WindowPosition::LeftBottom
-               )
-            {
-                x += dx;
-            }
-            break;
-            
-        case ABE_TOP:
-            if (windowPosition == Impulse::WindowPosition::LeftTop
-            ||  windowPosition == Impulse::WindowPosition::CenterTop
-            ||  windowPosition == Impulse::WindowPosition::RightTop
-               )
-            {
-                y += dy;
-            }
-            break;
-
-        case ABE_RIGHT:
-            if (windowPosition == Impulse::WindowPosition::RightTop
-            ||  windowPosition == Impulse::WindowPosition::RightEdge
-            ||  windowPosition == Impulse::WindowPosition::RightBottom
-               )
-            {
-                x -= dx;
-            }
-            break;
-            
-        case ABE_BOTTOM:
-            if (windowPosition == Impulse::WindowPosition::LeftBottom
-            ||  windowPosition == Impulse::WindowPosition::CenterBottom
-            ||  windowPosition == Impulse::WindowPosition::RightBottom
-               )
-            {
-                y -= dy;
-            }
-            break;
-        }
+        spdlog::error("Failed to move '{}' to '{}': {}", legacy.string(), directory.string(), error.message());
+        return;
     }
-    
-    return std::tuple(D2D1::Point2L(x, y), D2D1::SizeU(windowWidth, windowHeight));
+
+    spdlog::info("Moved session history to '{}'", directory.string());
 }
 
 }
@@ -192,17 +90,33 @@ auto ImpulseApp::CreateGraphicsResources () -> bool
     r = CreateButtons();
     r = CreateTimer();
     r = CreateStaticText();
+    r = CreateTaskList();
     if (!r)
     {
         return false;
     }
 
-    CalculateLayout();
+    // Clock is at the bottom, only widgets that react to mouse are hit tested.
+    mWidgets.Add(mClockWidget.get()       , 0, false);
+    mWidgets.Add(mStaticImpulseState.get(), 1, false);
+    mWidgets.Add(mStaticCurrentTask.get() , 1);
+    mWidgets.Add(mButtonSettings.get()    , 2);
+    mWidgets.Add(mButtonClose.get()       , 2);
+    mWidgets.Add(mButtonPause.get()       , 2);
+    mWidgets.Add(mButtonInfo.get()        , 2);
+    mWidgets.Add(mTaskList.get()          , 3);
+
+    CreateLayout();
+    UpdateLayout();
 
     UpdatePauseButton();
     UpdateStateStatic();
     UpdateTaskStatic();
-    
+
+    if (mSettings->AutoStartTimer)
+    {
+        mEngine->Handle(PomodoroEvent::Start);
+    }
 
     spdlog::debug("Successfully created Graphics Resources");
 
@@ -213,8 +127,12 @@ auto ImpulseApp::DiscardGraphicsResources () -> void
 {
     spdlog::debug("Discarding Graphics Resources");
 
+    mPointer.Discard();
+    mWidgets.Clear();
+
     mStaticImpulseState.reset();
     mStaticCurrentTask.reset();
+    mTaskList.reset();
 
     mClockWidget.reset();
 
@@ -223,123 +141,119 @@ auto ImpulseApp::DiscardGraphicsResources () -> void
     mButtonPause.reset();
     mButtonInfo.reset();
 
-    mHoveredWidget = nullptr;
-    mClickedWidget = nullptr;
+    mLayout.reset();
+    mFontScale = 0.0f;
 }
 
-auto ImpulseApp::CalculateLayout () -> void
+auto ImpulseApp::CreateLayout () -> void
 {
-    if (!mD2DDeviceContext || !mInitialzied)
+    const auto placeButton = [](Button* button)
     {
-        return;
-    }
-
-    const auto originalWidth  = 450.f;
-    const auto originalHeight = 330.f;
-    const auto windowPadding  = 20.f;
+        return [button](const LayoutRect& rect)
+        {
+            button->Position(rect.left, rect.top);
+            button->Size(rect.Width(), rect.Height());
+        };
+    };
 
-    const auto dpi   = GetDpi();
-    const auto scale = dpi / 96.f;
+    const auto placeStatic = [](StaticText* staticText)
+    {
+        return [staticText](const LayoutRect& rect)
+        {
+            staticText->Position(rect.left, rect.top);
+            staticText->Size(rect.Width(), rect.Height());
+        };
+    };
 
-    auto [position, size] = CalculateWindowPositionAndSize(
-        mSettings->WindowPosition, originalWidth, originalHeight, windowPadding, dpi
-    );
+    auto desc = MainLayout::Desc();
 
-#if defined(NDEBUG)
-    SetWindowPos(
-        Handle(), HWND_TOP, position.x, position.y, size.width, size.height, SWP_NOACTIVATE
-    );
-#endif
+    desc.settingsButton = placeButton(mButtonSettings.get());
+    desc.closeButton    = placeButton(mButtonClose.get());
+    desc.pauseButton    = placeButton(mButtonPause.get());
+    desc.infoButton     = placeButton(mButtonInfo.get());
+    desc.stateText      = placeStatic(mStaticImpulseState.get());
+    desc.taskText       = placeStatic(mStaticCurrentTask.get());
 
-    const auto rt = mD2DDeviceContext->GetSize();
+    desc.taskList = [this](const LayoutRect& rect)
+    {
+        mTaskList->Position(rect.left, rect.top);
+        mTaskList->Size(rect.Width(), rect.Height());
+    };
 
-    const auto buttonWidth    = ceil(32.f * scale);
-    const auto buttonHeight   = ceil(32.f * scale);
-    const auto buttonPaddingX = ceil(5.f * scale);
-    const auto buttonPaddingY = ceil(5.f * scale);
-    const auto buttonFontSize = ceil(22.f * scale);
+    desc.clock = [this, placeStatic](const ClockPlacement& clock)
+    {
+        mClockWidget->Position(clock.centerX, clock.centerY);
+        mClockWidget->OuterRadius(clock.outerRadius);
+        mClockWidget->InnerRadius(clock.innerRadius);
+        mClockWidget->OuterStroke(clock.stroke);
+        mClockWidget->InnerStroke(clock.stroke);
+
+        placeStatic(mClockWidget->GetTimerStatic())(clock.timerText);
+        placeStatic(mClockWidget->GetTopStatic())(clock.topText);
+        placeStatic(mClockWidget->GetBottomStatic())(clock.bottomText);
+    };
+
+    mLayout = std::make_unique<MainLayout>(desc);
+}
 
-    const auto staticTopPadding    = ceil(5.f * scale);
-    const auto staticBottomPadding = ceil(5.f * scale);
-    const auto staticStateFontSize = ceil(24.f * scale);
-    const auto staticTaskFontSize  = ceil(20.f * scale);
-
-    const auto timerPadding          = ceil(55.f * scale);
-    const auto timerOuterRadius      = (std::min(rt.width, rt.height) / 2.f) - timerPadding;
-    const auto timerInnerRadius      = timerOuterRadius - ceil(25.f * scale);
-    const auto timerStroke           = ceil(2.f * scale);
-    const auto timerFontSize         = ceil(40.f * scale);
-    const auto timerTopFontSize      = ceil(16.f * scale);
-    const auto timerBottomFontSize   = ceil(16.f * scale);
-    const auto timerTopTextHeight    = ceil(32.f * scale);
-    const auto timerBottomTextHeight = ceil(32.f * scale);
-    
-    // Calculate button position/size.
+auto ImpulseApp::UpdateLayout () -> void
+{
+    if (!mD2DDeviceContext || !mLayout)
     {
-        const auto brx = rt.width - buttonWidth - buttonPaddingX;
-        const auto bry = rt.height - buttonHeight - buttonPaddingY;
+        return;
+    }
 
-        mButtonSettings->Position(buttonPaddingX, buttonPaddingY);
-        mButtonSettings->Size(buttonWidth, buttonHeight);
-        mButtonSettings->FontSize(buttonFontSize);
+    const auto scale = GetDpi() / 96.f;
 
-        mButtonClose->Position(brx, buttonPaddingY);
-        mButtonClose->Size(buttonWidth, buttonHeight);
-        mButtonClose->FontSize(buttonFontSize);
+    // Font sizes change only with dpi, widgets keep formats per size.
+    if (scale != mFontScale)
+    {
+        mFontScale = scale;
+        UpdateFontSizes(scale);
+    }
 
-        mButtonPause->Position(buttonPaddingX, bry);
-        mButtonPause->Size(buttonWidth, buttonHeight);
-        mButtonPause->FontSize(buttonFontSize);
+    const auto rt = mD2DDeviceContext->GetSize();
 
-        mButtonInfo->Position(brx, bry);
-        mButtonInfo->Size(buttonWidth, buttonHeight);
-        mButtonInfo->FontSize(buttonFontSize);
+    if (mLayout->Update(LayoutSize{ rt.width, rt.height }, scale))
+    {
+        mWidgets.InvalidateIndex();
     }
 
-    // Calculate timer position/size.
-    {
-        const auto cx = rt.width / 2;
-        const auto cy = rt.height / 2;
-        mClockWidget->Position(cx, cy);
-        mClockWidget->OuterRadius(timerOuterRadius);
-        mClockWidget->InnerRadius(timerInnerRadius);
-        mClockWidget->OuterStroke(timerStroke);
-        mClockWidget->InnerStroke(timerStroke);
+    const auto stats = mLayout->Stats();
+    spdlog::trace(
+        "Layout: {} measured, {} arranged, {} applied", stats.measured, stats.arranged, stats.applied
+    );
+}
 
-        const auto timerRect = mClockWidget->Rect();
-        const auto timerText = mClockWidget->GetTimerStatic();
-        timerText->Position(timerRect.left, timerRect.top);
-        timerText->Size(2.f * timerOuterRadius, 2.f * timerOuterRadius);
-        timerText->FontSize(timerFontSize);
+auto ImpulseApp::UpdateFontSizes (float scale) -> void
+{
+    const auto buttonFontSize = ceil(22.f * scale);
 
-        const auto timerTop = mClockWidget->GetTopStatic();
-        const auto tar2 = cy - ceil(64.f * scale);
-        const auto tar = cy - (timerInnerRadius / 2) - (timerTopTextHeight / 2);
-        timerTop->Position(timerRect.left, tar);
-        timerTop->Size(timerRect.right - timerRect.left, timerTopTextHeight);
-        timerTop->FontSize(timerTopFontSize);
+    mButtonSettings->FontSize(buttonFontSize);
+    mButtonClose->FontSize(buttonFontSize);
+    mButtonPause->FontSize(buttonFontSize);
+    mButtonInfo->FontSize(buttonFontSize);
 
-        const auto timerBottom = mClockWidget->GetBottomStatic();
-        const auto bar2 = cy + ceil(32.f * scale);
-        const auto bar = cy + (timerInnerRadius / 2) - (timerBottomTextHeight / 2);
-        timerBottom->Position(timerRect.left, bar);
-        timerBottom->Size(timerRect.right - timerRect.left, timerBottomTextHeight);
-        timerBottom->FontSize(timerBottomFontSize);
-    }
+    mStaticImpulseState->FontSize(ceil(24.f * scale));
+    mStaticCurrentTask->FontSize(ceil(20.f * scale));
 
-    // Calculate static texts.
-    {
-        const auto slx = buttonWidth + 2 * buttonPaddingX;
-        const auto slw = (rt.width - (2 * (buttonWidth + 2 * buttonPaddingX)));
+    mTaskList->FontSize(ceil(14.f * scale));
+    mTaskList->RowHeight(ceil(24.f * scale));
 
-        mStaticImpulseState->Position(slx, staticTopPadding);
-        mStaticImpulseState->Size(slw, buttonHeight);
-        mStaticImpulseState->FontSize(staticStateFontSize);
+    mClockWidget->GetTimerStatic()->FontSize(ceil(40.f * scale));
+    mClockWidget->GetTopStatic()->FontSize(ceil(16.f * scale));
+    mClockWidget->GetBottomStatic()->FontSize(ceil(16.f * scale));
+}
 
-        mStaticCurrentTask->Position(slx, rt.height - staticBottomPadding - buttonHeight);
-        mStaticCurrentTask->Size(slw, buttonHeight);
-        mStaticCurrentTask->FontSize(staticTaskFontSize);
-    }
+auto ImpulseApp::PlaceWindow () -> void
+{
+    const auto placement = CalculateWindowPlacement(
+        mSettings->WindowPosition, mDisplayInfo->Geometry(), 450.f, 330.f, 20.f, GetDpi()
+    );
+
+    SetWindowPos(
+        Handle(), HWND_TOP, placement.x, placement.y, placement.width, placement.height, SWP_NOACTIVATE
+    );
 }
 
 #pragma endregion
@@ -386,6 +300,11 @@ auto ImpulseApp::CreateButtons () -> bool
         mButtonInfo = Button::Create(desc, mD2DDeviceContext.Get(), mDWriteFactory.Get());
     }
 
+    mButtonSettings->Scheduler(&mAnimations);
+    mButtonClose->Scheduler(&mAnimations);
+    mButtonPause->Scheduler(&mAnimations);
+    mButtonInfo->Scheduler(&mAnimations);
+
     mButtonSettings->OnClick = [&]{ ButtonSettings_Click(); };
     mButtonClose->OnClick = [&]{ ButtonClose_Click(); };
     mButtonPause->OnClick = [&]{ ButtonPause_Click(); };
@@ -402,29 +321,25 @@ auto ImpulseApp::CreateTimer () -> bool
     desc.outerOutlineColor = D2D1::ColorF(D2D1::ColorF::Black);
     desc.innerCircleColor  = D2D1::ColorF(0.68f, 0.81f, 1.0f);
     desc.innerOutlineColor = D2D1::ColorF(D2D1::ColorF::Black);
+    desc.progressColor     = D2D1::ColorF(0.16f, 0.40f, 0.85f);
 
     desc.topTextDesc.text = L"(paused)";
 
     mClockWidget = Widgets::Clock::Create(
-        desc, mD2DDeviceContext.Get(), mDWriteFactory.Get(), mSettings, mTimer
+        desc, mD2DDeviceContext.Get(), mDWriteFactory.Get(), mEngine, mTimer
     );
 
+    mClockWidget->Scheduler(&mAnimations);
+
     mTimer->OnTick    = [&]{ Timer_Tick(); };
     mTimer->OnTimeout = [&]{ Timer_Timeout(); };
 
+    mEngine->OnTransition = [&](ImpulseState from, ImpulseState to){ Engine_Transition(from, to); };
+
+    // Timer waits paused until engine starts a phase.
     mTimer->Interval(std::chrono::milliseconds(1000));
-    mTimer->Duration(std::chrono::milliseconds(mSettings->WorkDuration * 1000));
-    
-    if (mSettings->AutoStartTimer)
-    {
-        mTimer->Start(false);
-        mSettings->CurrentState = ImpulseState::WorkShift;
-    }
-    else
-    {
-        mTimer->Start(true);
-        mSettings->CurrentState = ImpulseState::Inactive; // on start clock is inactive
-    }
+    mTimer->Duration(mEngine->PhaseDuration());
+    mTimer->Start(true);
 
     return true;
 }
@@ -445,82 +360,33 @@ auto ImpulseApp::CreateStaticText () -> bool
         mStaticCurrentTask = StaticText::Create(desc, mD2DDeviceContext.Get(), mDWriteFactory.Get());
     }
 
-    return true;
-}
-
-#pragma endregion
+    mStaticImpulseState->Scheduler(&mAnimations);
+    mStaticCurrentTask->Scheduler(&mAnimations);
 
-#pragma region "Drawing"
+    mStaticCurrentTask->OnClick = [&]{ StaticTask_Click(); };
 
-////////////////////////////////////////////////////////////////////////////////
-
-auto ImpulseApp::DrawButtons () -> void
-{
-    auto d2dDeviceContext = mD2DDeviceContext.Get();
-
-    if (mButtonClose)    { mButtonClose->Draw(d2dDeviceContext); }
-    if (mButtonSettings) { mButtonSettings->Draw(d2dDeviceContext); }
-    if (mButtonPause)    { mButtonPause->Draw(d2dDeviceContext); }
-    if (mButtonInfo)     { mButtonInfo->Draw(d2dDeviceContext); }
-}
-
-auto ImpulseApp::DrawTimer () -> void
-{
-    if (mClockWidget)
-    {
-        mClockWidget->Draw(mD2DDeviceContext.Get());
-    }
+    return true;
 }
 
-auto ImpulseApp::DrawStaticTexts () -> void
+auto ImpulseApp::CreateTaskList () -> bool
 {
-    if (mStaticImpulseState)
-    {
-        mStaticImpulseState->Draw(mD2DDeviceContext.Get());
-    }
+    auto desc = TaskList::Desc();
 
-    if (mStaticCurrentTask)
+    mTaskList = TaskList::Create(desc, mD2DDeviceContext.Get(), mDWriteFactory.Get(), mTaskStore);
+    if (!mTaskList)
     {
-        mStaticCurrentTask->Draw(mD2DDeviceContext.Get());
+        return false;
     }
-}
 
-////////////////////////////////////////////////////////////////////////////////
+    // Shown on demand over the clock.
+    mTaskList->Visible(false);
+    mTaskList->OnClick = [&]{ TaskList_Click(); };
 
-#pragma endregion
+    SelectCurrentTask();
 
-#pragma region "HitTest"
-
-////////////////////////////////////////////////////////////////////////////////
-
-auto ImpulseApp::HitTest (D2D_POINT_2F point) -> Widget*
-{
-    if (mButtonClose->HitTest(point))
-    {
-        return mButtonClose.get();
-    }
-    if (mButtonSettings->HitTest(point))
-    {
-        return mButtonSettings.get();
-    }
-    if (mButtonPause->HitTest(point))
-    {
-        return mButtonPause.get();
-    }
-    if (mButtonInfo->HitTest(point))
-    {
-        return mButtonInfo.get();
-    }
-    if (mStaticCurrentTask->HitTest(point))
-    {
-        return mStaticCurrentTask.get();
-    }
-    
-    return nullptr;
+    return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-
 #pragma endregion
 
 #pragma region Events
@@ -531,45 +397,89 @@ auto ImpulseApp::Timer_Tick () -> void
 {
     // !!! This method is called from other thread !!!
 
-    SendMessage(Handle(), WM_IMPULSE_REDRAW, 0, 0);
+    // Nobody can see the clock, only the timeout matters.
+    if (IsVisible())
+    {
+        SendMessage(Handle(), WM_IMPULSE_REDRAW, 0, 0);
+    }
 }
 
 auto ImpulseApp::Timer_Timeout () -> void
 {
     // !!! This method is called from other thread !!!
-    
-    // This function gets executed when timer hit 0.
-    switch (mSettings->CurrentState)
+
+    // Engine lives on UI thread. SendMessage blocks the timer until next
+    // phase duration is set.
+    SendMessage(Handle(), WM_IMPULSE_TIMEOUT, 0, 0);
+}
+
+auto ImpulseApp::Engine_Transition (ImpulseState from, ImpulseState to) -> void
+{
+    RecordTransition(from, to);
+
+    switch (to)
     {
-    // Time for break.
-    case ImpulseState::WorkShift:
-        // Check if we need to start long break.
-        if (mSettings->WorkShiftCount == mSettings->LongBreakAfter)
-        {
-            SendMessage(Handle(), WM_IMPULSE_START_LONG_BREAK, 0, 0);
-        }
-        else
-        {
-            SendMessage(Handle(), WM_IMPULSE_START_SHORT_BREAK, 0, 0);
-        }
+    case ImpulseState::Paused:
+        mTimer->Pause();
+        break;
+
+    case ImpulseState::Inactive:
+        mTimer->Pause();
+        mTimer->Duration(mEngine->PhaseDuration());
         break;
 
-    // Time for work.
+    case ImpulseState::WorkShift:
     case ImpulseState::ShortBreak:
     case ImpulseState::LongBreak:
-        SendMessage(Handle(), WM_IMPULSE_START_WORK_SHIFT, 0, 0);
-
-        if (mSettings->WorkShiftCount < mSettings->LongBreakAfter)
+        // Resumed phase continues where it was paused.
+        if (from != ImpulseState::Paused)
         {
-            mSettings->WorkShiftCount += 1;
+            mTimer->Duration(mEngine->PhaseDuration());
         }
-        else
-        {
-            mSettings->WorkShiftCount = 1;
-        }     
-
+        mTimer->Start();
         break;
     }
+
+    UpdatePauseButton();
+    UpdateStateStatic();
+    Redraw();
+}
+
+auto ImpulseApp::RecordTransition (ImpulseState from, ImpulseState to) -> void
+{
+    if (!mHistory)
+    {
+        return;
+    }
+
+    // History is searched by time, it must not go back when clock does.
+    const auto now = std::max(mLastTransitionTime, std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count());
+
+    // First transition after start counts time app wasn't running too.
+    const auto duration = mLastTransitionTime > 0 ? std::min<int64_t>(now - mLastTransitionTime, UINT32_MAX) : 0;
+
+    auto record      = HistoryRecord();
+    record.time      = now;
+    record.task      = TaskId(mSettings->TaskName);
+    record.duration  = static_cast<uint32_t>(duration);
+    record.workShift = static_cast<uint16_t>(mEngine->WorkShiftCount());
+    record.event     = HistoryEventOf(from, to);
+    record.from      = from;
+    record.to        = to;
+
+    // Stats bucket record by local day it was written on, offset changes
+    // later don't move it.
+    SetUtcOffset(record, LocalUtcOffset());
+
+    // Queued only, writer thread commits it.
+    record.sequence = mHistory->Append(record);
+
+    mLastTransitionTime = now;
+
+    mStats.Add(record);
+    SaveStats();
 }
 
 auto ImpulseApp::ButtonClose_Click () -> void
@@ -584,64 +494,49 @@ auto ImpulseApp::ButtonSettings_Click () -> void
 
 auto ImpulseApp::ButtonPause_Click () -> void
 {
-    ImpulsePauseClock();
+    mEngine->Handle(PomodoroEvent::Toggle);
 }
 
 auto ImpulseApp::ButtonInfo_Click () -> void
 {
 }
 
-auto ImpulseApp::ImpulseStartWork () -> void
+auto ImpulseApp::StaticTask_Click () -> void
 {
-    mTimer->Duration(std::chrono::milliseconds(mSettings->WorkDuration * 1000));
-    mSettings->CurrentState = ImpulseState::WorkShift;
-    UpdateStateStatic();
-}
+    if (mTaskStore->Empty())
+    {
+        return;
+    }
 
-auto ImpulseApp::ImpulseStartShortBreak () -> void
-{
-    mTimer->Duration(std::chrono::milliseconds(mSettings->ShortBreakDuration * 1000));
-    mSettings->CurrentState = ImpulseState::ShortBreak;
-    UpdateStateStatic();
-}
+    mTaskList->Visible(!mTaskList->IsVisible());
+    if (mTaskList->IsVisible())
+    {
+        mTaskList->ScrollTo(mTaskList->SelectedTask());
+    }
 
-auto ImpulseApp::ImpulseStartLongBreak () -> void
-{
-    mTimer->Duration(std::chrono::milliseconds(mSettings->LongBreakDuration * 1000));
-    mSettings->CurrentState = ImpulseState::LongBreak;
-    UpdateStateStatic();
+    // Widget under pointer changed.
+    mWidgets.InvalidateIndex();
+    mPointer.Move(GetMousePositionX(), GetMousePositionY());
+    Redraw();
 }
 
-auto ImpulseApp::ImpulsePauseClock () -> void
+auto ImpulseApp::TaskList_Click () -> void
 {
-    switch (mSettings->CurrentState)
+    const auto task = mTaskList->HoveredTask();
+    if (task == TaskList::NO_TASK || task >= mTaskStore->Size())
     {
-    case ImpulseState::WorkShift:
-    case ImpulseState::LongBreak:
-    case ImpulseState::ShortBreak:
-        mTimer->Pause();
-        mButtonPause->Text(L"▶️");
-        mButtonPause->SetIcon(0);
-        mSettings->PreviousState = mSettings->CurrentState;
-        mSettings->CurrentState = ImpulseState::Paused;
-        break;
-
-    case ImpulseState::Inactive:
-    case ImpulseState::Paused:
-        mTimer->Start();
-        mButtonPause->Text(L"⏸");
-        mButtonPause->SetIcon(1);
-        mSettings->PreviousState = mSettings->CurrentState;
-        mSettings->CurrentState = ImpulseState::WorkShift;
-        break;
+        return;
     }
 
-    UpdateStateStatic();
-}
+    mTaskList->Select(task);
+    mSettings->TaskName = mTaskStore->Get(task);
+    UpdateTaskStatic();
+    SaveSettings();
 
-auto ImpulseApp::ImpulseInactive () -> void
-{
-    mSettings->CurrentState = ImpulseState::Inactive;
+    mTaskList->Visible(false);
+    mWidgets.InvalidateIndex();
+    mPointer.Move(GetMousePositionX(), GetMousePositionY());
+    Redraw();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -654,7 +549,7 @@ auto ImpulseApp::ImpulseInactive () -> void
 
 auto ImpulseApp::UpdatePauseButton () -> void
 {
-    switch (mSettings->CurrentState)
+    switch (mEngine->State())
     {
     case ImpulseState::WorkShift:
     case ImpulseState::LongBreak:
@@ -676,9 +571,36 @@ auto ImpulseApp::UpdateTaskStatic () -> void
     mStaticCurrentTask->Text(mSettings->TaskName);
 }
 
+auto ImpulseApp::SelectCurrentTask () -> void
+{
+    // Highlight current task, done on load only so cost of linear search
+    // doesn't matter.
+    mTaskList->Select(TaskList::NO_TASK);
+
+    for (auto i = 0u; i < mTaskStore->Size(); ++i)
+    {
+        if (mTaskStore->Get(i) == mSettings->TaskName)
+        {
+            mTaskList->Select(i);
+            break;
+        }
+    }
+}
+
+auto ImpulseApp::ReplaceTasks (std::shared_ptr<const TaskStore> tasks) -> void
+{
+    mTaskStore = std::move(tasks);
+
+    // Widgets don't exist yet while settings load.
+    if (mTaskList)
+    {
+        mTaskList->Store(mTaskStore);
+    }
+}
+
 auto ImpulseApp::UpdateStateStatic () -> void
 {
-    switch (mSettings->CurrentState)
+    switch (mEngine->State())
     {
     case ImpulseState::Inactive:
         mStaticImpulseState->Text(L"Inactive");
@@ -713,55 +635,319 @@ auto ImpulseApp::LoadSettings () -> bool
 {
     // NOTE: Settings should be in UTF-8
     // Read Settings file.
-    auto file = std::ifstream(mSettingsFilePath);
+    auto file = std::ifstream(mSettingsFilePath, std::ios::binary);
     if (!file)
     {
         spdlog::error("Can't open Settings file '{}' for reading", mSettingsFilePath.string());
         return false;
     }
 
-    // Deserialize.
-    auto json = nlohmann::json::parse(file, nullptr, false, true);
-    if (json.is_discarded())
+    const auto json = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    // Deserialize. Fields with bad values keep defaults, others are used.
+    auto settings = Settings();
+    auto tasks    = TaskStore();
+
+    const auto result = ReadSettings(json, settings, tasks);
+    if (!result.valid)
     {
         spdlog::error("Failed to deserialize json");
         return false;
     }
-    
-    try
+
+    *mSettings = std::move(settings);
+    ReplaceTasks(std::make_shared<const TaskStore>(std::move(tasks)));
+
+    spdlog::info("Loaded Settings '{}'", mSettingsFilePath.string());
+
+    // Migrated file is written back in current format. File with rejected
+    // fields is left for the user to fix.
+    if (result.version < SETTINGS_VERSION && result.rejected == 0)
     {
-        *mSettings = json.get<Settings>();
+        SaveSettings();
     }
-    catch (nlohmann::json::exception&)
+
+    return true;
+}
+
+auto ImpulseApp::ParseChangedSettings () -> void
+{
+    // Our own save is queued or being written, notification is about it.
+    // Anything edited meanwhile is overwritten by it anyway.
+    if (mSettingsWriter->Busy())
     {
-        spdlog::error("Failed to deserialize settings");
-        spdlog::info("Using default values");
-        *mSettings = Settings();
-        return true;
+        return;
     }
 
-    //Log() << json.dump(4).c_str() << std::endl;
-    spdlog::info("Loaded Settings '{}'", mSettingsFilePath.string());
+    // Editors may still be writing, bad file is skipped and next change
+    // notification tries again. Current settings stay as they are.
+    auto file = std::ifstream(mSettingsFilePath, std::ios::binary);
+    if (!file)
+    {
+        return;
+    }
 
-    return true;
+    const auto json = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    // Notifications of our last save arrive after it finished.
+    if (json == mSettingsWriter->LastWritten())
+    {
+        return;
+    }
+
+    auto reloaded = std::make_unique<ReloadedSettings>();
+    if (!ReadSettings(json, reloaded->settings, reloaded->tasks).valid)
+    {
+        spdlog::warn("Changed Settings file is not valid json, ignoring it");
+        return;
+    }
+
+    {
+        auto guard = std::lock_guard<std::mutex>(mReloadedMutex);
+        mReloaded = std::move(reloaded);
+    }
+
+    if (!mSettingsChanged.exchange(true))
+    {
+        PostMessage(Handle(), WM_IMPULSE_SETTINGS_CHANGED, 0, 0);
+    }
 }
 
-auto ImpulseApp::SaveSettings () -> bool
+auto ImpulseApp::ReloadSettings () -> void
 {
-    // Open Settings file.
-    auto file = std::ofstream(mSettingsFilePath);
-    if (!file)
+    auto reloaded = std::unique_ptr<ReloadedSettings>();
     {
-        spdlog::error("Can't open Settings file '{}' for writing", mSettingsFilePath.string());
-        return false;
+        auto guard = std::lock_guard<std::mutex>(mReloadedMutex);
+        reloaded = std::move(mReloaded);
     }
 
-    // Serialize.
-    auto json = nlohmann::json(*mSettings);
-    file << std::setw(4) << json;
+    if (!reloaded)
+    {
+        return;
+    }
 
-    spdlog::info("Saved Settings '{}'", mSettingsFilePath.string());
-    return true;
+    auto& settings = reloaded->settings;
+    auto& tasks    = reloaded->tasks;
+
+    // Editor may save file without changing anything.
+    const auto diff = DiffSettings(*mSettings, *mTaskStore, settings, tasks);
+    if (diff.Empty())
+    {
+        return;
+    }
+
+    spdlog::info(
+        "Settings changed: durations {}, auto start {}, task {}, task list {}, window position {}",
+        diff.durations, diff.autoStartTimer, diff.taskName, diff.tasks, diff.windowPosition
+    );
+
+    *mSettings = settings;
+
+    // Phase already running keeps its length, next ones use new durations.
+    if (diff.durations)
+    {
+        ConfigureEngine();
+    }
+
+    // Task list rebuilds only rows it shows.
+    if (diff.tasks)
+    {
+        ReplaceTasks(std::make_shared<const TaskStore>(std::move(tasks)));
+    }
+
+    if (diff.tasks || diff.taskName)
+    {
+        SelectCurrentTask();
+    }
+
+    if (diff.taskName)
+    {
+        UpdateTaskStatic();
+    }
+
+    // Same as on DPI change, layout doesn't depend on position.
+    if (diff.windowPosition)
+    {
+        PlaceWindow();
+    }
+
+    Redraw();
+}
+
+auto ImpulseApp::ConfigureEngine () -> void
+{
+    auto config = PomodoroConfig();
+    config.workDuration       = mSettings->WorkDuration;
+    config.shortBreakDuration = mSettings->ShortBreakDuration;
+    config.longBreakDuration  = mSettings->LongBreakDuration;
+    config.longBreakAfter     = mSettings->LongBreakAfter;
+
+    mEngine->Configure(config);
+}
+
+auto ImpulseApp::SaveSettings () -> void
+{
+    // Snapshot now, serialization and disk access happen on writer thread.
+    // Task store is never modified, writer shares it.
+    auto settings  = std::make_shared<const Settings>(*mSettings);
+    auto taskStore = mTaskStore;
+
+    mSettingsWriter->Submit([settings, taskStore]
+    {
+        return WriteSettings(*settings, *taskStore);
+    });
+}
+
+auto ImpulseApp::LoadStats () -> void
+{
+    mStats = HistoryStats(LocalUtcOffset());
+
+    // Rollups saved last time.
+    auto file = std::ifstream(mStatsFilePath, std::ios::binary);
+    if (file)
+    {
+        const auto data = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (!mStats.Deserialize(data))
+        {
+            spdlog::warn("Stats file '{}' is damaged, rebuilding from history", mStatsFilePath.string());
+            mStats = HistoryStats(LocalUtcOffset());
+        }
+    }
+
+    // Stats saw records that didn't make it to journal before a crash,
+    // start over so both agree.
+    if (mStats.NextSequence() > mHistory->Size())
+    {
+        mStats = HistoryStats(mStats.UtcOffset());
+    }
+
+    // Apply what was journaled since, normally nothing or a few records.
+    const auto applied = mStats.NextSequence();
+
+    if (auto reader = HistoryReader::OpenDirectory(mHistoryDirectory))
+    {
+        // New records continue in time order from last run, even when clock
+        // was set back since.
+        mLastTransitionTime = reader->LastTime();
+
+        reader->Since(applied, [&](HistorySpan span)
+        {
+            for (const auto& record : span)
+            {
+                mStats.Add(record);
+            }
+
+            return true;
+        });
+    }
+
+    auto writerDesc = DebouncedWriter::Desc();
+    writerDesc.path = mStatsFilePath;
+
+    mStatsWriter = std::make_unique<DebouncedWriter>(writerDesc);
+
+    if (mStats.NextSequence() != applied)
+    {
+        spdlog::info("Stats caught up with {} history records", mStats.NextSequence() - applied);
+        SaveStats();
+    }
+}
+
+auto ImpulseApp::SaveStats () -> void
+{
+    auto stats = std::make_shared<const HistoryStats>(mStats);
+
+    mStatsWriter->Submit([stats]
+    {
+        return stats->Serialize();
+    });
+}
+
+auto ImpulseApp::ExportHistory (ExportFormat format) -> void
+{
+    if (!mHistory || (mExporter && !mExporter->Finished()))
+    {
+        return;
+    }
+
+    // Export reads segments on disk, records still queued wouldn't be in it.
+    // Exporter waits for them on its own thread.
+    auto desc      = HistoryExporter::Desc();
+    desc.directory = mHistoryDirectory;
+    desc.path      = mHistoryDirectory.parent_path() / (format == ExportFormat::Csv ? "History.csv" : "History.jsonl");
+    desc.format    = format;
+    desc.sequence  = mHistory->Size();
+    desc.commit    = [history = mHistory.get()](uint32_t sequence)
+    {
+        return history->Commit(sequence);
+    };
+
+    for (auto i = 0u; i < mTaskStore->Size(); ++i)
+    {
+        if (auto name = UTF16ToUTF8(mTaskStore->Get(i)))
+        {
+            desc.taskNames[TaskId(mTaskStore->Get(i))] = std::move(*name);
+        }
+    }
+
+    desc.onProgress = [](uint64_t done, uint64_t total)
+    {
+        spdlog::debug("Exporting history: {} of {} records", done, total);
+    };
+
+    mExporter = HistoryExporter::Start(std::move(desc));
+}
+
+auto ImpulseApp::ImportTasks () -> void
+{
+    if (mImport)
+    {
+        return;
+    }
+
+    const auto directory = mSettingsFilePath.parent_path();
+
+    // Import copies and dedupes against store on its own thread.
+    auto desc   = TaskImport::Desc();
+    desc.paths  = { directory / "Tasks.csv", directory / "Tasks.txt" };
+    desc.tasks  = mTaskStore;
+    desc.onDone = [window = Handle()]
+    {
+        // !!! This is called from other thread !!!
+        PostMessage(window, WM_IMPULSE_TASKS_IMPORTED, 0, 0);
+    };
+
+    mImport = TaskImport::Start(std::move(desc));
+}
+
+auto ImpulseApp::TasksImported () -> void
+{
+    if (!mImport)
+    {
+        return;
+    }
+
+    auto job = std::move(mImport);
+    job->Wait();
+
+    if (job->Added() == 0)
+    {
+        return;
+    }
+
+    // Settings reload replaced task list meanwhile, job was deduped
+    // against tasks that are gone.
+    if (job->Source() != mTaskStore)
+    {
+        spdlog::warn("Task list changed during job, {} imported tasks dropped", job->Added());
+        return;
+    }
+
+    // Result starts with every task of current store, it takes its place.
+    // Appended tasks keep indices of existing ones, selection stays.
+    ReplaceTasks(std::make_shared<const TaskStore>(job->Take()));
+    SaveSettings();
+    Redraw();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -780,103 +966,116 @@ auto ImpulseApp::OnClose () -> void
 
 auto ImpulseApp::OnDpiChanged (float dpi) -> void
 {
-    auto [position, size] = CalculateWindowPositionAndSize(
-            mSettings->WindowPosition, 450.f, 330.f, 20.f, dpi
-        );
+    // Window moved to another monitor, its refresh rate may differ too.
+    mPointer.FrameInterval(DisplayFrameInterval(Handle()));
 
-    SetWindowPos(
-        Handle(), HWND_TOP, position.x, position.y, size.width, size.height, SWP_NOACTIVATE
-    );
+    PlaceWindow();
+}
+
+auto ImpulseApp::OnKeyDown (UINT key) -> void
+{
+    // Ctrl+E exports history as CSV, with Shift as JSON Lines.
+    if (key == 'E' && (GetKeyState(VK_CONTROL) & 0x8000))
+    {
+        ExportHistory((GetKeyState(VK_SHIFT) & 0x8000) ? ExportFormat::JsonLines : ExportFormat::Csv);
+    }
 
-    //CalculateLayout();
+    // Ctrl+I imports task lists dropped next to settings file.
+    if (key == 'I' && (GetKeyState(VK_CONTROL) & 0x8000))
+    {
+        ImportTasks();
+    }
+
+#if defined(_DEBUG)
+    // Exercise device loss recovery without waiting for a driver reset.
+    if (key == VK_F9)
+    {
+        spdlog::debug("Simulating device loss");
+        SimulateDeviceLost();
+        Redraw();
+    }
+#endif
+}
+
+auto ImpulseApp::ResolvePointer () -> void
+{
+    const auto redraw = mPointer.Flush([&](int x, int y)
+    {
+        return mWidgets.MouseMove(D2D1::Point2F(x, y));
+    });
+
+    if (redraw)
+    {
+        Redraw();
+    }
 }
 
 auto ImpulseApp::OnMouseDown (MouseButton button, int x, int y) -> void
 {
-    if (button == MouseButton::Left)
+    // Pending move happened before the press.
+    ResolvePointer();
+
+    if (button == MouseButton::Left && mWidgets.MouseDown(D2D1::Point2F(x, y)))
     {
-        auto widget = HitTest(D2D1::Point2F(x, y));
-        if (widget)
-        {
-            mClickedWidget = widget;
-            if (widget->Update(Widget::State::Active))
-            {
-                Redraw();
-            }
-        }
+        Redraw();
     }
 }
 
 auto ImpulseApp::OnMouseUp (MouseButton button, int x, int y) -> void
 {
-    if (button == MouseButton::Left)
-    {
-        const auto point = D2D1::Point2F(x, y);
+    ResolvePointer();
 
-        auto widget = HitTest(point);
-        if (widget)
-        {
-            if (widget->Update(Widget::State::Hover))
-            {
-                Redraw();
-            }
-        
-            if (widget == mClickedWidget)
-            {
-                widget->OnClick();
-            }
-        }
-    
-        mClickedWidget = nullptr;
+    if (button == MouseButton::Left && mWidgets.MouseUp(D2D1::Point2F(x, y)))
+    {
+        Redraw();
     }
 }
 
 auto ImpulseApp::OnMouseMove (int x, int y) -> void
 {
-    const auto point = D2D1::Point2F(x, y);
+    mPointer.Move(x, y);
+}
 
-    auto widget = HitTest(point);
-    if (widget)
+auto ImpulseApp::OnMouseWheel (float delta, int x, int y) -> void
+{
+    ResolvePointer();
+
+    if (mWidgets.MouseWheel(D2D1::Point2F(x, y), delta))
     {
-        if (widget == mClickedWidget)
-        {
-            if (widget->Update(Widget::State::Active))
-            {
-                Redraw();
-            }
-        }
-        else
-        {
-            if (widget->Update(Widget::State::Hover))
-            {
-                Redraw();
-            }
-        }
-        mHoveredWidget = widget;
+        Redraw();
     }
-    else
+}
+
+auto ImpulseApp::OnUpdate () -> void
+{
+    // Moves are hit tested once per display frame, not once per mouse
+    // report. Buttons and wheel resolve them right away.
+    const auto redraw = mPointer.Update(AnimationClock::now(), [&](int x, int y)
     {
-        if (mHoveredWidget)
-        {
-            if (mHoveredWidget->Update(Widget::State::Default))
-            {
-                Redraw();
-            }
-            mHoveredWidget = nullptr;
-        }
+        return mWidgets.MouseMove(D2D1::Point2F(x, y));
+    });
+
+    if (redraw)
+    {
+        Redraw();
     }
 }
 
-auto ImpulseApp::OnDraw () -> void
+auto ImpulseApp::UpdateTime () const -> AnimationClock::time_point
 {
-    static float frames = 0.f;
+    return mPointer.UpdateTime(AnimationClock::now());
+}
 
-    DrawButtons();
-    DrawTimer();
-    DrawStaticTexts();
+auto ImpulseApp::OnDraw () -> void
+{
+    mWidgets.Draw(mD2DDeviceContext.Get());
 
-    SetWindowTextW(Handle(), std::to_wstring(frames).c_str());
-    frames++;
+#if defined(_DEBUG)
+    // Frame counter in title bar, formatted without allocating.
+    auto title = FixedWString<32>();
+    title.AppendNumber(mLoopStats.frames);
+    SetWindowTextW(Handle(), title.c_str());
+#endif
 }
 
 auto ImpulseApp::OnResize (UINT32 width, UINT32 height) -> void
@@ -885,31 +1084,65 @@ auto ImpulseApp::OnResize (UINT32 width, UINT32 height) -> void
 
     if (mD2DDeviceContext)
     {
-        CalculateLayout();
+        UpdateLayout();
         Redraw();
 
         Draw();
     }
 }
 
+auto ImpulseApp::OnDeviceLost () -> void
+{
+    // Only GPU resources are dropped, widgets, settings and timer stay alive.
+    mWidgets.DiscardDeviceResources();
+}
+
+auto ImpulseApp::OnDeviceRestored () -> void
+{
+    if (!mWidgets.CreateDeviceResources(mD2DDeviceContext.Get()))
+    {
+        spdlog::error("Failed to recreate device resources");
+    }
+}
+
 auto ImpulseApp::CustomMessageHandler (UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT
 {
+    // Registered message, can't be a case label.
+    if (message == mTaskbarCreatedMessage && message != 0)
+    {
+        mDisplayInfo->Invalidate();
+        return 0;
+    }
+
     switch (message)
     {
+    case WM_DISPLAYCHANGE:
+        mDisplayInfo->Invalidate();
+        return 0;
+
+    case WM_SETTINGCHANGE:
+        // Work area changes when taskbar moves or resizes.
+        if (wParam == SPI_SETWORKAREA)
+        {
+            mDisplayInfo->Invalidate();
+        }
+        break;
+
     case WM_IMPULSE_REDRAW:
         Redraw();
         return 0;
 
-    case WM_IMPULSE_START_WORK_SHIFT:
-        ImpulseStartWork();
+    case WM_IMPULSE_TIMEOUT:
+        mEngine->Handle(PomodoroEvent::Timeout);
         return 0;
 
-    case WM_IMPULSE_START_LONG_BREAK:
-        ImpulseStartLongBreak();
+    case WM_IMPULSE_SETTINGS_CHANGED:
+        mSettingsChanged = false;
+        ReloadSettings();
         return 0;
 
-    case WM_IMPULSE_START_SHORT_BREAK:
-        ImpulseStartShortBreak();
+    case WM_IMPULSE_TASKS_IMPORTED:
+        TasksImported();
         return 0;
     }
 
@@ -943,15 +1176,49 @@ auto ImpulseApp::Init (HINSTANCE hInstance) -> bool
                 return false;
             }
         }
+
+        ConfigureEngine();
+    }
+
+    // Open session history, app works without it.
+    {
+        MigrateHistory(mHistoryDirectory);
+
+        auto historyDesc      = HistoryJournal::Desc();
+        historyDesc.directory = mHistoryDirectory;
+
+        mHistory = HistoryJournal::Open(historyDesc);
+        if (!mHistory)
+        {
+            spdlog::warn("Session history is not available");
+        }
+        else
+        {
+            auto compactorDesc      = HistoryCompactor::Desc();
+            compactorDesc.directory = mHistoryDirectory;
+
+            mCompactor = HistoryCompactor::Open(compactorDesc);
+
+            // Called on journal writer thread, compactor only gets woken.
+            mHistory->OnRotate = [compactor = mCompactor.get()]
+            {
+                compactor->Request();
+            };
+
+            LoadStats();
+        }
     }
 
+    // Explorer broadcasts it when taskbar is (re)created.
+    mTaskbarCreatedMessage = RegisterWindowMessageW(L"TaskbarCreated");
+
     // Create window.
     const auto originalWidth  = 450.f;
     const auto originalHeight = 330.f;
     const auto windowPadding  = 20.f;
 
-    auto [position, size] = CalculateWindowPositionAndSize(
-        mSettings->WindowPosition, originalWidth, originalHeight, windowPadding, GetDpi()
+    const auto placement = CalculateWindowPlacement(
+        mSettings->WindowPosition, mDisplayInfo->Geometry(), originalWidth, originalHeight, windowPadding, GetDpi()
     );
 
     auto wndDesc           = Window::Desc{0};
@@ -959,8 +1226,8 @@ auto ImpulseApp::Init (HINSTANCE hInstance) -> bool
     wndDesc.className      = L"Impulse_WndClass";
     wndDesc.exstyle        = WS_EX_TOOLWINDOW | WS_EX_TOPMOST;
     wndDesc.invisible      = false;
-    wndDesc.position       = position;
-    wndDesc.size           = size;
+    wndDesc.position       = D2D1::Point2L(placement.x, placement.y);
+    wndDesc.size           = D2D1::SizeU(placement.width, placement.height);
     wndDesc.instanceHandle = hInstance;
     wndDesc.parentHandle   = nullptr;
 
@@ -981,20 +1248,26 @@ auto ImpulseApp::Init (HINSTANCE hInstance) -> bool
     }
 
     CreateGraphicsResources();
-    
-    mInitialzied = true;
 
+    // Watch settings file for edits, app works without it.
+    if (auto watcher = FileWatcher::Create(mSettingsFilePath))
     {
-        auto [position, size] = CalculateWindowPositionAndSize(
-            mSettings->WindowPosition, originalWidth, originalHeight, windowPadding, GetDpi()
-        );
-    
-        SetWindowPos(
-            Handle(), HWND_TOP, position.x, position.y, size.width, size.height, SWP_NOACTIVATE
-        );
+        watcher->OnChange = [this]
+        {
+            // !!! This is called from other thread !!!
+            ParseChangedSettings();
+        };
+        watcher->Start();
+
+        mSettingsWatcher = std::move(watcher);
     }
+    
+    mInitialzied = true;
+
+    mPointer.FrameInterval(DisplayFrameInterval(Handle()));
 
-    CalculateLayout();
+    PlaceWindow();
+    UpdateLayout();
     Redraw();
     
     spdlog::info("Initialization finished");
@@ -1004,7 +1277,29 @@ auto ImpulseApp::Init (HINSTANCE hInstance) -> bool
 
 auto ImpulseApp::Release () -> void
 {
+    spdlog::debug(
+        "Pointer stats: {} moves, {} resolved, {} hit tests",
+        mPointer.Moves(), mPointer.Resolved(), mWidgets.HitTests()
+    );
+
+    // Our last save must not come back as a reload.
+    mSettingsWatcher.reset();
+
+    // Import still running is waited for, its tasks go into last save.
+    TasksImported();
+
+    // Window is gone, waiting for last writes doesn't freeze anything.
+    if (mHistory)
+    {
+        mHistory->Commit();
+        mStatsWriter->Flush();
+    }
+
     SaveSettings();
+    if (mSettingsWriter->Flush())
+    {
+        spdlog::info("Saved Settings '{}'", mSettingsFilePath.string());
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
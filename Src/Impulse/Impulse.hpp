@@ -1,14 +1,30 @@
 #pragma once
 
 #include "D2DApp.hpp"
+#include "DebouncedWriter.hpp"
+#include "DisplayInfo.hpp"
+#include "FileWatcher.hpp"
+#include "HistoryCompactor.hpp"
+#include "HistoryExporter.hpp"
+#include "HistoryJournal.hpp"
+#include "HistoryStats.hpp"
+#include "MainLayout.hpp"
+#include "PointerCoalescer.hpp"
+#include "PomodoroEngine.hpp"
 #include "Settings.hpp"
+#include "TaskImporter.hpp"
+#include "TaskStore.hpp"
 #include "Timer.hpp"
 
 #include "Widgets/Button.hpp"
 #include "Widgets/StaticText.hpp"
+#include "Widgets/TaskList.hpp"
 #include "Widgets/Clock.hpp"
+#include "Widgets/WidgetTree.hpp"
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 
 namespace {
     using namespace Impulse::Widgets;
@@ -20,10 +36,10 @@ namespace Impulse
 
 class ImpulseApp : public D2DApp
 {
-    static constexpr auto WM_IMPULSE_REDRAW            = WM_USER + 1;
-    static constexpr auto WM_IMPULSE_START_WORK_SHIFT  = WM_USER + 2;
-    static constexpr auto WM_IMPULSE_START_LONG_BREAK  = WM_USER + 3;
-    static constexpr auto WM_IMPULSE_START_SHORT_BREAK = WM_USER + 4;
+    static constexpr auto WM_IMPULSE_REDRAW           = WM_USER + 1;
+    static constexpr auto WM_IMPULSE_TIMEOUT          = WM_USER + 2;
+    static constexpr auto WM_IMPULSE_SETTINGS_CHANGED = WM_USER + 3;
+    static constexpr auto WM_IMPULSE_TASKS_IMPORTED   = WM_USER + 4;
 
     bool                         mInitialzied = false;
 
@@ -34,78 +50,166 @@ class ImpulseApp : public D2DApp
     std::unique_ptr<Clock>       mClockWidget;
     std::unique_ptr<StaticText>  mStaticImpulseState;
     std::unique_ptr<StaticText>  mStaticCurrentTask;
+    std::unique_ptr<TaskList>    mTaskList;
 
-    Widget*                      mClickedWidget = nullptr;
-    Widget*                      mHoveredWidget = nullptr;
+    // Draw order and input dispatch.
+    WidgetTree                   mWidgets;
+    PointerCoalescer             mPointer;
+
+    std::unique_ptr<MainLayout>  mLayout;
+    float                        mFontScale = 0.0f;
                                           
     fs::path                     mSettingsFilePath;
     std::shared_ptr<Settings>    mSettings;      
+    std::unique_ptr<DebouncedWriter> mSettingsWriter;
+
+    // Edits of settings file are applied while running. Watcher thread
+    // reads and parses the file, UI thread only applies latest result. Flag
+    // keeps burst of change notifications from queueing more than one reload.
+    struct ReloadedSettings
+    {
+        Settings  settings;
+        TaskStore tasks;
+    };
+
+    std::unique_ptr<FileWatcher> mSettingsWatcher;
+    std::atomic<bool>            mSettingsChanged = false;
+    std::mutex                   mReloadedMutex;
+    std::unique_ptr<ReloadedSettings> mReloaded;
     std::shared_ptr<Timer>       mTimer;
 
+    // Pomodoro state, touched only on UI thread.
+    std::shared_ptr<PomodoroEngine> mEngine;
+
+    // Never modified once created, changes replace it as a whole. Task list,
+    // settings writer and import share it without copying.
+    std::shared_ptr<const TaskStore> mTaskStore;
+
+    // Every engine transition is journaled, duration is measured from the
+    // previous one. Compactor goes after journal, which calls it on rotation.
+    fs::path                     mHistoryDirectory;
+    std::unique_ptr<HistoryCompactor> mCompactor;
+    std::unique_ptr<HistoryJournal> mHistory;
+    int64_t                      mLastTransitionTime = 0;
+
+    // Focus totals kept up to date with journal, stats never rescan it.
+    fs::path                     mStatsFilePath;
+    HistoryStats                 mStats;
+    std::unique_ptr<DebouncedWriter> mStatsWriter;
+
+    // Running or last finished export, one at a time.
+    std::unique_ptr<HistoryExporter> mExporter;
+
+    // Running import, one at a time. Its tasks are appended once it posts
+    // WM_IMPULSE_TASKS_IMPORTED.
+    std::unique_ptr<TaskImport>  mImport;
+
+    // Monitor and taskbar geometry, queried again only after display or
+    // taskbar change.
+    std::unique_ptr<DisplayInfo> mDisplayInfo;
+    UINT                         mTaskbarCreatedMessage = 0;
+
     auto CreateGraphicsResources  () -> bool;    
     auto DiscardGraphicsResources () -> void;
 
-    auto CalculateLayout          () -> void;
+    // Layout tree is built once, UpdateLayout() only re-lays-out what changed.
+    auto CreateLayout    () -> void;
+    auto UpdateLayout    () -> void;
+    auto UpdateFontSizes (float scale) -> void;
+    auto PlaceWindow     () -> void;
+
+    // Hover is resolved once per frame at latest pointer position.
+    auto ResolvePointer  () -> void;
     
     // Create methods.
     auto CreateButtons    () -> bool;
     auto CreateTimer      () -> bool;
     auto CreateStaticText () -> bool;
-
-    // Draw methods.
-    auto DrawButtons     () -> void;
-    auto DrawTimer       () -> void;
-    auto DrawStaticTexts () -> void;
-
-    // Get widget that is hit by @point.
-    auto HitTest (D2D_POINT_2F point) -> Widget*;
+    auto CreateTaskList   () -> bool;
 
     // Events (NOTE: Timer events are called from other thread).
     auto Timer_Tick           () -> void;
     auto Timer_Timeout        () -> void;
+    auto Engine_Transition    (ImpulseState from, ImpulseState to) -> void;
+    auto RecordTransition     (ImpulseState from, ImpulseState to) -> void;
     auto ButtonClose_Click    () -> void;
     auto ButtonSettings_Click () -> void;
     auto ButtonPause_Click    () -> void;
     auto ButtonInfo_Click     () -> void;
+    auto StaticTask_Click     () -> void;
+    auto TaskList_Click       () -> void;
 
     // Update.
     auto UpdatePauseButton () -> void;
     auto UpdateTaskStatic  () -> void;
+    auto SelectCurrentTask () -> void;
+    auto ReplaceTasks      (std::shared_ptr<const TaskStore> tasks) -> void;
     auto UpdateStateStatic () -> void;
 
-    // Manipulate state.
-    auto ImpulseStartWork       () -> void;
-    auto ImpulseStartShortBreak () -> void;
-    auto ImpulseStartLongBreak  () -> void;
-    auto ImpulsePauseClock      () -> void;
-    auto ImpulseInactive        () -> void;
+    // Durations from settings.
+    auto ConfigureEngine () -> void;
 
-    // Settings.
+    // Settings. Saving only queues a write, it never blocks on disk.
     auto LoadSettings () -> bool;
-    auto SaveSettings () -> bool;
+    auto SaveSettings () -> void;
+
+    // Settings file changed on disk, only fields that differ are applied.
+    auto ParseChangedSettings () -> void; // on watcher thread
+    auto ReloadSettings       () -> void;
+
+    // Statistics, loading catches up with records journaled after last save.
+    auto LoadStats    () -> void;
+    auto SaveStats    () -> void;
+
+    // Whole history next to settings file, runs in background.
+    auto ExportHistory (ExportFormat format) -> void;
+
+    // Tasks.csv or Tasks.txt next to settings file appended to task list,
+    // tasks already in it are skipped. Files are read and parsed in
+    // background, UI thread only appends the result.
+    auto ImportTasks   () -> void;
+    auto TasksImported () -> void;
 
     // Window callbacks.
     virtual auto OnClose      () -> void;
     virtual auto OnDpiChanged (float dpi) -> void;
 
+    virtual auto OnKeyDown    (UINT key) -> void;
+
     virtual auto OnMouseDown  (MouseButton button, int x, int y) -> void;
     virtual auto OnMouseUp    (MouseButton button, int x, int y) -> void;
     virtual auto OnMouseMove  (int x, int y)                     -> void;
+    virtual auto OnMouseWheel (float delta, int x, int y)        -> void;
 
+    virtual auto OnUpdate     () -> void;
+    virtual auto UpdateTime   () const -> AnimationClock::time_point;
     virtual auto OnDraw       () -> void;
     virtual auto OnResize     (UINT32 width, UINT32 height) -> void;
 
+    virtual auto OnDeviceLost     () -> void;
+    virtual auto OnDeviceRestored () -> void;
+
     virtual auto CustomMessageHandler (UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT;
 
 public:
     ImpulseApp ()
-        : mSettings (std::make_shared<Settings>())
-        , mTimer    (std::make_shared<Timer>())
+        : mSettings    (std::make_shared<Settings>())
+        , mTimer       (std::make_shared<Timer>())
+        , mEngine      (std::make_shared<PomodoroEngine>())
+        , mTaskStore   (std::make_shared<const TaskStore>())
+        , mDisplayInfo (std::make_unique<Win32DisplayInfo>())
     {
         auto appData = GetAppDataPath() / L"Impulse";
         fs::create_directory(appData);
     
         mSettingsFilePath = appData / "Impulse.json";
+        mHistoryDirectory = appData / "History";
+        mStatsFilePath    = appData / "Impulse.stats";
+
+        auto writerDesc = DebouncedWriter::Desc();
+        writerDesc.path = mSettingsFilePath;
+
+        mSettingsWriter = std::make_unique<DebouncedWriter>(writerDesc);
     }
     ~ImpulseApp () = default;
 
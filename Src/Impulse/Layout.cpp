@@ -0,0 +1,463 @@
+#include "Layout.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Clamp @value to [@min, @max], negative @max means unbounded.
+auto Constrain (float value, float min, float max) -> float
+{
+    if (max >= 0.0f)
+    {
+        value = std::min(value, max);
+    }
+
+    return std::max(value, min);
+}
+
+// Size and offset of node along one axis of its slot.
+auto AlignAxis (
+    Impulse::LayoutAlign align,
+    float                start,
+    float                space,
+    float                desired,
+    float                fixed,
+    float                min,
+    float                max
+) -> std::pair<float, float>
+{
+    auto size = desired;
+    if (align == Impulse::LayoutAlign::Stretch)
+    {
+        size = fixed >= 0.0f ? fixed : space;
+    }
+
+    size = std::max(Constrain(size, min, max), 0.0f);
+
+    switch (align)
+    {
+    case Impulse::LayoutAlign::Start:
+        return { start, size };
+
+    case Impulse::LayoutAlign::End:
+        return { start + space - size, size };
+
+    // Stretched node limited by its max size is centered.
+    case Impulse::LayoutAlign::Center:
+    case Impulse::LayoutAlign::Stretch:
+    default:
+        return { start + (space - size) / 2.0f, size };
+    }
+}
+
+}
+
+namespace Impulse {
+
+#pragma region LayoutNode
+
+////////////////////////////////////////////////////////////////////////////////
+
+auto LayoutNode::Root () -> LayoutNode*
+{
+    auto node = this;
+    while (node->mParent)
+    {
+        node = node->mParent;
+    }
+
+    return node;
+}
+
+auto LayoutNode::CountNodes () const -> size_t
+{
+    auto count = size_t(1);
+    for (auto& child : mChildren)
+    {
+        count += child->CountNodes();
+    }
+
+    return count;
+}
+
+auto LayoutNode::SaveNode (std::vector<LayoutSnapshot::Node>& nodes) const -> void
+{
+    nodes.push_back(LayoutSnapshot::Node{ mAvailable, mDesired, mSlot, mRect });
+
+    for (auto& child : mChildren)
+    {
+        child->SaveNode(nodes);
+    }
+}
+
+auto LayoutNode::RestoreNode (const std::vector<LayoutSnapshot::Node>& nodes, size_t& index) -> void
+{
+    const auto& node = nodes[index++];
+
+    mAvailable    = node.available;
+    mDesired      = node.desired;
+    mSlot         = node.slot;
+    mMeasureDirty = false;
+    mArrangeDirty = false;
+
+    if (node.rect != mRect || mApplyPending)
+    {
+        mRect         = node.rect;
+        mApplyPending = false;
+
+        Root()->mStats.applied += 1;
+        OnArrange(mRect);
+    }
+
+    for (auto& child : mChildren)
+    {
+        child->RestoreNode(nodes, index);
+    }
+}
+
+auto LayoutNode::MeasureOverride (LayoutSize available) -> LayoutSize
+{
+    auto desired = LayoutSize();
+    for (auto& child : mChildren)
+    {
+        const auto size = child->Measure(available);
+        desired.width  = std::max(desired.width, size.width);
+        desired.height = std::max(desired.height, size.height);
+    }
+
+    return desired;
+}
+
+auto LayoutNode::ArrangeOverride (const LayoutRect& rect) -> void
+{
+    for (auto& child : mChildren)
+    {
+        child->Arrange(rect);
+    }
+}
+
+auto LayoutNode::Size (float width, float height) -> void
+{
+    if (mSize != LayoutSize{ width, height })
+    {
+        mSize = { width, height };
+        InputChanged();
+        InvalidateMeasure();
+    }
+}
+
+auto LayoutNode::MinSize (float width, float height) -> void
+{
+    if (mMinSize != LayoutSize{ width, height })
+    {
+        mMinSize = { width, height };
+        InputChanged();
+        InvalidateMeasure();
+    }
+}
+
+auto LayoutNode::MaxSize (float width, float height) -> void
+{
+    if (mMaxSize != LayoutSize{ width, height })
+    {
+        mMaxSize = { width, height };
+        InputChanged();
+        InvalidateMeasure();
+    }
+}
+
+auto LayoutNode::Margin (float left, float top, float right, float bottom) -> void
+{
+    if (mMargin.left != left || mMargin.top != top || mMargin.right != right || mMargin.bottom != bottom)
+    {
+        mMargin = { left, top, right, bottom };
+        InputChanged();
+        InvalidateMeasure();
+    }
+}
+
+auto LayoutNode::Align (LayoutAlign horizontal, LayoutAlign vertical) -> void
+{
+    if (mHorizontalAlign != horizontal || mVerticalAlign != vertical)
+    {
+        mHorizontalAlign = horizontal;
+        mVerticalAlign   = vertical;
+        InputChanged();
+        InvalidateArrange();
+    }
+}
+
+auto LayoutNode::SetScale (float scale) -> void
+{
+    if (mScale == scale)
+    {
+        return;
+    }
+
+    mScale        = scale;
+    mMeasureDirty = true;
+    mArrangeDirty = true;
+    mApplyPending = true;
+
+    for (auto& child : mChildren)
+    {
+        child->SetScale(scale);
+    }
+
+    if (mParent)
+    {
+        mParent->InvalidateMeasure();
+    }
+}
+
+auto LayoutNode::Scaled (float value) const -> float
+{
+    return value < 0.0f ? value : std::ceil(value * mScale);
+}
+
+auto LayoutNode::InvalidateMeasure () -> void
+{
+    for (auto node = this; node; node = node->mParent)
+    {
+        node->mMeasureDirty = true;
+        node->mArrangeDirty = true;
+    }
+}
+
+auto LayoutNode::InvalidateArrange () -> void
+{
+    for (auto node = this; node; node = node->mParent)
+    {
+        node->mArrangeDirty = true;
+    }
+}
+
+auto LayoutNode::Measure (LayoutSize available) -> LayoutSize
+{
+    if (!mMeasureDirty && available == mAvailable)
+    {
+        return mDesired;
+    }
+
+    Root()->mStats.measured += 1;
+
+    const auto marginX = Scaled(mMargin.left) + Scaled(mMargin.right);
+    const auto marginY = Scaled(mMargin.top) + Scaled(mMargin.bottom);
+    const auto fixed   = LayoutSize{ Scaled(mSize.width), Scaled(mSize.height) };
+    const auto min     = LayoutSize{ Scaled(mMinSize.width), Scaled(mMinSize.height) };
+    const auto max     = LayoutSize{ Scaled(mMaxSize.width), Scaled(mMaxSize.height) };
+
+    // Fixed size limits space available to content.
+    auto inner = LayoutSize{
+        fixed.width  >= 0.0f ? fixed.width  : std::max(available.width - marginX, 0.0f),
+        fixed.height >= 0.0f ? fixed.height : std::max(available.height - marginY, 0.0f)
+    };
+    inner.width  = Constrain(inner.width, 0.0f, max.width);
+    inner.height = Constrain(inner.height, 0.0f, max.height);
+
+    const auto content = MeasureOverride(inner);
+
+    const auto width  = Constrain(fixed.width  >= 0.0f ? fixed.width  : content.width , min.width , max.width);
+    const auto height = Constrain(fixed.height >= 0.0f ? fixed.height : content.height, min.height, max.height);
+
+    const auto desired = LayoutSize{ width + marginX, height + marginY };
+    if (desired != mDesired)
+    {
+        // Slot may stay the same while node itself changed size.
+        mArrangeDirty = true;
+    }
+
+    mAvailable    = available;
+    mDesired      = desired;
+    mMeasureDirty = false;
+
+    return mDesired;
+}
+
+auto LayoutNode::Arrange (const LayoutRect& slot) -> void
+{
+    if (!mArrangeDirty && !mMeasureDirty && slot == mSlot)
+    {
+        return;
+    }
+
+    // Node invalidated after it was measured, measure it in the space it got.
+    if (mMeasureDirty)
+    {
+        Measure(LayoutSize{ slot.Width(), slot.Height() });
+    }
+
+    Root()->mStats.arranged += 1;
+
+    const auto left   = Scaled(mMargin.left);
+    const auto top    = Scaled(mMargin.top);
+    const auto right  = Scaled(mMargin.right);
+    const auto bottom = Scaled(mMargin.bottom);
+
+    const auto [x, width] = AlignAxis(
+        mHorizontalAlign,
+        slot.left + left,
+        std::max(slot.Width() - left - right, 0.0f),
+        mDesired.width - left - right,
+        Scaled(mSize.width),
+        Scaled(mMinSize.width),
+        Scaled(mMaxSize.width)
+    );
+
+    const auto [y, height] = AlignAxis(
+        mVerticalAlign,
+        slot.top + top,
+        std::max(slot.Height() - top - bottom, 0.0f),
+        mDesired.height - top - bottom,
+        Scaled(mSize.height),
+        Scaled(mMinSize.height),
+        Scaled(mMaxSize.height)
+    );
+
+    const auto rect = LayoutRect{ x, y, x + width, y + height };
+
+    mSlot         = slot;
+    mArrangeDirty = false;
+
+    if (rect != mRect || mApplyPending)
+    {
+        mRect         = rect;
+        mApplyPending = false;
+
+        Root()->mStats.applied += 1;
+        OnArrange(mRect);
+    }
+
+    ArrangeOverride(mRect);
+}
+
+auto LayoutNode::Update (LayoutSize size) -> void
+{
+    Measure(size);
+    Arrange(LayoutRect{ 0.0f, 0.0f, size.width, size.height });
+}
+
+auto LayoutNode::Save (LayoutSnapshot& snapshot) const -> bool
+{
+    if (mParent || mMeasureDirty || mArrangeDirty)
+    {
+        return false;
+    }
+
+    snapshot.generation = mGeneration;
+    snapshot.scale      = mScale;
+    snapshot.size       = LayoutSize{ mSlot.Width(), mSlot.Height() };
+    snapshot.nodes.clear();
+    SaveNode(snapshot.nodes);
+
+    return true;
+}
+
+auto LayoutNode::Restore (const LayoutSnapshot& snapshot, LayoutSize size) -> bool
+{
+    if (mParent
+    ||  snapshot.generation != mGeneration
+    ||  snapshot.scale      != mScale
+    ||  snapshot.size       != size
+    ||  snapshot.nodes.size() != CountNodes())
+    {
+        return false;
+    }
+
+    auto index = size_t(0);
+    RestoreNode(snapshot.nodes, index);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma endregion
+
+#pragma region CenterLayout
+
+////////////////////////////////////////////////////////////////////////////////
+
+auto CenterLayout::ArrangeOverride (const LayoutRect& rect) -> void
+{
+    for (auto& child : Children())
+    {
+        const auto desired = child->Desired();
+        const auto x       = rect.CenterX() - desired.width / 2.0f;
+        const auto y       = rect.CenterY() - desired.height / 2.0f;
+
+        child->Arrange(LayoutRect{ x, y, x + desired.width, y + desired.height });
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma endregion
+
+#pragma region StackLayout
+
+////////////////////////////////////////////////////////////////////////////////
+
+auto StackLayout::MeasureOverride (LayoutSize available) -> LayoutSize
+{
+    const auto unbounded = std::numeric_limits<float>::infinity();
+    const auto spacing   = Scaled(mSpacing);
+    const auto vertical  = mOrientation == LayoutOrientation::Vertical;
+
+    auto desired = LayoutSize();
+    auto first   = true;
+    for (auto& child : Children())
+    {
+        // Children get all the space across the stack, along it they take
+        // only what they need.
+        const auto size = child->Measure(
+            vertical ? LayoutSize{ available.width, unbounded } : LayoutSize{ unbounded, available.height }
+        );
+
+        const auto gap = first ? 0.0f : spacing;
+        first = false;
+
+        if (vertical)
+        {
+            desired.width   = std::max(desired.width, size.width);
+            desired.height += gap + size.height;
+        }
+        else
+        {
+            desired.width  += gap + size.width;
+            desired.height  = std::max(desired.height, size.height);
+        }
+    }
+
+    return desired;
+}
+
+auto StackLayout::ArrangeOverride (const LayoutRect& rect) -> void
+{
+    const auto spacing  = Scaled(mSpacing);
+    const auto vertical = mOrientation == LayoutOrientation::Vertical;
+
+    auto offset = vertical ? rect.top : rect.left;
+    for (auto& child : Children())
+    {
+        const auto desired = child->Desired();
+        if (vertical)
+        {
+            child->Arrange(LayoutRect{ rect.left, offset, rect.right, offset + desired.height });
+            offset += desired.height + spacing;
+        }
+        else
+        {
+            child->Arrange(LayoutRect{ offset, rect.top, offset + desired.width, rect.bottom });
+            offset += desired.width + spacing;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma endregion
+
+} // namespace Impulse
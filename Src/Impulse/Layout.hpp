@@ -0,0 +1,251 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Impulse {
+
+struct LayoutSize
+{
+    float width  = 0.0f;
+    float height = 0.0f;
+
+    auto operator== (const LayoutSize& other) const
+    {
+        return width == other.width && height == other.height;
+    }
+    auto operator!= (const LayoutSize& other) const { return !(*this == other); }
+};
+
+struct LayoutRect
+{
+    float left   = 0.0f;
+    float top    = 0.0f;
+    float right  = 0.0f;
+    float bottom = 0.0f;
+
+    auto Width   () const { return right - left; }
+    auto Height  () const { return bottom - top; }
+    auto CenterX () const { return (left + right) / 2.0f; }
+    auto CenterY () const { return (top + bottom) / 2.0f; }
+
+    auto operator== (const LayoutRect& other) const
+    {
+        return left == other.left && top == other.top
+            && right == other.right && bottom == other.bottom;
+    }
+    auto operator!= (const LayoutRect& other) const { return !(*this == other); }
+};
+
+struct LayoutThickness
+{
+    float left   = 0.0f;
+    float top    = 0.0f;
+    float right  = 0.0f;
+    float bottom = 0.0f;
+};
+
+// How node is placed inside the slot given by its parent.
+enum class LayoutAlign : unsigned char
+{
+    Start,
+    Center,
+    End,
+    Stretch
+};
+
+enum class LayoutOrientation : unsigned char
+{
+    Horizontal,
+    Vertical
+};
+
+// Layout work done since last ResetStats(), used to measure live resize cost.
+struct LayoutStats
+{
+    uint64_t measured = 0; // nodes actually measured (cache misses)
+    uint64_t arranged = 0; // nodes actually arranged (cache misses)
+    uint64_t applied  = 0; // OnArrange callbacks, i.e. widgets moved
+};
+
+// Results of whole tree for one scale and size, see LayoutNode::Save().
+struct LayoutSnapshot
+{
+    struct Node
+    {
+        LayoutSize available = LayoutSize();
+        LayoutSize desired   = LayoutSize();
+        LayoutRect slot      = LayoutRect();
+        LayoutRect rect      = LayoutRect();
+    };
+
+    uint64_t          generation = 0;
+    float             scale      = 0.0f;
+    LayoutSize        size       = LayoutSize();
+    std::vector<Node> nodes;     // pre-order
+};
+
+// Node of layout tree. Sizes, margins and spacing are given in 96 dpi units
+// and scaled (rounded up, like the rest of the UI) by tree scale.
+//
+// Measure and Arrange results are cached per node. Changing node inputs
+// invalidates it and its ancestors, subtrees with unchanged inputs are
+// skipped, so resizing window only touches nodes whose slot changed.
+class LayoutNode
+{
+public:
+    static constexpr auto AUTO = -1.0f;
+
+private:
+    LayoutNode*                              mParent          = nullptr;
+    std::vector<std::unique_ptr<LayoutNode>> mChildren;
+
+    // Inputs.
+    LayoutSize                               mSize            = { AUTO, AUTO };
+    LayoutSize                               mMinSize         = { 0.0f, 0.0f };
+    LayoutSize                               mMaxSize         = { AUTO, AUTO };
+    LayoutThickness                          mMargin          = LayoutThickness();
+    LayoutAlign                              mHorizontalAlign = LayoutAlign::Stretch;
+    LayoutAlign                              mVerticalAlign   = LayoutAlign::Stretch;
+    float                                    mScale           = 1.0f;
+
+    // Cache.
+    bool                                     mMeasureDirty    = true;
+    bool                                     mArrangeDirty    = true;
+    bool                                     mApplyPending    = true;
+    LayoutSize                               mAvailable       = LayoutSize();
+    LayoutSize                               mDesired         = LayoutSize();
+    LayoutRect                               mSlot            = LayoutRect();
+    LayoutRect                               mRect            = LayoutRect();
+    LayoutStats                              mStats           = LayoutStats();
+    uint64_t                                 mGeneration      = 0; // root only, bumped on input change
+
+    LayoutNode            (const LayoutNode&) = delete;
+    LayoutNode& operator= (const LayoutNode&) = delete;
+
+    auto Root () -> LayoutNode*;
+
+    // Input of some node changed, snapshots taken before are stale.
+    auto InputChanged () -> void { Root()->mGeneration += 1; }
+
+    auto CountNodes  () const -> size_t;
+    auto SaveNode    (std::vector<LayoutSnapshot::Node>& nodes) const -> void;
+    auto RestoreNode (const std::vector<LayoutSnapshot::Node>& nodes, size_t& index) -> void;
+
+protected:
+    // Desired size of content (without margin) within @available space.
+    virtual auto MeasureOverride (LayoutSize available) -> LayoutSize;
+
+    // Place children inside @rect (content rect of this node).
+    virtual auto ArrangeOverride (const LayoutRect& rect) -> void;
+
+    auto Children () const -> const std::vector<std::unique_ptr<LayoutNode>>& { return mChildren; }
+
+public:
+    // Called when node rect changed, that's where widgets are moved.
+    std::function<void (const LayoutRect& rect)> OnArrange = [](const LayoutRect&){};
+
+public:
+    LayoutNode () = default;
+    virtual ~LayoutNode () = default;
+
+    template <typename T = LayoutNode>
+    auto Add (std::unique_ptr<T> child) -> T*
+    {
+        auto node = child.get();
+        node->mParent = this;
+        node->SetScale(mScale);
+        mChildren.push_back(std::move(child));
+        InputChanged();
+        InvalidateMeasure();
+
+        return node;
+    }
+
+    template <typename T = LayoutNode, typename... Args>
+    auto Emplace (Args&&... args) -> T*
+    {
+        return Add(std::make_unique<T>(std::forward<Args>(args)...));
+    }
+
+    // Inputs, each invalidates node when value changes.
+    auto Size    (float width, float height)                        -> void;
+    auto MinSize (float width, float height)                        -> void;
+    auto MaxSize (float width, float height)                        -> void;
+    auto Margin  (float left, float top, float right, float bottom) -> void;
+    auto Margin  (float margin)                                     -> void { Margin(margin, margin, margin, margin); }
+    auto Align   (LayoutAlign horizontal, LayoutAlign vertical)     -> void;
+
+    // Set scale of whole subtree (dpi / 96).
+    auto SetScale (float scale) -> void;
+    auto Scale    () const { return mScale; }
+
+    // Value in 96 dpi units scaled to current dpi.
+    auto Scaled (float value) const -> float;
+
+    auto InvalidateMeasure () -> void;
+    auto InvalidateArrange () -> void;
+
+    // Measure within @available space (margin included), returns desired
+    // size including margin.
+    auto Measure (LayoutSize available) -> LayoutSize;
+
+    // Place node in @slot given by parent.
+    auto Arrange (const LayoutRect& slot) -> void;
+
+    // Measure and arrange whole tree to fill @size.
+    auto Update (LayoutSize size) -> void;
+
+    // Keep results of last Update() / bring them back without measuring and
+    // arranging. Restore fails when scale, @size or any input differs from
+    // the time snapshot was saved. Call on root only.
+    auto Save    (LayoutSnapshot& snapshot) const -> bool;
+    auto Restore (const LayoutSnapshot& snapshot, LayoutSize size) -> bool;
+
+    auto Parent  () const { return mParent; }
+    auto Desired () const { return mDesired; }
+    auto Rect    () const { return mRect; }
+
+    // Counters are kept in root node.
+    auto Stats      () const { return mStats; }
+    auto ResetStats ()       { mStats = LayoutStats(); }
+};
+
+// Children are placed over each other, each one aligned inside the whole
+// node by its own alignment and margin.
+class AnchorLayout : public LayoutNode
+{
+};
+
+// Children are centered, their alignment is ignored.
+class CenterLayout : public LayoutNode
+{
+protected:
+    virtual auto ArrangeOverride (const LayoutRect& rect) -> void override;
+};
+
+// Children are placed one after another.
+class StackLayout : public LayoutNode
+{
+    LayoutOrientation mOrientation = LayoutOrientation::Vertical;
+    float             mSpacing     = 0.0f;
+
+protected:
+    virtual auto MeasureOverride (LayoutSize available)   -> LayoutSize override;
+    virtual auto ArrangeOverride (const LayoutRect& rect) -> void override;
+
+public:
+    StackLayout (LayoutOrientation orientation = LayoutOrientation::Vertical, float spacing = 0.0f)
+        : mOrientation (orientation)
+        , mSpacing     (spacing)
+    {
+    }
+
+    auto Orientation () const { return mOrientation; }
+    auto Spacing     () const { return mSpacing; }
+};
+
+} // namespace Impulse
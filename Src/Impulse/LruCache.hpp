@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Impulse {
+
+// Small bounded cache, least recently used entry is evicted when full.
+// Meant for a handful of entries (one per dpi the window has been on), so
+// lookup is a linear scan over contiguous storage, no hashing or list nodes.
+template <typename Key, typename Value>
+class LruCache
+{
+    struct Entry
+    {
+        Key      key;
+        Value    value;
+        uint64_t lastUse = 0;
+    };
+
+    std::vector<Entry> mEntries;
+    size_t             mCapacity  = 0;
+    uint64_t           mClock     = 0;
+
+    uint64_t           mHits      = 0;
+    uint64_t           mMisses    = 0;
+    uint64_t           mEvictions = 0;
+
+public:
+    explicit LruCache (size_t capacity = 4)
+        : mCapacity (capacity > 0 ? capacity : 1)
+    {
+        mEntries.reserve(mCapacity);
+    }
+
+    // Cached value for @key or nullptr. Pointer is valid until next Insert().
+    auto Find (const Key& key) -> Value*
+    {
+        for (auto& entry : mEntries)
+        {
+            if (entry.key == key)
+            {
+                entry.lastUse = ++mClock;
+                mHits += 1;
+                return &entry.value;
+            }
+        }
+
+        mMisses += 1;
+        return nullptr;
+    }
+
+    // Store @value under @key, replacing existing one. When cache is full
+    // least recently used entry makes room.
+    auto Insert (const Key& key, Value value) -> Value&
+    {
+        for (auto& entry : mEntries)
+        {
+            if (entry.key == key)
+            {
+                entry.value   = std::move(value);
+                entry.lastUse = ++mClock;
+                return entry.value;
+            }
+        }
+
+        if (mEntries.size() < mCapacity)
+        {
+            mEntries.push_back(Entry{ key, std::move(value), ++mClock });
+            return mEntries.back().value;
+        }
+
+        auto oldest = &mEntries.front();
+        for (auto& entry : mEntries)
+        {
+            if (entry.lastUse < oldest->lastUse)
+            {
+                oldest = &entry;
+            }
+        }
+
+        mEvictions += 1;
+
+        oldest->key     = key;
+        oldest->value   = std::move(value);
+        oldest->lastUse = ++mClock;
+
+        return oldest->value;
+    }
+
+    auto Clear () -> void { mEntries.clear(); }
+
+    auto Size      () const { return mEntries.size(); }
+    auto Capacity  () const { return mCapacity; }
+    auto Hits      () const { return mHits; }
+    auto Misses    () const { return mMisses; }
+    auto Evictions () const { return mEvictions; }
+};
+
+} // namespace Impulse
@@ -1,15 +1,61 @@
 #include "PCH.hpp"
 
+#include "AsyncLogSink.hpp"
 #include "Impulse.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
 #include <memory>
 
 #include <spdlog/spdlog.h>
+#include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/msvc_sink.h>
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+namespace {
+
+// Messages still queued when process dies are written by handlers below.
+Impulse::AsyncLogSink*       gLogSink        = nullptr;
+LPTOP_LEVEL_EXCEPTION_FILTER gPreviousFilter = nullptr;
+
+// Heap may be what broke, last message is formatted on stack and handed to
+// sink directly, bypassing logger's own formatting buffer.
+auto LogCrash (spdlog::string_view_t text) -> void
+{
+    gLogSink->log(spdlog::details::log_msg("crash", spdlog::level::critical, text));
+    gLogSink->Drain();
+}
+
+auto WINAPI FlushLogOnCrash (EXCEPTION_POINTERS* exception) -> LONG
+{
+    if (gLogSink)
+    {
+        char text[64];
+        const auto result = fmt::format_to_n(
+            text, sizeof(text), "Unhandled exception {:#x}", exception->ExceptionRecord->ExceptionCode
+        );
+
+        LogCrash(spdlog::string_view_t(text, std::min(result.size, sizeof(text))));
+    }
+
+    return gPreviousFilter ? gPreviousFilter(exception) : EXCEPTION_CONTINUE_SEARCH;
+}
+
+auto FlushLogOnTerminate () -> void
+{
+    if (gLogSink)
+    {
+        LogCrash("std::terminate() called");
+    }
+
+    std::abort();
+}
+
+}
+
 auto WINAPI wWinMain (
     _In_     HINSTANCE hInstance,
     _In_opt_ HINSTANCE hPrevInstance,
@@ -17,19 +63,32 @@ auto WINAPI wWinMain (
     _In_     int       nShowCmd
 ) -> int
 {
-    // Init logger.
-    auto logger = spdlog::basic_logger_mt("file_logger", "Impulse.log", true);
+    // Init logger. Logging only queues the message, file is written on
+    // logger thread so UI and timer never wait for disk. When queue is
+    // full oldest messages go, what led to a crash is what matters.
+    auto logDesc     = Impulse::AsyncLogSink::Desc();
+    logDesc.overflow = Impulse::LogOverflow::DropOldest;
+
+#if defined(_DEBUG)
+    logDesc.sinks.push_back(std::make_shared<spdlog::sinks::windebug_sink_mt>());
+#else
+    logDesc.sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>("Impulse.log", true));
+#endif
+
+    const auto logSink = std::shared_ptr<Impulse::AsyncLogSink>(Impulse::AsyncLogSink::Start(std::move(logDesc)));
+    const auto logger  = std::make_shared<spdlog::logger>("file_logger", logSink);
+
     spdlog::set_default_logger(logger);
     spdlog::flush_on(spdlog::level::err);
 
 #if defined(_DEBUG)
-    auto msvcSink    = std::make_shared<spdlog::sinks::windebug_sink_mt>();
-    auto debugLogger = std::make_shared<spdlog::logger>("msvc_logger", msvcSink);
-
-    spdlog::set_default_logger(debugLogger);
     spdlog::set_level(spdlog::level::level_enum::debug);
 #endif
 
+    gLogSink        = logSink.get();
+    gPreviousFilter = SetUnhandledExceptionFilter(FlushLogOnCrash);
+    std::set_terminate(FlushLogOnTerminate);
+
     // Init ImpulseApp.
     auto impulse = Impulse::ImpulseApp();
     if (!impulse.Init(hInstance))
@@ -41,7 +100,13 @@ auto WINAPI wWinMain (
 
     impulse.Release();
 
-    logger->flush();
+    spdlog::info(
+        "Log messages: {} written, {} dropped, {} truncated",
+        logSink->Written(), logSink->Dropped(), logSink->Truncated()
+    );
+
+    // Later messages, from destructors, are written directly.
+    logSink->Stop();
 
     return ret;
 }
@@ -0,0 +1,105 @@
+#include "MainLayout.hpp"
+
+#include <algorithm>
+
+namespace Impulse {
+
+MainLayout::MainLayout (const Desc& desc)
+    : mRoot (std::make_unique<AnchorLayout>())
+{
+    // Nodes without a widget keep default callback.
+    const auto add = [&](const Place& place)
+    {
+        auto node = mRoot->Emplace<LayoutNode>();
+        if (place)
+        {
+            node->OnArrange = place;
+        }
+
+        return node;
+    };
+
+    // All sizes are in 96 dpi units, layout scales them.
+    const auto addButton = [&](const Place& place, LayoutAlign horizontal, LayoutAlign vertical)
+    {
+        auto node = add(place);
+        node->Size(32.f, 32.f);
+        node->Margin(5.f);
+        node->Align(horizontal, vertical);
+    };
+
+    addButton(desc.settingsButton, LayoutAlign::Start, LayoutAlign::Start);
+    addButton(desc.closeButton   , LayoutAlign::End  , LayoutAlign::Start);
+    addButton(desc.pauseButton   , LayoutAlign::Start, LayoutAlign::End);
+    addButton(desc.infoButton    , LayoutAlign::End  , LayoutAlign::End);
+
+    // Static texts between buttons.
+    const auto addStatic = [&](const Place& place, LayoutAlign vertical)
+    {
+        auto node = add(place);
+        node->Size(LayoutNode::AUTO, 32.f);
+        node->Margin(42.f, 5.f, 42.f, 5.f);
+        node->Align(LayoutAlign::Stretch, vertical);
+    };
+
+    addStatic(desc.stateText, LayoutAlign::Start);
+    addStatic(desc.taskText , LayoutAlign::End);
+
+    // Task list covers everything between the buttons.
+    {
+        auto node = add(desc.taskList);
+        node->Margin(42.f);
+    }
+
+    // Clock fills the rest, its texts are placed relative to the ring.
+    {
+        auto node = mRoot->Emplace<LayoutNode>();
+        node->Margin(55.f);
+        node->OnArrange = [node, place = desc.clock](const LayoutRect& rect)
+        {
+            auto clock = ClockPlacement();
+
+            clock.centerX     = rect.CenterX();
+            clock.centerY     = rect.CenterY();
+            clock.outerRadius = std::min(rect.Width(), rect.Height()) / 2.f;
+            clock.innerRadius = clock.outerRadius - node->Scaled(25.f);
+            clock.stroke      = node->Scaled(2.f);
+
+            const auto textHeight = node->Scaled(32.f);
+            const auto left       = clock.centerX - clock.outerRadius;
+            const auto right      = clock.centerX + clock.outerRadius;
+            const auto top        = clock.centerY - (clock.innerRadius / 2) - (textHeight / 2);
+            const auto bottom     = clock.centerY + (clock.innerRadius / 2) - (textHeight / 2);
+
+            clock.timerText  = LayoutRect{ left, clock.centerY - clock.outerRadius, right, clock.centerY + clock.outerRadius };
+            clock.topText    = LayoutRect{ left, top, right, top + textHeight };
+            clock.bottomText = LayoutRect{ left, bottom, right, bottom + textHeight };
+
+            if (place)
+            {
+                place(clock);
+            }
+        };
+    }
+}
+
+auto MainLayout::Update (LayoutSize size, float scale) -> bool
+{
+    mRoot->ResetStats();
+    mRoot->SetScale(scale);
+
+    auto snapshot = mSnapshots.Find(scale);
+    if (!snapshot || !mRoot->Restore(*snapshot, size))
+    {
+        mRoot->Update(size);
+
+        if (mRoot->Stats().arranged > 0)
+        {
+            mRoot->Save(snapshot ? *snapshot : mSnapshots.Insert(scale, LayoutSnapshot()));
+        }
+    }
+
+    return mRoot->Stats().applied > 0;
+}
+
+} // namespace Impulse
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Layout.hpp"
+#include "LruCache.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace Impulse {
+
+// Where clock and texts inside it go, derived from slot left for clock.
+struct ClockPlacement
+{
+    float      centerX     = 0.0f;
+    float      centerY     = 0.0f;
+    float      outerRadius = 0.0f;
+    float      innerRadius = 0.0f;
+    float      stroke      = 0.0f;
+
+    LayoutRect timerText   = LayoutRect(); // whole ring
+    LayoutRect topText     = LayoutRect(); // above center
+    LayoutRect bottomText  = LayoutRect(); // below center
+};
+
+// Layout of main window: buttons in corners, state and task texts between
+// them, task list and clock in the middle. Widgets are moved by callbacks,
+// tree doesn't know about Direct2D.
+//
+// Tree is built once. Update() re-lays-out only what changed, and results
+// at each dpi scale are kept, switching monitors back and forth restores
+// them instead of measuring again.
+class MainLayout
+{
+public:
+    using Place = std::function<void (const LayoutRect& rect)>;
+
+    struct Desc
+    {
+        Place settingsButton;
+        Place closeButton;
+        Place pauseButton;
+        Place infoButton;
+
+        Place stateText;
+        Place taskText;
+        Place taskList;
+
+        std::function<void (const ClockPlacement& clock)> clock;
+    };
+
+private:
+    std::unique_ptr<AnchorLayout>   mRoot;
+    LruCache<float, LayoutSnapshot> mSnapshots;
+
+public:
+    explicit MainLayout (const Desc& desc);
+
+    // Window client area of @size at dpi @scale, both in pixels. True when
+    // any widget was moved.
+    auto Update (LayoutSize size, float scale) -> bool;
+
+    // Work done by last Update().
+    auto Stats () const { return mRoot->Stats(); }
+};
+
+} // namespace Impulse
@@ -0,0 +1,167 @@
+#include "MappedFile.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+#include "Utility.hpp"
+#else
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse {
+
+#if defined(_WIN32)
+
+MappedFile::~MappedFile ()
+{
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+    }
+
+    if (mMapping)
+    {
+        CloseHandle(mMapping);
+    }
+
+    if (mFile && mFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFile);
+    }
+}
+
+auto MappedFile::Open (const std::filesystem::path& path) -> std::unique_ptr<MappedFile>
+{
+    auto mappedFile = std::make_unique<MappedFile>();
+
+    // Writer keeps appending while we read.
+    mappedFile->mFile = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (mappedFile->mFile == INVALID_HANDLE_VALUE)
+    {
+        spdlog::error("CreateFileW() failed for '{}': {}", path.string(), GetLastErrorMessage());
+        return nullptr;
+    }
+
+    auto size = LARGE_INTEGER{};
+    if (!GetFileSizeEx(mappedFile->mFile, &size))
+    {
+        spdlog::error("GetFileSizeEx() failed for '{}': {}", path.string(), GetLastErrorMessage());
+        return nullptr;
+    }
+
+    // Empty file can't be mapped, it is just empty view.
+    mappedFile->mSize = static_cast<uint64_t>(size.QuadPart);
+    if (mappedFile->mSize == 0)
+    {
+        return mappedFile;
+    }
+
+    mappedFile->mMapping = CreateFileMappingW(mappedFile->mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappedFile->mMapping)
+    {
+        spdlog::error("CreateFileMappingW() failed for '{}': {}", path.string(), GetLastErrorMessage());
+        return nullptr;
+    }
+
+    mappedFile->mData = static_cast<const uint8_t*>(
+        MapViewOfFile(mappedFile->mMapping, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(mappedFile->mSize))
+    );
+    if (!mappedFile->mData)
+    {
+        spdlog::error("MapViewOfFile() failed for '{}': {}", path.string(), GetLastErrorMessage());
+        return nullptr;
+    }
+
+    return mappedFile;
+}
+
+#else
+
+MappedFile::~MappedFile ()
+{
+    if (mData)
+    {
+        ::munmap(const_cast<uint8_t*>(mData), static_cast<size_t>(mSize));
+    }
+}
+
+auto MappedFile::Open (const std::filesystem::path& path) -> std::unique_ptr<MappedFile>
+{
+    auto mappedFile = std::make_unique<MappedFile>();
+
+    const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+    {
+        spdlog::error("open() failed for '{}': {}", path.string(), std::strerror(errno));
+        return nullptr;
+    }
+
+    struct stat status = {};
+    if (::fstat(file, &status) != 0)
+    {
+        spdlog::error("fstat() failed for '{}': {}", path.string(), std::strerror(errno));
+        ::close(file);
+        return nullptr;
+    }
+
+    // Empty file can't be mapped, it is just empty view.
+    mappedFile->mSize = static_cast<uint64_t>(status.st_size);
+    if (mappedFile->mSize == 0)
+    {
+        ::close(file);
+        return mappedFile;
+    }
+
+    // Mapping stays valid after descriptor is closed.
+    const auto data = ::mmap(nullptr, static_cast<size_t>(mappedFile->mSize), PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+
+    if (data == MAP_FAILED)
+    {
+        spdlog::error("mmap() failed for '{}': {}", path.string(), std::strerror(errno));
+        return nullptr;
+    }
+
+    mappedFile->mData = static_cast<const uint8_t*>(data);
+
+    return mappedFile;
+}
+
+#endif
+
+auto ReleaseMappedPages (const void* data, size_t size) -> void
+{
+#if defined(_WIN32)
+    // Unlocking pages that are not locked takes them out of working set.
+    VirtualUnlock(const_cast<void*>(data), size);
+#else
+    static const auto pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+
+    const auto first = (reinterpret_cast<uintptr_t>(data) + pageSize - 1) & ~(pageSize - 1);
+    const auto last  = (reinterpret_cast<uintptr_t>(data) + size) & ~(pageSize - 1);
+    if (first < last)
+    {
+        ::madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+    }
+#endif
+}
+
+} // namespace Impulse
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace Impulse {
+
+// Read-only view of a whole file. Pages are loaded by the OS on first
+// touch, so opening is cheap no matter how big the file is. Other
+// processes may keep writing the file; the view keeps size it had when
+// opened.
+class MappedFile
+{
+    void*          mFile    = nullptr; // Windows file and mapping handles
+    void*          mMapping = nullptr;
+    const uint8_t* mData    = nullptr;
+    uint64_t       mSize    = 0;
+
+    MappedFile            (const MappedFile& rhs) = delete;
+    MappedFile& operator= (const MappedFile& rhs) = delete;
+
+public:
+    MappedFile  () = default;
+    ~MappedFile ();
+
+    auto Data () const { return mData; }
+    auto Size () const { return mSize; }
+
+    static auto Open (const std::filesystem::path& path) -> std::unique_ptr<MappedFile>;
+};
+
+// Takes pages of mapped @data out of resident memory, they are loaded
+// again on next touch. Only whole pages inside range are released.
+auto ReleaseMappedPages (const void* data, size_t size) -> void;
+
+} // namespace Impulse
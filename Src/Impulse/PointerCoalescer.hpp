@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Impulse {
+
+// Collapses pointer moves between frames into the latest position. Hit
+// testing and hover resolution then run once per display frame no matter
+// how fast the mouse reports. Loop calls Update() on every wake up and
+// sleeps until UpdateTime() without waking for further moves. Buttons must
+// call Flush() before they are handled, so press and release see the
+// pointer where it really was.
+class PointerCoalescer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    bool              mPending    = false;
+    int               mX          = 0;
+    int               mY          = 0;
+    Clock::duration   mInterval   = std::chrono::microseconds(16667);
+    Clock::time_point mNextUpdate;
+    uint64_t          mMoves      = 0;
+    uint64_t          mResolved   = 0;
+
+public:
+    auto Move (int x, int y) -> void
+    {
+        mPending = true;
+        mX       = x;
+        mY       = y;
+        mMoves  += 1;
+    }
+
+    // Display refresh period, 60 Hz until set.
+    auto FrameInterval (Clock::duration interval) { mInterval = interval; }
+
+    // Resolve pending move if its frame has come, first move after a pause
+    // right away. Returns what @resolve returned, false otherwise.
+    template <typename Fn>
+    auto Update (Clock::time_point now, Fn&& resolve) -> bool
+    {
+        // Vsync paced loop wakes up around frame boundary, a bit early
+        // still counts.
+        if (!mPending || now + mInterval / 8 < mNextUpdate)
+        {
+            return false;
+        }
+
+        // Frames stay on one grid unless loop slept through some.
+        mNextUpdate = now < mNextUpdate + mInterval ? mNextUpdate + mInterval : now + mInterval;
+
+        return Flush(resolve);
+    }
+
+    // When pending move will be resolved by Update(). Moves that come
+    // before next frame wait for it too, so loop keeps sleeping through them
+    // even right after a resolve. max() when there is nothing to wait for.
+    auto UpdateTime (Clock::time_point now) const
+    {
+        return mPending || now < mNextUpdate ? mNextUpdate : Clock::time_point::max();
+    }
+
+    // Call @resolve(x, y) with latest position if there was a move since
+    // last flush. Returns what @resolve returned, false otherwise.
+    template <typename Fn>
+    auto Flush (Fn&& resolve) -> bool
+    {
+        if (!mPending)
+        {
+            return false;
+        }
+
+        mPending   = false;
+        mResolved += 1;
+
+        return resolve(mX, mY);
+    }
+
+    auto Discard () -> void { mPending = false; }
+
+    auto HasPending () const { return mPending; }
+    auto Moves      () const { return mMoves; }
+    auto Resolved   () const { return mResolved; }
+};
+
+} // namespace Impulse
@@ -0,0 +1,142 @@
+#include "PomodoroEngine.hpp"
+
+namespace Impulse {
+
+auto PomodoroNext (ImpulseState state, uint32_t workShiftCount, uint32_t longBreakAfter) -> PomodoroStep
+{
+    switch (state)
+    {
+    // Time for break.
+    case ImpulseState::WorkShift:
+        return PomodoroStep{
+            workShiftCount >= longBreakAfter ? ImpulseState::LongBreak : ImpulseState::ShortBreak,
+            workShiftCount
+        };
+
+    // Time for work.
+    case ImpulseState::ShortBreak:
+    case ImpulseState::LongBreak:
+        return PomodoroStep{
+            ImpulseState::WorkShift,
+            workShiftCount < longBreakAfter ? workShiftCount + 1 : 1
+        };
+
+    default:
+        return PomodoroStep{ state, workShiftCount };
+    }
+}
+
+auto PomodoroDuration (const PomodoroConfig& config, ImpulseState state) -> uint32_t
+{
+    switch (state)
+    {
+    case ImpulseState::ShortBreak:
+        return config.shortBreakDuration;
+
+    case ImpulseState::LongBreak:
+        return config.longBreakDuration;
+
+    case ImpulseState::Inactive:
+    case ImpulseState::WorkShift:
+    default:
+        return config.workDuration;
+    }
+}
+
+auto PomodoroEngine::Transition (ImpulseState state) -> void
+{
+    const auto from = mState;
+
+    mPreviousState = mState;
+    mState         = state;
+    mTransitions  += 1;
+
+    OnTransition(from, state);
+}
+
+auto PomodoroEngine::Configure (const PomodoroConfig& config) -> void
+{
+    mConfig = config;
+
+    // Don't leave count past the new limit, long break would never come.
+    if (mWorkShiftCount > mConfig.longBreakAfter)
+    {
+        mWorkShiftCount = 1;
+    }
+}
+
+auto PomodoroEngine::Handle (PomodoroEvent event) -> bool
+{
+    switch (event)
+    {
+    case PomodoroEvent::Start:
+        if (mState != ImpulseState::Inactive)
+        {
+            return false;
+        }
+
+        Transition(ImpulseState::WorkShift);
+        return true;
+
+    case PomodoroEvent::Pause:
+        if (!IsRunning())
+        {
+            return false;
+        }
+
+        Transition(ImpulseState::Paused);
+        return true;
+
+    case PomodoroEvent::Resume:
+        if (mState != ImpulseState::Paused)
+        {
+            return false;
+        }
+
+        Transition(mPreviousState);
+        return true;
+
+    case PomodoroEvent::Toggle:
+        switch (mState)
+        {
+        case ImpulseState::Inactive: return Handle(PomodoroEvent::Start);
+        case ImpulseState::Paused:   return Handle(PomodoroEvent::Resume);
+        default:                     return Handle(PomodoroEvent::Pause);
+        }
+
+    case PomodoroEvent::Timeout:
+    {
+        if (!IsRunning())
+        {
+            return false;
+        }
+
+        const auto next = PomodoroNext(mState, mWorkShiftCount, mConfig.longBreakAfter);
+
+        mWorkShiftCount = next.workShiftCount;
+        Transition(next.state);
+        return true;
+    }
+
+    case PomodoroEvent::Stop:
+        mWorkShiftCount = 1;
+        if (mState == ImpulseState::Inactive)
+        {
+            return false;
+        }
+
+        Transition(ImpulseState::Inactive);
+        return true;
+    }
+
+    return false;
+}
+
+auto PomodoroEngine::PhaseDuration () const -> std::chrono::seconds
+{
+    const auto state = (mState == ImpulseState::Paused) ? mPreviousState : mState;
+
+    return std::chrono::seconds(PomodoroDuration(mConfig, state));
+}
+
+} // namespace Impulse
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "ImpulseState.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace Impulse {
+
+// Durations are in seconds, like in Settings.
+struct PomodoroConfig
+{
+    uint32_t workDuration       = 25 * 60;
+    uint32_t shortBreakDuration = 5 * 60;
+    uint32_t longBreakDuration  = 15 * 60;
+    uint32_t longBreakAfter     = 4;
+};
+
+enum class PomodoroEvent : unsigned char
+{
+    Start,   // Inactive -> WorkShift
+    Pause,   // running phase -> Paused
+    Resume,  // Paused -> phase that was paused
+    Toggle,  // Start, Pause or Resume, whichever applies (pause button)
+    Timeout, // phase is over, go to next one
+    Stop     // anything -> Inactive, work shifts are counted from 1 again
+};
+
+// Phase that follows a finished one, with work shift count updated.
+struct PomodoroStep
+{
+    ImpulseState state          = ImpulseState::WorkShift;
+    uint32_t     workShiftCount = 1;
+};
+
+// Transition rules shared by PomodoroEngine and SessionHost. Only running
+// phases (WorkShift, ShortBreak, LongBreak) have a successor, others are
+// returned unchanged.
+auto PomodoroNext (ImpulseState state, uint32_t workShiftCount, uint32_t longBreakAfter) -> PomodoroStep;
+
+// Length of @state phase in seconds, Inactive counts as WorkShift.
+auto PomodoroDuration (const PomodoroConfig& config, ImpulseState state) -> uint32_t;
+
+// Pomodoro state machine. Knows nothing about timers, windows or threads,
+// it only moves between states on events. Owner feeds it events on one
+// thread and reacts to OnTransition (restart timer, update texts).
+//
+//     WorkShift --Timeout--> ShortBreak, or LongBreak after every
+//                            longBreakAfter work shifts
+//     ShortBreak/LongBreak --Timeout--> WorkShift (next one)
+class PomodoroEngine
+{
+    PomodoroConfig mConfig;
+    ImpulseState   mState          = ImpulseState::Inactive;
+    ImpulseState   mPreviousState  = ImpulseState::Inactive;
+    uint32_t       mWorkShiftCount = 1;
+    uint64_t       mTransitions    = 0;
+
+    auto Transition (ImpulseState state) -> void;
+
+public:
+    // Called after every state change with old and new state.
+    std::function<void (ImpulseState from, ImpulseState to)> OnTransition = [](ImpulseState, ImpulseState){};
+
+public:
+    explicit PomodoroEngine (const PomodoroConfig& config = PomodoroConfig())
+        : mConfig (config)
+    {
+    }
+
+    // New durations apply from next phase on.
+    auto Configure (const PomodoroConfig& config) -> void;
+
+    // Returns true when event caused transition, events that don't apply in
+    // current state are ignored.
+    auto Handle (PomodoroEvent event) -> bool;
+
+    auto State          () const { return mState; }
+    auto PreviousState  () const { return mPreviousState; }
+    auto WorkShiftCount () const { return mWorkShiftCount; }
+    auto Config         () const -> const PomodoroConfig& { return mConfig; }
+    auto Transitions    () const { return mTransitions; }
+
+    auto IsRunning () const
+    {
+        return mState == ImpulseState::WorkShift
+            || mState == ImpulseState::ShortBreak
+            || mState == ImpulseState::LongBreak
+            ;;
+    }
+
+    // Full length of current phase, paused phase counts as the one that was
+    // paused and inactive engine as a work shift.
+    auto PhaseDuration () const -> std::chrono::seconds;
+};
+
+} // namespace Impulse
@@ -0,0 +1,132 @@
+#include "ScheduleProjection.hpp"
+
+namespace Impulse {
+
+auto MakeScheduleCycle (const PomodoroConfig& config) -> ScheduleCycle
+{
+    const auto ms = [](uint32_t seconds) { return std::max<int64_t>(seconds, 1) * 1000; };
+
+    // Limit of 0 plays out like 1, every work shift ends in long break.
+    const auto longBreakAfter = std::max<uint32_t>(config.longBreakAfter, 1);
+
+    auto cycle = ScheduleCycle();
+
+    cycle.phases     = 2 * longBreakAfter;
+    cycle.work       = ms(config.workDuration);
+    cycle.shortBreak = ms(config.shortBreakDuration);
+    cycle.longBreak  = ms(config.longBreakDuration);
+    cycle.length     = longBreakAfter * cycle.work
+                     + (longBreakAfter - 1) * cycle.shortBreak
+                     + cycle.longBreak;
+
+    return cycle;
+}
+
+auto SchedulePhase (const ScheduleCycle& cycle, ImpulseState state, uint32_t workShiftCount) -> int64_t
+{
+    const auto shift = static_cast<int64_t>(std::clamp<uint32_t>(workShiftCount, 1, cycle.phases / 2)) - 1;
+
+    switch (state)
+    {
+    case ImpulseState::WorkShift:  return 2 * shift;
+    case ImpulseState::ShortBreak: return 2 * shift + 1;
+    case ImpulseState::LongBreak:  return cycle.phases - 1;
+    default:                       return -1;
+    }
+}
+
+ScheduleProjection::ScheduleProjection (
+    const PomodoroConfig& config,
+    ImpulseState          state,
+    uint32_t              workShiftCount,
+    Milliseconds          phaseEnd
+)
+    : mCycle     (MakeScheduleCycle(config))
+    , mNextStart (phaseEnd.count())
+{
+    mPhase = SchedulePhase(mCycle, state, workShiftCount);
+}
+
+auto ScheduleProjection::From (const PomodoroEngine& engine, Milliseconds phaseEnd) -> ScheduleProjection
+{
+    const auto state = (engine.State() == ImpulseState::Paused) ? engine.PreviousState() : engine.State();
+
+    return ScheduleProjection(engine.Config(), state, engine.WorkShiftCount(), phaseEnd);
+}
+
+auto ScheduleProjection::Phase (uint64_t phase) const -> ProjectedPhase
+{
+    const auto p     = static_cast<uint32_t>(phase % mCycle.phases);
+    const auto start = mNextStart
+                     + ScheduleOffset(mCycle, phase)
+                     - ScheduleOffset(mCycle, static_cast<uint64_t>(mPhase + 1));
+
+    auto state = ImpulseState::WorkShift;
+    if (p % 2 == 1)
+    {
+        state = (p == mCycle.phases - 1) ? ImpulseState::LongBreak : ImpulseState::ShortBreak;
+    }
+
+    return ProjectedPhase{ state, p / 2 + 1, Milliseconds(start) };
+}
+
+auto ScheduleProjection::Transition (uint64_t n) const -> ProjectedPhase
+{
+    return Phase(static_cast<uint64_t>(mPhase + 1) + n);
+}
+
+auto ScheduleProjection::Transitions (size_t count, std::vector<ProjectedPhase>& out) const -> void
+{
+    out.resize(count);
+    for (auto n = size_t(0); n < count; ++n)
+    {
+        out[n] = Transition(n);
+    }
+}
+
+auto ScheduleProjection::PhaseIndexAt (Milliseconds time) const -> int64_t
+{
+    if (time.count() < mNextStart)
+    {
+        return mPhase;
+    }
+
+    // Time since start of cycle 0, split into whole cycles and the rest.
+    const auto offset = time.count() - mNextStart + ScheduleOffset(mCycle, static_cast<uint64_t>(mPhase + 1));
+    const auto cycles = offset / mCycle.length;
+    const auto rest   = offset % mCycle.length;
+
+    // Cycle is L - 1 (work, short break) pairs followed by work and long
+    // break, last pair is found the same way as others.
+    const auto pair  = mCycle.work + mCycle.shortBreak;
+    const auto pairs = std::min<int64_t>(rest / pair, mCycle.phases / 2 - 1);
+    const auto p     = 2 * pairs + (rest - pairs * pair >= mCycle.work ? 1 : 0);
+
+    return cycles * mCycle.phases + p;
+}
+
+auto ScheduleProjection::PhaseAt (Milliseconds time) const -> ProjectedPhase
+{
+    const auto phase = PhaseIndexAt(time);
+    if (phase < 0)
+    {
+        return ProjectedPhase{ ImpulseState::Inactive, 1, time };
+    }
+
+    return Phase(static_cast<uint64_t>(phase));
+}
+
+auto ScheduleProjection::TransitionsUntil (Milliseconds time) const -> uint64_t
+{
+    return static_cast<uint64_t>(PhaseIndexAt(time) - mPhase);
+}
+
+auto ScheduleProjection::NextLongBreak () const -> Milliseconds
+{
+    const auto next  = static_cast<uint64_t>(mPhase + 1);
+    const auto phase = next + (mCycle.phases - 1 - next % mCycle.phases);
+
+    return Phase(phase).start;
+}
+
+} // namespace Impulse
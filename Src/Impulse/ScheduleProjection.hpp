@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ImpulseState.hpp"
+#include "PomodoroEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace Impulse {
+
+// Phase of a projected schedule and time it starts.
+struct ProjectedPhase
+{
+    ImpulseState              state          = ImpulseState::WorkShift;
+    uint32_t                  workShiftCount = 1;
+    std::chrono::milliseconds start          = std::chrono::milliseconds(0);
+};
+
+// Schedule repeats in cycles of 2 * longBreakAfter phases:
+//
+//     W1 S W2 S ... WL B
+//
+// Phase p of a cycle is work shift (p / 2 + 1) when even, break after it
+// when odd. Start of a phase is plain arithmetic, so any future time is
+// answered without stepping through transitions.
+struct ScheduleCycle
+{
+    uint32_t phases     = 8; // 2 * longBreakAfter
+    int64_t  work       = 0; // ms
+    int64_t  shortBreak = 0; // ms
+    int64_t  longBreak  = 0; // ms
+    int64_t  length     = 0; // ms, whole cycle
+};
+
+// Phases shorter than a second are stretched to one, like SessionHost does.
+auto MakeScheduleCycle (const PomodoroConfig& config) -> ScheduleCycle;
+
+// Time from start of cycle 0 to start of @phase, @phase may lie in any later
+// cycle. Branch free, meant to be called in loops over many sessions.
+inline auto ScheduleOffset (const ScheduleCycle& cycle, uint64_t phase) -> int64_t
+{
+    const auto cycles = static_cast<int64_t>(phase / cycle.phases);
+    const auto p      = static_cast<int64_t>(phase % cycle.phases);
+
+    return cycles * cycle.length + ((p + 1) / 2) * cycle.work + (p / 2) * cycle.shortBreak;
+}
+
+// Index of phase in cycle for @state, or -1 (before first work shift) for
+// Inactive.
+auto SchedulePhase (const ScheduleCycle& cycle, ImpulseState state, uint32_t workShiftCount) -> int64_t;
+
+// Future of one session, as PomodoroNext() would play it out with no more
+// pauses. Built from current phase and time it ends; pauses already taken
+// are part of that time. Paused session is projected from the phase that
+// was paused, ending remaining time after now.
+class ScheduleProjection
+{
+    using Milliseconds = std::chrono::milliseconds;
+
+    ScheduleCycle mCycle;
+    int64_t       mPhase     = -1; // current phase, counted from cycle 0
+    int64_t       mNextStart = 0;  // ms, when phase after it starts
+
+    auto Phase        (uint64_t phase)   const -> ProjectedPhase;
+    auto PhaseIndexAt (Milliseconds time) const -> int64_t;
+
+public:
+    ScheduleProjection () = default;
+
+    // @state is running phase (or Inactive, then @phaseEnd is when session
+    // would be started), @phaseEnd is when it ends.
+    ScheduleProjection (
+        const PomodoroConfig& config,
+        ImpulseState          state,
+        uint32_t              workShiftCount,
+        Milliseconds          phaseEnd
+    );
+
+    // Projection of @engine whose current phase ends at @phaseEnd.
+    static auto From (const PomodoroEngine& engine, Milliseconds phaseEnd) -> ScheduleProjection;
+
+    // @n-th transition from now on, 0 is end of current phase. O(1).
+    auto Transition (uint64_t n) const -> ProjectedPhase;
+
+    // Next @count transitions, @out is reused.
+    auto Transitions (size_t count, std::vector<ProjectedPhase>& out) const -> void;
+
+    // Phase running at @time, O(1). Before end of current phase that is
+    // current phase with nominal start (end minus full length).
+    auto PhaseAt (Milliseconds time) const -> ProjectedPhase;
+
+    // Number of transitions from now until @time, inclusive.
+    auto TransitionsUntil (Milliseconds time) const -> uint64_t;
+
+    // Start of next long break.
+    auto NextLongBreak () const -> Milliseconds;
+};
+
+} // namespace Impulse
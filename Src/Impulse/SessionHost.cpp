@@ -0,0 +1,373 @@
+#include "SessionHost.hpp"
+#include "ScheduleProjection.hpp"
+
+#include <algorithm>
+
+namespace Impulse {
+
+namespace {
+
+auto IsRunning (ImpulseState state) -> bool
+{
+    return state == ImpulseState::WorkShift
+        || state == ImpulseState::ShortBreak
+        || state == ImpulseState::LongBreak
+        ;;
+}
+
+} // namespace
+
+auto SessionHost::Later (const HeapEntry& a, const HeapEntry& b) -> bool
+{
+    // std heap functions build max-heap, inverted order puts earliest on top.
+    return a.at > b.at;
+}
+
+auto SessionHost::PhaseLength (SessionId id, ImpulseState state) const -> int64_t
+{
+    // Zero length phase would make Advance() spin forever.
+    const auto seconds = PomodoroDuration(Config(id), state);
+
+    return std::max<int64_t>(seconds, 1) * 1000;
+}
+
+auto SessionHost::Schedule (SessionId id, int64_t at) -> void
+{
+    mDeadline[id] = at;
+
+    mHeap.push_back(HeapEntry{ at, id, mGeneration[id] });
+    std::push_heap(mHeap.begin(), mHeap.end(), Later);
+}
+
+auto SessionHost::DropDeadline (SessionId id) -> void
+{
+    // Entry stays in heap, it no longer matches and is skipped when popped.
+    mGeneration[id] += 1;
+    mStale          += 1;
+
+    // Sessions pausing over and over would keep growing heap, sweep dead
+    // entries once they outnumber live ones.
+    if (mStale > 64 && mStale * 2 > mHeap.size())
+    {
+        const auto dead = [this](const HeapEntry& entry)
+        {
+            return entry.generation != mGeneration[entry.session];
+        };
+
+        mHeap.erase(std::remove_if(mHeap.begin(), mHeap.end(), dead), mHeap.end());
+        std::make_heap(mHeap.begin(), mHeap.end(), Later);
+        mStale = 0;
+    }
+}
+
+auto SessionHost::PopDeadline () -> HeapEntry
+{
+    std::pop_heap(mHeap.begin(), mHeap.end(), Later);
+    const auto entry = mHeap.back();
+    mHeap.pop_back();
+
+    if (entry.generation != mGeneration[entry.session])
+    {
+        mStale -= 1;
+    }
+
+    return entry;
+}
+
+auto SessionHost::UpdateCycle (SessionId id) -> void
+{
+    const auto cycle = MakeScheduleCycle(Config(id));
+
+    mCyclePhases[id]     = cycle.phases;
+    mCycleWork[id]       = cycle.work;
+    mCycleShortBreak[id] = cycle.shortBreak;
+    mCycleLength[id]     = cycle.length;
+}
+
+auto SessionHost::Transition (SessionId id, ImpulseState state, int64_t at) -> void
+{
+    mBatch.push_back(SessionTransition{ id, mState[id], state, Milliseconds(at) });
+
+    mPreviousState[id] = mState[id];
+    mState[id]         = state;
+    mTransitions      += 1;
+}
+
+auto SessionHost::Reserve (size_t sessions) -> void
+{
+    mState.reserve(sessions);
+    mPreviousState.reserve(sessions);
+    mWorkShiftCount.reserve(sessions);
+    mWorkDuration.reserve(sessions);
+    mShortBreakDuration.reserve(sessions);
+    mLongBreakDuration.reserve(sessions);
+    mLongBreakAfter.reserve(sessions);
+    mDeadline.reserve(sessions);
+    mRemaining.reserve(sessions);
+    mGeneration.reserve(sessions);
+    mCyclePhases.reserve(sessions);
+    mCycleWork.reserve(sessions);
+    mCycleShortBreak.reserve(sessions);
+    mCycleLength.reserve(sessions);
+
+    mHeap.reserve(sessions);
+}
+
+auto SessionHost::Add (const PomodoroConfig& config) -> SessionId
+{
+    const auto id = static_cast<SessionId>(mState.size());
+
+    mState.push_back(ImpulseState::Inactive);
+    mPreviousState.push_back(ImpulseState::Inactive);
+    mWorkShiftCount.push_back(1);
+    mWorkDuration.push_back(config.workDuration);
+    mShortBreakDuration.push_back(config.shortBreakDuration);
+    mLongBreakDuration.push_back(config.longBreakDuration);
+    mLongBreakAfter.push_back(config.longBreakAfter);
+    mDeadline.push_back(0);
+    mRemaining.push_back(0);
+    mGeneration.push_back(0);
+    mCyclePhases.push_back(0);
+    mCycleWork.push_back(0);
+    mCycleShortBreak.push_back(0);
+    mCycleLength.push_back(0);
+
+    UpdateCycle(id);
+
+    return id;
+}
+
+auto SessionHost::Configure (SessionId id, const PomodoroConfig& config) -> void
+{
+    mWorkDuration[id]       = config.workDuration;
+    mShortBreakDuration[id] = config.shortBreakDuration;
+    mLongBreakDuration[id]  = config.longBreakDuration;
+    mLongBreakAfter[id]     = config.longBreakAfter;
+
+    UpdateCycle(id);
+
+    // Same rule as PomodoroEngine::Configure().
+    if (mWorkShiftCount[id] > config.longBreakAfter)
+    {
+        mWorkShiftCount[id] = 1;
+    }
+}
+
+auto SessionHost::Config (SessionId id) const -> PomodoroConfig
+{
+    return PomodoroConfig{
+        mWorkDuration[id],
+        mShortBreakDuration[id],
+        mLongBreakDuration[id],
+        mLongBreakAfter[id]
+    };
+}
+
+auto SessionHost::Start (SessionId id, Milliseconds now) -> bool
+{
+    if (mState[id] != ImpulseState::Inactive)
+    {
+        return false;
+    }
+
+    Transition(id, ImpulseState::WorkShift, now.count());
+    Schedule(id, now.count() + PhaseLength(id, ImpulseState::WorkShift));
+
+    return true;
+}
+
+auto SessionHost::Pause (SessionId id, Milliseconds now) -> bool
+{
+    if (!IsRunning(mState[id]))
+    {
+        return false;
+    }
+
+    mRemaining[id] = std::max<int64_t>(mDeadline[id] - now.count(), 0);
+    DropDeadline(id);
+    Transition(id, ImpulseState::Paused, now.count());
+
+    return true;
+}
+
+auto SessionHost::Resume (SessionId id, Milliseconds now) -> bool
+{
+    if (mState[id] != ImpulseState::Paused)
+    {
+        return false;
+    }
+
+    Transition(id, mPreviousState[id], now.count());
+    Schedule(id, now.count() + mRemaining[id]);
+
+    return true;
+}
+
+auto SessionHost::Stop (SessionId id, Milliseconds now) -> bool
+{
+    mWorkShiftCount[id] = 1;
+    if (mState[id] == ImpulseState::Inactive)
+    {
+        return false;
+    }
+
+    // Paused session has no deadline, it was dropped by Pause().
+    if (IsRunning(mState[id]))
+    {
+        DropDeadline(id);
+    }
+
+    Transition(id, ImpulseState::Inactive, now.count());
+
+    return true;
+}
+
+auto SessionHost::Advance (Milliseconds now) -> size_t
+{
+    // Transitions queued by Start/Pause/Resume/Stop are already in batch.
+    const auto until = now.count();
+
+    while (!mHeap.empty() && mHeap.front().at <= until)
+    {
+        const auto entry = PopDeadline();
+
+        const auto id = entry.session;
+        if (entry.generation != mGeneration[id])
+        {
+            continue;
+        }
+
+        const auto next = PomodoroNext(mState[id], mWorkShiftCount[id], mLongBreakAfter[id]);
+
+        mWorkShiftCount[id] = next.workShiftCount;
+        Transition(id, next.state, entry.at);
+
+        // Next phase counts from when previous one should have ended, not
+        // from when we woke up, so late wakes don't stretch the schedule.
+        // If it is already over too, it comes around again in this loop.
+        Schedule(id, entry.at + PhaseLength(id, next.state));
+    }
+
+    const auto count = mBatch.size();
+    if (count > 0)
+    {
+        mWakes += 1;
+        OnTransitions(mBatch);
+        mBatch.clear();
+    }
+
+    return count;
+}
+
+auto SessionHost::NextDeadline () -> Milliseconds
+{
+    // Throw away dead entries on top, they would wake us for nothing.
+    while (!mHeap.empty() && mHeap.front().generation != mGeneration[mHeap.front().session])
+    {
+        PopDeadline();
+    }
+
+    if (mHeap.empty())
+    {
+        return Milliseconds::max();
+    }
+
+    return Milliseconds(mHeap.front().at);
+}
+
+auto SessionHost::Remaining (SessionId id, Milliseconds now) const -> Milliseconds
+{
+    switch (mState[id])
+    {
+    case ImpulseState::Paused:
+        return Milliseconds(mRemaining[id]);
+
+    case ImpulseState::Inactive:
+        return Milliseconds(PhaseLength(id, ImpulseState::WorkShift));
+
+    default:
+        return Milliseconds(std::max<int64_t>(mDeadline[id] - now.count(), 0));
+    }
+}
+
+auto SessionHost::ProjectTransitions (uint32_t n, Milliseconds now, std::vector<Milliseconds>& out) const -> void
+{
+    out.resize(mState.size());
+
+    // n / phases in double is exact for 32-bit operands, the quotient can't
+    // round up to the next integer. Unlike 64-bit integer division it has
+    // a vector instruction.
+    const auto nd    = static_cast<double>(n);
+    const auto count = mState.size();
+
+    for (auto id = size_t(0); id < count; ++id)
+    {
+        // Every field is loaded and selected from, no branches, so the loop
+        // can be vectorized.
+        const auto current   = static_cast<uint32_t>(mState[id]);
+        const auto previous  = static_cast<uint32_t>(mPreviousState[id]);
+        const auto remaining = mRemaining[id];
+        const auto deadline  = mDeadline[id];
+        const auto paused    = current == static_cast<uint32_t>(ImpulseState::Paused);
+        const auto state     = paused ? previous : current;
+        const auto end       = paused ? now.count() + remaining : deadline;
+
+        const auto phases = mCyclePhases[id];
+        const auto work   = mCycleWork[id];
+        const auto rest   = mCycleShortBreak[id];
+        const auto length = mCycleLength[id];
+
+        // Position of next phase in its cycle, see SchedulePhase(). Phase
+        // after the last one is first one of the next cycle.
+        const auto shift = std::min(std::max(mWorkShiftCount[id], 1u), phases / 2) - 1;
+        const auto work1 = state == static_cast<uint32_t>(ImpulseState::WorkShift);
+        const auto rest1 = state == static_cast<uint32_t>(ImpulseState::ShortBreak);
+        const auto after = work1 ? 2 * shift + 1 : rest1 ? 2 * shift + 2 : phases;
+        const auto first = after < phases ? after : 0u;
+
+        // n phases later: whole cycles, then the rest of the way, which may
+        // wrap into one more cycle.
+        const auto cycles = static_cast<uint32_t>(static_cast<int32_t>(nd / static_cast<double>(phases)));
+        const auto ahead  = first + (n - cycles * phases);
+        const auto wrap   = ahead >= phases ? 1u : 0u;
+        const auto phase  = ahead - wrap * phases;
+
+        // Start of phase p within cycle, see ScheduleOffset().
+        const auto offset = [&](uint32_t p) { return ((p + 1) / 2) * work + (p / 2) * rest; };
+
+        const auto at = end
+                      + (cycles + wrap) * length
+                      + offset(phase)
+                      - offset(first);
+
+        // WorkShift, ShortBreak or LongBreak. Mask instead of select, with
+        // select compilers move the division under a branch.
+        const auto running = state - static_cast<uint32_t>(ImpulseState::WorkShift) < 3u;
+        const auto mask    = static_cast<int64_t>(running) - 1;
+
+        out[id] = Milliseconds((at & ~mask) | (Milliseconds::max().count() & mask));
+    }
+}
+
+auto SessionHost::MemoryUsage () const -> size_t
+{
+    return mState.capacity()              * sizeof(ImpulseState)
+         + mPreviousState.capacity()      * sizeof(ImpulseState)
+         + mWorkShiftCount.capacity()     * sizeof(uint32_t)
+         + mWorkDuration.capacity()       * sizeof(uint32_t)
+         + mShortBreakDuration.capacity() * sizeof(uint32_t)
+         + mLongBreakDuration.capacity()  * sizeof(uint32_t)
+         + mLongBreakAfter.capacity()     * sizeof(uint32_t)
+         + mDeadline.capacity()           * sizeof(int64_t)
+         + mRemaining.capacity()          * sizeof(int64_t)
+         + mGeneration.capacity()         * sizeof(uint32_t)
+         + mCyclePhases.capacity()        * sizeof(uint32_t)
+         + mCycleWork.capacity()          * sizeof(int64_t)
+         + mCycleShortBreak.capacity()    * sizeof(int64_t)
+         + mCycleLength.capacity()        * sizeof(int64_t)
+         + mHeap.capacity()               * sizeof(HeapEntry)
+         + mBatch.capacity()              * sizeof(SessionTransition)
+         ;;
+}
+
+} // namespace Impulse
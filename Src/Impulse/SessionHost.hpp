@@ -0,0 +1,129 @@
+#pragma once
+
+#include "ImpulseState.hpp"
+#include "PomodoroEngine.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace Impulse {
+
+using SessionId = uint32_t;
+
+struct SessionTransition
+{
+    SessionId                 session = 0;
+    ImpulseState              from    = ImpulseState::Inactive;
+    ImpulseState              to      = ImpulseState::Inactive;
+    std::chrono::milliseconds at      = std::chrono::milliseconds(0); // deadline that fired
+};
+
+// Runs many independent pomodoro sessions in one process. Time is given by
+// the caller as milliseconds since any fixed epoch, host never reads clock.
+// Meant for a shared server, desktop app doesn't use it; it's built with
+// the portable CMake targets only.
+//
+// Session fields are kept in parallel arrays (structure of arrays), so
+// walking one field of all sessions touches only that field's memory.
+// Deadlines of all running sessions live in one min-heap; Advance() pops
+// everything that is due and reports transitions in one batch. Heap entries
+// of paused or stopped sessions are left in place and skipped when popped.
+class SessionHost
+{
+    using Milliseconds = std::chrono::milliseconds;
+
+    struct HeapEntry
+    {
+        int64_t   at         = 0;
+        SessionId session    = 0;
+        uint32_t  generation = 0;
+    };
+
+    // Per session, indexed by SessionId.
+    std::vector<ImpulseState> mState;
+    std::vector<ImpulseState> mPreviousState;
+    std::vector<uint32_t>     mWorkShiftCount;
+    std::vector<uint32_t>     mWorkDuration;       // seconds
+    std::vector<uint32_t>     mShortBreakDuration; // seconds
+    std::vector<uint32_t>     mLongBreakDuration;  // seconds
+    std::vector<uint32_t>     mLongBreakAfter;
+    std::vector<int64_t>      mDeadline;           // ms, end of running phase
+    std::vector<int64_t>      mRemaining;          // ms, left in paused phase
+    std::vector<uint32_t>     mGeneration;         // bumped when deadline is dropped
+
+    // Schedule cycle of each session (see ScheduleCycle), kept up to date by
+    // Add() and Configure() so ProjectTransitions() only does arithmetic.
+    std::vector<uint32_t>     mCyclePhases;
+    std::vector<int64_t>      mCycleWork;          // ms
+    std::vector<int64_t>      mCycleShortBreak;    // ms
+    std::vector<int64_t>      mCycleLength;        // ms
+
+    std::vector<HeapEntry>         mHeap;        // min-heap of deadlines
+    std::vector<SessionTransition> mBatch;       // reused between wakes
+    size_t                         mStale       = 0; // dropped entries still in heap
+    uint64_t                       mTransitions = 0;
+    uint64_t                       mWakes       = 0;
+
+    static auto Later (const HeapEntry& a, const HeapEntry& b) -> bool;
+
+    auto PhaseLength  (SessionId id, ImpulseState state) const -> int64_t;
+    auto Schedule     (SessionId id, int64_t at) -> void;
+    auto DropDeadline (SessionId id) -> void;
+    auto PopDeadline  () -> HeapEntry;
+    auto UpdateCycle  (SessionId id) -> void;
+    auto Transition   (SessionId id, ImpulseState state, int64_t at) -> void;
+
+public:
+    // Called from Advance() with all transitions of one wake, in deadline
+    // order. Batch is only valid during the call.
+    std::function<void (const std::vector<SessionTransition>& batch)> OnTransitions =
+        [](const std::vector<SessionTransition>&){};
+
+public:
+    auto Reserve (size_t sessions) -> void;
+
+    // New session is inactive.
+    auto Add       (const PomodoroConfig& config) -> SessionId;
+    auto Configure (SessionId id, const PomodoroConfig& config) -> void;
+    auto Config    (SessionId id) const -> PomodoroConfig;
+
+    // Same events as PomodoroEngine, Timeout is generated by Advance().
+    // Return false when event doesn't apply in current state. Transitions
+    // are queued and reported with next Advance() batch.
+    auto Start  (SessionId id, Milliseconds now) -> bool;
+    auto Pause  (SessionId id, Milliseconds now) -> bool;
+    auto Resume (SessionId id, Milliseconds now) -> bool;
+    auto Stop   (SessionId id, Milliseconds now) -> bool;
+
+    // Fire all deadlines up to @now, session that slept through several
+    // phases goes through all of them. Returns number of transitions.
+    auto Advance (Milliseconds now) -> size_t;
+
+    // Earliest pending deadline, scheduler sleeps until then. Max when no
+    // session is running.
+    auto NextDeadline () -> Milliseconds;
+
+    auto State          (SessionId id) const { return mState[id]; }
+    auto PreviousState  (SessionId id) const { return mPreviousState[id]; }
+    auto WorkShiftCount (SessionId id) const { return mWorkShiftCount[id]; }
+    auto Deadline       (SessionId id) const { return Milliseconds(mDeadline[id]); }
+    auto Remaining      (SessionId id, Milliseconds now) const -> Milliseconds;
+
+    // Time of @n-th upcoming transition of every session, 0 is end of its
+    // current phase, see ScheduleProjection. Inactive sessions get max.
+    // One branch free pass over session arrays without integer division,
+    // compilers vectorize it. @out is indexed by SessionId.
+    auto ProjectTransitions (uint32_t n, Milliseconds now, std::vector<Milliseconds>& out) const -> void;
+
+    auto Size        () const { return static_cast<uint32_t>(mState.size()); }
+    auto Transitions () const { return mTransitions; }
+    auto Wakes       () const { return mWakes; }
+
+    // Bytes held by session arrays, deadline heap and batch buffer.
+    auto MemoryUsage () const -> size_t;
+};
+
+} // namespace Impulse
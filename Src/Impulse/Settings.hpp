@@ -1,6 +1,6 @@
 #pragma once
 
-#include "ImpulseState.hpp"
+#include "WindowPosition.hpp"
 #include "Utility.hpp"
 
 #include <cstdint>
@@ -36,35 +36,18 @@ constexpr auto MINUTES (const uint32_t m)
     return m * 60;
 }
 
-enum class WindowPosition : unsigned char
-{
-    Auto,
-    LeftTop,
-    LeftEdge,
-    LeftBottom,
-    CenterTop,
-    Center,
-    CenterBottom,
-    RightTop,
-    RightEdge,
-    RightBottom
-};
-
 class Settings
 {
 public:
-    uint32_t       WorkDuration        = 10;//MINUTES(25);
-    uint32_t       ShortBreakDuration  = 4;//MINUTES(5);
-    uint32_t       LongBreakDuration   = 8;//MINUTES(15);
-    uint32_t       LongBreakAfter      = 4;
-    bool           AutoStartTimer      = true;
-    std::wstring   TaskName            = L"";
-    WindowPosition WindowPosition      = WindowPosition::Auto;
-
-    // Internal (don't save).
-    ImpulseState CurrentState        = ImpulseState::Inactive;
-    ImpulseState PreviousState       = ImpulseState::Inactive;
-    uint32_t     WorkShiftCount      = 1;
+    uint32_t                  WorkDuration        = 10;//MINUTES(25);
+    uint32_t                  ShortBreakDuration  = 4;//MINUTES(5);
+    uint32_t                  LongBreakDuration   = 8;//MINUTES(15);
+    uint32_t                  LongBreakAfter      = 4;
+    bool                      AutoStartTimer      = true;
+    std::wstring              TaskName            = L"";
+
+    // Qualified, member has the same name as its type.
+    ::Impulse::WindowPosition WindowPosition      = ::Impulse::WindowPosition::Auto;
 
     NLOHMANN_DEFINE_TYPE_INTRUSIVE(
         Settings,
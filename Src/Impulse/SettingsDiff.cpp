@@ -0,0 +1,33 @@
+#include "SettingsDiff.hpp"
+
+namespace Impulse {
+
+auto DiffSettings (
+    const Settings&  current,
+    const TaskStore& currentTasks,
+    const Settings&  loaded,
+    const TaskStore& loadedTasks
+) -> SettingsDiff
+{
+    auto diff = SettingsDiff();
+
+    diff.durations = current.WorkDuration       != loaded.WorkDuration
+                  || current.ShortBreakDuration != loaded.ShortBreakDuration
+                  || current.LongBreakDuration  != loaded.LongBreakDuration
+                  || current.LongBreakAfter     != loaded.LongBreakAfter
+                  ;;
+
+    diff.autoStartTimer = current.AutoStartTimer != loaded.AutoStartTimer;
+    diff.taskName       = current.TaskName       != loaded.TaskName;
+    diff.windowPosition = current.WindowPosition != loaded.WindowPosition;
+
+    diff.tasks = currentTasks.Size() != loadedTasks.Size();
+    for (auto i = 0u; !diff.tasks && i < currentTasks.Size(); ++i)
+    {
+        diff.tasks = currentTasks.Get(i) != loadedTasks.Get(i);
+    }
+
+    return diff;
+}
+
+} // namespace Impulse
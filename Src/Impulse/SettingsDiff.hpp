@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Settings.hpp"
+#include "TaskStore.hpp"
+
+namespace Impulse {
+
+// Settings fields that differ between two versions. Each group names the
+// part of the app that has to be updated, nothing else is touched.
+struct SettingsDiff
+{
+    bool durations      = false; // work, breaks, long break after -> engine
+    bool autoStartTimer = false;
+    bool taskName       = false; // -> current task text
+    bool tasks          = false; // -> task store
+    bool windowPosition = false; // -> window placement
+
+    auto Empty () const { return !durations && !autoStartTimer && !taskName && !tasks && !windowPosition; }
+};
+
+auto DiffSettings (
+    const Settings&  current,
+    const TaskStore& currentTasks,
+    const Settings&  loaded,
+    const TaskStore& loadedTasks
+) -> SettingsDiff;
+
+} // namespace Impulse
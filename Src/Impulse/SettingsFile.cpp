@@ -0,0 +1,449 @@
+#include "SettingsFile.hpp"
+
+#include <iterator>
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+using Impulse::Settings;
+using Impulse::TaskStore;
+using Impulse::WindowPosition;
+
+using Json = nlohmann::json;
+
+enum class Field : unsigned char
+{
+    None,    // no top level key pending
+    Unknown, // key we don't know, value is skipped
+    Version,
+    WorkDuration,
+    ShortBreakDuration,
+    LongBreakDuration,
+    LongBreakAfter,
+    AutoStartTimer,
+    TaskName,
+    WindowPosition,
+    Tasks
+};
+
+// Indexed by Field.
+constexpr std::string_view FIELD_NAMES[] = {
+    "",
+    "",
+    "Version",
+    "WorkDuration",
+    "ShortBreakDuration",
+    "LongBreakDuration",
+    "LongBreakAfter",
+    "AutoStartTimer",
+    "TaskName",
+    "WindowPosition",
+    "Tasks"
+};
+
+// Indexed by WindowPosition.
+constexpr std::string_view WINDOW_POSITION_NAMES[] = {
+    "Auto",
+    "LeftTop",
+    "LeftEdge",
+    "LeftBottom",
+    "CenterTop",
+    "Center",
+    "CenterBottom",
+    "RightTop",
+    "RightEdge",
+    "RightBottom"
+};
+
+// Phases longer than a day are typos, not settings.
+constexpr auto MAX_DURATION         = uint64_t(24) * 60 * 60;
+constexpr auto MAX_LONG_BREAK_AFTER = uint64_t(1000);
+
+// Parser fails on malformed UTF-8, so it is replaced by noncharacter U+FFFF
+// first, which has no business in settings either. Strings holding it are
+// treated as invalid.
+constexpr auto INVALID_MARK = std::string_view("\xEF\xBF\xBF");
+
+// Length of well-formed UTF-8 sequence at @i, 0 when there is none.
+auto SequenceLength (std::string_view str, size_t i) -> size_t
+{
+    const auto lead = static_cast<uint8_t>(str[i]);
+    if (lead < 0x80)
+    {
+        return 1;
+    }
+
+    const auto length = lead >= 0xF0 && lead <= 0xF4 ? size_t(4)
+                      : lead >= 0xE0 && lead <  0xF0 ? size_t(3)
+                      : lead >= 0xC2 && lead <  0xE0 ? size_t(2)
+                      :                                size_t(0);
+    if (length == 0 || i + length > str.size())
+    {
+        return 0;
+    }
+
+    for (auto k = size_t(1); k < length; ++k)
+    {
+        if ((static_cast<uint8_t>(str[i + k]) & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+    }
+
+    // Overlong forms, surrogates and values past U+10FFFF, all told by
+    // second byte.
+    const auto second = static_cast<uint8_t>(str[i + 1]);
+    if ((lead == 0xE0 && second < 0xA0) || (lead == 0xED && second > 0x9F)
+    ||  (lead == 0xF0 && second < 0x90) || (lead == 0xF4 && second > 0x8F))
+    {
+        return 0;
+    }
+
+    return length;
+}
+
+// Copy of @json with every malformed byte replaced by INVALID_MARK, nullopt
+// when there are none.
+auto MarkInvalidUTF8 (std::string_view json) -> std::optional<std::string>
+{
+    auto i = size_t(0);
+    while (i < json.size() && SequenceLength(json, i) != 0)
+    {
+        i += SequenceLength(json, i);
+    }
+
+    if (i == json.size())
+    {
+        return std::nullopt;
+    }
+
+    auto marked = std::string(json.substr(0, i));
+    while (i < json.size())
+    {
+        const auto length = SequenceLength(json, i);
+        if (length == 0)
+        {
+            marked += INVALID_MARK;
+            i      += 1;
+        }
+        else
+        {
+            marked += json.substr(i, length);
+            i      += length;
+        }
+    }
+
+    return marked;
+}
+
+// MIGRATIONS[v] upgrades file of version v to v + 1.
+using Migration = void (*) (Settings& settings, TaskStore& tasks);
+
+constexpr Migration MIGRATIONS[] = {
+    // 0 -> 1: only new fields, they already hold defaults.
+    [](Settings&, TaskStore&) {}
+};
+
+static_assert(std::size(MIGRATIONS) == Impulse::SETTINGS_VERSION, "Every version needs a migration");
+
+// Events of nlohmann SAX parser, applied straight to Settings. Only top
+// level fields and strings of "Tasks" array are looked at, anything nested
+// deeper is skipped.
+class SettingsHandler : public Json::json_sax_t
+{
+    Settings&  mSettings;
+    TaskStore& mTasks;
+    Field      mField    = Field::None;
+    int        mDepth    = 0;
+    uint32_t   mVersion  = 0;
+    uint32_t   mRejected = 0;
+    bool       mObject   = false; // top level is an object
+
+    auto IsValue () const { return mDepth == 1 && mField != Field::None; }
+    auto IsTask  () const { return mDepth == 2 && mField == Field::Tasks; }
+
+    auto Reject () -> bool
+    {
+        if (mField != Field::Unknown)
+        {
+            spdlog::warn("Settings field '{}' has invalid value, using default", FIELD_NAMES[static_cast<size_t>(mField)]);
+            mRejected += 1;
+        }
+
+        return true;
+    }
+
+    auto Number (uint64_t value) -> bool
+    {
+        const auto set = [&](uint32_t& field, uint64_t min, uint64_t max)
+        {
+            if (value < min || value > max)
+            {
+                return Reject();
+            }
+
+            field = static_cast<uint32_t>(value);
+            return true;
+        };
+
+        switch (mField)
+        {
+        case Field::Version:            return set(mVersion,                     0, UINT32_MAX);
+        case Field::WorkDuration:       return set(mSettings.WorkDuration,       1, MAX_DURATION);
+        case Field::ShortBreakDuration: return set(mSettings.ShortBreakDuration, 1, MAX_DURATION);
+        case Field::LongBreakDuration:  return set(mSettings.LongBreakDuration,  1, MAX_DURATION);
+        case Field::LongBreakAfter:     return set(mSettings.LongBreakAfter,     0, MAX_LONG_BREAK_AFTER);
+        default:                        return Reject();
+        }
+    }
+
+public:
+    SettingsHandler (Settings& settings, TaskStore& tasks)
+        : mSettings (settings)
+        , mTasks    (tasks)
+    {
+    }
+
+    auto Object   () const { return mObject; }
+    auto Version  () const { return mVersion; }
+    auto Rejected () const { return mRejected; }
+
+    virtual auto null () -> bool override
+    {
+        return IsValue() ? Reject() : true;
+    }
+
+    virtual auto boolean (bool value) -> bool override
+    {
+        if (!IsValue())
+        {
+            return true;
+        }
+
+        if (mField != Field::AutoStartTimer)
+        {
+            return Reject();
+        }
+
+        mSettings.AutoStartTimer = value;
+        return true;
+    }
+
+    virtual auto number_integer (number_integer_t value) -> bool override
+    {
+        if (!IsValue())
+        {
+            return true;
+        }
+
+        return value < 0 ? Reject() : Number(static_cast<uint64_t>(value));
+    }
+
+    virtual auto number_unsigned (number_unsigned_t value) -> bool override
+    {
+        return IsValue() ? Number(value) : true;
+    }
+
+    virtual auto number_float (number_float_t, const string_t&) -> bool override
+    {
+        return IsValue() ? Reject() : true;
+    }
+
+    virtual auto string (string_t& value) -> bool override
+    {
+        if (IsTask())
+        {
+            if (value.find(INVALID_MARK) != string_t::npos)
+            {
+                spdlog::warn("Skipping task that is not valid UTF-8");
+                return true;
+            }
+
+            if (const auto name = Impulse::UTF8ToUTF16(value))
+            {
+                mTasks.Add(*name);
+            }
+
+            return true;
+        }
+
+        if (!IsValue())
+        {
+            return true;
+        }
+
+        if (mField == Field::TaskName)
+        {
+            // No task is written as empty string, which converts to nullopt.
+            const auto name = Impulse::UTF8ToUTF16(value);
+            if ((!name && !value.empty()) || value.find(INVALID_MARK) != string_t::npos)
+            {
+                return Reject();
+            }
+
+            mSettings.TaskName = name.value_or(std::wstring());
+            return true;
+        }
+
+        if (mField == Field::WindowPosition)
+        {
+            for (auto i = size_t(0); i < std::size(WINDOW_POSITION_NAMES); ++i)
+            {
+                if (value == WINDOW_POSITION_NAMES[i])
+                {
+                    mSettings.WindowPosition = static_cast<WindowPosition>(i);
+                    return true;
+                }
+            }
+        }
+
+        return Reject();
+    }
+
+    virtual auto binary (binary_t&) -> bool override
+    {
+        return IsValue() ? Reject() : true;
+    }
+
+    virtual auto start_object (std::size_t) -> bool override
+    {
+        if (mDepth == 0)
+        {
+            mObject = true;
+        }
+
+        if (IsValue())
+        {
+            Reject();
+        }
+
+        mDepth += 1;
+        return true;
+    }
+
+    virtual auto key (string_t& value) -> bool override
+    {
+        if (mDepth != 1)
+        {
+            return true;
+        }
+
+        mField = Field::Unknown;
+        for (auto i = size_t(Field::Version); i < std::size(FIELD_NAMES); ++i)
+        {
+            if (value == FIELD_NAMES[i])
+            {
+                mField = static_cast<Field>(i);
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    virtual auto end_object () -> bool override
+    {
+        mDepth -= 1;
+        return true;
+    }
+
+    virtual auto start_array (std::size_t) -> bool override
+    {
+        // Top level must be an object, anything else isn't settings file.
+        if (mDepth == 0)
+        {
+            return false;
+        }
+
+        if (IsValue())
+        {
+            if (mField != Field::Tasks)
+            {
+                Reject();
+            }
+            else
+            {
+                mTasks.Clear();
+            }
+        }
+
+        mDepth += 1;
+        return true;
+    }
+
+    virtual auto end_array () -> bool override
+    {
+        mDepth -= 1;
+        return true;
+    }
+
+    virtual auto parse_error (std::size_t position, const std::string&, const nlohmann::detail::exception& error) -> bool override
+    {
+        spdlog::error("Settings file is not valid json at {}: {}", position, error.what());
+        return false;
+    }
+};
+
+}
+
+namespace Impulse {
+
+auto ReadSettings (std::string_view json, Settings& settings, TaskStore& tasks) -> SettingsReadResult
+{
+    auto result  = SettingsReadResult();
+    auto handler = SettingsHandler(settings, tasks);
+
+    const auto marked = MarkInvalidUTF8(json);
+    if (marked)
+    {
+        json = *marked;
+    }
+
+    // Comments are allowed, settings file is edited by hand.
+    const auto parsed = Json::sax_parse(json.data(), json.data() + json.size(), &handler, Json::input_format_t::json, true, true);
+
+    result.valid = parsed && handler.Object();
+    if (!result.valid)
+    {
+        return result;
+    }
+
+    result.version  = handler.Version();
+    result.rejected = handler.Rejected();
+
+    if (result.version > SETTINGS_VERSION)
+    {
+        spdlog::warn("Settings file version {} is newer than {}, unknown fields are ignored", result.version, SETTINGS_VERSION);
+    }
+
+    for (auto version = result.version; version < SETTINGS_VERSION; ++version)
+    {
+        spdlog::info("Migrating Settings from version {} to {}", version, version + 1);
+        MIGRATIONS[version](settings, tasks);
+    }
+
+    return result;
+}
+
+auto WriteSettings (const Settings& settings, const TaskStore& tasks) -> std::string
+{
+    auto json = Json(settings);
+
+    json["Version"]        = SETTINGS_VERSION;
+    json["WindowPosition"] = WINDOW_POSITION_NAMES[static_cast<size_t>(settings.WindowPosition)];
+
+    auto& names = json["Tasks"] = Json::array();
+    for (auto i = 0u; i < tasks.Size(); ++i)
+    {
+        if (const auto name = UTF16ToUTF8(tasks.Get(i)))
+        {
+            names.push_back(*name);
+        }
+    }
+
+    return json.dump(4);
+}
+
+} // namespace Impulse
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Settings.hpp"
+#include "TaskStore.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Impulse {
+
+// Version written to settings file. Files without "Version" are 0.
+//
+//     0  fields of Settings and "Tasks", no WindowPosition
+//     1  "Version" and "WindowPosition" added
+constexpr auto SETTINGS_VERSION = uint32_t(1);
+
+struct SettingsReadResult
+{
+    bool     valid    = false; // file is JSON object, fields were read
+    uint32_t version  = 0;     // as stored in file
+    uint32_t rejected = 0;     // fields with wrong type or range, left at default
+};
+
+// Reads settings JSON in one pass without building a document. Every
+// field is checked on its own, bad one keeps its default value and the
+// rest is read as usual. Unknown fields are skipped. Older versions are
+// migrated to SETTINGS_VERSION afterwards. Text that isn't valid UTF-8
+// doesn't fail the file, task containing it is skipped and TaskName is
+// rejected.
+//
+// @settings and @tasks are filled as fields come, on invalid JSON they hold
+// whatever was read before the error and should be thrown away.
+auto ReadSettings (std::string_view json, Settings& settings, TaskStore& tasks) -> SettingsReadResult;
+
+// Current version of settings file, pretty printed.
+auto WriteSettings (const Settings& settings, const TaskStore& tasks) -> std::string;
+
+} // namespace Impulse
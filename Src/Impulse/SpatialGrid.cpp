@@ -0,0 +1,114 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace Impulse {
+
+auto SpatialGrid::Build (const std::vector<LayoutRect>& rects) -> void
+{
+    Clear();
+
+    if (rects.empty())
+    {
+        return;
+    }
+
+    // Grid covers bounding box of all items.
+    auto bounds = rects.front();
+    for (const auto& rect : rects)
+    {
+        bounds.left   = std::min(bounds.left, rect.left);
+        bounds.top    = std::min(bounds.top, rect.top);
+        bounds.right  = std::max(bounds.right, rect.right);
+        bounds.bottom = std::max(bounds.bottom, rect.bottom);
+    }
+
+    // Huge areas get bigger cells rather than too many of them.
+    const auto extent = std::max(bounds.Width(), bounds.Height());
+    const auto cell   = std::max(mMinCellSize, extent / MAX_CELLS_PER_AXIS);
+
+    mLeft     = bounds.left;
+    mTop      = bounds.top;
+    mCellSize = cell;
+    mColumns  = std::max(1, static_cast<int>(std::ceil(bounds.Width() / cell)));
+    mRows     = std::max(1, static_cast<int>(std::ceil(bounds.Height() / cell)));
+
+    const auto cellRange = [&](const LayoutRect& rect)
+    {
+        const auto x0 = std::clamp(static_cast<int>((rect.left - mLeft) / cell), 0, mColumns - 1);
+        const auto y0 = std::clamp(static_cast<int>((rect.top - mTop) / cell), 0, mRows - 1);
+        const auto x1 = std::clamp(static_cast<int>((rect.right - mLeft) / cell), 0, mColumns - 1);
+        const auto y1 = std::clamp(static_cast<int>((rect.bottom - mTop) / cell), 0, mRows - 1);
+
+        return std::make_tuple(x0, y0, x1, y1);
+    };
+
+    // Count items per cell, then fill them in, keeping item order.
+    mCellStart.assign(static_cast<size_t>(mColumns * mRows) + 1, 0);
+    for (const auto& rect : rects)
+    {
+        const auto [x0, y0, x1, y1] = cellRange(rect);
+        for (auto y = y0; y <= y1; ++y)
+        {
+            for (auto x = x0; x <= x1; ++x)
+            {
+                mCellStart[y * mColumns + x + 1] += 1;
+            }
+        }
+    }
+
+    for (size_t i = 1; i < mCellStart.size(); ++i)
+    {
+        mCellStart[i] += mCellStart[i - 1];
+    }
+
+    // Vectors keep their capacity, rebuilding after layout change doesn't
+    // allocate once they grew to size.
+    mCursor.assign(mCellStart.begin(), mCellStart.end() - 1);
+    mCellItems.resize(mCellStart.back());
+
+    for (uint32_t item = 0; item < rects.size(); ++item)
+    {
+        const auto [x0, y0, x1, y1] = cellRange(rects[item]);
+        for (auto y = y0; y <= y1; ++y)
+        {
+            for (auto x = x0; x <= x1; ++x)
+            {
+                mCellItems[mCursor[y * mColumns + x]++] = item;
+            }
+        }
+    }
+}
+
+auto SpatialGrid::Clear () -> void
+{
+    mColumns = 0;
+    mRows    = 0;
+    mCellStart.clear();
+    mCellItems.clear();
+}
+
+auto SpatialGrid::CellAt (float x, float y) const -> int
+{
+    if (mColumns == 0 || mRows == 0)
+    {
+        return -1;
+    }
+
+    // Items touching right/bottom edge of grid are in the last cell.
+    const auto right  = mLeft + mColumns * mCellSize;
+    const auto bottom = mTop + mRows * mCellSize;
+    if (x < mLeft || y < mTop || x > right || y > bottom)
+    {
+        return -1;
+    }
+
+    const auto column = std::min(static_cast<int>((x - mLeft) / mCellSize), mColumns - 1);
+    const auto row    = std::min(static_cast<int>((y - mTop) / mCellSize), mRows - 1);
+
+    return row * mColumns + column;
+}
+
+} // namespace Impulse
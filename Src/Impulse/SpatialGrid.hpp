@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Layout.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Impulse {
+
+// Uniform grid over item rectangles, used to find items under a point
+// without testing all of them. Grid is rebuilt when layout changes, queries
+// only read it and don't allocate.
+class SpatialGrid
+{
+    static constexpr auto MAX_CELLS_PER_AXIS = 64;
+
+    float                 mMinCellSize = 64.0f;
+    float                 mCellSize    = 64.0f;
+    float                 mLeft        = 0.0f;
+    float                 mTop         = 0.0f;
+    int                   mColumns     = 0;
+    int                   mRows        = 0;
+    std::vector<uint32_t> mCellStart;      // offset of each cell in mCellItems, one extra at end
+    std::vector<uint32_t> mCellItems;      // item indices, grouped by cell, in build order
+    std::vector<uint32_t> mCursor;         // next free slot of each cell, while building
+
+public:
+    SpatialGrid (float minCellSize = 64.0f)
+        : mMinCellSize (minCellSize)
+        , mCellSize    (minCellSize)
+    {
+    }
+
+    // Index @rects. Items keep their order inside each cell, so ordering
+    // rects topmost first makes queries return topmost items first.
+    auto Build (const std::vector<LayoutRect>& rects) -> void;
+    auto Clear () -> void;
+
+    // Call @fn with index of each item whose cell contains point, stop when
+    // @fn returns true. Returns whether some call returned true.
+    template <typename Fn>
+    auto Query (float x, float y, Fn&& fn) const -> bool
+    {
+        const auto cell = CellAt(x, y);
+        if (cell < 0)
+        {
+            return false;
+        }
+
+        for (auto i = mCellStart[cell]; i < mCellStart[cell + 1]; ++i)
+        {
+            if (fn(mCellItems[i]))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Index of cell containing point, -1 when outside of grid.
+    auto CellAt (float x, float y) const -> int;
+
+    auto Columns  () const { return mColumns; }
+    auto Rows     () const { return mRows; }
+    auto CellSize () const { return mCellSize; }
+};
+
+} // namespace Impulse
@@ -0,0 +1,520 @@
+#include "TaskImporter.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+using Impulse::TaskFormat;
+using Impulse::TaskStore;
+
+// Smaller files aren't worth starting threads for.
+constexpr auto MIN_CHUNK_SIZE = size_t(1) << 20;
+
+constexpr std::string_view UTF8_BOM = "\xEF\xBB\xBF";
+
+constexpr std::string_view TASK_COLUMNS[] = {
+    "task",
+    "title",
+    "name",
+    "summary"
+};
+
+struct Interned
+{
+    std::wstring_view name;
+    size_t            hash = 0;
+
+    auto operator== (const Interned& rhs) const { return name == rhs.name; }
+};
+
+struct InternedHash
+{
+    auto operator() (const Interned& interned) const { return interned.hash; }
+};
+
+// Tasks of one chunk in file order. Duplicates within chunk are found on
+// chunk thread, merging only looks at @unique.
+struct Chunk
+{
+    std::string_view      text;
+    TaskStore             tasks;
+    std::vector<size_t>   hashes;
+    std::vector<uint32_t> unique;     // first occurrences in @tasks
+    uint32_t              lines   = 0;
+    uint32_t              invalid = 0;
+};
+
+auto Trim (std::string_view text) -> std::string_view
+{
+    const auto first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+auto EqualsIgnoreCase (std::string_view a, std::string_view b) -> bool
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y)
+    {
+        return (x >= 'A' && x <= 'Z' ? x - 'A' + 'a' : x) == y;
+    });
+}
+
+// Appends @text as UTF-16 to @out. False on anything that isn't strict
+// UTF-8: stray continuation bytes, overlong forms, surrogates, values past
+// U+10FFFF and sequences cut short.
+auto AppendUtf16 (std::string_view text, std::wstring& out) -> bool
+{
+    const auto bytes = reinterpret_cast<const uint8_t*>(text.data());
+    const auto size  = text.size();
+
+    for (auto i = size_t(0); i < size;)
+    {
+        const auto lead = bytes[i];
+        if (lead < 0x80)
+        {
+            out.push_back(static_cast<wchar_t>(lead));
+            i += 1;
+            continue;
+        }
+
+        auto length = size_t(0);
+        auto code   = uint32_t(0);
+        auto min    = uint32_t(0);
+
+        if ((lead & 0xE0) == 0xC0)      { length = 2; code = lead & 0x1F; min = 0x80;    }
+        else if ((lead & 0xF0) == 0xE0) { length = 3; code = lead & 0x0F; min = 0x800;   }
+        else if ((lead & 0xF8) == 0xF0) { length = 4; code = lead & 0x07; min = 0x10000; }
+        else
+        {
+            return false;
+        }
+
+        if (size - i < length)
+        {
+            return false;
+        }
+
+        for (auto k = size_t(1); k < length; ++k)
+        {
+            const auto next = bytes[i + k];
+            if ((next & 0xC0) != 0x80)
+            {
+                return false;
+            }
+
+            code = (code << 6) | (next & 0x3F);
+        }
+
+        if (code < min || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+        {
+            return false;
+        }
+
+        if (code >= 0x10000)
+        {
+            code -= 0x10000;
+            out.push_back(static_cast<wchar_t>(0xD800 + (code >> 10)));
+            out.push_back(static_cast<wchar_t>(0xDC00 + (code & 0x3FF)));
+        }
+        else
+        {
+            out.push_back(static_cast<wchar_t>(code));
+        }
+
+        i += length;
+    }
+
+    return true;
+}
+
+// Field @column of CSV @line, quotes removed, into @field. Empty when line
+// has fewer fields. False when quoted field isn't closed or is followed by
+// anything but a separator.
+auto CsvField (std::string_view line, size_t column, std::string& field) -> bool
+{
+    field.clear();
+
+    auto i = size_t(0);
+    for (auto current = size_t(0);; ++current)
+    {
+        const auto wanted = current == column;
+
+        if (i < line.size() && line[i] == '"')
+        {
+            // Quoted, "" stands for one quote.
+            for (i += 1;; i += 1)
+            {
+                if (i >= line.size())
+                {
+                    return false;
+                }
+
+                if (line[i] == '"')
+                {
+                    if (i + 1 < line.size() && line[i + 1] == '"')
+                    {
+                        if (wanted)
+                        {
+                            field.push_back('"');
+                        }
+
+                        i += 1;
+                        continue;
+                    }
+
+                    i += 1;
+                    break;
+                }
+
+                if (wanted)
+                {
+                    field.push_back(line[i]);
+                }
+            }
+
+            if (i < line.size() && line[i] != ',')
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const auto end = std::min(line.find(',', i), line.size());
+            if (wanted)
+            {
+                field.assign(line.data() + i, end - i);
+            }
+
+            i = end;
+        }
+
+        if (wanted || i >= line.size())
+        {
+            return true;
+        }
+
+        i += 1;
+    }
+}
+
+// Description of todo.txt @line without priority and creation date, empty
+// for done tasks.
+auto TodoDescription (std::string_view line) -> std::string_view
+{
+    const auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+
+    if (line.size() >= 2 && line[0] == 'x' && line[1] == ' ')
+    {
+        return {};
+    }
+
+    if (line.size() >= 4 && line[0] == '(' && line[1] >= 'A' && line[1] <= 'Z' && line[2] == ')' && line[3] == ' ')
+    {
+        line = Trim(line.substr(4));
+    }
+
+    // YYYY-MM-DD
+    if (line.size() >= 11 &&
+        isDigit(line[0]) && isDigit(line[1]) && isDigit(line[2]) && isDigit(line[3]) && line[4] == '-' &&
+        isDigit(line[5]) && isDigit(line[6]) && line[7] == '-' &&
+        isDigit(line[8]) && isDigit(line[9]) && line[10] == ' ')
+    {
+        line = Trim(line.substr(11));
+    }
+
+    return line;
+}
+
+auto ParseChunk (Chunk& chunk, TaskFormat format, size_t column) -> void
+{
+    auto field = std::string();
+    auto name  = std::wstring();
+
+    chunk.tasks.Reserve(chunk.text.size() / 32, chunk.text.size());
+
+    for (auto text = chunk.text; !text.empty();)
+    {
+        const auto end = std::min(text.find('\n'), text.size());
+
+        auto line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+
+        chunk.lines += 1;
+
+        auto task = std::string_view();
+        if (format == TaskFormat::Csv)
+        {
+            if (!CsvField(line, column, field))
+            {
+                chunk.invalid += 1;
+                continue;
+            }
+
+            task = Trim(field);
+        }
+        else
+        {
+            task = TodoDescription(Trim(line));
+        }
+
+        if (task.empty())
+        {
+            continue;
+        }
+
+        name.clear();
+        if (!AppendUtf16(task, name))
+        {
+            chunk.invalid += 1;
+            continue;
+        }
+
+        chunk.tasks.Add(name);
+    }
+
+    // Store text is final now, views into it stay valid.
+    auto seen = std::unordered_set<Interned, InternedHash>();
+    seen.reserve(chunk.tasks.Size());
+
+    // Hashing in a pass of its own streams through text, interleaved with
+    // lookups it runs at half the speed.
+    chunk.hashes.resize(chunk.tasks.Size());
+    for (auto i = 0u; i < chunk.tasks.Size(); ++i)
+    {
+        chunk.hashes[i] = std::hash<std::wstring_view>()(chunk.tasks.Get(i));
+    }
+
+    for (auto i = 0u; i < chunk.tasks.Size(); ++i)
+    {
+        if (seen.insert(Interned{ chunk.tasks.Get(i), chunk.hashes[i] }).second)
+        {
+            chunk.unique.push_back(i);
+        }
+    }
+}
+
+}
+
+namespace Impulse {
+
+auto TaskFormatOf (const std::filesystem::path& path) -> TaskFormat
+{
+    auto extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](char c)
+    {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    });
+
+    return extension == ".csv" ? TaskFormat::Csv : TaskFormat::TodoTxt;
+}
+
+auto ImportTasks (std::string_view text, TaskFormat format, TaskStore& tasks) -> TaskImportResult
+{
+    auto result = TaskImportResult();
+
+    if (text.substr(0, UTF8_BOM.size()) == UTF8_BOM)
+    {
+        text.remove_prefix(UTF8_BOM.size());
+    }
+
+    // CSV header picks task column, it isn't a task itself.
+    auto column = size_t(0);
+    if (format == TaskFormat::Csv)
+    {
+        const auto end = std::min(text.find('\n'), text.size());
+
+        auto header = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+
+        if (!header.empty() && header.back() == '\r')
+        {
+            header.remove_suffix(1);
+        }
+
+        auto field  = std::string();
+        auto found  = false;
+        auto fields = static_cast<size_t>(std::count(header.begin(), header.end(), ',')) + 1;
+
+        for (const auto name : TASK_COLUMNS)
+        {
+            for (auto i = size_t(0); !found && i < fields && CsvField(header, i, field); ++i)
+            {
+                if (EqualsIgnoreCase(Trim(field), name))
+                {
+                    column = i;
+                    found  = true;
+                }
+            }
+        }
+    }
+
+    // Chunks end after a line end, none of them starts mid-line.
+    const auto threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const auto count   = std::clamp<size_t>(text.size() / MIN_CHUNK_SIZE, 1, threads);
+
+    auto chunks = std::vector<Chunk>(count);
+    auto start  = size_t(0);
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        auto end = i + 1 == count ? text.size() : std::max(start, text.size() / count * (i + 1));
+
+        end = std::min(text.find('\n', end), text.size());
+        end = std::min(end + 1, text.size());
+
+        chunks[i].text = text.substr(start, end - start);
+        start = end;
+    }
+
+    auto workers = std::vector<std::thread>();
+    workers.reserve(count - 1);
+
+    for (auto i = size_t(1); i < count; ++i)
+    {
+        workers.emplace_back(ParseChunk, std::ref(chunks[i]), format, column);
+    }
+
+    ParseChunk(chunks[0], format, column);
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    // Dedupe against store and earlier chunks in file order. Names are
+    // collected first, adding to store moves its text.
+    auto total = size_t(0);
+    for (const auto& chunk : chunks)
+    {
+        total += chunk.unique.size();
+    }
+
+    auto seen = std::unordered_set<Interned, InternedHash>();
+    seen.reserve(tasks.Size() + total);
+
+    auto added      = std::vector<std::wstring_view>();
+    auto characters = size_t(0);
+
+    for (auto i = 0u; i < tasks.Size(); ++i)
+    {
+        seen.insert(Interned{ tasks.Get(i), std::hash<std::wstring_view>()(tasks.Get(i)) });
+        characters += tasks.Get(i).size();
+    }
+
+    for (const auto& chunk : chunks)
+    {
+        result.lines      += chunk.lines;
+        result.duplicates += static_cast<uint32_t>(chunk.tasks.Size() - chunk.unique.size());
+        result.invalid    += chunk.invalid;
+
+        for (const auto i : chunk.unique)
+        {
+            if (!seen.insert(Interned{ chunk.tasks.Get(i), chunk.hashes[i] }).second)
+            {
+                result.duplicates += 1;
+                continue;
+            }
+
+            added.push_back(chunk.tasks.Get(i));
+            characters += chunk.tasks.Get(i).size();
+        }
+    }
+
+    seen.clear();
+
+    tasks.Reserve(tasks.Size() + added.size(), characters);
+    for (const auto name : added)
+    {
+        tasks.Add(name);
+    }
+
+    result.added = static_cast<uint32_t>(added.size());
+    return result;
+}
+
+auto ImportTasks (const std::filesystem::path& path, TaskStore& tasks) -> std::optional<TaskImportResult>
+{
+    const auto file = MappedFile::Open(path);
+    if (!file)
+    {
+        spdlog::error("Can't open task list '{}'", path.string());
+        return std::nullopt;
+    }
+
+    const auto text = std::string_view(reinterpret_cast<const char*>(file->Data()), static_cast<size_t>(file->Size()));
+    return ImportTasks(text, TaskFormatOf(path), tasks);
+}
+
+TaskImport::~TaskImport ()
+{
+    Wait();
+}
+
+auto TaskImport::Wait () -> void
+{
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+auto TaskImport::Start (Desc desc) -> std::unique_ptr<TaskImport>
+{
+    auto job = std::make_unique<TaskImport>();
+    job->mSource = std::move(desc.tasks);
+    job->mFirst  = job->mSource ? job->mSource->Size() : 0;
+
+    job->mThread = std::thread([job = job.get(), paths = std::move(desc.paths), onDone = std::move(desc.onDone)]
+    {
+        // Copy is as big as the store, caller shouldn't wait for it.
+        if (job->mSource)
+        {
+            job->mTasks = *job->mSource;
+        }
+
+        for (const auto& path : paths)
+        {
+            auto error = std::error_code();
+            if (!std::filesystem::exists(path, error))
+            {
+                continue;
+            }
+
+            const auto result = ImportTasks(path, job->mTasks);
+            if (!result)
+            {
+                continue;
+            }
+
+            spdlog::info(
+                "Imported '{}': {} lines, {} tasks added, {} duplicates, {} invalid",
+                path.string(), result->lines, result->added, result->duplicates, result->invalid
+            );
+
+            job->mAdded += result->added;
+        }
+
+        onDone();
+    });
+
+    return job;
+}
+
+} // namespace Impulse
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "TaskStore.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Impulse {
+
+enum class TaskFormat : unsigned char
+{
+    Csv,     // header line, task from "Task", "Title", "Name" or "Summary" column, else first
+    TodoTxt  // todo.txt, priority and dates are dropped, done tasks skipped
+};
+
+struct TaskImportResult
+{
+    uint32_t lines      = 0;
+    uint32_t added      = 0;
+    uint32_t duplicates = 0; // already in store or earlier in file
+    uint32_t invalid    = 0; // not UTF-8 or broken CSV quoting
+};
+
+// ".csv" is Csv, anything else TodoTxt.
+auto TaskFormatOf (const std::filesystem::path& path) -> TaskFormat;
+
+// Appends tasks of @text not yet in @tasks, in order of first appearance.
+// Text is split at line ends into chunks parsed on separate threads, so
+// CSV fields can't span lines, such record counts as invalid.
+auto ImportTasks (std::string_view text, TaskFormat format, TaskStore& tasks) -> TaskImportResult;
+
+// Same over memory mapped file, nullopt when it can't be opened.
+auto ImportTasks (const std::filesystem::path& path, TaskStore& tasks) -> std::optional<TaskImportResult>;
+
+// Imports task lists on its own thread into a copy of the store, made on
+// that thread too, so caller keeps using its store meanwhile. Result has
+// all tasks of the store followed by imported ones, see First() and Take().
+class TaskImport
+{
+public:
+    struct Desc
+    {
+        std::vector<std::filesystem::path> paths; // missing files are skipped
+        std::shared_ptr<const TaskStore>   tasks; // current store, not modified
+
+        // Called on import thread once Tasks() is complete.
+        std::function<void ()> onDone = []{};
+    };
+
+private:
+    std::thread                      mThread;
+    std::shared_ptr<const TaskStore> mSource;
+    TaskStore                        mTasks;
+    uint32_t                         mFirst = 0;
+    uint32_t                         mAdded = 0;
+
+    TaskImport            (const TaskImport& rhs) = delete;
+    TaskImport& operator= (const TaskImport& rhs) = delete;
+
+public:
+    TaskImport  () = default;
+    ~TaskImport ();
+
+    // Blocks until import ends. Others below are valid only after it.
+    auto Wait () -> void;
+
+    // Store with imported tasks appended from First() on. It can take the
+    // place of Source() only while that is still caller's current store.
+    auto Tasks  () const -> const TaskStore& { return mTasks; }
+    auto Source () const -> const std::shared_ptr<const TaskStore>& { return mSource; }
+    auto First  () const { return mFirst; }
+    auto Added  () const { return mAdded; }
+
+    // Moves result out without copying, Tasks() is empty afterwards.
+    auto Take () -> TaskStore { return std::move(mTasks); }
+
+    static auto Start (Desc desc) -> std::unique_ptr<TaskImport>;
+};
+
+} // namespace Impulse
@@ -0,0 +1,135 @@
+#include "TaskListView.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Impulse {
+
+auto TaskListView::UpdateSlots () -> void
+{
+    if (mStore && mStore->Version() != mStoreVersion)
+    {
+        mStoreVersion = mStore->Version();
+        mScroll       = std::min(mScroll, MaxScroll());
+        InvalidateRows();
+    }
+
+    // One spare slot, partially visible rows at both ends need distinct ones.
+    const auto slots = mRowHeight > 0.0f
+        ? static_cast<size_t>(std::ceil(mHeight / mRowHeight)) + 1
+        : size_t(1);
+
+    if (mSlots.size() != slots)
+    {
+        mSlots.assign(slots, NO_TASK);
+    }
+}
+
+auto TaskListView::Store (const TaskStore* store) -> void
+{
+    mStore        = store;
+    mStoreVersion = store ? store->Version() : 0;
+    mScroll       = std::min(mScroll, MaxScroll());
+    InvalidateRows();
+}
+
+auto TaskListView::Size (float width, float height) -> void
+{
+    if (mWidth != width)
+    {
+        InvalidateRows();
+    }
+
+    mWidth  = width;
+    mHeight = height;
+    mScroll = std::min(mScroll, MaxScroll());
+}
+
+auto TaskListView::RowHeight (float height) -> void
+{
+    if (mRowHeight != height)
+    {
+        // Keep first visible task in place.
+        const auto first = static_cast<uint32_t>(mScroll / mRowHeight);
+
+        mRowHeight = height;
+        mScroll    = std::min(first * mRowHeight, MaxScroll());
+        InvalidateRows();
+    }
+}
+
+auto TaskListView::Scroll (float delta) -> bool
+{
+    // Three rows per wheel notch.
+    const auto scroll = std::clamp(mScroll - delta * 3.0f * mRowHeight, 0.0f, MaxScroll());
+    if (scroll == mScroll)
+    {
+        return false;
+    }
+
+    mScroll = scroll;
+    return true;
+}
+
+auto TaskListView::ScrollTo (uint32_t task) -> void
+{
+    if (!mStore || task >= mStore->Size())
+    {
+        return;
+    }
+
+    const auto top    = task * mRowHeight;
+    const auto bottom = top + mRowHeight;
+
+    if (top < mScroll)
+    {
+        mScroll = top;
+    }
+    else if (bottom > mScroll + mHeight)
+    {
+        mScroll = std::min(bottom - mHeight, MaxScroll());
+    }
+}
+
+auto TaskListView::VisibleRange () const -> std::pair<uint32_t, uint32_t>
+{
+    if (!mStore || mRowHeight <= 0.0f)
+    {
+        return { 0, 0 };
+    }
+
+    const auto count = mStore->Size();
+    const auto first = static_cast<uint32_t>(mScroll / mRowHeight);
+    const auto last  = static_cast<uint32_t>(std::ceil((mScroll + mHeight) / mRowHeight));
+
+    return { std::min(first, count), std::min(last, count) };
+}
+
+auto TaskListView::MaxScroll () const -> float
+{
+    if (!mStore)
+    {
+        return 0.0f;
+    }
+
+    return std::max(mStore->Size() * mRowHeight - mHeight, 0.0f);
+}
+
+auto TaskListView::TaskAt (float y) const -> uint32_t
+{
+    if (!mStore || mRowHeight <= 0.0f || y < 0.0f || mHeight < y)
+    {
+        return NO_TASK;
+    }
+
+    const auto task = static_cast<uint32_t>((y + mScroll) / mRowHeight);
+
+    return task < mStore->Size() ? task : NO_TASK;
+}
+
+auto TaskListView::InvalidateRows () -> void
+{
+    std::fill(mSlots.begin(), mSlots.end(), NO_TASK);
+}
+
+} // namespace Impulse
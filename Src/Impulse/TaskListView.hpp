@@ -0,0 +1,90 @@
+#pragma once
+
+#include "TaskStore.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Impulse {
+
+// Scroll position and row recycling of a task list, in list coordinates.
+// Only rows in view exist, so cost of a frame doesn't depend on number of
+// tasks. Row content (text layouts) is owned by the widget, PrepareRows()
+// tells it which slots need new content.
+class TaskListView
+{
+public:
+    static constexpr auto NO_TASK = std::numeric_limits<uint32_t>::max();
+
+private:
+    const TaskStore*      mStore        = nullptr;
+    float                 mWidth        = 0.0f;
+    float                 mHeight       = 0.0f;
+    float                 mRowHeight    = 24.0f;
+    float                 mScroll       = 0.0f;
+
+    // Task shown by each slot. Task i always uses slot i % slots, so slot
+    // keeps its content while its task stays in view.
+    std::vector<uint32_t> mSlots;
+    uint64_t              mStoreVersion = 0;
+    uint64_t              mRowsLaidOut  = 0;
+
+    auto UpdateSlots () -> void;
+
+public:
+    auto Store     (const TaskStore* store) -> void;
+    auto Size      (float width, float height) -> void;
+    auto RowHeight (float height) -> void;
+
+    // Scroll by wheel @delta (notches), false when already at the end.
+    auto Scroll   (float delta)   -> bool;
+    auto ScrollTo (uint32_t task) -> void;
+
+    // Range [first, last) of tasks at least partially in view.
+    auto VisibleRange () const -> std::pair<uint32_t, uint32_t>;
+    auto MaxScroll    () const -> float;
+
+    // Task at @y from top of the list, NO_TASK when there is none.
+    auto TaskAt (float y) const -> uint32_t;
+
+    // Top of @task row relative to top of the list.
+    auto RowTop (uint32_t task) const { return task * mRowHeight - mScroll; }
+
+    auto Slot  (uint32_t task) const { return static_cast<size_t>(task % mSlots.size()); }
+    auto Slots () const { return mSlots.size(); }
+
+    // Call @layout(slot, task) for visible tasks whose slot shows some other
+    // task (or nothing) yet.
+    template <typename Fn>
+    auto PrepareRows (uint32_t first, uint32_t last, Fn&& layout) -> void
+    {
+        UpdateSlots();
+
+        for (auto task = first; task < last; ++task)
+        {
+            const auto slot = Slot(task);
+            if (mSlots[slot] == task)
+            {
+                continue;
+            }
+
+            mSlots[slot]  = task;
+            mRowsLaidOut += 1;
+
+            layout(slot, task);
+        }
+    }
+
+    // Row content must be rebuilt, e.g. font or width changed.
+    auto InvalidateRows () -> void;
+
+    auto Width        () const { return mWidth; }
+    auto Height       () const { return mHeight; }
+    auto RowHeight    () const { return mRowHeight; }
+    auto ScrollOffset () const { return mScroll; }
+    auto RowsLaidOut  () const { return mRowsLaidOut; }
+};
+
+} // namespace Impulse
@@ -0,0 +1,31 @@
+#include "TaskStore.hpp"
+
+namespace Impulse {
+
+auto TaskStore::Reserve (size_t tasks, size_t characters) -> void
+{
+    mEntries.reserve(tasks);
+    mText.reserve(characters);
+}
+
+auto TaskStore::Add (std::wstring_view name) -> uint32_t
+{
+    const auto entry = Entry{
+        static_cast<uint32_t>(mText.size()),
+        static_cast<uint32_t>(name.size())
+    };
+
+    mText.insert(mText.end(), name.begin(), name.end());
+    mEntries.push_back(entry);
+
+    return static_cast<uint32_t>(mEntries.size() - 1);
+}
+
+auto TaskStore::Clear () -> void
+{
+    mText.clear();
+    mEntries.clear();
+    mVersion += 1;
+}
+
+} // namespace Impulse
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Impulse {
+
+// Task names packed into one character arena. Each task costs 8 bytes plus
+// its text, there is no per-task allocation, so backlogs with hundreds of
+// thousands of tasks stay compact.
+class TaskStore
+{
+    struct Entry
+    {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    std::vector<wchar_t> mText;
+    std::vector<Entry>   mEntries;
+    uint64_t             mVersion = 0;
+
+public:
+    auto Reserve (size_t tasks, size_t characters) -> void;
+
+    // Append task, returns its index.
+    auto Add   (std::wstring_view name) -> uint32_t;
+    auto Clear () -> void;
+
+    auto Get (uint32_t index) const -> std::wstring_view
+    {
+        const auto& entry = mEntries[index];
+        return std::wstring_view(mText.data() + entry.offset, entry.length);
+    }
+
+    auto Size  () const { return static_cast<uint32_t>(mEntries.size()); }
+    auto Empty () const { return mEntries.empty(); }
+
+    // Bumped when existing tasks change, views use it to drop cached rows.
+    // Appending keeps indices of existing tasks, so it doesn't count.
+    auto Version () const { return mVersion; }
+
+    auto MemoryUsage () const
+    {
+        return mText.capacity() * sizeof(wchar_t) + mEntries.capacity() * sizeof(Entry);
+    }
+};
+
+} // namespace Impulse
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <functional>
@@ -15,11 +16,16 @@ class Timer
     std::condition_variable   mPauseConditionVar;
     std::mutex                mPauseMutex;
     std::mutex                mTimerMutex;
+    std::mutex                mTickMutex;
 
     std::chrono::milliseconds mInterval = std::chrono::milliseconds(1000);
     std::chrono::milliseconds mDuration = std::chrono::milliseconds(0);
     bool                      mIsPaused = false;
 
+    // Duration and time of last tick, used to interpolate Remaining().
+    std::chrono::milliseconds             mTickDuration = std::chrono::milliseconds(0);
+    std::chrono::steady_clock::time_point mTickTime     = std::chrono::steady_clock::now();
+
     auto Worker () -> void
     {
         const auto _0ms = std::chrono::milliseconds(0);
@@ -31,6 +37,12 @@ class Timer
             {
                 if (mDuration >= _0ms)
                 {
+                    {
+                        auto guard = std::lock_guard<std::mutex>(mTickMutex);
+                        mTickDuration = mDuration;
+                        mTickTime     = std::chrono::steady_clock::now();
+                    }
+
                     OnTick();
 
                     mDuration -= mInterval;
@@ -158,11 +170,34 @@ public:
         {
             mDuration = duration;
         }
+
+        auto tickGuard = std::lock_guard<std::mutex>(mTickMutex);
+        mTickDuration = mDuration;
+        mTickTime     = std::chrono::steady_clock::now();
     }
 
     auto Interval () const { return mInterval; }
     auto Duration () const { return mDuration; }
 
+    // Remaining time with sub-interval resolution, Duration() changes only
+    // once per interval. Frozen while paused.
+    auto Remaining () -> std::chrono::milliseconds
+    {
+        auto guard     = std::lock_guard<std::mutex>(mTimerMutex);
+        auto tickGuard = std::lock_guard<std::mutex>(mTickMutex);
+
+        if (mIsDone || mIsPaused)
+        {
+            return mTickDuration;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - mTickTime
+        );
+
+        return std::max(mTickDuration - elapsed, std::min(mDuration, mTickDuration));
+    }
+
     auto IsRunning () -> bool
     {
         auto guard = std::lock_guard<std::mutex>(mTimerMutex);
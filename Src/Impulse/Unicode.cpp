@@ -0,0 +1,244 @@
+#include "Unicode.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <cstdint>
+#endif
+
+namespace {
+
+#if !defined(_WIN32)
+
+constexpr auto REPLACEMENT = char32_t(0xFFFD);
+
+auto AppendUTF8 (char32_t c, std::string& out) -> void
+{
+    if (c < 0x80)
+    {
+        out += static_cast<char>(c);
+    }
+    else if (c < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (c >> 6));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+    else if (c < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (c >> 12));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (c >> 18));
+        out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+}
+
+auto AppendWide (char32_t c, std::wstring& out) -> void
+{
+    if constexpr (sizeof(wchar_t) == 2)
+    {
+        if (c >= 0x10000)
+        {
+            c -= 0x10000;
+            out += static_cast<wchar_t>(0xD800 + (c >> 10));
+            out += static_cast<wchar_t>(0xDC00 + (c & 0x3FF));
+            return;
+        }
+    }
+
+    out += static_cast<wchar_t>(c);
+}
+
+// Next code point of @str at @i, advances @i past it. Malformed sequence
+// gives U+FFFD and skips only its first byte.
+auto DecodeUTF8 (std::string_view str, size_t& i) -> char32_t
+{
+    const auto lead = static_cast<uint8_t>(str[i++]);
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    const auto length = lead >= 0xF0 && lead <= 0xF4 ? 3
+                      : lead >= 0xE0 && lead <  0xF0 ? 2
+                      : lead >= 0xC2 && lead <  0xE0 ? 1
+                      :                                0;
+    if (length == 0 || i + length > str.size())
+    {
+        return REPLACEMENT;
+    }
+
+    auto c = static_cast<char32_t>(lead & (0x3F >> length));
+    for (auto k = 0; k < length; ++k)
+    {
+        const auto next = static_cast<uint8_t>(str[i + k]);
+        if ((next & 0xC0) != 0x80)
+        {
+            return REPLACEMENT;
+        }
+
+        c = (c << 6) | (next & 0x3F);
+    }
+
+    // Overlong forms, surrogates and values past Unicode range.
+    const auto overlong = (length == 2 && c < 0x800) || (length == 3 && c < 0x10000);
+    if (overlong || (c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF)
+    {
+        return REPLACEMENT;
+    }
+
+    i += length;
+    return c;
+}
+
+#endif
+
+}
+
+namespace Impulse {
+
+#if defined(_WIN32)
+
+auto UTF8ToUTF16 (const std::string_view str) -> std::optional<std::wstring>
+{
+    // Get size.
+    auto size = ::MultiByteToWideChar(
+        CP_UTF8,
+        0,
+        str.data(),
+        static_cast<int>(str.size()),
+        nullptr,
+        0
+    );
+
+    if (size <= 0)
+    {
+        return std::nullopt;
+    }
+
+    // Convert.
+    auto utf16 = std::wstring(size, L'\0');
+    auto ret = ::MultiByteToWideChar(
+        CP_UTF8,
+        0,
+        str.data(),
+        static_cast<int>(str.size()),
+        utf16.data(),
+        static_cast<int>(utf16.size())
+    );
+
+    if (ret == 0)
+    {
+        return std::nullopt;
+    }
+
+    return utf16;
+}
+
+auto UTF16ToUTF8 (const std::wstring_view str) -> std::optional<std::string>
+{
+    // Get size.
+    auto size = ::WideCharToMultiByte(
+        CP_UTF8,
+        0,
+        str.data(),
+        static_cast<int>(str.size()),
+        nullptr,
+        0,
+        nullptr,
+        nullptr
+    );
+
+    if (size <= 0)
+    {
+        return std::nullopt;
+    }
+    
+    // Convert.
+    auto utf8 = std::string(size, '\0');
+    auto ret = ::WideCharToMultiByte(
+        CP_UTF8,
+        0,
+        str.data(),
+        static_cast<int>(str.size()),
+        utf8.data(),
+        static_cast<int>(utf8.size()),
+        nullptr,
+        nullptr
+    );
+
+    if (ret == 0)
+    {
+        return std::nullopt;
+    }
+
+    return utf8;
+}
+
+#else
+
+auto UTF8ToUTF16 (const std::string_view str) -> std::optional<std::wstring>
+{
+    if (str.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto wide = std::wstring();
+    wide.reserve(str.size());
+
+    for (auto i = size_t(0); i < str.size();)
+    {
+        AppendWide(DecodeUTF8(str, i), wide);
+    }
+
+    return wide;
+}
+
+auto UTF16ToUTF8 (const std::wstring_view str) -> std::optional<std::string>
+{
+    if (str.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto utf8 = std::string();
+    utf8.reserve(str.size());
+
+    for (auto i = size_t(0); i < str.size(); ++i)
+    {
+        auto c = static_cast<char32_t>(str[i]);
+
+        // Surrogate pairs only occur with 16-bit wchar_t, lone ones are
+        // invalid.
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < str.size())
+        {
+            const auto low = static_cast<char32_t>(str[i + 1]);
+            if (low >= 0xDC00 && low <= 0xDFFF)
+            {
+                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                i += 1;
+            }
+        }
+
+        if ((c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF)
+        {
+            c = REPLACEMENT;
+        }
+
+        AppendUTF8(c, utf8);
+    }
+
+    return utf8;
+}
+
+#endif
+
+} // namespace Impulse
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Impulse {
+
+// Conversions between UTF-8 and wide strings, UTF-16 on Windows and UTF-32
+// elsewhere. Invalid sequences become U+FFFD. Empty input gives nullopt,
+// same as the Win32 functions they wrap.
+auto UTF8ToUTF16 (const std::string_view str) -> std::optional<std::wstring>;
+auto UTF16ToUTF8 (const std::wstring_view str) -> std::optional<std::string>;
+
+} // namespace Impulse
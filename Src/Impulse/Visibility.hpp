@@ -0,0 +1,161 @@
+#pragma once
+
+#include <functional>
+
+namespace Impulse {
+
+enum class Visibility : unsigned char
+{
+    Visible,
+    Occluded,
+    Minimized,
+    SessionLocked
+};
+
+// Tracks whether window content can be seen. Platform layer reports each
+// condition separately, they can overlap (e.g. minimized window on locked
+// session), the most restrictive one is reported by State().
+//
+// Nothing is rendered or presented while not visible. When window becomes
+// visible again exactly one catch-up frame is requested.
+class VisibilityTracker
+{
+    bool mOccluded      = false;
+    bool mMinimized     = false;
+    bool mSessionLocked = false;
+    bool mCatchUpFrame  = false;
+
+    // Apply @value to @condition, return true when visibility changed.
+    auto Set (bool& condition, bool value) -> bool
+    {
+        if (condition == value)
+        {
+            return false;
+        }
+
+        const auto wasVisible = IsVisible();
+        condition = value;
+
+        const auto visible = IsVisible();
+        if (!wasVisible && visible)
+        {
+            mCatchUpFrame = true;
+        }
+
+        return wasVisible != visible;
+    }
+
+public:
+    auto Occluded      (bool occluded)  -> bool { return Set(mOccluded, occluded); }
+    auto Minimized     (bool minimized) -> bool { return Set(mMinimized, minimized); }
+    auto SessionLocked (bool locked)    -> bool { return Set(mSessionLocked, locked); }
+
+    auto IsOccluded      () const { return mOccluded; }
+    auto IsMinimized     () const { return mMinimized; }
+    auto IsSessionLocked () const { return mSessionLocked; }
+
+    auto IsVisible () const -> bool { return !mOccluded && !mMinimized && !mSessionLocked; }
+
+    auto State () const
+    {
+        if (mSessionLocked) { return Visibility::SessionLocked; }
+        if (mMinimized)     { return Visibility::Minimized; }
+        if (mOccluded)      { return Visibility::Occluded; }
+
+        return Visibility::Visible;
+    }
+
+    // Returns true once after window became visible again.
+    auto ConsumeCatchUpFrame () -> bool
+    {
+        const auto catchUp = mCatchUpFrame;
+        mCatchUpFrame = false;
+        return catchUp;
+    }
+};
+
+// Feeds platform events into VisibilityTracker. Occlusion is only known
+// from Present(), window stays hidden until platform reports it can be seen
+// again, so it's only marked occluded when that report can be watched for.
+//
+// Knows nothing about DXGI or window messages, platform is reached through
+// Desc callbacks so it can be driven by a fake platform layer.
+class VisibilityController
+{
+public:
+    struct Desc
+    {
+        std::function<bool ()>     watchOcclusion   = []{ return false; }; // register for "occlusion ended" report
+        std::function<void ()>     unwatchOcclusion = []{};
+        std::function<bool ()>     stillOccluded    = []{ return false; }; // test present after the report
+        std::function<void ()>     catchUp          = []{};                // request single frame
+        std::function<void (bool)> changed          = [](bool){};          // window became visible or hidden
+    };
+
+private:
+    Desc              mDesc;
+    VisibilityTracker mTracker;
+
+    auto Update (bool changed) -> void
+    {
+        if (changed)
+        {
+            mDesc.changed(mTracker.IsVisible());
+        }
+
+        // Hidden frames were dropped, single frame brings window up to date.
+        if (mTracker.ConsumeCatchUpFrame())
+        {
+            mDesc.catchUp();
+        }
+    }
+
+public:
+    VisibilityController () = default;
+    explicit VisibilityController (const Desc& desc)
+        : mDesc (desc)
+    {
+    }
+
+    auto Minimized     (bool minimized) -> void { Update(mTracker.Minimized(minimized)); }
+    auto SessionLocked (bool locked)    -> void { Update(mTracker.SessionLocked(locked)); }
+
+    // Frame was presented, @occluded when Present() said nobody can see it.
+    auto Presented (bool occluded) -> void
+    {
+        if (occluded && !mTracker.IsOccluded() && mDesc.watchOcclusion())
+        {
+            Update(mTracker.Occluded(true));
+        }
+    }
+
+    // Platform reported occlusion status changed, it may still be occluded.
+    auto OcclusionStatus () -> void
+    {
+        if (!mTracker.IsOccluded() || mDesc.stillOccluded())
+        {
+            return;
+        }
+
+        mDesc.unwatchOcclusion();
+        Update(mTracker.Occluded(false));
+    }
+
+    // Swap chain was released, new one reports occlusion again.
+    auto SwapChainReleased () -> void
+    {
+        if (!mTracker.IsOccluded())
+        {
+            return;
+        }
+
+        mDesc.unwatchOcclusion();
+        Update(mTracker.Occluded(false));
+    }
+
+    auto IsVisible () const { return mTracker.IsVisible(); }
+    auto State     () const { return mTracker.State(); }
+    auto Tracker   () const -> const VisibilityTracker& { return mTracker; }
+};
+
+} // namespace Impulse
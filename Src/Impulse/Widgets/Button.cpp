@@ -9,20 +9,20 @@
 
 namespace Impulse::Widgets {
 
-auto Button::CreateBrushes (const Button::Desc& desc) -> bool
+auto Button::CreateBrushes () -> bool
 {
     auto hr = S_OK;
 
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.defaultTextColor    , &mDefaultTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.defaultOutlineColor , &mDefaultOutlineBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.hoverTextColor      , &mHoverTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.hoverOutlineColor   , &mHoverOutlineBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.activeTextColor     , &mActiveTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.activeOutlineColor  , &mActiveOutlineBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.focusTextColor      , &mFocusTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.focusOutlineColor   , &mFocusOutlineBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.disabledTextColor   , &mDisabledTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.disabledOutlineColor, &mDisabledOutlineBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mDefaultTextColor    , &mDefaultTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mDefaultOutlineColor , &mDefaultOutlineBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mHoverTextColor      , &mHoverTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mHoverOutlineColor   , &mHoverOutlineBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mActiveTextColor     , &mActiveTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mActiveOutlineColor  , &mActiveOutlineBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mFocusTextColor      , &mFocusTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mFocusOutlineColor   , &mFocusOutlineBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mDisabledTextColor   , &mDisabledTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mDisabledOutlineColor, &mDisabledOutlineBrush);
     if (FAILED(hr))
     {
         spdlog::error("CreateSolidColorBrush() failed: {}", DX::GetErrorMessage(hr));
@@ -56,7 +56,7 @@ auto Button::CreateTextFormats (const Button::Desc& desc) -> bool
     return true;
 }
 
-auto Button::CrateSvg (const Button::Desc& desc) -> bool
+auto Button::CrateSvg () -> bool
 {
     auto d2ddc5 = static_cast<ID2D1DeviceContext5*>(mD2DDeviceContext);
     if (!d2ddc5)
@@ -71,9 +71,9 @@ auto Button::CrateSvg (const Button::Desc& desc) -> bool
     //    spdlog::error("SHCreateStreamOnFileEx() failed: {}", DX::GetErrorMessage(hr));
     //    return false;
     //}
-    if (desc.svg0 != 0)
+    if (mSvg0 != 0)
     {
-        const auto data = LoadSvgFromResource(desc.svg0);
+        const auto data = LoadSvgFromResource(mSvg0);
         if (data.empty())
         {
             spdlog::error("Failed to load svg from resource");
@@ -97,9 +97,9 @@ auto Button::CrateSvg (const Button::Desc& desc) -> bool
         }
     }
 
-    if (desc.svg1 != 0)
+    if (mSvg1 != 0)
     {
-        const auto data = LoadSvgFromResource(desc.svg1);
+        const auto data = LoadSvgFromResource(mSvg1);
         if (data.empty())
         {
             spdlog::error("Failed to load svg from resource");
@@ -126,6 +126,65 @@ auto Button::CrateSvg (const Button::Desc& desc) -> bool
     return true;
 }
 
+auto Button::IconRaster (int icon, uint32_t pixels, float dpi) -> ID2D1Bitmap1*
+{
+    const auto key = (pixels << 1) | (icon == 0 ? 0u : 1u);
+    if (auto raster = mIconRasters.Find(key))
+    {
+        return raster->Get();
+    }
+
+    auto raster = RasterizeIcon(icon == 0 ? mSvgIcon0.Get() : mSvgIcon1.Get(), pixels, dpi);
+    if (!raster)
+    {
+        return nullptr;
+    }
+
+    return mIconRasters.Insert(key, raster).Get();
+}
+
+auto Button::RasterizeIcon (ID2D1SvgDocument* svg, uint32_t pixels, float dpi) -> ComPtr<ID2D1Bitmap1>
+{
+    auto d2ddc5 = static_cast<ID2D1DeviceContext5*>(mD2DDeviceContext);
+    if (!d2ddc5 || !svg || pixels == 0)
+    {
+        return nullptr;
+    }
+
+    const auto props = D2D1::BitmapProperties1(
+        D2D1_BITMAP_OPTIONS_TARGET,
+        D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED),
+        dpi,
+        dpi
+    );
+
+    auto raster = ComPtr<ID2D1Bitmap1>();
+    auto hr = d2ddc5->CreateBitmap(D2D1::SizeU(pixels, pixels), nullptr, 0, props, &raster);
+    if (FAILED(hr))
+    {
+        spdlog::error("CreateBitmap() failed: {}", DX::GetErrorMessage(hr));
+        return nullptr;
+    }
+
+    // Render into the bitmap in the middle of frame, then put frame target back.
+    auto target    = ComPtr<ID2D1Image>();
+    auto transform = D2D1::Matrix3x2F();
+    d2ddc5->GetTarget(&target);
+    d2ddc5->GetTransform(&transform);
+
+    const auto s = (pixels * 96.f / dpi) / 32.f;
+
+    d2ddc5->SetTarget(raster.Get());
+    d2ddc5->SetTransform(D2D1::Matrix3x2F::Scale(s, s));
+    d2ddc5->Clear(D2D1::ColorF(0, 0.0f));
+    d2ddc5->DrawSvgDocument(svg);
+
+    d2ddc5->SetTarget(target.Get());
+    d2ddc5->SetTransform(transform);
+
+    return raster;
+}
+
 auto Button::CreateTextFormat (
     const WCHAR*        fontName,
     FLOAT               fontSize,
@@ -172,6 +231,22 @@ auto Button::CreateBrush (D2D_COLOR_F color) -> ComPtr<ID2D1SolidColorBrush>
     return brush;
 }
 
+auto Button::Update (Widget::State state) -> bool
+{
+    if (!Widget::Update(state))
+    {
+        return false;
+    }
+
+    const auto outline = (state == State::Hover || state == State::Active) ? 1.0f : 0.0f;
+    const auto press   = (state == State::Active) ? 0.9f : 1.0f;
+
+    mOutlineOpacity.AnimateTo(outline, std::chrono::milliseconds(150), mScheduler);
+    mPressScale.AnimateTo(press, std::chrono::milliseconds(80), mScheduler);
+
+    return true;
+}
+
 auto Button::HitTest (D2D_POINT_2F point) -> bool
 {
     const auto rect = Rect();
@@ -185,8 +260,12 @@ auto Button::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
 {
     auto draw = [&](ComPtr<ID2D1SolidColorBrush> textBrush, ComPtr<ID2D1SolidColorBrush> outlineBrush)
     {
-        if (mForceOutline || (mIntelOutline && (mState == State::Hover || mState == State::Active)))
+        // Outline fades in/out with hover, see Update().
+        const auto outlineOpacity = mForceOutline ? 1.0f : mOutlineOpacity.Value();
+        if (mForceOutline || (mIntelOutline && outlineOpacity > 0.0f))
         {
+            outlineBrush->SetOpacity(outlineOpacity);
+
             if (mRoundedCorners)
             {
                 auto rr = D2D1::RoundedRect(Rect(), mRoundedRadius, mRoundedRadius);
@@ -196,10 +275,21 @@ auto Button::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
             {
                 d2dDeviceContext->DrawRectangle(Rect(), outlineBrush.Get());
             }
+
+            outlineBrush->SetOpacity(1.0f);
         }
 
+        // Content shrinks a bit when pressed.
+        const auto press  = mPressScale.Value();
+        const auto center = D2D1::Point2F(
+            mPosition.x + (mSize.width / 2), mPosition.y + (mSize.height / 2)
+        );
+        const auto pressTransform = D2D1::Matrix3x2F::Scale(D2D1::SizeF(press, press), center);
+
         if (!mSvgIcon0)
         {
+            d2dDeviceContext->SetTransform(pressTransform);
+
             d2dDeviceContext->DrawTextW(
                 mText.c_str(),
                 mText.length(),
@@ -208,6 +298,8 @@ auto Button::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
                 textBrush.Get(),
                 D2D1_DRAW_TEXT_OPTIONS_CLIP | D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT
             );
+
+            d2dDeviceContext->SetTransform(D2D1::Matrix3x2F::Identity());
         }
         else
         {
@@ -220,15 +312,32 @@ auto Button::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
             auto dpiY = FLOAT{0};
             d2ddc5->GetDpi(&dpiX, &dpiY);
             
-            const auto pad = ceil(4.f * dpiX / 96.f);
-            const auto s = (mSize.width - 2*pad) / 32.f;
-            const auto dx = mPosition.x + pad;
-            const auto dy = mPosition.y + pad;
+            const auto pad    = ceil(4.f * dpiX / 96.f);
+            const auto extent = mSize.width - 2*pad;
+            const auto dx     = mPosition.x + pad;
+            const auto dy     = mPosition.y + pad;
+
+            // Svg is rasterized once per size and dpi, not parsed and
+            // tessellated every frame.
+            const auto pixels = static_cast<uint32_t>(ceil(extent * dpiX / 96.f));
+            if (auto raster = IconRaster(mIconId, pixels, dpiX))
+            {
+                d2ddc5->SetTransform(pressTransform);
+                d2ddc5->DrawBitmap(
+                    raster,
+                    D2D1::RectF(dx, dy, dx + extent, dy + extent),
+                    1.0f,
+                    D2D1_INTERPOLATION_MODE_LINEAR
+                );
+                d2ddc5->SetTransform(D2D1::Matrix3x2F::Identity());
+                return;
+            }
 
+            const auto s         = extent / 32.f;
             const auto scale     = D2D1::Matrix3x2F::Scale(s, s);
             const auto translate = D2D1::Matrix3x2F::Translation(dx, dy);
             
-            d2ddc5->SetTransform(scale * translate);
+            d2ddc5->SetTransform(scale * translate * pressTransform);
 
             if (mIconId == 0)
                 d2ddc5->DrawSvgDocument(mSvgIcon0.Get());
@@ -263,6 +372,45 @@ auto Button::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
     }
 }
 
+auto Button::CreateDeviceResources (ID2D1DeviceContext* d2dDeviceContext) -> bool
+{
+    mD2DDeviceContext = d2dDeviceContext;
+
+    if (!CreateBrushes())
+    {
+        return false;
+    }
+
+    if (mSvg0 != 0)
+    {
+        if (!CrateSvg())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+auto Button::DiscardDeviceResources () -> void
+{
+    mDefaultTextBrush     = nullptr;
+    mDefaultOutlineBrush  = nullptr;
+    mHoverTextBrush       = nullptr;
+    mHoverOutlineBrush    = nullptr;
+    mActiveTextBrush      = nullptr;
+    mActiveOutlineBrush   = nullptr;
+    mFocusTextBrush       = nullptr;
+    mFocusOutlineBrush    = nullptr;
+    mDisabledTextBrush    = nullptr;
+    mDisabledOutlineBrush = nullptr;
+    mSvgIcon0             = nullptr;
+    mSvgIcon1             = nullptr;
+    mIconRasters.Clear();
+
+    mD2DDeviceContext = nullptr;
+}
+
 auto Button::Create (
     const Button::Desc& desc,
     ID2D1DeviceContext* d2dDeviceContext,
@@ -290,34 +438,38 @@ auto Button::Create (
 
     button->mPosition = desc.position;
     button->mSize     = desc.size;
-    button->mText     = desc.text;
+    button->mText.Assign(desc.text);
     
     button->mForceOutline   = desc.forceOutline;
     button->mIntelOutline   = desc.intelOutline;
     button->mRoundedCorners = desc.roundedCorners;
     button->mRoundedRadius  = desc.roundedRadius;
 
+    button->mDefaultTextColor     = desc.defaultTextColor;
+    button->mDefaultOutlineColor  = desc.defaultOutlineColor;
+    button->mHoverTextColor       = desc.hoverTextColor;
+    button->mHoverOutlineColor    = desc.hoverOutlineColor;
+    button->mActiveTextColor      = desc.activeTextColor;
+    button->mActiveOutlineColor   = desc.activeOutlineColor;
+    button->mFocusTextColor       = desc.focusTextColor;
+    button->mFocusOutlineColor    = desc.focusOutlineColor;
+    button->mDisabledTextColor    = desc.disabledTextColor;
+    button->mDisabledOutlineColor = desc.disabledOutlineColor;
+    button->mSvg0                 = desc.svg0;
+    button->mSvg1                 = desc.svg1;
+
     // Create TextFormat.
     if (!button->CreateTextFormats(desc))
     {
         return nullptr;
     }
 
-    // Create Brushes.
-    if (!button->CreateBrushes(desc))
+    // Create Brushes and svg icons.
+    if (!button->CreateDeviceResources(d2dDeviceContext))
     {
         return nullptr;
     }
 
-    // Create svg icon.
-    if (desc.svg0 != 0)
-    {
-        if (!button->CrateSvg(desc))
-        {
-            return nullptr;
-        }
-    }
-
     spdlog::debug("Button created");
 
     return button;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FixedString.hpp"
+#include "LruCache.hpp"
 #include "Widget.hpp"
 
 #include <memory>
@@ -55,7 +57,7 @@ public:
 private:
     D2D_POINT_2F        mPosition             = D2D1::Point2F();
     D2D_SIZE_F          mSize                 = D2D1::SizeF();
-    std::wstring        mText                 = L"";
+    FixedWString<16>    mText;
 
     bool                mForceOutline         = false;
     bool                mIntelOutline         = true;
@@ -63,7 +65,26 @@ private:
     float               mRoundedRadius        = 1.0f;
     int                 mIconId               = 0;
 
+    D2D_COLOR_F         mDefaultTextColor     = {0};
+    D2D_COLOR_F         mDefaultOutlineColor  = {0};
+    D2D_COLOR_F         mHoverTextColor       = {0};
+    D2D_COLOR_F         mHoverOutlineColor    = {0};
+    D2D_COLOR_F         mActiveTextColor      = {0};
+    D2D_COLOR_F         mActiveOutlineColor   = {0};
+    D2D_COLOR_F         mFocusTextColor       = {0};
+    D2D_COLOR_F         mFocusOutlineColor    = {0};
+    D2D_COLOR_F         mDisabledTextColor    = {0};
+    D2D_COLOR_F         mDisabledOutlineColor = {0};
+    int                 mSvg0                 = 0;
+    int                 mSvg1                 = 0;
+
+    AnimatedValue       mOutlineOpacity       = AnimatedValue(0.0f);
+    AnimatedValue       mPressScale           = AnimatedValue(1.0f);
+
+    // Current text format and ones used before, by font size.
     ComPtr<IDWriteTextFormat>    mTextFormat;
+    LruCache<float, ComPtr<IDWriteTextFormat>> mTextFormats;
+
     ComPtr<ID2D1SolidColorBrush> mDefaultTextBrush;
     ComPtr<ID2D1SolidColorBrush> mDefaultOutlineBrush;
     ComPtr<ID2D1SolidColorBrush> mHoverTextBrush;
@@ -77,13 +98,20 @@ private:
     ComPtr<ID2D1SvgDocument>     mSvgIcon0;
     ComPtr<ID2D1SvgDocument>     mSvgIcon1;
 
+    // Icons rasterized at pixel size they are drawn at, key is
+    // (pixels << 1 | icon). One entry per icon and dpi.
+    LruCache<uint32_t, ComPtr<ID2D1Bitmap1>> mIconRasters = LruCache<uint32_t, ComPtr<ID2D1Bitmap1>>(8);
+
     ID2D1DeviceContext* mD2DDeviceContext = nullptr;
     IDWriteFactory*     mDWriteFactory    = nullptr;
 
 private:
-    auto CreateBrushes     (const Button::Desc& desc) -> bool;
+    auto CreateBrushes     ()                         -> bool;
     auto CreateTextFormats (const Button::Desc& desc) -> bool;
-    auto CrateSvg          (const Button::Desc& desc) -> bool;
+    auto CrateSvg          ()                         -> bool;
+
+    auto IconRaster    (int icon, uint32_t pixels, float dpi)                  -> ID2D1Bitmap1*;
+    auto RasterizeIcon (ID2D1SvgDocument* svg, uint32_t pixels, float dpi) -> ComPtr<ID2D1Bitmap1>;
 
     auto CreateBrush      (D2D_COLOR_F color) -> ComPtr<ID2D1SolidColorBrush>;
     auto CreateTextFormat (
@@ -101,12 +129,19 @@ public:
 
     auto Position (float x, float y)  { mPosition.x = x; mPosition.y = y; }
     auto Size     (float w, float h)  { mSize.width  = w; mSize.height = h; }
-    auto Text     (std::wstring text) { mText = std::move(text); }
+    auto Text     (std::wstring_view text) { mText.Assign(text); }
 
     auto SetIcon  (int id) { mIconId = id; }
 
+    // Formats are kept per size, going back to a known dpi creates nothing.
     auto FontSize (float size) -> bool
     {
+        if (auto textFormat = mTextFormats.Find(size))
+        {
+            mTextFormat = *textFormat;
+            return true;
+        }
+
         auto length   = static_cast<size_t>(mTextFormat->GetFontFamilyNameLength());
         auto fontName = std::wstring(length + 1, '\0');
         if (FAILED(mTextFormat->GetFontFamilyName(fontName.data(), fontName.length())))
@@ -124,13 +159,14 @@ public:
         if (textFormat)
         {
             mTextFormat = textFormat;
+            mTextFormats.Insert(size, textFormat);
             return true;
         }
 
         return false;
     }
 
-    const auto& Text  () const { return mText; }
+    const auto  Text  () const { return mText.view(); }
     const auto  Rect  () const
     {
         return D2D1::RectF(
@@ -141,8 +177,13 @@ public:
         );
     }
 
+    virtual auto Update  (Widget::State state)                  -> bool override;
     virtual auto HitTest (D2D_POINT_2F point)                   -> bool override;
     virtual auto Draw    (ID2D1DeviceContext* d2dDeviceContext) -> void override;
+    virtual auto Bounds  () const                               -> D2D1_RECT_F override { return Rect(); }
+
+    virtual auto CreateDeviceResources  (ID2D1DeviceContext* d2dDeviceContext) -> bool override;
+    virtual auto DiscardDeviceResources ()                                     -> void override;
 
     static auto Create (
         const Button::Desc& desc,
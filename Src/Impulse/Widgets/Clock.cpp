@@ -3,40 +3,84 @@
 
 #include "DX.hpp"
 
+#include <algorithm>
+
 #include <spdlog/spdlog.h>
 
-namespace Impulse::Widgets {
+namespace {
+
+constexpr auto PI = 3.14159265358979f;
 
-auto Clock::DurationToString() -> std::wstring
+// Annular sector between @innerRadius and @outerRadius. Angles are in radians,
+// 0 is at 12 o'clock and they grow clockwise.
+auto CreateRingSegment (
+    ID2D1Factory*  factory,
+    D2D1_POINT_2F  center,
+    float          innerRadius,
+    float          outerRadius,
+    float          fromAngle,
+    float          toAngle
+) -> ComPtr<ID2D1PathGeometry>
 {
-    const auto original = std::chrono::duration_cast<std::chrono::seconds>(mTimer->Duration());
-    const auto negative = original < std::chrono::seconds(0);
-    const auto duration = negative ? std::chrono::abs(original) : original;
+    auto point = [&](float radius, float angle)
+    {
+        return D2D1::Point2F(
+            center.x + radius * std::sin(angle), center.y - radius * std::cos(angle)
+        );
+    };
 
-    const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(original).count();
-    const auto seconds = original % 60;
-    auto str = std::wstring();
+    auto geometry = ComPtr<ID2D1PathGeometry>();
+    auto sink     = ComPtr<ID2D1GeometrySink>();
 
-    if (negative)
+    if (FAILED(factory->CreatePathGeometry(&geometry)) || FAILED(geometry->Open(&sink)))
     {
-        str += L"-";
+        return nullptr;
     }
 
-    if (minutes < 10)
+    // Arcs are split in half, so full circle doesn't degenerate.
+    const auto midAngle = (fromAngle + toAngle) / 2.0f;
+    const auto outer    = D2D1::SizeF(outerRadius, outerRadius);
+    const auto inner    = D2D1::SizeF(innerRadius, innerRadius);
+
+    sink->BeginFigure(point(outerRadius, fromAngle), D2D1_FIGURE_BEGIN_FILLED);
+    sink->AddArc(D2D1::ArcSegment(
+        point(outerRadius, midAngle), outer, 0.0f, D2D1_SWEEP_DIRECTION_CLOCKWISE, D2D1_ARC_SIZE_SMALL
+    ));
+    sink->AddArc(D2D1::ArcSegment(
+        point(outerRadius, toAngle), outer, 0.0f, D2D1_SWEEP_DIRECTION_CLOCKWISE, D2D1_ARC_SIZE_SMALL
+    ));
+    sink->AddLine(point(innerRadius, toAngle));
+    sink->AddArc(D2D1::ArcSegment(
+        point(innerRadius, midAngle), inner, 0.0f, D2D1_SWEEP_DIRECTION_COUNTER_CLOCKWISE, D2D1_ARC_SIZE_SMALL
+    ));
+    sink->AddArc(D2D1::ArcSegment(
+        point(innerRadius, fromAngle), inner, 0.0f, D2D1_SWEEP_DIRECTION_COUNTER_CLOCKWISE, D2D1_ARC_SIZE_SMALL
+    ));
+    sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+
+    if (FAILED(sink->Close()))
     {
-        str += L"0";
+        return nullptr;
     }
-    str += std::to_wstring(minutes);
-    
-    str += L":";
 
-    if (seconds < std::chrono::seconds(10))
-    {
-        str += L"0";
-    }
-    str += std::to_wstring(seconds.count());
-    
-    return std::move(str);
+    return geometry;
+}
+
+}
+
+namespace Impulse::Widgets {
+
+auto Clock::ProgressAnimation::Step (AnimationClock::time_point now) -> bool
+{
+    // Request frame only when ring end moved to next step, sleep until then.
+    const auto progress = mClock->Progress();
+
+    mChanged  = progress.step != mClock->mDrawnStep;
+    mWakeTime = progress.next == AnimationClock::duration::max()
+              ? AnimationClock::time_point::max()
+              : now + progress.next;
+
+    return mClock->mTimer->IsRunning();
 }
 
 auto Clock::CreateBrushes () -> bool
@@ -47,6 +91,7 @@ auto Clock::CreateBrushes () -> bool
     hr = mD2DDeviceContext->CreateSolidColorBrush(mOuterOutlineColor, &mOuterOutlineBrush);
     hr = mD2DDeviceContext->CreateSolidColorBrush(mInnerCircleColor , &mInnerCircleBrush);
     hr = mD2DDeviceContext->CreateSolidColorBrush(mInnerOutlineColor, &mInnerOutlineBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mProgressColor    , &mProgressBrush);
     if (FAILED(hr))
     {
         spdlog::error("CreateSolidColorBrush() failed: {}", DX::GetErrorMessage(hr));
@@ -70,6 +115,103 @@ auto Clock::CreateBrush (D2D_COLOR_F color) -> ComPtr<ID2D1SolidColorBrush>
     return brush;
 }
 
+auto Clock::Progress () -> SteppedProgress
+{
+    return ClockFace::Progress(*mEngine, mTimer->Remaining());
+}
+
+auto Clock::DrawProgress (ID2D1DeviceContext* d2dDeviceContext, int step) -> void
+{
+    const auto whole   = step / RING_SUBSTEPS;
+    const auto partial = step % RING_SUBSTEPS;
+    const auto angle   = 2.0f * PI / RING_SEGMENTS;
+
+    // Clock moved or resized.
+    if (mRingSegments < 0)
+    {
+        mPartialGeometries   = PartialGeometries();
+        mPartialRealizations = PartialRealizations();
+    }
+
+    // Whole segments change only every 1/RING_SEGMENTS of phase duration.
+    if (whole != mRingSegments)
+    {
+        mRingGeometry    = nullptr;
+        mRingRealization = nullptr;
+        mRingSegments    = whole;
+
+        if (whole > 0)
+        {
+            mRingGeometry = CreateRingSegment(
+                mD2DFactory.Get(), mCenter, mInnerRadius, mOuterRadius, 0.0f, whole * angle
+            );
+        }
+    }
+
+    if (mRingGeometry)
+    {
+        DrawRingPart(d2dDeviceContext, mRingGeometry.Get(), mRingRealization);
+    }
+
+    if (partial > 0)
+    {
+        auto& geometry = mPartialGeometries[partial];
+        if (!geometry)
+        {
+            geometry = CreateRingSegment(
+                mD2DFactory.Get(), mCenter, mInnerRadius, mOuterRadius,
+                0.0f, partial * angle / RING_SUBSTEPS
+            );
+        }
+
+        if (geometry)
+        {
+            auto transform = D2D1::Matrix3x2F();
+            d2dDeviceContext->GetTransform(&transform);
+
+            const auto degrees = whole * 360.0f / RING_SEGMENTS;
+            d2dDeviceContext->SetTransform(D2D1::Matrix3x2F::Rotation(degrees, mCenter) * transform);
+
+            DrawRingPart(d2dDeviceContext, geometry.Get(), mPartialRealizations[partial]);
+
+            d2dDeviceContext->SetTransform(transform);
+        }
+    }
+
+    mDrawnStep = step;
+}
+
+auto Clock::DrawRingPart (
+    ID2D1DeviceContext*               d2dDeviceContext,
+    ID2D1PathGeometry*                geometry,
+    ComPtr<ID2D1GeometryRealization>& realization
+) -> void
+{
+    auto d2ddc1 = static_cast<ID2D1DeviceContext1*>(d2dDeviceContext);
+
+    // Realization is device dependent, it's dropped on device loss.
+    if (!realization)
+    {
+        auto dpiX = FLOAT{0};
+        auto dpiY = FLOAT{0};
+        d2ddc1->GetDpi(&dpiX, &dpiY);
+
+        const auto tolerance = D2D1::ComputeFlatteningTolerance(
+            D2D1::Matrix3x2F::Identity(), dpiX, dpiY
+        );
+        d2ddc1->CreateFilledGeometryRealization(geometry, tolerance, &realization);
+    }
+
+    if (realization)
+    {
+        d2ddc1->DrawGeometryRealization(realization.Get(), mProgressBrush.Get());
+    }
+    else
+    {
+        d2dDeviceContext->FillGeometry(geometry, mProgressBrush.Get());
+    }
+}
+
 auto Clock::HitTest (D2D_POINT_2F point) -> bool
 {
     const auto dx = mCenter.x - point.x;
@@ -94,6 +236,7 @@ auto Clock::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
     {
         d2dDeviceContext->DrawEllipse(outer, pOuterOutlineBrush, mOuterStroke);
         d2dDeviceContext->FillEllipse(outer, pOuterBrush);
+        DrawProgress(d2dDeviceContext, Progress().step);
         d2dDeviceContext->DrawEllipse(inner, pInnerOutlineBrush, mInnerStroke);
         d2dDeviceContext->FillEllipse(inner, pInnerBrush);
     };
@@ -106,31 +249,67 @@ auto Clock::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
         mInnerOutlineBrush.Get()
     );
 
+    // Keep ring moving between timer ticks.
+    if (mScheduler && mTimer->IsRunning())
+    {
+        mScheduler->Start(&mProgressAnimation);
+    }
+
     // Draw Texts.
-    if (mSettings->CurrentState == ImpulseState::Paused)
+    if (mEngine->State() == ImpulseState::Paused)
     {
         mStaticTop->Draw(d2dDeviceContext);
     }
 
-    const auto bottomText = std::wstring()
-        + std::to_wstring(mSettings->WorkShiftCount)
-        + L"/"
-        + std::to_wstring(mSettings->LongBreakAfter)
-        ;
-    mStaticBottom->Text(bottomText);
+    // Texts are formatted into inline buffers, drawing doesn't allocate.
+    mFace.Format(*mEngine, mTimer->Duration());
+
+    mStaticBottom->Text(mFace.BottomText());
     mStaticBottom->Draw(d2dDeviceContext);
 
-    const auto text = DurationToString();
-    mStaticTimer->Text(text);
+    mStaticTimer->Text(mFace.TimerText());
     mStaticTimer->Draw(d2dDeviceContext);
 }
 
+auto Clock::CreateDeviceResources (ID2D1DeviceContext* d2dDeviceContext) -> bool
+{
+    mD2DDeviceContext = d2dDeviceContext;
+
+    if (!mStaticTimer->CreateDeviceResources(d2dDeviceContext)
+    ||  !mStaticTop->CreateDeviceResources(d2dDeviceContext)
+    ||  !mStaticBottom->CreateDeviceResources(d2dDeviceContext)
+       )
+    {
+        return false;
+    }
+
+    return CreateBrushes();
+}
+
+auto Clock::DiscardDeviceResources () -> void
+{
+    mStaticTimer->DiscardDeviceResources();
+    mStaticTop->DiscardDeviceResources();
+    mStaticBottom->DiscardDeviceResources();
+
+    mOuterCircleBrush  = nullptr;
+    mOuterOutlineBrush = nullptr;
+    mInnerCircleBrush  = nullptr;
+    mInnerOutlineBrush = nullptr;
+    mProgressBrush     = nullptr;
+    mRingRealization   = nullptr;
+
+    mPartialRealizations = PartialRealizations();
+
+    mD2DDeviceContext = nullptr;
+}
+
 auto Clock::Create (
-    const Clock::Desc&        desc,
-    ID2D1DeviceContext*       d2dDeviceContext,
-    IDWriteFactory*           dwriteFactory,
-    std::shared_ptr<Settings> settingsPtr,
-    std::shared_ptr<Timer>    timerPtr
+    const Clock::Desc&              desc,
+    ID2D1DeviceContext*             d2dDeviceContext,
+    IDWriteFactory*                 dwriteFactory,
+    std::shared_ptr<PomodoroEngine> enginePtr,
+    std::shared_ptr<Timer>          timerPtr
 ) -> std::unique_ptr<Clock>
 {
     spdlog::debug("Creating Clock");
@@ -152,8 +331,8 @@ auto Clock::Create (
     clock->mD2DDeviceContext = d2dDeviceContext;
     clock->mDWriteFactory    = dwriteFactory;
 
-    clock->mSettings = settingsPtr;
-    clock->mTimer    = timerPtr;
+    clock->mEngine = enginePtr;
+    clock->mTimer  = timerPtr;
 
     clock->mCenter      = desc.center;
     clock->mOuterRadius = desc.outerRadius;
@@ -165,6 +344,10 @@ auto Clock::Create (
     clock->mOuterOutlineColor   = desc.outerOutlineColor;
     clock->mInnerCircleColor   = desc.innerCircleColor;
     clock->mInnerOutlineColor  = desc.innerOutlineColor;
+    clock->mProgressColor      = desc.progressColor;
+
+    // Ring geometry is device independent, keep factory around.
+    d2dDeviceContext->GetFactory(&clock->mD2DFactory);
 
     // Create Clock Text.
     {
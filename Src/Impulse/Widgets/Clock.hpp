@@ -1,14 +1,16 @@
 #pragma once
 
+#include "ClockFace.hpp"
+#include "PomodoroEngine.hpp"
 #include "Timer.hpp"
-#include "Settings.hpp"
 #include "StaticText.hpp"
 #include "Widget.hpp"
 
+#include <array>
 #include <memory>
 #include <string>
 
-#include <d2d1_1.h>
+#include <d2d1_3.h>
 #include <dwrite.h>
 #include <wrl.h>
 
@@ -34,12 +36,41 @@ public:
         D2D1_COLOR_F     outerOutlineColor  = D2D1::ColorF(D2D1::ColorF::Black);
         D2D1_COLOR_F     innerCircleColor   = D2D1::ColorF(D2D1::ColorF::Black);
         D2D1_COLOR_F     innerOutlineColor  = D2D1::ColorF(D2D1::ColorF::Black);
+        D2D1_COLOR_F     progressColor      = D2D1::ColorF(D2D1::ColorF::Black);
         
         StaticText::Desc timerTextDesc      = StaticText::Desc();
         StaticText::Desc topTextDesc        = StaticText::Desc();
         StaticText::Desc bottomTextDesc     = StaticText::Desc();
     };
 
+private:
+    // Keeps frames coming while timer runs, but only when progress ring moved
+    // enough to be visible. Loop sleeps until then, ring of 25 minute phase
+    // moves every 0.78 s.
+    class ProgressAnimation : public Animation
+    {
+        Clock*                     mClock    = nullptr;
+        bool                       mChanged  = false;
+        AnimationClock::time_point mWakeTime = AnimationClock::time_point::min();
+
+    protected:
+        virtual auto Step     (AnimationClock::time_point now) -> bool override;
+        virtual auto Changed  () const -> bool override { return mChanged; }
+        virtual auto WakeTime () const -> AnimationClock::time_point override { return mWakeTime; }
+
+    public:
+        ProgressAnimation (Clock* clock) : mClock(clock) {}
+    };
+
+    // Geometry of whole ring segments is cached and realized, partial
+    // segment is one of RING_SUBSTEPS cached realizations rotated in place,
+    // so steady state frame doesn't build any geometry.
+    static constexpr auto RING_SEGMENTS = ClockFace::RING_SEGMENTS;
+    static constexpr auto RING_SUBSTEPS = ClockFace::RING_SUBSTEPS;
+
+    using PartialGeometries   = std::array<ComPtr<ID2D1PathGeometry>, RING_SUBSTEPS>;
+    using PartialRealizations = std::array<ComPtr<ID2D1GeometryRealization>, RING_SUBSTEPS>;
+
 private:
     D2D1_POINT_2F                mCenter             = D2D1::Point2F();
     float                        mOuterRadius        = 0.0f;
@@ -51,11 +82,24 @@ private:
     D2D1_COLOR_F                 mOuterOutlineColor  = {0};
     D2D1_COLOR_F                 mInnerCircleColor   = {0};
     D2D1_COLOR_F                 mInnerOutlineColor  = {0};
+    D2D1_COLOR_F                 mProgressColor      = {0};
 
     ComPtr<ID2D1SolidColorBrush> mOuterCircleBrush;
     ComPtr<ID2D1SolidColorBrush> mOuterOutlineBrush;
     ComPtr<ID2D1SolidColorBrush> mInnerCircleBrush;
     ComPtr<ID2D1SolidColorBrush> mInnerOutlineBrush;
+    ComPtr<ID2D1SolidColorBrush> mProgressBrush;
+
+    ComPtr<ID2D1Factory>             mD2DFactory;
+    ComPtr<ID2D1PathGeometry>        mRingGeometry;
+    ComPtr<ID2D1GeometryRealization> mRingRealization;
+    PartialGeometries                mPartialGeometries;
+    PartialRealizations              mPartialRealizations;
+    int                              mRingSegments      = -1;
+    int                              mDrawnStep         = -1;
+    ProgressAnimation                mProgressAnimation = ProgressAnimation(this);
+
+    ClockFace                        mFace;
 
     ID2D1DeviceContext*          mD2DDeviceContext   = nullptr;
     IDWriteFactory*              mDWriteFactory      = nullptr;
@@ -64,11 +108,18 @@ private:
     std::unique_ptr<StaticText>  mStaticTop;
     std::unique_ptr<StaticText>  mStaticBottom;
 
-    std::shared_ptr<Settings>    mSettings;
-    std::shared_ptr<Timer>       mTimer;
+    std::shared_ptr<PomodoroEngine> mEngine;
+    std::shared_ptr<Timer>          mTimer;
 
 private:
-    auto DurationToString() -> std::wstring;
+    // Ring step at timer's remaining time.
+    auto Progress     () -> SteppedProgress;
+    auto DrawProgress (ID2D1DeviceContext* d2dDeviceContext, int step) -> void;
+    auto DrawRingPart (
+        ID2D1DeviceContext*               d2dDeviceContext,
+        ID2D1PathGeometry*                geometry,
+        ComPtr<ID2D1GeometryRealization>& realization
+    ) -> void;
 
     auto CreateBrushes () -> bool;
     auto CreateBrush   (D2D_COLOR_F color) -> ComPtr<ID2D1SolidColorBrush>;
@@ -77,9 +128,9 @@ public:
     Clock  () = default;
     ~Clock () = default;
 
-    auto Position    (float x, float y)  { mCenter.x = x; mCenter.y = y; }
-    auto OuterRadius (float r)           { mOuterRadius = r; }
-    auto InnerRadius (float r)           { mInnerRadius = r; }
+    auto Position    (float x, float y)  { mCenter.x = x; mCenter.y = y; mRingSegments = -1; }
+    auto OuterRadius (float r)           { mOuterRadius = r; mRingSegments = -1; }
+    auto InnerRadius (float r)           { mInnerRadius = r; mRingSegments = -1; }
     auto OuterStroke (float s)           { mOuterStroke = s; }
     auto InnerStroke (float s)           { mInnerStroke = s; }
 
@@ -102,13 +153,17 @@ public:
 
     virtual auto HitTest (D2D_POINT_2F point)                   -> bool override;    
     virtual auto Draw    (ID2D1DeviceContext* d2dDeviceContext) -> void override;
+    virtual auto Bounds  () const                               -> D2D1_RECT_F override { return Rect(); }
+
+    virtual auto CreateDeviceResources  (ID2D1DeviceContext* d2dDeviceContext) -> bool override;
+    virtual auto DiscardDeviceResources ()                                     -> void override;
 
     static auto Create (
-        const Clock::Desc&        desc,
-        ID2D1DeviceContext*       d2dDeviceContext,
-        IDWriteFactory*           dwriteFactory,
-        std::shared_ptr<Settings> settingsPtr,
-        std::shared_ptr<Timer>    timerPtr
+        const Clock::Desc&              desc,
+        ID2D1DeviceContext*             d2dDeviceContext,
+        IDWriteFactory*                 dwriteFactory,
+        std::shared_ptr<PomodoroEngine> enginePtr,
+        std::shared_ptr<Timer>          timerPtr
     ) -> std::unique_ptr<Clock>;
 };
 
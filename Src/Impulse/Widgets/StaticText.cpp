@@ -6,15 +6,15 @@
 
 namespace Impulse::Widgets {
 
-auto StaticText::CreateBrushes (const StaticText::Desc& desc) -> bool
+auto StaticText::CreateBrushes () -> bool
 {
     auto hr = S_OK;
 
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.defaultTextColor , &mDefaultTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.hoverTextColor   , &mHoverTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.activeTextColor  , &mActiveTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.focusTextColor   , &mFocusTextBrush);
-    hr = mD2DDeviceContext->CreateSolidColorBrush(desc.disabledTextColor, &mDisabledTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mDefaultTextColor , &mDefaultTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mHoverTextColor   , &mHoverTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mActiveTextColor  , &mActiveTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mFocusTextColor   , &mFocusTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mDisabledTextColor, &mDisabledTextBrush);
     if (FAILED(hr))
     {
         spdlog::error("CreateSolidColorBrush() failed: {}", DX::GetErrorMessage(hr));
@@ -94,6 +94,19 @@ auto StaticText::CreateBrush (D2D_COLOR_F color) -> ComPtr<ID2D1SolidColorBrush>
     return brush;
 }
 
+auto StaticText::Update (Widget::State state) -> bool
+{
+    if (!Widget::Update(state))
+    {
+        return false;
+    }
+
+    const auto scale = (state == Widget::State::Hover) ? 1.1f : 1.0f;
+    mScale.AnimateTo(scale, std::chrono::milliseconds(120), mScheduler);
+
+    return true;
+}
+
 auto StaticText::HitTest (D2D_POINT_2F point)  -> bool
 {
     const auto rect = Rect();
@@ -115,12 +128,17 @@ auto StaticText::Draw (ID2D1DeviceContext* d2dContext) -> void
     {
     case Widget::State::Hover:
         brush = mHoverTextBrush.Get();
-        auto rect = Rect();
-        auto mat = D2D1::Matrix3x2F::Scale(D2D1::SizeF(1.1f, 1.1f), D2D1::Point2F(mPosition.x + (mSize.width / 2), mPosition.y + (mSize.height / 2)));
-        d2dContext->SetTransform(mat);
         break;
     }
 
+    const auto scale = mScale.Value();
+    if (scale != 1.0f)
+    {
+        const auto center = D2D1::Point2F(
+            mPosition.x + (mSize.width / 2), mPosition.y + (mSize.height / 2)
+        );
+        d2dContext->SetTransform(D2D1::Matrix3x2F::Scale(D2D1::SizeF(scale, scale), center));
+    }
 
     d2dContext->DrawTextW(
         mText.c_str(), mText.length(), mTextFormat.Get(), Rect(), brush
@@ -129,6 +147,24 @@ auto StaticText::Draw (ID2D1DeviceContext* d2dContext) -> void
     d2dContext->SetTransform(D2D1::Matrix3x2F::Identity());
 }
 
+auto StaticText::CreateDeviceResources (ID2D1DeviceContext* d2dDeviceContext) -> bool
+{
+    mD2DDeviceContext = d2dDeviceContext;
+
+    return CreateBrushes();
+}
+
+auto StaticText::DiscardDeviceResources () -> void
+{
+    mDefaultTextBrush  = nullptr;
+    mHoverTextBrush    = nullptr;
+    mActiveTextBrush   = nullptr;
+    mFocusTextBrush    = nullptr;
+    mDisabledTextBrush = nullptr;
+
+    mD2DDeviceContext = nullptr;
+}
+
 auto StaticText::Create (
     const StaticText::Desc& desc,
     ID2D1DeviceContext*     d2dDeviceContext,
@@ -156,7 +192,13 @@ auto StaticText::Create (
 
     staticText->mPosition = desc.position;
     staticText->mSize     = desc.size;
-    staticText->mText     = desc.text;
+    staticText->mText.Assign(desc.text);
+
+    staticText->mDefaultTextColor  = desc.defaultTextColor;
+    staticText->mHoverTextColor    = desc.hoverTextColor;
+    staticText->mActiveTextColor   = desc.activeTextColor;
+    staticText->mFocusTextColor    = desc.focusTextColor;
+    staticText->mDisabledTextColor = desc.disabledTextColor;
 
     // Create TextFormat.
     if (!staticText->CreateTextFormats(desc))
@@ -165,7 +207,7 @@ auto StaticText::Create (
     }
 
     // Create Brushes.
-    if (!staticText->CreateBrushes(desc))
+    if (!staticText->CreateDeviceResources(d2dDeviceContext))
     {
         return nullptr;
     }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FixedString.hpp"
+#include "LruCache.hpp"
 #include "Widget.hpp"
 
 #include <memory>
@@ -42,9 +44,20 @@ public:
 private:
     D2D_POINT_2F                 mPosition          = D2D1::Point2F();
     D2D_SIZE_F                   mSize              = D2D1::SizeF();
-    std::wstring                 mText              = L"";
+    SmallWString<128>            mText;
 
+    D2D_COLOR_F                  mDefaultTextColor  = {0};
+    D2D_COLOR_F                  mHoverTextColor    = {0};
+    D2D_COLOR_F                  mActiveTextColor   = {0};
+    D2D_COLOR_F                  mFocusTextColor    = {0};
+    D2D_COLOR_F                  mDisabledTextColor = {0};
+
+    AnimatedValue                mScale             = AnimatedValue(1.0f);
+
+    // Current text format and ones used before, by font size.
     ComPtr<IDWriteTextFormat>    mTextFormat;
+    LruCache<float, ComPtr<IDWriteTextFormat>> mTextFormats;
+
     ComPtr<ID2D1SolidColorBrush> mDefaultTextBrush;
     ComPtr<ID2D1SolidColorBrush> mHoverTextBrush;
     ComPtr<ID2D1SolidColorBrush> mActiveTextBrush;
@@ -55,7 +68,7 @@ private:
     IDWriteFactory*              mDWriteFactory     = nullptr;
 
 private:
-    auto CreateBrushes     (const StaticText::Desc& desc) -> bool;
+    auto CreateBrushes     ()                             -> bool;
     auto CreateTextFormats (const StaticText::Desc& desc) -> bool;
 
     auto CreateBrush      (D2D_COLOR_F color) -> ComPtr<ID2D1SolidColorBrush>;
@@ -74,11 +87,11 @@ public:
 
     auto Position (float x, float y)  { mPosition.x = x; mPosition.y = y; }
     auto Size     (float w, float h)  { mSize.width = w; mSize.height = h; }
-    auto Text     (std::wstring text) { mText = std::move(text); }
+    auto Text     (std::wstring_view text) { mText.Assign(text); }
 
     const auto  Position () const { return mPosition; }
     const auto  Size     () const { return mSize; }
-    const auto& Text     () const { return mText; }
+    const auto  Text     () const { return mText.view(); }
     const auto  Rect     () const
     {
         return D2D1::RectF(
@@ -89,8 +102,15 @@ public:
         );
     }
 
+    // Formats are kept per size, going back to a known dpi creates nothing.
     auto FontSize (float size) -> bool
     {
+        if (auto textFormat = mTextFormats.Find(size))
+        {
+            mTextFormat = *textFormat;
+            return true;
+        }
+
         auto length   = static_cast<size_t>(mTextFormat->GetFontFamilyNameLength());
         auto fontName = std::wstring(length + 1, '\0');
         if (FAILED(mTextFormat->GetFontFamilyName(fontName.data(), fontName.length())))
@@ -108,6 +128,7 @@ public:
         if (textFormat)
         {
             mTextFormat = textFormat;
+            mTextFormats.Insert(size, textFormat);
             return true;
         }
 
@@ -121,6 +142,7 @@ public:
         if (auto brush = CreateBrush(color))
         {            
             mDefaultTextBrush = brush;
+            mDefaultTextColor = color;
             return true;
         }
 
@@ -132,6 +154,7 @@ public:
         if (auto brush = CreateBrush(color))
         {
             mHoverTextBrush = brush;
+            mHoverTextColor = color;
             return true;
         }
 
@@ -143,6 +166,7 @@ public:
         if (auto brush = CreateBrush(color))
         {
             mActiveTextBrush = brush;
+            mActiveTextColor = color;
             return true;
         }
 
@@ -154,6 +178,7 @@ public:
         if (auto brush = CreateBrush(color))
         {
             mFocusTextBrush = brush;
+            mFocusTextColor = color;
             return true;
         }
 
@@ -165,6 +190,7 @@ public:
         if (auto brush = CreateBrush(color))
         {
             mDisabledTextBrush = brush;
+            mDisabledTextColor = color;
             return true;
         }
 
@@ -173,8 +199,13 @@ public:
 
     #pragma endregion
 
+    virtual auto Update  (Widget::State state)                  -> bool override;
     virtual auto HitTest (D2D_POINT_2F point)                   -> bool override;
     virtual auto Draw    (ID2D1DeviceContext* d2dDeviceContext) -> void override;
+    virtual auto Bounds  () const                               -> D2D1_RECT_F override { return Rect(); }
+
+    virtual auto CreateDeviceResources  (ID2D1DeviceContext* d2dDeviceContext) -> bool override;
+    virtual auto DiscardDeviceResources ()                                     -> void override;
 
     static auto Create (
         const StaticText::Desc& desc,
@@ -0,0 +1,358 @@
+#include "PCH.hpp"
+#include "TaskList.hpp"
+#include "DX.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <spdlog/spdlog.h>
+
+namespace Impulse::Widgets {
+
+auto TaskList::CreateBrushes () -> bool
+{
+    auto hr = S_OK;
+
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mBackgroundColor, &mBackgroundBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mOutlineColor   , &mOutlineBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mTextColor      , &mTextBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mHoverColor     , &mHoverBrush);
+    hr = mD2DDeviceContext->CreateSolidColorBrush(mSelectedColor  , &mSelectedBrush);
+    if (FAILED(hr))
+    {
+        spdlog::error("CreateSolidColorBrush() failed: {}", DX::GetErrorMessage(hr));
+        return false;
+    }
+
+    return true;
+}
+
+auto TaskList::CreateTextFormat (const WCHAR* fontName, FLOAT fontSize) -> bool
+{
+    auto textFormat = ComPtr<IDWriteTextFormat>();
+
+    auto hr = mDWriteFactory->CreateTextFormat(
+        fontName,
+        nullptr,
+        DWRITE_FONT_WEIGHT_NORMAL,
+        DWRITE_FONT_STYLE_NORMAL,
+        DWRITE_FONT_STRETCH_NORMAL,
+        fontSize,
+        L"",
+        &textFormat
+    );
+    if (FAILED(hr))
+    {
+        spdlog::error("CreateTextFormat() failed: {}", DX::GetErrorMessage(hr));
+        return false;
+    }
+
+    // Long names are cut at row end instead of wrapping.
+    const auto trimming = DWRITE_TRIMMING{ DWRITE_TRIMMING_GRANULARITY_CHARACTER, 0, 0 };
+    textFormat->SetTrimming(&trimming, nullptr);
+    textFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP);
+    textFormat->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_CENTER);
+    textFormat->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_LEADING);
+
+    mTextFormat = textFormat;
+    InvalidateRows();
+
+    return true;
+}
+
+auto TaskList::TaskAt (D2D_POINT_2F point) const -> uint32_t
+{
+    const auto rect = Rect();
+    if (point.x < rect.left || rect.right  < point.x
+    ||  point.y < rect.top  || rect.bottom < point.y)
+    {
+        return NO_TASK;
+    }
+
+    return mView.TaskAt(point.y - mPosition.y);
+}
+
+auto TaskList::PrepareRows (uint32_t first, uint32_t last) -> void
+{
+    const auto width = std::max(mView.Width() - 2.0f * mPadding, 0.0f);
+
+    mView.PrepareRows(first, last, [&](size_t slot, uint32_t task)
+    {
+        if (mLayouts.size() != mView.Slots())
+        {
+            mLayouts.resize(mView.Slots());
+        }
+
+        const auto name = mStore->Get(task);
+
+        auto& layout = mLayouts[slot];
+        layout = nullptr;
+
+        auto hr = mDWriteFactory->CreateTextLayout(
+            name.data(),
+            static_cast<UINT32>(name.length()),
+            mTextFormat.Get(),
+            width,
+            mView.RowHeight(),
+            &layout
+        );
+        if (FAILED(hr))
+        {
+            spdlog::error("CreateTextLayout() failed: {}", DX::GetErrorMessage(hr));
+        }
+    });
+}
+
+auto TaskList::InvalidateRows () -> void
+{
+    mView.InvalidateRows();
+    mLayouts.clear();
+}
+
+auto TaskList::Position (float x, float y) -> void
+{
+    mPosition.x = x;
+    mPosition.y = y;
+}
+
+auto TaskList::Size (float w, float h) -> void
+{
+    if (mView.Width() != w)
+    {
+        mLayouts.clear();
+    }
+
+    mView.Size(w, h);
+}
+
+auto TaskList::RowHeight (float height) -> void
+{
+    if (mView.RowHeight() != height)
+    {
+        mLayouts.clear();
+    }
+
+    mView.RowHeight(height);
+}
+
+auto TaskList::FontSize (float size) -> bool
+{
+    if (auto textFormat = mTextFormats.Find(size))
+    {
+        if (mTextFormat != *textFormat)
+        {
+            mTextFormat = *textFormat;
+            InvalidateRows();
+        }
+
+        return true;
+    }
+
+    auto length   = static_cast<size_t>(mTextFormat->GetFontFamilyNameLength());
+    auto fontName = std::wstring(length + 1, '\0');
+    if (FAILED(mTextFormat->GetFontFamilyName(fontName.data(), fontName.length())))
+    {
+        return false;
+    }
+
+    if (!CreateTextFormat(fontName.c_str(), size))
+    {
+        return false;
+    }
+
+    mTextFormats.Insert(size, mTextFormat);
+    return true;
+}
+
+auto TaskList::ScrollTo (uint32_t task) -> void
+{
+    mView.ScrollTo(task);
+}
+
+auto TaskList::Store (std::shared_ptr<const TaskStore> store) -> void
+{
+    mStore = std::move(store);
+    mView.Store(mStore.get());
+    mHoveredTask = TaskAt(mPointer);
+
+    if (!mStore || mSelectedTask >= mStore->Size())
+    {
+        mSelectedTask = NO_TASK;
+    }
+}
+
+auto TaskList::Update (Widget::State state) -> bool
+{
+    if (!Widget::Update(state))
+    {
+        return false;
+    }
+
+    if (state == Widget::State::Default)
+    {
+        mHoveredTask = NO_TASK;
+    }
+
+    return true;
+}
+
+auto TaskList::PointerMove (D2D_POINT_2F point) -> bool
+{
+    mPointer = point;
+
+    const auto task = TaskAt(point);
+    if (task == mHoveredTask)
+    {
+        return false;
+    }
+
+    mHoveredTask = task;
+    return true;
+}
+
+auto TaskList::Scroll (float delta) -> bool
+{
+    if (!mView.Scroll(delta))
+    {
+        return false;
+    }
+
+    mHoveredTask = TaskAt(mPointer);
+
+    return true;
+}
+
+auto TaskList::HitTest (D2D_POINT_2F point) -> bool
+{
+    const auto rect = Rect();
+
+    return (rect.left <= point.x && point.x <= rect.right)
+        && (rect.top  <= point.y && point.y <= rect.bottom)
+        ;;
+}
+
+auto TaskList::Draw (ID2D1DeviceContext* d2dContext) -> void
+{
+    const auto rect = Rect();
+
+    d2dContext->FillRectangle(rect, mBackgroundBrush.Get());
+
+    if (mStore && mTextFormat)
+    {
+        const auto [first, last] = mView.VisibleRange();
+        PrepareRows(first, last);
+
+        d2dContext->PushAxisAlignedClip(rect, D2D1_ANTIALIAS_MODE_ALIASED);
+
+        for (auto task = first; task < last; ++task)
+        {
+            const auto top     = mPosition.y + mView.RowTop(task);
+            const auto rowRect = D2D1::RectF(rect.left, top, rect.right, top + mView.RowHeight());
+
+            if (task == mSelectedTask)
+            {
+                d2dContext->FillRectangle(rowRect, mSelectedBrush.Get());
+            }
+            else if (task == mHoveredTask)
+            {
+                d2dContext->FillRectangle(rowRect, mHoverBrush.Get());
+            }
+
+            const auto slot = mView.Slot(task);
+            if (slot < mLayouts.size() && mLayouts[slot])
+            {
+                d2dContext->DrawTextLayout(
+                    D2D1::Point2F(rect.left + mPadding, top), mLayouts[slot].Get(), mTextBrush.Get()
+                );
+            }
+        }
+
+        d2dContext->PopAxisAlignedClip();
+    }
+
+    d2dContext->DrawRectangle(rect, mOutlineBrush.Get());
+}
+
+auto TaskList::CreateDeviceResources (ID2D1DeviceContext* d2dDeviceContext) -> bool
+{
+    mD2DDeviceContext = d2dDeviceContext;
+
+    return CreateBrushes();
+}
+
+auto TaskList::DiscardDeviceResources () -> void
+{
+    // Text layouts are device independent and survive.
+    mBackgroundBrush = nullptr;
+    mOutlineBrush    = nullptr;
+    mTextBrush       = nullptr;
+    mHoverBrush      = nullptr;
+    mSelectedBrush   = nullptr;
+
+    mD2DDeviceContext = nullptr;
+}
+
+auto TaskList::Create (
+    const TaskList::Desc&            desc,
+    ID2D1DeviceContext*              d2dDeviceContext,
+    IDWriteFactory*                  dwriteFactory,
+    std::shared_ptr<const TaskStore> storePtr
+) -> std::unique_ptr<TaskList>
+{
+    spdlog::debug("Creating TaskList");
+
+    if (!d2dDeviceContext)
+    {
+        spdlog::error("D2DDeviceContext is null");
+        return nullptr;
+    }
+
+    if (!dwriteFactory)
+    {
+        spdlog::error("DWriteFactory is null");
+        return nullptr;
+    }
+
+    if (!storePtr)
+    {
+        spdlog::error("TaskStore is null");
+        return nullptr;
+    }
+
+    auto taskList = std::make_unique<TaskList>();
+
+    taskList->mD2DDeviceContext = d2dDeviceContext;
+    taskList->mDWriteFactory    = dwriteFactory;
+    taskList->mStore            = storePtr;
+
+    taskList->mPosition = desc.position;
+    taskList->mPadding  = desc.padding;
+
+    taskList->mView.Store(storePtr.get());
+    taskList->mView.Size(desc.size.width, desc.size.height);
+    taskList->mView.RowHeight(desc.rowHeight);
+
+    taskList->mBackgroundColor = desc.backgroundColor;
+    taskList->mOutlineColor    = desc.outlineColor;
+    taskList->mTextColor       = desc.textColor;
+    taskList->mHoverColor      = desc.hoverColor;
+    taskList->mSelectedColor   = desc.selectedColor;
+
+    // Create TextFormat.
+    if (!taskList->CreateTextFormat(desc.fontName, desc.fontSize))
+    {
+        return nullptr;
+    }
+
+    // Create Brushes.
+    if (!taskList->CreateDeviceResources(d2dDeviceContext))
+    {
+        return nullptr;
+    }
+
+    spdlog::debug("TaskList created");
+
+    return taskList;
+}
+
+} // namespace Impulse::Widgets
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "LruCache.hpp"
+#include "TaskListView.hpp"
+#include "TaskStore.hpp"
+#include "Widget.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <d2d1_3.h>
+#include <dwrite.h>
+#include <wrl.h>
+
+namespace {
+    using namespace D2D1;
+    using namespace Microsoft::WRL;
+}
+
+namespace Impulse::Widgets {
+
+// Scrollable list of tasks. Only rows in view are laid out and drawn, so
+// frame cost doesn't depend on number of tasks.
+class TaskList : public Widget
+{
+public:
+    static constexpr auto NO_TASK = TaskListView::NO_TASK;
+
+    struct Desc
+    {
+        D2D_POINT_2F        position        = D2D1::Point2F();
+        D2D_SIZE_F          size            = D2D1::SizeF();
+        float               rowHeight       = 24.0f;
+        float               padding         = 6.0f;
+
+        const WCHAR*        fontName        = L"Segoe UI";
+        FLOAT               fontSize        = 14.0f;
+
+        D2D_COLOR_F         backgroundColor = D2D1::ColorF(D2D1::ColorF::White);
+        D2D_COLOR_F         outlineColor    = D2D1::ColorF(D2D1::ColorF::Black);
+        D2D_COLOR_F         textColor       = D2D1::ColorF(D2D1::ColorF::Black);
+        D2D_COLOR_F         hoverColor      = D2D1::ColorF(D2D1::ColorF::LightGray);
+        D2D_COLOR_F         selectedColor   = D2D1::ColorF(D2D1::ColorF::LightBlue);
+    };
+
+private:
+    D2D_POINT_2F                 mPosition        = D2D1::Point2F();
+    float                        mPadding         = 6.0f;
+    D2D_POINT_2F                 mPointer         = D2D1::Point2F(-1.0f, -1.0f);
+    uint32_t                     mHoveredTask     = NO_TASK;
+    uint32_t                     mSelectedTask    = NO_TASK;
+
+    D2D_COLOR_F                  mBackgroundColor = {0};
+    D2D_COLOR_F                  mOutlineColor    = {0};
+    D2D_COLOR_F                  mTextColor       = {0};
+    D2D_COLOR_F                  mHoverColor      = {0};
+    D2D_COLOR_F                  mSelectedColor   = {0};
+
+    // Current text format and ones used before, by font size.
+    ComPtr<IDWriteTextFormat>    mTextFormat;
+    LruCache<float, ComPtr<IDWriteTextFormat>> mTextFormats;
+
+    ComPtr<ID2D1SolidColorBrush> mBackgroundBrush;
+    ComPtr<ID2D1SolidColorBrush> mOutlineBrush;
+    ComPtr<ID2D1SolidColorBrush> mTextBrush;
+    ComPtr<ID2D1SolidColorBrush> mHoverBrush;
+    ComPtr<ID2D1SolidColorBrush> mSelectedBrush;
+
+    // Scrolling and row recycling, text layouts are kept per view slot.
+    TaskListView                 mView;
+    std::vector<ComPtr<IDWriteTextLayout>> mLayouts;
+
+    std::shared_ptr<const TaskStore> mStore;
+
+    ID2D1DeviceContext*          mD2DDeviceContext = nullptr;
+    IDWriteFactory*              mDWriteFactory    = nullptr;
+
+private:
+    auto CreateBrushes    () -> bool;
+    auto CreateTextFormat (const WCHAR* fontName, FLOAT fontSize) -> bool;
+
+    auto TaskAt (D2D_POINT_2F point) const -> uint32_t;
+
+    // Make sure rows of visible tasks have their text laid out.
+    auto PrepareRows     (uint32_t first, uint32_t last) -> void;
+    auto InvalidateRows  () -> void;
+
+public:
+    TaskList  () = default;
+    ~TaskList () = default;
+
+    auto Position  (float x, float y) -> void;
+    auto Size      (float w, float h) -> void;
+    auto RowHeight (float height)     -> void;
+    auto FontSize  (float size)       -> bool;
+
+    // Scroll so that @task is in view.
+    auto ScrollTo (uint32_t task) -> void;
+
+    // Replace tasks shown, hovered task and scroll must not point past end
+    // of new store.
+    auto Store (std::shared_ptr<const TaskStore> store) -> void;
+
+    auto Select       (uint32_t task) { mSelectedTask = task; }
+    auto SelectedTask () const        { return mSelectedTask; }
+    auto HoveredTask  () const        { return mHoveredTask; }
+    auto RowsLaidOut  () const        { return mView.RowsLaidOut(); }
+
+    const auto Rect () const
+    {
+        return D2D1::RectF(
+            mPosition.x,
+            mPosition.y,
+            mPosition.x + mView.Width(),
+            mPosition.y + mView.Height()
+        );
+    }
+
+    virtual auto Update      (Widget::State state) -> bool override;
+    virtual auto PointerMove (D2D_POINT_2F point)  -> bool override;
+    virtual auto Scroll      (float delta)         -> bool override;
+
+    virtual auto HitTest (D2D_POINT_2F point)                   -> bool override;
+    virtual auto Draw    (ID2D1DeviceContext* d2dDeviceContext) -> void override;
+    virtual auto Bounds  () const                               -> D2D1_RECT_F override { return Rect(); }
+
+    virtual auto CreateDeviceResources  (ID2D1DeviceContext* d2dDeviceContext) -> bool override;
+    virtual auto DiscardDeviceResources ()                                     -> void override;
+
+    static auto Create (
+        const TaskList::Desc&            desc,
+        ID2D1DeviceContext*              d2dDeviceContext,
+        IDWriteFactory*                  dwriteFactory,
+        std::shared_ptr<const TaskStore> storePtr
+    ) -> std::unique_ptr<TaskList>;
+};
+
+} // namespace Impulse::Widgets
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Animation.hpp"
+
 #include <functional>
 
 #include <d2d1_1.h>
@@ -23,7 +25,9 @@ public:
     };
 
 protected:
-    State mState = State::Default;
+    State               mState     = State::Default;
+    AnimationScheduler* mScheduler = nullptr;
+    bool                mVisible   = true;
 
 public:
     std::function<void ()> OnClick     = []{};
@@ -33,6 +37,13 @@ public:
 public:
     virtual ~Widget () = default;
 
+    // Without scheduler state transitions are applied instantly.
+    auto Scheduler (AnimationScheduler* scheduler) { mScheduler = scheduler; }
+
+    // Hidden widget is neither drawn nor hit.
+    auto Visible   (bool visible) { mVisible = visible; }
+    auto IsVisible () const       { return mVisible; }
+
     virtual auto Update  (Widget::State state) -> bool
     {
         if (mState != state)
@@ -44,8 +55,21 @@ public:
         return false;
     }
 
+    // Pointer moved over widget / wheel turned by @delta notches. Return true
+    // when widget needs to be redrawn.
+    virtual auto PointerMove (D2D_POINT_2F point) -> bool { return false; }
+    virtual auto Scroll      (float delta)        -> bool { return false; }
+
     virtual auto HitTest (D2D_POINT_2F point)                   -> bool = 0;
     virtual auto Draw    (ID2D1DeviceContext* d2dDeviceContext) -> void = 0;
+
+    // Bounding rectangle, HitTest() is only called for points inside.
+    virtual auto Bounds  () const -> D2D1_RECT_F = 0;
+
+    // Device dependent resources are recreated from retained descriptors
+    // (colors, resource ids), so widget survives device loss.
+    virtual auto CreateDeviceResources  (ID2D1DeviceContext* d2dDeviceContext) -> bool = 0;
+    virtual auto DiscardDeviceResources ()                                     -> void = 0;
 };
 
 } // namespace Impulse::Widgets
@@ -0,0 +1,220 @@
+#include "PCH.hpp"
+#include "WidgetTree.hpp"
+
+#include <algorithm>
+
+namespace Impulse::Widgets {
+
+auto WidgetTree::Find (Widget* widget) const -> std::vector<Entry>::const_iterator
+{
+    return std::find_if(mEntries.begin(), mEntries.end(),
+        [widget](const Entry& entry) { return entry.widget == widget; }
+    );
+}
+
+auto WidgetTree::Add (Widget* widget, int zOrder, bool hitTestable) -> void
+{
+    if (!widget || Find(widget) != mEntries.end())
+    {
+        return;
+    }
+
+    const auto entry = Entry{ widget, zOrder, mSequence++, hitTestable };
+
+    // Keep entries sorted by z-order, equal ones in insertion order.
+    const auto it = std::upper_bound(mEntries.begin(), mEntries.end(), entry,
+        [](const Entry& a, const Entry& b)
+        {
+            return a.zOrder != b.zOrder ? a.zOrder < b.zOrder : a.sequence < b.sequence;
+        }
+    );
+    mEntries.insert(it, entry);
+
+    mIndexDirty = true;
+}
+
+auto WidgetTree::Remove (Widget* widget) -> void
+{
+    const auto it = Find(widget);
+    if (it == mEntries.end())
+    {
+        return;
+    }
+
+    mEntries.erase(it);
+
+    if (mHovered == widget) { mHovered = nullptr; }
+    if (mPressed == widget) { mPressed = nullptr; }
+
+    mIndexDirty = true;
+}
+
+auto WidgetTree::Clear () -> void
+{
+    mEntries.clear();
+    mHitTestable.clear();
+    mGrid.Clear();
+
+    mHovered    = nullptr;
+    mPressed    = nullptr;
+    mIndexDirty = true;
+}
+
+auto WidgetTree::RebuildIndex () -> void
+{
+    mHitTestable.clear();
+    mBounds.clear();
+
+    // Topmost first, so first hit in a cell is the right one.
+    for (auto i = mEntries.size(); i-- > 0; )
+    {
+        const auto& entry = mEntries[i];
+        if (!entry.hitTestable)
+        {
+            continue;
+        }
+
+        const auto bounds = entry.widget->Bounds();
+
+        mHitTestable.push_back(static_cast<uint32_t>(i));
+        mBounds.push_back(LayoutRect{ bounds.left, bounds.top, bounds.right, bounds.bottom });
+    }
+
+    mGrid.Build(mBounds);
+    mIndexDirty = false;
+}
+
+auto WidgetTree::HitTest (D2D_POINT_2F point) -> Widget*
+{
+    if (mIndexDirty)
+    {
+        RebuildIndex();
+    }
+
+    mHitTests += 1;
+
+    // Grid narrows candidates down, widget decides about exact shape.
+    auto hit = static_cast<Widget*>(nullptr);
+    mGrid.Query(point.x, point.y, [&](uint32_t item)
+    {
+        auto widget = mEntries[mHitTestable[item]].widget;
+        if (widget->IsVisible() && widget->HitTest(point))
+        {
+            hit = widget;
+            return true;
+        }
+
+        return false;
+    });
+
+    return hit;
+}
+
+auto WidgetTree::Draw (ID2D1DeviceContext* d2dDeviceContext) -> void
+{
+    for (const auto& entry : mEntries)
+    {
+        if (entry.widget->IsVisible())
+        {
+            entry.widget->Draw(d2dDeviceContext);
+        }
+    }
+}
+
+auto WidgetTree::CreateDeviceResources (ID2D1DeviceContext* d2dDeviceContext) -> bool
+{
+    auto r = true;
+    for (const auto& entry : mEntries)
+    {
+        r &= entry.widget->CreateDeviceResources(d2dDeviceContext);
+    }
+
+    return r;
+}
+
+auto WidgetTree::DiscardDeviceResources () -> void
+{
+    for (const auto& entry : mEntries)
+    {
+        entry.widget->DiscardDeviceResources();
+    }
+}
+
+auto WidgetTree::MouseMove (D2D_POINT_2F point) -> bool
+{
+    auto redraw = false;
+
+    auto widget = HitTest(point);
+    if (mHovered && mHovered != widget)
+    {
+        redraw |= mHovered->Update(Widget::State::Default);
+        mHovered->OnMouseAway();
+    }
+
+    if (widget)
+    {
+        // Pressed widget stays active while pointer is over it.
+        const auto state = (widget == mPressed) ? Widget::State::Active : Widget::State::Hover;
+        redraw |= widget->Update(state);
+        redraw |= widget->PointerMove(point);
+
+        if (widget != mHovered)
+        {
+            widget->OnMouseOver();
+        }
+    }
+
+    mHovered = widget;
+
+    return redraw;
+}
+
+auto WidgetTree::MouseDown (D2D_POINT_2F point) -> bool
+{
+    auto widget = HitTest(point);
+    if (!widget)
+    {
+        return false;
+    }
+
+    mPressed = widget;
+
+    return widget->Update(Widget::State::Active);
+}
+
+auto WidgetTree::MouseUp (D2D_POINT_2F point) -> bool
+{
+    auto redraw  = false;
+    auto pressed = mPressed;
+
+    mPressed = nullptr;
+
+    auto widget = HitTest(point);
+
+    // Released outside, pressed widget goes back to normal without click.
+    if (pressed && pressed != widget)
+    {
+        redraw |= pressed->Update(Widget::State::Default);
+    }
+
+    if (widget)
+    {
+        redraw |= widget->Update(Widget::State::Hover);
+
+        if (widget == pressed)
+        {
+            widget->OnClick();
+        }
+    }
+
+    return redraw;
+}
+
+auto WidgetTree::MouseWheel (D2D_POINT_2F point, float delta) -> bool
+{
+    auto widget = HitTest(point);
+
+    return widget && widget->Scroll(delta);
+}
+
+} // namespace Impulse::Widgets
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "SpatialGrid.hpp"
+#include "Widget.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <d2d1_1.h>
+
+namespace {
+    using namespace D2D1;
+}
+
+namespace Impulse::Widgets {
+
+// Retained list of widgets ordered by z-order. Draws them bottom to top and
+// dispatches mouse input to the topmost widget under the pointer. Hit testing
+// goes through spatial grid rebuilt after layout, widgets don't own it.
+class WidgetTree
+{
+    struct Entry
+    {
+        Widget*  widget      = nullptr;
+        int      zOrder      = 0;
+        uint32_t sequence    = 0;     // insertion order, keeps sort stable
+        bool     hitTestable = true;
+    };
+
+    std::vector<Entry>      mEntries;       // sorted bottom to top
+    std::vector<uint32_t>   mHitTestable;   // indices into mEntries, topmost first
+    std::vector<LayoutRect> mBounds;        // reused between rebuilds
+    SpatialGrid             mGrid;
+    uint32_t                mSequence   = 0;
+    bool                    mIndexDirty = true;
+
+    Widget*                 mHovered    = nullptr;
+    Widget*                 mPressed    = nullptr;
+    uint64_t                mHitTests   = 0;
+
+    auto Find (Widget* widget) const -> std::vector<Entry>::const_iterator;
+
+public:
+    // Widgets with higher @zOrder are drawn later and hit first. Widgets
+    // that are not @hitTestable are only drawn.
+    auto Add    (Widget* widget, int zOrder = 0, bool hitTestable = true) -> void;
+    auto Remove (Widget* widget) -> void;
+    auto Clear  () -> void;
+
+    // Call after widgets were moved or resized.
+    auto InvalidateIndex () -> void { mIndexDirty = true; }
+    auto RebuildIndex    () -> void;
+
+    // Topmost hit testable widget under @point.
+    auto HitTest (D2D_POINT_2F point) -> Widget*;
+
+    auto Draw (ID2D1DeviceContext* d2dDeviceContext) -> void;
+
+    auto CreateDeviceResources  (ID2D1DeviceContext* d2dDeviceContext) -> bool;
+    auto DiscardDeviceResources () -> void;
+
+    // Mouse input, each returns true when some widget changed its state and
+    // frame should be redrawn.
+    auto MouseMove  (D2D_POINT_2F point) -> bool;
+    auto MouseDown  (D2D_POINT_2F point) -> bool;
+    auto MouseUp    (D2D_POINT_2F point) -> bool;
+    auto MouseWheel (D2D_POINT_2F point, float delta) -> bool;
+
+    auto Hovered  () const { return mHovered; }
+    auto Pressed  () const { return mPressed; }
+    auto Size     () const { return mEntries.size(); }
+    auto HitTests () const { return mHitTests; }
+};
+
+} // namespace Impulse::Widgets
@@ -23,7 +23,11 @@ auto Window::Dispatch (UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT
         return 0;
 
     case WM_SIZE:
-        Resize(static_cast<UINT32>(LOWORD(lParam)), static_cast<UINT32>(HIWORD(lParam)));
+        Resize(
+            static_cast<UINT>(wParam),
+            static_cast<UINT32>(LOWORD(lParam)),
+            static_cast<UINT32>(HIWORD(lParam))
+        );
         return 0;
 
     case WM_MOVE:
@@ -61,6 +65,10 @@ auto Window::Dispatch (UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT
     case WM_RBUTTONDOWN:
         MouseDown(MouseButton::Right, GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
         return 0;
+
+    case WM_MOUSEWHEEL:
+        MouseWheel(GET_WHEEL_DELTA_WPARAM(wParam), GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
+        return 0;
     }
     
     return CustomMessageHandler(message, wParam, lParam);
@@ -71,8 +79,21 @@ auto Window::Close () -> void
     OnClose();
 }
 
-auto Window::Resize (UINT32 width, UINT32 height) -> void
+auto Window::Resize (UINT type, UINT32 width, UINT32 height) -> void
 {
+    const auto minimized = (type == SIZE_MINIMIZED);
+    if (minimized != mMinimized)
+    {
+        mMinimized = minimized;
+        OnMinimize(minimized);
+    }
+
+    // Minimized window reports 0x0 client area, keep the last real size.
+    if (minimized)
+    {
+        return;
+    }
+
     mWindowSize = D2D1::SizeU(width, height);
     OnResize(width, height);
 }
@@ -131,6 +152,15 @@ auto Window::MouseMove (int x, int y) -> void
     OnMouseMove(x, y);
 }
 
+auto Window::MouseWheel (int delta, int x, int y) -> void
+{
+    // Wheel message carries screen coordinates.
+    auto point = POINT{ x, y };
+    ScreenToClient(mWindowHandle, &point);
+
+    OnMouseWheel(static_cast<float>(delta) / WHEEL_DELTA, point.x, point.y);
+}
+
 auto Window::WindowProc (HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT
 {
     auto windowPtr = static_cast<Window*>(nullptr);
@@ -53,6 +53,7 @@ private:
 
     bool          mClosed          = false;
     bool          mInvisible       = false;
+    bool          mMinimized       = false;
     float         mDpi             = 96.f;
 
     D2D1_POINT_2L mMousePosition   = D2D1::Point2L();
@@ -64,6 +65,7 @@ protected:
     virtual auto OnClose      () -> void {}
 
     virtual auto OnResize     (UINT32 width, UINT32 height) -> void {}
+    virtual auto OnMinimize   (bool minimized)              -> void {}
     virtual auto OnMove       (int x, int y)                -> void {}
     virtual auto OnDpiChanged (float dpi)                   -> void {}
 
@@ -73,6 +75,7 @@ protected:
     virtual auto OnMouseDown  (MouseButton button, int x, int y) -> void {}
     virtual auto OnMouseUp    (MouseButton button, int x, int y) -> void {}
     virtual auto OnMouseMove  (int x, int y)                     -> void {}
+    virtual auto OnMouseWheel (float delta, int x, int y)        -> void {}
 
     // Override to handle custom messages.
     virtual auto CustomMessageHandler (UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT
@@ -86,7 +89,7 @@ private:
 
     // Message handlers.
     auto Close      ()                                 -> void;
-    auto Resize     (UINT32 width, UINT32 height)      -> void;
+    auto Resize     (UINT type, UINT32 width, UINT32 height) -> void;
     auto Move       (int x, int y)                     -> void;
     auto DpiChanged ()                                 -> void;
     auto KeyDown    (UINT key)                         -> void;
@@ -94,6 +97,7 @@ private:
     auto MouseDown  (MouseButton button, int x, int y) -> void;
     auto MouseUp    (MouseButton button, int x, int y) -> void;
     auto MouseMove  (int x, int y)                     -> void;
+    auto MouseWheel (int delta, int x, int y)          -> void;
 
     // WndProc callback.
     static auto CALLBACK WindowProc (HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) -> LRESULT;
@@ -126,6 +130,8 @@ public:
 
     auto Title    () const { return mWindowTitle; }
 
+    auto IsMinimized () const { return mMinimized; }
+
     auto Show     () { ShowWindow(mWindowHandle, SW_SHOW); }
     auto Hide     () { ShowWindow(mWindowHandle, SW_HIDE); }
 
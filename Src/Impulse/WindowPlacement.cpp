@@ -0,0 +1,163 @@
+#include "WindowPlacement.hpp"
+
+#include <cmath>
+
+namespace Impulse {
+
+auto CalculateWindowPlacement (
+    WindowPosition         position,
+    const DisplayGeometry& geometry,
+    float                  width,
+    float                  height,
+    float                  padding,
+    float                  dpi
+) -> WindowPlacement
+{
+    if (!geometry.valid)
+    {
+        return WindowPlacement{
+            static_cast<long>(padding),
+            static_cast<long>(padding),
+            static_cast<uint32_t>(width),
+            static_cast<uint32_t>(height)
+        };
+    }
+
+    // Re-calculate with dpi in mind.
+    const auto windowWidth   = std::ceil(width * dpi / 96.f);
+    const auto windowHeight  = std::ceil(height * dpi / 96.f);
+    const auto windowPadding = std::ceil(padding * dpi / 96.f);
+
+    const auto monitorWidth  = static_cast<float>(geometry.monitor.Width());
+    const auto monitorHeight = static_cast<float>(geometry.monitor.Height());
+
+    // Detect window position basing on taskbar position.
+    if (position == WindowPosition::Auto)
+    {
+        switch (geometry.taskbarEdge)
+        {
+        case TaskbarEdge::Left:
+            position = WindowPosition::LeftBottom;
+            break;
+
+        case TaskbarEdge::Top:
+            position = WindowPosition::RightTop;
+            break;
+
+        case TaskbarEdge::Right:
+        case TaskbarEdge::Bottom:
+            position = WindowPosition::RightBottom;
+            break;
+
+        case TaskbarEdge::None:
+            break;
+        }
+    }
+
+    auto x = monitorWidth - windowWidth - windowPadding;
+    auto y = monitorHeight - windowHeight - windowPadding;
+
+    switch (position)
+    {
+    case WindowPosition::Auto:
+        // Fallback to right-bottom.
+        x = monitorWidth - windowWidth - windowPadding;
+        y = monitorHeight - windowHeight - windowPadding;
+        break;
+    case WindowPosition::LeftTop:
+        x = windowPadding;
+        y = windowPadding;
+        break;
+    case WindowPosition::LeftEdge:
+        x = windowPadding;
+        y = (monitorHeight - windowHeight) / 2;
+        break;
+    case WindowPosition::LeftBottom:
+        x = windowPadding;
+        y = monitorHeight - windowHeight - windowPadding;
+        break;
+    case WindowPosition::CenterTop:
+        x = (monitorWidth - windowWidth) / 2;
+        y = windowPadding;
+        break;
+    case WindowPosition::Center:
+        x = (monitorWidth - windowWidth) / 2;
+        y = (monitorHeight - windowHeight) / 2;
+        break;
+    case WindowPosition::CenterBottom:
+        x = (monitorWidth - windowWidth) / 2;
+        y = monitorHeight - windowHeight - windowPadding;
+        break;
+    case WindowPosition::RightTop:
+        x = monitorWidth - windowWidth - windowPadding;
+        y = windowPadding;
+        break;
+    case WindowPosition::RightEdge:
+        x = monitorWidth - windowWidth - windowPadding;
+        y = (monitorHeight - windowHeight) / 2;
+        break;
+    case WindowPosition::RightBottom:
+        x = monitorWidth - windowWidth - windowPadding;
+        y = monitorHeight - windowHeight - windowPadding;
+        break;
+    }
+
+    // Move window off the taskbar when it's on the same edge.
+    const auto dx = static_cast<float>(geometry.taskbar.Width());
+    const auto dy = static_cast<float>(geometry.taskbar.Height());
+
+    switch (geometry.taskbarEdge)
+    {
+    case TaskbarEdge::Left:
+        if (position == WindowPosition::LeftTop
+        ||  position == WindowPosition::LeftEdge
+        ||  position == WindowPosition::LeftBottom
+           )
+        {
+            x += dx;
+        }
+        break;
+
+    case TaskbarEdge::Top:
+        if (position == WindowPosition::LeftTop
+        ||  position == WindowPosition::CenterTop
+        ||  position == WindowPosition::RightTop
+           )
+        {
+            y += dy;
+        }
+        break;
+
+    case TaskbarEdge::Right:
+        if (position == WindowPosition::RightTop
+        ||  position == WindowPosition::RightEdge
+        ||  position == WindowPosition::RightBottom
+           )
+        {
+            x -= dx;
+        }
+        break;
+
+    case TaskbarEdge::Bottom:
+        if (position == WindowPosition::LeftBottom
+        ||  position == WindowPosition::CenterBottom
+        ||  position == WindowPosition::RightBottom
+           )
+        {
+            y -= dy;
+        }
+        break;
+
+    case TaskbarEdge::None:
+        break;
+    }
+
+    return WindowPlacement{
+        static_cast<long>(x),
+        static_cast<long>(y),
+        static_cast<uint32_t>(windowWidth),
+        static_cast<uint32_t>(windowHeight)
+    };
+}
+
+} // namespace Impulse
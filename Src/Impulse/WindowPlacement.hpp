@@ -0,0 +1,31 @@
+#pragma once
+
+#include "DisplayInfo.hpp"
+#include "WindowPosition.hpp"
+
+#include <cstdint>
+
+namespace Impulse {
+
+// Window rectangle in physical pixels.
+struct WindowPlacement
+{
+    long     x      = 0;
+    long     y      = 0;
+    uint32_t width  = 0;
+    uint32_t height = 0;
+};
+
+// Place window of @width x @height (96 dpi units) at @position on monitor
+// described by @geometry, @padding away from monitor edges and taskbar.
+// Auto picks corner next to the taskbar. Pure, no system calls.
+auto CalculateWindowPlacement (
+    WindowPosition         position,
+    const DisplayGeometry& geometry,
+    float                  width,
+    float                  height,
+    float                  padding,
+    float                  dpi = 96.f
+) -> WindowPlacement;
+
+} // namespace Impulse
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Impulse {
+
+enum class WindowPosition : unsigned char
+{
+    Auto,
+    LeftTop,
+    LeftEdge,
+    LeftBottom,
+    CenterTop,
+    Center,
+    CenterBottom,
+    RightTop,
+    RightEdge,
+    RightBottom
+};
+
+} // namespace Impulse
@@ -0,0 +1,117 @@
+#include "AsyncLogSink.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+enum class Target
+{
+    Null, // queue and writer only
+    File  // what the app logs to
+};
+
+auto LogPath () -> std::filesystem::path
+{
+    return std::filesystem::temp_directory_path() / "ImpulseBenchmarks-Log.txt";
+}
+
+auto MakeSink (Target target) -> spdlog::sink_ptr
+{
+    if (target == Target::Null)
+    {
+        return std::make_shared<spdlog::sinks::null_sink_mt>();
+    }
+
+    return std::make_shared<spdlog::sinks::basic_file_sink_mt>(LogPath().string(), true);
+}
+
+// Latency of every call on calling thread, reported as percentiles.
+auto Percentile (std::vector<int64_t>& latencies, double p) -> double
+{
+    if (latencies.empty())
+    {
+        return 0.0;
+    }
+
+    const auto at = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1));
+    std::nth_element(latencies.begin(), latencies.begin() + static_cast<ptrdiff_t>(at), latencies.end());
+    return static_cast<double>(latencies[at]);
+}
+
+auto Run (benchmark::State& state, spdlog::logger& logger) -> void
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto latencies = std::vector<int64_t>();
+    latencies.reserve(1 << 20);
+
+    auto i = 0;
+    for (auto _ : state)
+    {
+        const auto start = Clock::now();
+        logger.info("Engine transition {} -> {} after {} ms, task {}", "WorkShift", "ShortBreak", 1500000 + i, i % 7);
+        const auto end = Clock::now();
+
+        if (latencies.size() < latencies.capacity())
+        {
+            latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+
+        i += 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["p50 ns"] = Percentile(latencies, 0.50);
+    state.counters["p99 ns"] = Percentile(latencies, 0.99);
+    state.counters["max ns"] = latencies.empty() ? 0.0 : static_cast<double>(*std::max_element(latencies.begin(), latencies.end()));
+}
+
+// Caller formats and writes itself, under sink mutex.
+auto BM_LogSync (benchmark::State& state)
+{
+    auto logger = spdlog::logger("bench", MakeSink(static_cast<Target>(state.range(0))));
+
+    Run(state, logger);
+
+    state.SetLabel(state.range(0) == 0 ? "null" : "file");
+}
+BENCHMARK(BM_LogSync)->Arg(0)->Arg(1);
+
+// Caller only copies message into queue, writer thread does the rest.
+// Queue is large enough that nothing is dropped at this rate, then small
+// enough to overflow.
+auto BM_LogAsync (benchmark::State& state)
+{
+    auto desc     = AsyncLogSink::Desc();
+    desc.sinks    = { MakeSink(static_cast<Target>(state.range(0))) };
+    desc.capacity = static_cast<size_t>(state.range(1));
+    desc.overflow = LogOverflow::DropNewest;
+
+    const auto sink = std::shared_ptr<AsyncLogSink>(AsyncLogSink::Start(std::move(desc)));
+
+    auto logger = spdlog::logger("bench", sink);
+
+    Run(state, logger);
+
+    sink->Stop();
+
+    state.counters["dropped"] = static_cast<double>(sink->Dropped());
+    state.SetLabel(state.range(0) == 0 ? "null" : "file");
+}
+BENCHMARK(BM_LogAsync)
+    ->Args({ 0, 1 << 16 })
+    ->Args({ 1, 1 << 16 })
+    ->Args({ 1, 256 });
+
+}
@@ -0,0 +1,147 @@
+#include "ColumnarHistory.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+constexpr auto RECORDS = size_t(1'000'000);
+
+// A few years of use: transitions minutes apart, backlog of 50 tasks each
+// worked on during its own stretch of history, a handful of recurring
+// tasks throughout, no task now and then.
+auto MakeRecords () -> std::vector<HistoryRecord>
+{
+    auto random  = std::mt19937(42);
+    auto records = std::vector<HistoryRecord>(RECORDS);
+    auto time    = int64_t(1'600'000'000'000);
+
+    for (auto i = size_t(0); i < records.size(); ++i)
+    {
+        auto& record = records[i];
+        time += 60'000 + random() % 1'500'000;
+
+        record.time      = time;
+        record.sequence  = static_cast<uint32_t>(i);
+        record.task      = random() % 8 == 0 ? 0 : random() % 4 == 0 ? 1 + random() % 5 : static_cast<uint32_t>(6 + i * 50 / records.size());
+        record.duration  = random() % 1'500'000;
+        record.workShift = static_cast<uint16_t>(i / 8);
+        record.event     = i % 4 == 3 ? HistoryEvent::Pause : HistoryEvent::End;
+        record.from      = i % 2 ? ImpulseState::WorkShift : ImpulseState::ShortBreak;
+        record.to        = i % 2 ? ImpulseState::ShortBreak : ImpulseState::WorkShift;
+        Seal(record);
+    }
+
+    return records;
+}
+
+// Same records in both layouts, columnar one written once and removed at
+// exit.
+struct History
+{
+    std::filesystem::path            path    = std::filesystem::temp_directory_path() / "ImpulseBenchmarks-Columnar.imp";
+    std::vector<HistoryRecord>       records = MakeRecords();
+    std::unique_ptr<ColumnarHistory> columnar;
+
+    History ()
+    {
+        const auto data = EncodeColumnarHistory(records.data(), records.size());
+
+        auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        file.close();
+
+        columnar = ColumnarHistory::Open(path);
+    }
+
+    ~History ()
+    {
+        columnar.reset();
+
+        auto error = std::error_code();
+        std::filesystem::remove(path, error);
+    }
+
+    static auto Get () -> const History&
+    {
+        static auto history = History();
+        return history;
+    }
+};
+
+auto TaskQuery () -> HistoryQuery
+{
+    auto query     = HistoryQuery();
+    query.task     = 42;
+    query.allTasks = false;
+    return query;
+}
+
+// Encoding cost and size against 32 byte records.
+auto BM_ColumnarEncode (benchmark::State& state)
+{
+    const auto& records = History::Get().records;
+
+    auto size = size_t(0);
+    for (auto _ : state)
+    {
+        const auto data = EncodeColumnarHistory(records.data(), records.size(), static_cast<uint16_t>(state.range(0)));
+        size = data.size();
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(records.size()));
+    state.counters["bytes/record"] = static_cast<double>(size) / static_cast<double>(records.size());
+    state.counters["ratio"]        = static_cast<double>(records.size() * sizeof(HistoryRecord)) / static_cast<double>(size);
+}
+BENCHMARK(BM_ColumnarEncode)->Arg(1024)->Arg(4096)->Arg(16384)->Unit(benchmark::kMillisecond);
+
+// Totals over whole history from mapped 32 byte records, the archive
+// layout the app reads today.
+auto BM_RecordScan (benchmark::State& state)
+{
+    const auto& records = History::Get().records;
+    const auto  span    = HistorySpan{ records.data(), records.data() + records.size() };
+    const auto  query   = state.range(0) == 0 ? HistoryQuery() : TaskQuery();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ScanHistory(span, query));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(records.size()));
+    state.SetLabel(state.range(0) == 0 ? "all tasks" : "rare task");
+}
+BENCHMARK(BM_RecordScan)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Same totals decoding columnar blocks, blocks without task are skipped.
+auto BM_ColumnarScan (benchmark::State& state)
+{
+    const auto& history = History::Get();
+    const auto  query   = state.range(0) == 0 ? HistoryQuery() : TaskQuery();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(history.columnar->Scan(query));
+    }
+
+    auto decoded = 0;
+    for (auto block = size_t(0); block < history.columnar->Blocks(); ++block)
+    {
+        decoded += history.columnar->Skips(block, query) ? 0 : 1;
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(history.records.size()));
+    state.SetLabel(state.range(0) == 0 ? "all tasks" : "rare task");
+    state.counters["blocks"]  = static_cast<double>(history.columnar->Blocks());
+    state.counters["decoded"] = decoded;
+}
+BENCHMARK(BM_ColumnarScan)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,28 @@
+#include "Crc32.hpp"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Journal records are 28 bytes, columnar blocks tens of KB.
+template <uint32_t (*Crc)(const void*, size_t, uint32_t)>
+auto BM_Crc (benchmark::State& state)
+{
+    const auto data = std::string(static_cast<size_t>(state.range(0)), 'x');
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Crc(data.data(), data.size(), 0));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Crc, Crc32)->Name("BM_Crc32")->Arg(28)->Arg(4096)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Crc, Crc32c)->Name("BM_Crc32c")->Arg(28)->Arg(4096)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Crc, Crc32cScalar)->Name("BM_Crc32cScalar")->Arg(28)->Arg(4096)->Arg(1 << 20);
+
+}
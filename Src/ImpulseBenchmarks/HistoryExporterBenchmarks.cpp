@@ -0,0 +1,118 @@
+#include "HistoryExporter.hpp"
+#include "HistorySegments.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+using namespace Impulse;
+
+namespace {
+
+// History of @count records in one archive segment, removed afterwards.
+struct History
+{
+    std::filesystem::path root      = std::filesystem::temp_directory_path() / "ImpulseBenchmarks-Export";
+    std::filesystem::path directory = root / "History";
+
+    explicit History (uint32_t count)
+    {
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(directory);
+
+        auto file = std::ofstream(directory / ArchiveSegmentName(0, count - 1), std::ios::binary);
+
+        const auto header = MakeHistoryHeader(0, 0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        auto chunk = std::vector<HistoryRecord>(1 << 16);
+        for (auto first = uint32_t(0); first < count; first += static_cast<uint32_t>(chunk.size()))
+        {
+            const auto n = std::min<uint32_t>(count - first, static_cast<uint32_t>(chunk.size()));
+            for (auto i = uint32_t(0); i < n; ++i)
+            {
+                auto& record = chunk[i];
+                record.sequence = first + i;
+                record.time     = int64_t(1'600'000'000'000) + int64_t(first + i) * 60'000;
+                record.task     = (first + i) % 7;
+                record.duration = 1'500'000;
+                record.event    = HistoryEvent::End;
+                record.from     = ImpulseState::WorkShift;
+                record.to       = ImpulseState::ShortBreak;
+                Seal(record);
+            }
+
+            file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(n * sizeof(HistoryRecord)));
+        }
+    }
+
+    ~History ()
+    {
+        auto error = std::error_code();
+        std::filesystem::remove_all(root, error);
+    }
+};
+
+// Peak resident memory of the process so far, 0 where not known.
+auto PeakMemory () -> double
+{
+#if defined(_WIN32)
+    return 0.0;
+#else
+    auto usage = rusage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) * 1024.0;
+#endif
+}
+
+// Whole history to a file on export thread, start to finish.
+auto BM_HistoryExport (benchmark::State& state)
+{
+    const auto count   = static_cast<uint32_t>(state.range(0));
+    const auto format  = state.range(1) == 0 ? ExportFormat::Csv : ExportFormat::JsonLines;
+    const auto history = History(count);
+    const auto path    = history.root / "History.out";
+
+    for (auto _ : state)
+    {
+        auto desc      = HistoryExporter::Desc();
+        desc.directory = history.directory;
+        desc.path      = path;
+        desc.format    = format;
+        desc.taskNames = { { 1, "Write report" }, { 2, "Review, \"quoted\"" } };
+
+        const auto exporter = HistoryExporter::Start(std::move(desc));
+        if (!exporter->Wait())
+        {
+            state.SkipWithError("Export failed");
+            break;
+        }
+    }
+
+    // Mapped segments are let go as export goes, peak stays the same
+    // for 1M and 10M records.
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+    state.counters["peak RSS"] = benchmark::Counter(PeakMemory(), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    state.SetLabel(format == ExportFormat::Csv ? "csv" : "jsonl");
+}
+BENCHMARK(BM_HistoryExport)
+    ->Args({ 1'000'000, 0 })
+    ->Args({ 1'000'000, 1 })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// 10M records, peak resident memory should match 1M above.
+BENCHMARK(BM_HistoryExport)
+    ->Args({ 10'000'000, 0 })
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}
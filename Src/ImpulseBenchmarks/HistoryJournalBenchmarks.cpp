@@ -0,0 +1,88 @@
+#include "HistoryJournal.hpp"
+
+#include <filesystem>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct TempDirectory
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "ImpulseBenchmarks-History";
+
+    TempDirectory  () { std::filesystem::remove_all(path); std::filesystem::create_directories(path); }
+    ~TempDirectory () { auto error = std::error_code(); std::filesystem::remove_all(path, error); }
+};
+
+auto MakeRecord (int64_t time) -> HistoryRecord
+{
+    auto record  = HistoryRecord();
+    record.time  = time;
+    record.task  = 7;
+    record.event = HistoryEvent::End;
+    record.from  = ImpulseState::WorkShift;
+    record.to    = ImpulseState::ShortBreak;
+    return record;
+}
+
+// What UI thread pays per transition: queueing only, writer thread
+// commits in the background.
+auto BM_HistoryAppend (benchmark::State& state)
+{
+    const auto dir = TempDirectory();
+
+    auto desc           = HistoryJournal::Desc();
+    desc.directory      = dir.path;
+    desc.maxSegmentSize = uint64_t(1) << 40;
+
+    auto journal = HistoryJournal::Open(desc);
+    auto time    = int64_t(0);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(journal->Append(MakeRecord(time++)));
+    }
+
+    journal->Commit();
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["commits"] = static_cast<double>(journal->Commits());
+}
+BENCHMARK(BM_HistoryAppend);
+
+// Records on disk per second when every group of @range(0) records is
+// flushed, group commit shares one flush between all of them.
+auto BM_HistoryGroupCommit (benchmark::State& state)
+{
+    const auto dir   = TempDirectory();
+    const auto group = state.range(0);
+
+    auto desc           = HistoryJournal::Desc();
+    desc.directory      = dir.path;
+    desc.commitDelay    = 10s;
+    desc.maxGroup       = static_cast<size_t>(group);
+    desc.maxSegmentSize = uint64_t(1) << 40;
+
+    auto journal = HistoryJournal::Open(desc);
+    auto time    = int64_t(0);
+
+    for (auto _ : state)
+    {
+        for (auto i = int64_t(0); i < group; ++i)
+        {
+            journal->Append(MakeRecord(time++));
+        }
+
+        journal->Commit();
+    }
+
+    state.SetItemsProcessed(state.iterations() * group);
+    state.SetBytesProcessed(state.iterations() * group * static_cast<int64_t>(sizeof(HistoryRecord)));
+}
+BENCHMARK(BM_HistoryGroupCommit)->Arg(1)->Arg(64)->Arg(4096)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,108 @@
+#include "HistoryReader.hpp"
+#include "HistorySegments.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+constexpr auto RECORDS = uint32_t(10'000'000);
+constexpr auto STEP    = int64_t(60'000); // ms between records
+constexpr auto DAY     = int64_t(24) * 60 * 60 * 1000;
+
+// 10M records in one archive segment (320 MB), written once for all
+// benchmarks and removed at exit.
+struct History
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "ImpulseBenchmarks-Reader";
+
+    History ()
+    {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        auto file = std::ofstream(directory / ArchiveSegmentName(0, RECORDS - 1), std::ios::binary);
+
+        const auto header = MakeHistoryHeader(0, 0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        auto chunk = std::vector<HistoryRecord>(1 << 16);
+        for (auto first = uint32_t(0); first < RECORDS; first += static_cast<uint32_t>(chunk.size()))
+        {
+            for (auto i = uint32_t(0); i < chunk.size(); ++i)
+            {
+                auto& record = chunk[i];
+                record.sequence = first + i;
+                record.time     = int64_t(first + i) * STEP;
+                record.task     = (first + i) % 7;
+                Seal(record);
+            }
+
+            file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size() * sizeof(HistoryRecord)));
+        }
+    }
+
+    ~History ()
+    {
+        auto error = std::error_code();
+        std::filesystem::remove_all(directory, error);
+    }
+
+    static auto Get () -> const History&
+    {
+        static auto history = History();
+        return history;
+    }
+};
+
+// Mapping and building sparse index, what app pays at startup.
+auto BM_HistoryReaderOpen (benchmark::State& state)
+{
+    const auto& history = History::Get();
+
+    auto memory = size_t(0);
+    for (auto _ : state)
+    {
+        const auto reader = HistoryReader::OpenDirectory(history.directory);
+        memory = reader->MemoryUsage();
+        benchmark::DoNotOptimize(reader->Size());
+    }
+
+    state.counters["index bytes"] = static_cast<double>(memory);
+}
+BENCHMARK(BM_HistoryReaderOpen)->Unit(benchmark::kMillisecond);
+
+// "Sessions between date A and B" for random ranges @range(0) days long.
+auto BM_HistoryRangeQuery (benchmark::State& state)
+{
+    const auto& history = History::Get();
+    const auto  reader  = HistoryReader::OpenDirectory(history.directory);
+    const auto  length  = state.range(0) * DAY;
+
+    auto random = std::mt19937_64(42);
+    auto from   = std::uniform_int_distribution<int64_t>(0, int64_t(RECORDS) * STEP - length);
+    auto found  = uint64_t(0);
+
+    for (auto _ : state)
+    {
+        const auto start = from(random);
+        reader->Range(start, start + length, [&](HistorySpan span)
+        {
+            found += span.size();
+            return true;
+        });
+    }
+
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["records/query"] = static_cast<double>(found) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_HistoryRangeQuery)->Arg(1)->Arg(30)->Arg(365);
+
+}
@@ -0,0 +1,136 @@
+#include "HistoryScan.hpp"
+#include "HistoryStats.hpp"
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+// A transition every 10 minutes on average, three tasks.
+auto MakeHistory (size_t count) -> std::vector<HistoryRecord>
+{
+    constexpr ImpulseState STATES[] = {
+        ImpulseState::WorkShift, ImpulseState::ShortBreak, ImpulseState::WorkShift,
+        ImpulseState::LongBreak, ImpulseState::Paused
+    };
+
+    auto random  = std::mt19937(7);
+    auto records = std::vector<HistoryRecord>(count);
+    auto time    = int64_t(1'600'000'000'000);
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        auto& record = records[i];
+        time += 300'000 + random() % 600'000;
+
+        record.time     = time;
+        record.sequence = static_cast<uint32_t>(i);
+        record.task     = random() % 3;
+        record.duration = 60'000 + random() % 1'500'000;
+        record.event    = random() % 4 ? HistoryEvent::End : HistoryEvent::Pause;
+        record.from     = STATES[i % 5];
+        Seal(record);
+    }
+
+    return records;
+}
+
+// Ad-hoc query over raw records: one task, middle half of history.
+auto MakeQuery (const std::vector<HistoryRecord>& records) -> HistoryQuery
+{
+    auto query = HistoryQuery();
+    query.from     = records[records.size() / 4].time;
+    query.to       = records[records.size() * 3 / 4].time;
+    query.task     = 1;
+    query.allTasks = false;
+    return query;
+}
+
+auto BM_HistoryScan (benchmark::State& state)
+{
+    const auto records = MakeHistory(static_cast<size_t>(state.range(0)));
+    const auto span    = HistorySpan{ records.data(), records.data() + records.size() };
+    const auto query   = MakeQuery(records);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ScanHistory(span, query));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(HistoryRecord)));
+    state.SetLabel(HistoryScanUsesAvx2() ? "avx2" : "scalar");
+}
+BENCHMARK(BM_HistoryScan)->Arg(1 << 10)->Arg(1 << 20);
+
+auto BM_HistoryScanScalar (benchmark::State& state)
+{
+    const auto records = MakeHistory(static_cast<size_t>(state.range(0)));
+    const auto span    = HistorySpan{ records.data(), records.data() + records.size() };
+    const auto query   = MakeQuery(records);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ScanHistoryScalar(span, query));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(HistoryRecord)));
+}
+BENCHMARK(BM_HistoryScanScalar)->Arg(1 << 10)->Arg(1 << 20);
+
+// Incremental path, cost of one new record on UI thread.
+auto BM_HistoryStatsAdd (benchmark::State& state)
+{
+    const auto records = MakeHistory(1 << 16);
+
+    auto stats = HistoryStats(2 * 60 * 60 * 1000);
+    auto next  = size_t(0);
+
+    for (auto _ : state)
+    {
+        if (next == records.size())
+        {
+            state.PauseTiming();
+            stats.Clear();
+            next = 0;
+            state.ResumeTiming();
+        }
+
+        stats.Add(records[next++]);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HistoryStatsAdd);
+
+// What stats view pays: day, week and month of one task from rollups.
+auto BM_HistoryStatsTotals (benchmark::State& state)
+{
+    const auto records = MakeHistory(1 << 16);
+
+    auto stats = HistoryStats();
+    for (const auto& record : records)
+    {
+        stats.Add(record);
+    }
+
+    const auto time = records.back().time;
+
+    for (auto _ : state)
+    {
+        auto totals = stats.Totals(StatsPeriod::Day, stats.PeriodOf(StatsPeriod::Day, time), 1);
+        totals += stats.Totals(StatsPeriod::Week, stats.PeriodOf(StatsPeriod::Week, time), 1);
+        totals += stats.Totals(StatsPeriod::Month, stats.PeriodOf(StatsPeriod::Month, time), 1);
+        benchmark::DoNotOptimize(totals);
+    }
+
+    state.counters["rollups"] = static_cast<double>(stats.Size());
+}
+BENCHMARK(BM_HistoryStatsTotals);
+
+}
@@ -0,0 +1,170 @@
+#include "Layout.hpp"
+
+#include <array>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Widget positions written by OnArrange, stand in for Widget::Position/Size.
+struct Placement
+{
+    LayoutRect rects[8] = {};
+};
+
+// Same tree as ImpulseApp::CreateLayout(): corner buttons, two texts, task
+// list and clock.
+auto CreateAppLayout (Placement& placement) -> std::unique_ptr<LayoutNode>
+{
+    auto root  = std::make_unique<AnchorLayout>();
+    auto index = 0;
+
+    const auto addNode = [&](LayoutAlign horizontal, LayoutAlign vertical) -> LayoutNode*
+    {
+        auto node = root->Emplace<LayoutNode>();
+        node->Align(horizontal, vertical);
+        node->OnArrange = [&placement, i = index++](const LayoutRect& rect)
+        {
+            placement.rects[i] = rect;
+        };
+
+        return node;
+    };
+
+    for (auto horizontal : { LayoutAlign::Start, LayoutAlign::End })
+    {
+        for (auto vertical : { LayoutAlign::Start, LayoutAlign::End })
+        {
+            auto button = addNode(horizontal, vertical);
+            button->Size(32.f, 32.f);
+            button->Margin(5.f);
+        }
+    }
+
+    for (auto vertical : { LayoutAlign::Start, LayoutAlign::End })
+    {
+        auto text = addNode(LayoutAlign::Stretch, vertical);
+        text->Size(LayoutNode::AUTO, 32.f);
+        text->Margin(42.f, 5.f, 42.f, 5.f);
+    }
+
+    addNode(LayoutAlign::Stretch, LayoutAlign::Stretch)->Margin(42.f);
+    addNode(LayoutAlign::Stretch, LayoutAlign::Stretch)->Margin(55.f);
+
+    return root;
+}
+
+// App tree with a stack of @rows rows in place of the task list.
+auto CreateDeepLayout (Placement& placement, int rows) -> std::unique_ptr<LayoutNode>
+{
+    auto root  = CreateAppLayout(placement);
+    auto stack = root->Emplace<StackLayout>(LayoutOrientation::Vertical, 2.f);
+    stack->Margin(42.f);
+
+    for (auto i = 0; i < rows; ++i)
+    {
+        auto row = stack->Emplace<StackLayout>(LayoutOrientation::Horizontal, 4.f);
+        row->Size(LayoutNode::AUTO, 24.f);
+        row->Emplace<LayoutNode>()->Size(16.f, 16.f);
+        row->Emplace<CenterLayout>()->Emplace<LayoutNode>()->Size(120.f, 20.f);
+    }
+
+    return root;
+}
+
+// Live resize: every update gets a different size, like dragging a corner.
+auto BM_LayoutLiveResize (benchmark::State& state)
+{
+    auto placement = Placement();
+    auto layout    = CreateAppLayout(placement);
+    auto step      = 0;
+
+    layout->Update(LayoutSize{ 450.f, 330.f });
+    layout->ResetStats();
+
+    for (auto _ : state)
+    {
+        const auto delta = static_cast<float>(step++ % 200);
+        layout->Update(LayoutSize{ 450.f + delta, 330.f + delta / 2.f });
+        benchmark::DoNotOptimize(placement);
+    }
+
+    const auto stats = layout->Stats();
+    state.counters["measured"] = benchmark::Counter(static_cast<double>(stats.measured), benchmark::Counter::kAvgIterations);
+    state.counters["arranged"] = benchmark::Counter(static_cast<double>(stats.arranged), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LayoutLiveResize);
+
+// Repeated update with same inputs, everything comes from the cache.
+auto BM_LayoutUnchanged (benchmark::State& state)
+{
+    auto placement = Placement();
+    auto layout    = CreateAppLayout(placement);
+
+    layout->Update(LayoutSize{ 450.f, 330.f });
+
+    for (auto _ : state)
+    {
+        layout->Update(LayoutSize{ 450.f, 330.f });
+        benchmark::DoNotOptimize(placement);
+    }
+}
+BENCHMARK(BM_LayoutUnchanged);
+
+// Window moving between monitors with different dpi, results restored from
+// snapshot per scale, the way UpdateLayout() does it.
+auto BM_LayoutDpiSwitch (benchmark::State& state)
+{
+    auto placement = Placement();
+    auto layout    = CreateAppLayout(placement);
+    auto snapshots = std::array<LayoutSnapshot, 2>();
+    auto scales    = std::array<float, 2>{ 1.0f, 1.5f };
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        layout->SetScale(scales[i]);
+        layout->Update(LayoutSize{ 450.f * scales[i], 330.f * scales[i] });
+        layout->Save(snapshots[i]);
+    }
+
+    auto index = 0;
+    for (auto _ : state)
+    {
+        index = 1 - index;
+        layout->SetScale(scales[index]);
+
+        const auto size = LayoutSize{ 450.f * scales[index], 330.f * scales[index] };
+        if (!layout->Restore(snapshots[index], size))
+        {
+            layout->Update(size);
+        }
+
+        benchmark::DoNotOptimize(placement);
+    }
+}
+BENCHMARK(BM_LayoutDpiSwitch);
+
+// Live resize cost as the tree grows.
+auto BM_LayoutLiveResizeRows (benchmark::State& state)
+{
+    auto placement = Placement();
+    auto layout    = CreateDeepLayout(placement, static_cast<int>(state.range(0)));
+    auto step      = 0;
+
+    layout->Update(LayoutSize{ 450.f, 330.f });
+
+    for (auto _ : state)
+    {
+        const auto delta = static_cast<float>(step++ % 200);
+        layout->Update(LayoutSize{ 450.f + delta, 330.f + delta / 2.f });
+        benchmark::DoNotOptimize(placement);
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_LayoutLiveResizeRows)->RangeMultiplier(10)->Range(10, 1000)->Complexity();
+
+}
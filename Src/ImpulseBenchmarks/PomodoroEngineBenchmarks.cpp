@@ -0,0 +1,52 @@
+#include "PomodoroEngine.hpp"
+
+#include <iterator>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Timeouts only, engine cycles through work shifts and breaks.
+auto BM_PomodoroEngineTimeout (benchmark::State& state)
+{
+    auto engine = PomodoroEngine();
+    engine.Handle(PomodoroEvent::Start);
+
+    for (auto _ : state)
+    {
+        engine.Handle(PomodoroEvent::Timeout);
+        benchmark::DoNotOptimize(engine.State());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(engine.Transitions()));
+}
+BENCHMARK(BM_PomodoroEngineTimeout);
+
+// Mix of every event, with an observer like the UI has.
+auto BM_PomodoroEngineEvents (benchmark::State& state)
+{
+    static constexpr PomodoroEvent EVENTS[] = {
+        PomodoroEvent::Start,   PomodoroEvent::Timeout, PomodoroEvent::Toggle,
+        PomodoroEvent::Toggle,  PomodoroEvent::Timeout, PomodoroEvent::Pause,
+        PomodoroEvent::Resume,  PomodoroEvent::Timeout, PomodoroEvent::Stop,
+    };
+
+    auto engine   = PomodoroEngine();
+    auto observed = uint64_t(0);
+    engine.OnTransition = [&](ImpulseState, ImpulseState to) { observed += static_cast<uint64_t>(to); };
+
+    auto index = size_t(0);
+    for (auto _ : state)
+    {
+        engine.Handle(EVENTS[index]);
+        index = (index + 1) % std::size(EVENTS);
+    }
+
+    benchmark::DoNotOptimize(observed);
+    state.SetItemsProcessed(static_cast<int64_t>(engine.Transitions()));
+}
+BENCHMARK(BM_PomodoroEngineEvents);
+
+}
@@ -0,0 +1,97 @@
+#include "ScheduleProjection.hpp"
+#include "SessionHost.hpp"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto CreateHost (uint32_t sessions) -> SessionHost
+{
+    auto host = SessionHost();
+    host.Reserve(sessions);
+
+    for (auto i = uint32_t(0); i < sessions; ++i)
+    {
+        auto config = PomodoroConfig();
+        config.workDuration       = 60 + i % 240;
+        config.shortBreakDuration = 20 + i % 40;
+        config.longBreakDuration  = 60 + i % 120;
+        config.longBreakAfter     = 1 + i % 4;
+
+        const auto id = host.Add(config);
+        host.Start(id, std::chrono::milliseconds(i % 60000));
+        if (i % 5 == 0)
+        {
+            host.Pause(id, 60s);
+        }
+    }
+
+    host.Advance(60s);
+    return host;
+}
+
+// n-th transition of every session in one pass over the session arrays.
+auto BM_ProjectTransitions (benchmark::State& state)
+{
+    auto host = CreateHost(static_cast<uint32_t>(state.range(0)));
+    auto out  = std::vector<std::chrono::milliseconds>();
+    auto n    = uint32_t(0);
+
+    for (auto _ : state)
+    {
+        host.ProjectTransitions(n++ % 1000, 60s, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProjectTransitions)->Arg(10000)->Arg(100000);
+
+// Same through one ScheduleProjection per session.
+auto BM_ScheduleProjectionPerSession (benchmark::State& state)
+{
+    auto host = CreateHost(static_cast<uint32_t>(state.range(0)));
+    auto out  = std::vector<std::chrono::milliseconds>(host.Size());
+    auto n    = uint32_t(0);
+
+    for (auto _ : state)
+    {
+        for (auto id = SessionId(0); id < host.Size(); ++id)
+        {
+            const auto paused = host.State(id) == ImpulseState::Paused;
+            const auto end    = paused ? 60s + host.Remaining(id, 60s) : host.Deadline(id);
+            const auto phase  = paused ? host.PreviousState(id) : host.State(id);
+
+            const auto projection = ScheduleProjection(host.Config(id), phase, host.WorkShiftCount(id), end);
+            out[id] = projection.Transition(n % 1000).start;
+        }
+
+        n += 1;
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScheduleProjectionPerSession)->Arg(10000)->Arg(100000);
+
+// Questions the app would ask: phase at some time, next long break.
+auto BM_ScheduleProjectionQueries (benchmark::State& state)
+{
+    const auto projection = ScheduleProjection(PomodoroConfig(), ImpulseState::WorkShift, 2, 9h);
+    auto       time       = std::chrono::milliseconds(9h);
+
+    for (auto _ : state)
+    {
+        time += 7min;
+        benchmark::DoNotOptimize(projection.PhaseAt(time));
+        benchmark::DoNotOptimize(projection.NextLongBreak());
+    }
+}
+BENCHMARK(BM_ScheduleProjectionQueries);
+
+}
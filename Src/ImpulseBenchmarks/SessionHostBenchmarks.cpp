@@ -0,0 +1,83 @@
+#include "SessionHost.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Floor of users with their own durations, started a little apart. Every
+// iteration is one scheduler wake a second later.
+auto BM_SessionHostAdvance (benchmark::State& state)
+{
+    const auto sessions = static_cast<uint32_t>(state.range(0));
+
+    auto host = SessionHost();
+    host.Reserve(sessions);
+
+    for (auto i = uint32_t(0); i < sessions; ++i)
+    {
+        auto config = PomodoroConfig();
+        config.workDuration       = 60 + i % 240;
+        config.shortBreakDuration = 20 + i % 40;
+        config.longBreakDuration  = 60 + i % 120;
+        config.longBreakAfter     = 1 + i % 4;
+
+        host.Start(host.Add(config), std::chrono::milliseconds(i % 60000));
+    }
+
+    auto observed = uint64_t(0);
+    host.OnTransitions = [&](const std::vector<SessionTransition>& batch) { observed += batch.size(); };
+
+    auto now = 0ms;
+    host.Advance(now);
+
+    const auto before = host.Transitions();
+    for (auto _ : state)
+    {
+        now += 1s;
+        host.Advance(now);
+    }
+
+    benchmark::DoNotOptimize(observed);
+
+    const auto transitions = host.Transitions() - before;
+    state.counters["transitions/s"] = benchmark::Counter(static_cast<double>(transitions), benchmark::Counter::kIsRate);
+    state.counters["bytes/session"] = static_cast<double>(host.MemoryUsage()) / sessions;
+}
+BENCHMARK(BM_SessionHostAdvance)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// Users pausing and resuming all the time, dead heap entries pile up.
+auto BM_SessionHostPauseResume (benchmark::State& state)
+{
+    const auto sessions = static_cast<uint32_t>(state.range(0));
+
+    auto host = SessionHost();
+    host.Reserve(sessions);
+
+    for (auto i = uint32_t(0); i < sessions; ++i)
+    {
+        host.Start(host.Add(PomodoroConfig()), 0ms);
+    }
+
+    auto now = 0ms;
+    auto id  = SessionId(0);
+    for (auto _ : state)
+    {
+        now += 1ms;
+        host.Pause(id, now);
+        host.Resume(id, now);
+        id = (id + 1) % sessions;
+
+        if (id == 0)
+        {
+            host.Advance(now);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SessionHostPauseResume)->Arg(10000);
+
+}
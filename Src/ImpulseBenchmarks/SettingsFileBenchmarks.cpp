@@ -0,0 +1,109 @@
+#include "AllocationCounter.hpp"
+#include "SettingsFile.hpp"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Settings file as the app writes it, with @tasks task names.
+auto CreateFile (int64_t tasks) -> std::string
+{
+    auto settings     = Settings();
+    settings.TaskName = L"Write report for sprint 3";
+
+    auto store = TaskStore();
+    for (auto i = int64_t(0); i < tasks; ++i)
+    {
+        store.Add(L"Write report for sprint " + std::to_wstring(i));
+    }
+
+    return WriteSettings(settings, store);
+}
+
+// How settings were loaded before ReadSettings(): whole document, then
+// fields and tasks copied out of it.
+auto ReadSettingsDom (const std::string& text, Settings& settings, TaskStore& tasks) -> bool
+{
+    const auto json = nlohmann::json::parse(text, nullptr, false, true);
+    if (json.is_discarded())
+    {
+        return false;
+    }
+
+    try
+    {
+        settings = json.get<Settings>();
+    }
+    catch (nlohmann::json::exception&)
+    {
+        return false;
+    }
+
+    tasks.Clear();
+
+    const auto names = json.find("Tasks");
+    if (names == json.end() || !names->is_array())
+    {
+        return true;
+    }
+
+    tasks.Reserve(names->size(), 0);
+    for (const auto& name : *names)
+    {
+        if (name.is_string())
+        {
+            if (const auto utf16 = UTF8ToUTF16(name.get_ref<const std::string&>()))
+            {
+                tasks.Add(*utf16);
+            }
+        }
+    }
+
+    return true;
+}
+
+auto BM_SettingsReadSax (benchmark::State& state)
+{
+    const auto text = CreateFile(state.range(0));
+
+    const auto before = AllocationCount();
+    for (auto _ : state)
+    {
+        auto settings = Settings();
+        auto tasks    = TaskStore();
+
+        benchmark::DoNotOptimize(ReadSettings(text, settings, tasks).valid);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.counters["allocs/parse"] = benchmark::Counter(
+        static_cast<double>(AllocationCount() - before), benchmark::Counter::kAvgIterations
+    );
+}
+BENCHMARK(BM_SettingsReadSax)->Arg(10)->Arg(1000)->Arg(100'000);
+
+auto BM_SettingsReadDom (benchmark::State& state)
+{
+    const auto text = CreateFile(state.range(0));
+
+    const auto before = AllocationCount();
+    for (auto _ : state)
+    {
+        auto settings = Settings();
+        auto tasks    = TaskStore();
+
+        benchmark::DoNotOptimize(ReadSettingsDom(text, settings, tasks));
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.counters["allocs/parse"] = benchmark::Counter(
+        static_cast<double>(AllocationCount() - before), benchmark::Counter::kAvgIterations
+    );
+}
+BENCHMARK(BM_SettingsReadDom)->Arg(10)->Arg(1000)->Arg(100'000);
+
+}
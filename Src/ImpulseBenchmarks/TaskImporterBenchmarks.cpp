@@ -0,0 +1,61 @@
+#include "TaskImporter.hpp"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+constexpr auto FILE_SIZE = size_t(100) << 20;
+
+// 100 MB task list of @format, every tenth line repeats an earlier task.
+auto CreateFile (TaskFormat format) -> std::string
+{
+    auto text = std::string();
+    text.reserve(FILE_SIZE + 256);
+
+    if (format == TaskFormat::Csv)
+    {
+        text += "Id,Title,Due\r\n";
+    }
+
+    for (auto i = size_t(0); text.size() < FILE_SIZE; ++i)
+    {
+        const auto task = std::to_string(i % 10 == 9 ? i / 2 : i);
+
+        if (format == TaskFormat::Csv)
+        {
+            text += std::to_string(i) + ",\"Write report for sprint " + task + ", part \"\"two\"\"\",2024-01-01\r\n";
+        }
+        else
+        {
+            text += "(B) 2024-01-01 Write report for sprint " + task + " +work @office\n";
+        }
+    }
+
+    return text;
+}
+
+// Whole file into empty store, parsing spread over all cores.
+auto BM_ImportTasks (benchmark::State& state)
+{
+    const auto format = state.range(0) == 0 ? TaskFormat::Csv : TaskFormat::TodoTxt;
+    const auto text   = CreateFile(format);
+
+    auto added = uint32_t(0);
+    for (auto _ : state)
+    {
+        auto tasks = TaskStore();
+        added = ImportTasks(text, format, tasks).added;
+        benchmark::DoNotOptimize(tasks.Size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.counters["tasks"] = static_cast<double>(added);
+    state.SetLabel(format == TaskFormat::Csv ? "csv" : "todo.txt");
+}
+BENCHMARK(BM_ImportTasks)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
@@ -0,0 +1,101 @@
+#include "TaskListView.hpp"
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+auto CreateStore (int64_t tasks) -> TaskStore
+{
+    auto store = TaskStore();
+    store.Reserve(static_cast<size_t>(tasks), static_cast<size_t>(tasks) * 24);
+
+    for (auto i = int64_t(0); i < tasks; ++i)
+    {
+        store.Add(L"Write report for sprint " + std::to_wstring(i));
+    }
+
+    return store;
+}
+
+// Frame of TaskList::Draw() without Direct2D: visible range, row layout
+// for slots that got a new task (text copied in place of CreateTextLayout)
+// and per-row draw positions.
+auto BM_TaskListScroll (benchmark::State& state)
+{
+    auto store  = CreateStore(state.range(0));
+    auto view   = TaskListView();
+    auto layout = std::vector<std::wstring>();
+
+    view.Store(&store);
+    view.Size(336.0f, 246.0f);
+    view.RowHeight(24.0f);
+
+    // Wheel notches down, reversed at either end, like scrolling through
+    // the whole backlog.
+    auto delta = -1.0f;
+    auto drawn = 0.0f;
+
+    for (auto _ : state)
+    {
+        if (!view.Scroll(delta))
+        {
+            delta = -delta;
+            view.Scroll(delta);
+        }
+
+        const auto [first, last] = view.VisibleRange();
+        view.PrepareRows(first, last, [&](size_t slot, uint32_t task)
+        {
+            layout.resize(view.Slots());
+            layout[slot].assign(store.Get(task));
+        });
+
+        for (auto task = first; task < last; ++task)
+        {
+            drawn += view.RowTop(task) + static_cast<float>(layout[view.Slot(task)].size());
+        }
+
+        benchmark::DoNotOptimize(drawn);
+    }
+
+    state.counters["rows/frame"] = benchmark::Counter(
+        static_cast<double>(view.RowsLaidOut()), benchmark::Counter::kAvgIterations
+    );
+}
+BENCHMARK(BM_TaskListScroll)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+// Dragging scroll bar: each frame shows a different screen full of tasks.
+auto BM_TaskListJump (benchmark::State& state)
+{
+    auto store  = CreateStore(state.range(0));
+    auto view   = TaskListView();
+    auto layout = std::vector<std::wstring>();
+
+    view.Store(&store);
+    view.Size(336.0f, 246.0f);
+    view.RowHeight(24.0f);
+
+    auto target = uint32_t(0);
+    for (auto _ : state)
+    {
+        target = (target + 7919) % store.Size();
+        view.ScrollTo(target);
+
+        const auto [first, last] = view.VisibleRange();
+        view.PrepareRows(first, last, [&](size_t slot, uint32_t task)
+        {
+            layout.resize(view.Slots());
+            layout[slot].assign(store.Get(task));
+        });
+
+        benchmark::DoNotOptimize(layout.data());
+    }
+}
+BENCHMARK(BM_TaskListJump)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+}
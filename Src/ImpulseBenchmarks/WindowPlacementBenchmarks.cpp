@@ -0,0 +1,39 @@
+#include "WindowPlacement.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Placement of all ten positions from cached geometry, what layout and dpi
+// changes cost now that the system isn't queried each time.
+auto BM_WindowPlacementAllPositions (benchmark::State& state)
+{
+    auto geometry = DisplayGeometry();
+    geometry.valid       = true;
+    geometry.monitor     = DisplayRect{ 0, 0, 1920, 1080 };
+    geometry.taskbarEdge = TaskbarEdge::Bottom;
+    geometry.taskbar     = DisplayRect{ 0, 1040, 1920, 1080 };
+
+    auto display = FakeDisplayInfo(geometry);
+    auto dpi     = 96.f;
+
+    for (auto _ : state)
+    {
+        for (auto position = 0; position <= static_cast<int>(WindowPosition::RightBottom); ++position)
+        {
+            auto placement = CalculateWindowPlacement(
+                static_cast<WindowPosition>(position), display.Geometry(), 450.f, 330.f, 20.f, dpi
+            );
+            benchmark::DoNotOptimize(placement);
+        }
+
+        dpi = dpi == 96.f ? 144.f : 96.f;
+    }
+
+    state.SetItemsProcessed(state.iterations() * 10);
+}
+BENCHMARK(BM_WindowPlacementAllPositions);
+
+}
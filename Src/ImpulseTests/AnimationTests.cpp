@@ -0,0 +1,391 @@
+#include "Animation.hpp"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Scheduler reading time from a clock the test moves by hand.
+struct VirtualClock
+{
+    AnimationClock::time_point now = AnimationClock::time_point(1h);
+    AnimationScheduler         scheduler;
+
+    VirtualClock ()
+    {
+        scheduler.SetTimeSource([this] { return now; });
+    }
+
+    auto Advance (AnimationClock::duration duration) -> bool
+    {
+        now += duration;
+        return scheduler.Tick();
+    }
+};
+
+// Animation that only asks for a frame every @every steps.
+class SteppedAnimation : public Animation
+{
+    int mSteps = 0;
+    int mEvery = 1;
+    int mCount = 0;
+
+protected:
+    virtual auto Step (AnimationClock::time_point) -> bool override
+    {
+        mSteps += 1;
+        return mSteps < mCount;
+    }
+
+    virtual auto Changed () const -> bool override
+    {
+        return mSteps % mEvery == 0;
+    }
+
+public:
+    SteppedAnimation (int count, int every)
+        : mEvery (every)
+        , mCount (count)
+    {
+    }
+};
+
+}
+
+TEST(Animation, IdleSchedulerRequestsNoFrames)
+{
+    auto clock = VirtualClock();
+
+    EXPECT_TRUE(clock.scheduler.IsIdle());
+    EXPECT_FALSE(clock.Advance(16ms));
+    EXPECT_EQ(clock.scheduler.FrameRequests(), 0u);
+}
+
+TEST(Animation, LinearValueFollowsVirtualClock)
+{
+    auto clock = VirtualClock();
+    auto value = AnimatedValue(0.0f);
+
+    value.AnimateTo(100.0f, 200ms, &clock.scheduler, Easing::Linear);
+    EXPECT_TRUE(value.IsActive());
+    EXPECT_EQ(value.Target(), 100.0f);
+
+    EXPECT_TRUE(clock.Advance(50ms));
+    EXPECT_FLOAT_EQ(value.Value(), 25.0f);
+
+    EXPECT_TRUE(clock.Advance(50ms));
+    EXPECT_FLOAT_EQ(value.Value(), 50.0f);
+
+    // Clock jumping past the end lands exactly on target.
+    EXPECT_TRUE(clock.Advance(10s));
+    EXPECT_EQ(value.Value(), 100.0f);
+    EXPECT_FALSE(value.IsActive());
+    EXPECT_TRUE(clock.scheduler.IsIdle());
+
+    EXPECT_FALSE(clock.Advance(16ms));
+    EXPECT_EQ(clock.scheduler.FrameRequests(), 3u);
+}
+
+TEST(Animation, EasingKeepsEndpoints)
+{
+    for (const auto easing : { Easing::Linear, Easing::EaseOut, Easing::EaseInOut })
+    {
+        auto clock = VirtualClock();
+        auto value = AnimatedValue(10.0f);
+
+        value.AnimateTo(20.0f, 100ms, &clock.scheduler, easing);
+
+        auto previous = value.Value();
+        for (auto i = 0; i < 10; ++i)
+        {
+            clock.Advance(10ms);
+
+            EXPECT_GE(value.Value(), previous);
+            EXPECT_LE(value.Value(), 20.0f);
+            previous = value.Value();
+        }
+
+        EXPECT_EQ(value.Value(), 20.0f);
+        EXPECT_FALSE(value.IsActive());
+    }
+}
+
+TEST(Animation, EaseOutIsAheadOfLinear)
+{
+    auto clock   = VirtualClock();
+    auto linear  = AnimatedValue(0.0f);
+    auto easeOut = AnimatedValue(0.0f);
+
+    linear.AnimateTo(1.0f, 100ms, &clock.scheduler, Easing::Linear);
+    easeOut.AnimateTo(1.0f, 100ms, &clock.scheduler, Easing::EaseOut);
+
+    clock.Advance(50ms);
+
+    EXPECT_FLOAT_EQ(linear.Value(), 0.5f);
+    EXPECT_FLOAT_EQ(easeOut.Value(), 0.75f);
+}
+
+TEST(Animation, RetargetStartsFromCurrentValue)
+{
+    auto clock = VirtualClock();
+    auto value = AnimatedValue(0.0f);
+
+    value.AnimateTo(100.0f, 100ms, &clock.scheduler, Easing::Linear);
+    clock.Advance(50ms);
+    ASSERT_FLOAT_EQ(value.Value(), 50.0f);
+
+    // Interrupted animation doesn't jump back.
+    value.AnimateTo(0.0f, 100ms, &clock.scheduler, Easing::Linear);
+    EXPECT_FLOAT_EQ(value.Value(), 50.0f);
+    EXPECT_EQ(clock.scheduler.ActiveCount(), 1u);
+
+    clock.Advance(50ms);
+    EXPECT_FLOAT_EQ(value.Value(), 25.0f);
+
+    // Same target again doesn't restart it.
+    value.AnimateTo(0.0f, 100ms, &clock.scheduler, Easing::Linear);
+    clock.Advance(50ms);
+    EXPECT_EQ(value.Value(), 0.0f);
+}
+
+TEST(Animation, NoSchedulerOrZeroDurationSetsValue)
+{
+    auto clock = VirtualClock();
+    auto value = AnimatedValue(1.0f);
+
+    value.AnimateTo(2.0f, 100ms, nullptr);
+    EXPECT_EQ(value.Value(), 2.0f);
+    EXPECT_FALSE(value.IsActive());
+
+    value.AnimateTo(3.0f, 0ms, &clock.scheduler);
+    EXPECT_EQ(value.Value(), 3.0f);
+    EXPECT_TRUE(clock.scheduler.IsIdle());
+}
+
+TEST(Animation, SetStopsRunningAnimation)
+{
+    auto clock = VirtualClock();
+    auto value = AnimatedValue(0.0f);
+
+    value.AnimateTo(1.0f, 100ms, &clock.scheduler);
+    value.Set(5.0f);
+
+    EXPECT_FALSE(value.IsActive());
+    EXPECT_TRUE(clock.scheduler.IsIdle());
+    EXPECT_FALSE(clock.Advance(50ms));
+    EXPECT_EQ(value.Value(), 5.0f);
+}
+
+TEST(Animation, UnchangedStepsRequestNoFrame)
+{
+    auto clock     = VirtualClock();
+    auto animation = SteppedAnimation(10, 4);
+
+    clock.scheduler.Start(&animation);
+
+    auto frames = 0;
+    for (auto i = 0; i < 10; ++i)
+    {
+        frames += clock.Advance(16ms) ? 1 : 0;
+    }
+
+    // Steps 4 and 8 changed something, 10 finished and shows final state.
+    EXPECT_EQ(frames, 3);
+    EXPECT_TRUE(clock.scheduler.IsIdle());
+}
+
+TEST(Animation, DestroyedAnimationLeavesScheduler)
+{
+    auto clock = VirtualClock();
+
+    {
+        auto value = AnimatedValue(0.0f);
+        value.AnimateTo(1.0f, 100ms, &clock.scheduler);
+        EXPECT_EQ(clock.scheduler.ActiveCount(), 1u);
+    }
+
+    EXPECT_TRUE(clock.scheduler.IsIdle());
+    EXPECT_FALSE(clock.Advance(16ms));
+}
+
+TEST(Animation, DestroyedSchedulerReleasesAnimations)
+{
+    auto value     = AnimatedValue(0.0f);
+    auto scheduler = std::make_unique<AnimationScheduler>();
+
+    value.AnimateTo(1.0f, 100ms, scheduler.get());
+    EXPECT_TRUE(value.IsActive());
+
+    scheduler.reset();
+    EXPECT_FALSE(value.IsActive());
+}
+
+TEST(Animation, ManyAnimationsFinishOnTheirOwnTime)
+{
+    auto clock  = VirtualClock();
+    auto values = std::vector<std::unique_ptr<AnimatedValue>>();
+
+    for (auto i = 1; i <= 8; ++i)
+    {
+        values.push_back(std::make_unique<AnimatedValue>(0.0f));
+        values.back()->AnimateTo(1.0f, std::chrono::milliseconds(i * 100), &clock.scheduler, Easing::Linear);
+    }
+
+    for (auto i = 1; i <= 8; ++i)
+    {
+        clock.Advance(100ms);
+        EXPECT_EQ(clock.scheduler.ActiveCount(), static_cast<size_t>(8 - i));
+        EXPECT_EQ(values[i - 1]->Value(), 1.0f);
+    }
+}
+
+TEST(Animation, StepProgressOf25MinutePhase)
+{
+    constexpr auto STEPS = 120 * 16;
+
+    const auto total = AnimationClock::duration(25min);
+
+    // Full ring lasts only until clock starts running.
+    EXPECT_EQ(StepProgress(total, total, STEPS).step, STEPS);
+    EXPECT_EQ(StepProgress(total, total, STEPS).next.count(), 1);
+
+    // Then it moves once per 1500 s / 1920 steps.
+    const auto progress = StepProgress(total - AnimationClock::duration(1), total, STEPS);
+
+    EXPECT_EQ(progress.step, STEPS - 1);
+    EXPECT_GT(progress.next, 781ms);
+    EXPECT_LT(progress.next, 782ms);
+}
+
+TEST(Animation, StepProgressChangesExactlyAtNext)
+{
+    constexpr auto STEPS = 7;
+
+    const auto total = AnimationClock::duration(std::chrono::seconds(100));
+
+    for (auto remaining = total;;)
+    {
+        const auto progress = StepProgress(remaining, total, STEPS);
+        if (progress.step == 0)
+        {
+            break;
+        }
+
+        // One tick earlier is still the same step, at next it isn't.
+        const auto before = StepProgress(remaining - progress.next + AnimationClock::duration(1), total, STEPS);
+        const auto after  = StepProgress(remaining - progress.next, total, STEPS);
+
+        EXPECT_EQ(before.step, progress.step);
+        EXPECT_EQ(after.step, progress.step - 1);
+
+        remaining -= progress.next;
+    }
+}
+
+TEST(Animation, StepProgressEdges)
+{
+    const auto total = AnimationClock::duration(std::chrono::seconds(60));
+
+    EXPECT_EQ(StepProgress(total, AnimationClock::duration::zero(), 10).next, AnimationClock::duration::max());
+    EXPECT_EQ(StepProgress(-1s, total, 10).step, 0);
+    EXPECT_EQ(StepProgress(10min, total, 10).step, 10);
+
+    // Empty ring only waits for the end.
+    EXPECT_EQ(StepProgress(1s, total, 10).step, 0);
+    EXPECT_EQ(StepProgress(1s, total, 10).next, 1s);
+    EXPECT_EQ(StepProgress(0s, total, 10).next, AnimationClock::duration::max());
+}
+
+namespace {
+
+// Countdown drawn in steps, like progress ring of Clock widget.
+class CountdownAnimation : public Animation
+{
+    AnimationClock::time_point mEnd;
+    AnimationClock::duration   mTotal;
+    int                        mSteps    = 0;
+    int                        mDrawn    = -1;
+    bool                       mChanged  = false;
+    AnimationClock::time_point mWakeTime = AnimationClock::time_point::min();
+
+protected:
+    virtual auto Step (AnimationClock::time_point now) -> bool override
+    {
+        const auto progress = StepProgress(mEnd - now, mTotal, mSteps);
+
+        mChanged  = progress.step != mDrawn;
+        mDrawn    = progress.step;
+        mWakeTime = progress.next == AnimationClock::duration::max()
+                  ? AnimationClock::time_point::max()
+                  : now + progress.next;
+
+        return now < mEnd;
+    }
+
+    virtual auto Changed  () const -> bool override { return mChanged; }
+    virtual auto WakeTime () const -> AnimationClock::time_point override { return mWakeTime; }
+
+public:
+    CountdownAnimation (AnimationClock::time_point start, AnimationClock::duration total, int steps)
+        : mEnd   (start + total)
+        , mTotal (total)
+        , mSteps (steps)
+    {
+    }
+};
+
+}
+
+TEST(Animation, WakeTimeOfIdleAndFreshAnimations)
+{
+    auto clock = VirtualClock();
+    auto value = AnimatedValue(0.0f);
+
+    EXPECT_EQ(clock.scheduler.WakeTime(), AnimationClock::time_point::max());
+
+    // Animations that change every frame want the next one.
+    value.AnimateTo(1.0f, 100ms, &clock.scheduler);
+    EXPECT_EQ(clock.scheduler.WakeTime(), AnimationClock::time_point::min());
+
+    clock.Advance(16ms);
+    EXPECT_EQ(clock.scheduler.WakeTime(), AnimationClock::time_point::min());
+}
+
+TEST(Animation, LoopSleepsUntilNextStep)
+{
+    constexpr auto STEPS = 120 * 16;
+
+    auto clock     = VirtualClock();
+    auto animation = CountdownAnimation(clock.now, 25min, STEPS);
+
+    clock.scheduler.Start(&animation);
+
+    // Loop as D2DApp runs it: frame when Tick() asks for one, otherwise sleep
+    // until WakeTime(), 16 ms when it isn't known.
+    auto wakeups = 0;
+    auto frames  = 0;
+
+    while (!clock.scheduler.IsIdle())
+    {
+        wakeups += 1;
+        if (clock.scheduler.Tick(clock.now))
+        {
+            frames  += 1;
+            clock.now += 16ms;
+            continue;
+        }
+
+        const auto wake = clock.scheduler.WakeTime();
+        clock.now = wake > clock.now && wake != AnimationClock::time_point::max() ? wake : clock.now + 16ms;
+    }
+
+    // Frame for every step and for the end, one sleep after each frame.
+    // Polling every 16 ms would wake up 93750 times.
+    EXPECT_EQ(frames, STEPS + 2);
+    EXPECT_LE(wakeups, 2 * frames);
+}
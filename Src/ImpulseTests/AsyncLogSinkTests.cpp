@@ -0,0 +1,139 @@
+#include "AsyncLogSink.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Keeps message texts in order they were written.
+class MemorySink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+    std::vector<std::string> lines;
+
+protected:
+    auto sink_it_ (const spdlog::details::log_msg& msg) -> void override
+    {
+        lines.emplace_back(msg.payload.data(), msg.payload.size());
+    }
+
+    auto flush_ () -> void override {}
+};
+
+}
+
+TEST(AsyncLogSink, WritesMessagesInOrder)
+{
+    const auto memory = std::make_shared<MemorySink>();
+
+    auto desc  = AsyncLogSink::Desc();
+    desc.sinks = { memory };
+
+    const auto sink = std::shared_ptr<AsyncLogSink>(AsyncLogSink::Start(std::move(desc)));
+    auto logger     = spdlog::logger("test", sink);
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        logger.info("message {}", i);
+    }
+
+    sink->Stop();
+
+    ASSERT_EQ(memory->lines.size(), 1000u);
+    EXPECT_EQ(memory->lines[0], "message 0");
+    EXPECT_EQ(memory->lines[999], "message 999");
+    EXPECT_EQ(sink->Written(), 1000u);
+    EXPECT_EQ(sink->Dropped(), 0u);
+}
+
+TEST(AsyncLogSink, WritesDirectlyAfterStop)
+{
+    const auto memory = std::make_shared<MemorySink>();
+
+    auto desc  = AsyncLogSink::Desc();
+    desc.sinks = { memory };
+
+    const auto sink = std::shared_ptr<AsyncLogSink>(AsyncLogSink::Start(std::move(desc)));
+    auto logger     = spdlog::logger("test", sink);
+
+    sink->Stop();
+    logger.warn("after stop");
+
+    ASSERT_EQ(memory->lines.size(), 1u);
+    EXPECT_EQ(memory->lines[0], "after stop");
+}
+
+TEST(AsyncLogSink, StopKeepsMessagesLoggedMeanwhile)
+{
+    constexpr auto THREADS  = 4;
+    constexpr auto MESSAGES = 20000;
+
+    for (const auto overflow : { LogOverflow::Block, LogOverflow::DropOldest })
+    {
+        const auto memory = std::make_shared<MemorySink>();
+
+        auto desc     = AsyncLogSink::Desc();
+        desc.sinks    = { memory };
+        desc.capacity = 64;
+        desc.overflow = overflow;
+
+        const auto sink = std::shared_ptr<AsyncLogSink>(AsyncLogSink::Start(std::move(desc)));
+        auto logger     = spdlog::logger("test", sink);
+
+        // Writer goes away while producers are mid-push, none of what they
+        // logged may stay in queue.
+        auto producers = std::vector<std::thread>();
+        for (auto t = 0; t < THREADS; ++t)
+        {
+            producers.emplace_back([&logger] {
+                for (auto i = 0; i < MESSAGES; ++i)
+                {
+                    logger.info("message {}", i);
+                }
+            });
+        }
+
+        sink->Stop();
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        // Drop reports are written too, but aren't counted.
+        const auto logged = std::count_if(memory->lines.begin(), memory->lines.end(), [](const auto& line) {
+            return line.rfind("message ", 0) == 0;
+        });
+
+        EXPECT_EQ(sink->Written() + sink->Dropped(), uint64_t(THREADS * MESSAGES));
+        EXPECT_EQ(uint64_t(logged), sink->Written());
+    }
+}
+
+TEST(AsyncLogSink, LongMessageIsTruncated)
+{
+    const auto memory = std::make_shared<MemorySink>();
+
+    auto desc  = AsyncLogSink::Desc();
+    desc.sinks = { memory };
+
+    const auto sink = std::shared_ptr<AsyncLogSink>(AsyncLogSink::Start(std::move(desc)));
+    auto logger     = spdlog::logger("test", sink);
+
+    logger.info(std::string(4096, 'x'));
+    sink->Stop();
+
+    ASSERT_EQ(memory->lines.size(), 1u);
+    EXPECT_LT(memory->lines[0].size(), 4096u);
+    EXPECT_EQ(sink->Truncated(), 1u);
+}
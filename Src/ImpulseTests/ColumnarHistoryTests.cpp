@@ -0,0 +1,239 @@
+#include "ColumnarHistory.hpp"
+#include "TempDirectory.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Pomodoro-like history: minutes apart, a few tasks, mostly work shifts.
+auto MakeRecords (size_t count, uint32_t seed) -> std::vector<HistoryRecord>
+{
+    auto random  = std::mt19937(seed);
+    auto records = std::vector<HistoryRecord>(count);
+    auto time    = int64_t(1'600'000'000'000);
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        auto& record = records[i];
+        time += 60'000 + random() % 1'500'000;
+
+        record.time      = time;
+        record.sequence  = static_cast<uint32_t>(1000 + i);
+        record.task      = random() % 4 == 0 ? 0 : 100 + random() % 20;
+        record.duration  = random() % 1'500'000;
+        record.workShift = static_cast<uint16_t>(i / 8);
+        record.event     = static_cast<HistoryEvent>(random() % 5);
+        record.from      = i % 2 ? ImpulseState::WorkShift : ImpulseState::ShortBreak;
+        record.to        = i % 2 ? ImpulseState::ShortBreak : ImpulseState::WorkShift;
+        SetUtcOffset(record, i < count / 3 ? 3'600'000 : 7'200'000);
+        Seal(record);
+    }
+
+    return records;
+}
+
+auto Write (const std::filesystem::path& path, const std::vector<HistoryRecord>& records) -> std::unique_ptr<ColumnarHistory>
+{
+    WriteFile(path, EncodeColumnarHistory(records.data(), records.size(), 256));
+    return ColumnarHistory::Open(path);
+}
+
+}
+
+TEST(ColumnarHistory, DecodesRecordsAsEncoded)
+{
+    const auto dir     = TempDirectory();
+    const auto records = MakeRecords(1000, 1);
+    const auto history = Write(dir.path / "history.imp", records);
+    ASSERT_TRUE(history);
+
+    EXPECT_EQ(history->Records(), 1000u);
+    EXPECT_EQ(history->Blocks(), 4u);
+    EXPECT_LT(history->Size(), records.size() * sizeof(HistoryRecord) / 2);
+
+    auto columns = HistoryColumns();
+    auto next    = size_t(0);
+
+    for (auto block = size_t(0); block < history->Blocks(); ++block)
+    {
+        ASSERT_TRUE(history->Decode(block, columns));
+
+        for (auto i = size_t(0); i < columns.Size(); ++i, ++next)
+        {
+            const auto record = columns.Record(i);
+            EXPECT_EQ(std::memcmp(&record, &records[next], sizeof(record)), 0) << "record " << next;
+        }
+    }
+
+    EXPECT_EQ(next, records.size());
+}
+
+TEST(ColumnarHistory, DecodesWideAndConstantColumns)
+{
+    const auto dir = TempDirectory();
+
+    // Months between records don't fit 32 bit deltas, one task and
+    // constant durations take no bits at all.
+    auto records = MakeRecords(600, 6);
+    for (auto i = size_t(0); i < records.size(); ++i)
+    {
+        records[i].task     = 42;
+        records[i].duration = 25 * 60'000;
+        records[i].time    += i % 3 == 0 ? int64_t(i) * 90 * 86'400'000 : 0;
+        Seal(records[i]);
+    }
+
+    const auto history = Write(dir.path / "history.imp", records);
+    ASSERT_TRUE(history);
+
+    auto columns = HistoryColumns();
+    auto next    = size_t(0);
+
+    for (auto block = size_t(0); block < history->Blocks(); ++block)
+    {
+        ASSERT_TRUE(history->Decode(block, columns));
+
+        for (auto i = size_t(0); i < columns.Size(); ++i, ++next)
+        {
+            const auto record = columns.Record(i);
+            EXPECT_EQ(std::memcmp(&record, &records[next], sizeof(record)), 0) << "record " << next;
+        }
+    }
+
+    EXPECT_EQ(next, records.size());
+}
+
+TEST(ColumnarHistory, ScanMatchesRecordScan)
+{
+    const auto dir     = TempDirectory();
+    const auto records = MakeRecords(1000, 2);
+    const auto history = Write(dir.path / "history.imp", records);
+    ASSERT_TRUE(history);
+
+    auto task     = HistoryQuery();
+    task.task     = 105;
+    task.allTasks = false;
+
+    auto range = HistoryQuery();
+    range.from = records[300].time;
+    range.to   = records[700].time;
+
+    auto missing     = HistoryQuery();
+    missing.task     = 7;
+    missing.allTasks = false;
+
+    const auto span = HistorySpan{ records.data(), records.data() + records.size() };
+
+    for (const auto& query : { HistoryQuery(), task, range, missing })
+    {
+        const auto expected = ScanHistory(span, query);
+        const auto actual   = history->Scan(query);
+
+        EXPECT_EQ(actual.focus,     expected.focus);
+        EXPECT_EQ(actual.pause,     expected.pause);
+        EXPECT_EQ(actual.pomodoros, expected.pomodoros);
+    }
+}
+
+TEST(ColumnarHistory, DamagedBlockFailsDecode)
+{
+    const auto dir     = TempDirectory();
+    const auto path    = dir.path / "history.imp";
+    const auto records = MakeRecords(1000, 3);
+
+    {
+        const auto history = Write(path, records);
+        ASSERT_TRUE(history);
+    }
+
+    auto data = ReadFile(path);
+    data[data.size() - 10] ^= 0x5A;
+    WriteFile(path, data);
+
+    const auto history = ColumnarHistory::Open(path);
+    ASSERT_TRUE(history);
+
+    auto columns = HistoryColumns();
+    EXPECT_TRUE(history->Decode(0, columns));
+    EXPECT_FALSE(history->Decode(history->Blocks() - 1, columns));
+}
+
+TEST(ColumnarHistory, BlocksWithoutTaskAreSkipped)
+{
+    const auto dir = TempDirectory();
+
+    // Tasks worked on one after another, each block holds a few of them.
+    auto records = MakeRecords(1000, 4);
+    for (auto i = size_t(0); i < records.size(); ++i)
+    {
+        records[i].task = static_cast<uint32_t>(100 + i / 100);
+        Seal(records[i]);
+    }
+
+    const auto history = Write(dir.path / "history.imp", records);
+    ASSERT_TRUE(history);
+
+    // Task 103 is in records 300 to 399, block 1 only.
+    auto query     = HistoryQuery();
+    query.task     = 103;
+    query.allTasks = false;
+
+    EXPECT_TRUE(history->Skips(0, query));
+    EXPECT_FALSE(history->Skips(1, query));
+    EXPECT_TRUE(history->Skips(2, query));
+    EXPECT_TRUE(history->Skips(3, query));
+
+    // Dictionary index of another task in block, not a hash collision.
+    query.task = 102;
+    EXPECT_FALSE(history->Skips(0, query));
+    EXPECT_FALSE(history->Skips(1, query));
+    EXPECT_TRUE(history->Skips(2, query));
+
+    query.task = 7;
+    for (auto block = size_t(0); block < history->Blocks(); ++block)
+    {
+        EXPECT_TRUE(history->Skips(block, query));
+    }
+
+    const auto span = HistorySpan{ records.data(), records.data() + records.size() };
+    for (auto task = uint32_t(100); task < 110; ++task)
+    {
+        query.task = task;
+
+        const auto expected = ScanHistory(span, query);
+        const auto actual   = history->Scan(query);
+
+        EXPECT_EQ(actual.focus,     expected.focus);
+        EXPECT_EQ(actual.pomodoros, expected.pomodoros);
+    }
+}
+
+TEST(ColumnarHistory, DamagedTaskListFailsOpen)
+{
+    const auto dir     = TempDirectory();
+    const auto path    = dir.path / "history.imp";
+    const auto records = MakeRecords(1000, 5);
+
+    {
+        const auto history = Write(path, records);
+        ASSERT_TRUE(history);
+    }
+
+    // First entry of block tasks, right after directory and dictionary.
+    auto data   = ReadFile(path);
+    auto header = ColumnarHeader();
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    const auto offset = sizeof(ColumnarHeader) + header.blocks * sizeof(ColumnarBlock) + header.tasks * sizeof(uint32_t);
+
+    data[offset] ^= 0x01;
+    WriteFile(path, data);
+
+    EXPECT_FALSE(ColumnarHistory::Open(path));
+}
@@ -0,0 +1,87 @@
+#include "Crc32.hpp"
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+// One byte at a time, what every file written so far was checked with.
+auto ReferenceCrc32 (const uint8_t* data, size_t size) -> uint32_t
+{
+    auto crc = ~uint32_t(0);
+
+    for (auto i = size_t(0); i < size; ++i)
+    {
+        crc ^= data[i];
+        for (auto bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+        }
+    }
+
+    return ~crc;
+}
+
+}
+
+TEST(Crc32, MatchesZlibCheckValue)
+{
+    EXPECT_EQ(Crc32("123456789", 9), 0xCBF43926u);
+    EXPECT_EQ(Crc32("", 0), 0u);
+}
+
+TEST(Crc32, Crc32cMatchesCastagnoliCheckValue)
+{
+    EXPECT_EQ(Crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(Crc32cScalar("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(Crc32c("", 0), 0u);
+}
+
+TEST(Crc32, MatchesBytewiseAtEveryLengthAndAlignment)
+{
+    auto random = std::mt19937(1);
+    auto data   = std::vector<uint8_t>(64 + 8);
+
+    for (auto& byte : data)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+
+    for (auto offset = size_t(0); offset < 8; ++offset)
+    {
+        for (auto size = size_t(0); size <= 64; ++size)
+        {
+            const auto bytes = data.data() + offset;
+
+            EXPECT_EQ(Crc32(bytes, size), ReferenceCrc32(bytes, size)) << offset << " " << size;
+            EXPECT_EQ(Crc32c(bytes, size), Crc32cScalar(bytes, size)) << offset << " " << size;
+        }
+    }
+}
+
+TEST(Crc32, ContinuesOverSplitData)
+{
+    auto data = std::vector<uint8_t>(100);
+    for (auto i = size_t(0); i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    const auto whole = Crc32(data.data(), data.size());
+
+    for (auto split = size_t(0); split <= data.size(); split += 13)
+    {
+        EXPECT_EQ(Crc32(data.data() + split, data.size() - split, Crc32(data.data(), split)), whole);
+    }
+
+    const auto wholeC = Crc32c(data.data(), data.size());
+
+    for (auto split = size_t(0); split <= data.size(); split += 13)
+    {
+        EXPECT_EQ(Crc32c(data.data() + split, data.size() - split, Crc32c(data.data(), split)), wholeC);
+    }
+}
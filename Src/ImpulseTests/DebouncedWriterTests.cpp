@@ -0,0 +1,264 @@
+#include "AtomicFile.hpp"
+#include "DebouncedWriter.hpp"
+#include "TempDirectory.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Writes that fail the way a crash or full disk would: nothing at all, or
+// half of the temporary file, before rename ever happens.
+enum class Fault
+{
+    None,
+    Fail,
+    Partial,
+};
+
+struct FaultyDisk
+{
+    std::atomic<Fault>    fault  = Fault::None;
+    std::atomic<uint32_t> writes = 0;
+
+    auto Writer () -> DebouncedWriter::Write
+    {
+        return [this](const std::filesystem::path& path, std::string_view data)
+        {
+            writes += 1;
+
+            switch (fault.load())
+            {
+            case Fault::Fail:
+                return false;
+
+            case Fault::Partial:
+            {
+                auto temp = path;
+                temp += ".tmp";
+                WriteFile(temp, data.substr(0, data.size() / 2));
+                return false;
+            }
+
+            case Fault::None:
+                break;
+            }
+
+            return WriteFileAtomic(path, data);
+        };
+    }
+
+    // Writer thread attempted at least @n writes.
+    auto WaitForWrites (uint32_t n, std::chrono::milliseconds timeout) -> bool
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (writes < n && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+
+        return writes >= n;
+    }
+};
+
+auto Content (std::string text) -> DebouncedWriter::Serialize
+{
+    return [text = std::move(text)] { return text; };
+}
+
+}
+
+TEST(AtomicFile, ReplacesContentAndLeavesNoTemporary)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+
+    WriteFile(path, "old");
+
+    EXPECT_TRUE(WriteFileAtomic(path, "{\"new\":true}"));
+    EXPECT_EQ(ReadFile(path), "{\"new\":true}");
+    EXPECT_FALSE(std::filesystem::exists(dir.path / "Impulse.json.tmp"));
+
+    // Missing directory fails without touching anything.
+    EXPECT_FALSE(WriteFileAtomic(dir.path / "missing" / "Impulse.json", "data"));
+}
+
+TEST(DebouncedWriter, FailedWriteKeepsOldFile)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+    auto       disk = FaultyDisk();
+
+    WriteFile(path, "old");
+
+    auto writer = DebouncedWriter({ path, 1ms, 5ms, disk.Writer() });
+
+    disk.fault = Fault::Fail;
+    writer.Submit(Content("new"));
+
+    EXPECT_FALSE(writer.Flush());
+    EXPECT_EQ(writer.Failed(), 1u);
+    EXPECT_EQ(ReadFile(path), "old");
+
+    // Disk recovered, next submission goes through.
+    disk.fault = Fault::None;
+    writer.Submit(Content("newer"));
+
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(writer.Written(), 1u);
+    EXPECT_EQ(ReadFile(path), "newer");
+}
+
+TEST(DebouncedWriter, PartialWriteKeepsOldFile)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+    auto       disk = FaultyDisk();
+
+    WriteFile(path, "{\"tasks\":[\"old\"]}");
+
+    auto writer = DebouncedWriter({ path, 1ms, 5ms, disk.Writer() });
+
+    // Crash in the middle of temporary file, it never replaces original.
+    disk.fault = Fault::Partial;
+    writer.Submit(Content("{\"tasks\":[\"old\",\"new\"]}"));
+
+    EXPECT_FALSE(writer.Flush());
+    EXPECT_EQ(ReadFile(path), "{\"tasks\":[\"old\"]}");
+    EXPECT_TRUE(std::filesystem::exists(dir.path / "Impulse.json.tmp"));
+
+    // Leftover temporary file doesn't get in the way of next write.
+    disk.fault = Fault::None;
+    writer.Submit(Content("{\"tasks\":[\"old\",\"new\",\"newer\"]}"));
+
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(ReadFile(path), "{\"tasks\":[\"old\",\"new\",\"newer\"]}");
+    EXPECT_FALSE(std::filesystem::exists(dir.path / "Impulse.json.tmp"));
+}
+
+TEST(DebouncedWriter, BurstIsOneWrite)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+    auto       disk = FaultyDisk();
+
+    auto writer = DebouncedWriter({ path, 200ms, 5s, disk.Writer() });
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        writer.Submit(Content(std::to_string(i)));
+    }
+
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(writer.Submitted(), 100u);
+    EXPECT_EQ(writer.Written(), 1u);
+    EXPECT_EQ(disk.writes.load(), 1u);
+    EXPECT_EQ(ReadFile(path), "99");
+}
+
+TEST(DebouncedWriter, DestructorFlushes)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+
+    {
+        auto writer = DebouncedWriter({ path, 10s, 10s, nullptr });
+        writer.Submit(Content("last"));
+    }
+
+    EXPECT_EQ(ReadFile(path), "last");
+}
+
+TEST(DebouncedWriter, BusyUntilWrittenAndRemembersContent)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+    auto       disk = FaultyDisk();
+
+    auto writer = DebouncedWriter({ path, 10s, 10s, disk.Writer() });
+    EXPECT_FALSE(writer.Busy());
+
+    writer.Submit(Content("first"));
+    EXPECT_TRUE(writer.Busy());
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_FALSE(writer.Busy());
+    EXPECT_EQ(writer.LastWritten(), "first");
+
+    // Failed write is not what's on disk.
+    disk.fault = Fault::Fail;
+    writer.Submit(Content("second"));
+    EXPECT_FALSE(writer.Flush());
+    EXPECT_EQ(writer.LastWritten(), "first");
+}
+
+TEST(DebouncedWriter, FailedWriteIsRetried)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+    auto       disk = FaultyDisk();
+
+    WriteFile(path, "old");
+
+    auto desc          = DebouncedWriter::Desc{ path, 1ms, 5ms, disk.Writer() };
+    desc.retryDelay    = 5ms;
+    desc.maxRetryDelay = 20ms;
+
+    auto writer = DebouncedWriter(desc);
+
+    // Keeps failing, submission stays pending through several attempts.
+    disk.fault = Fault::Fail;
+    writer.Submit(Content("new"));
+
+    EXPECT_TRUE(disk.WaitForWrites(3, 5s));
+    EXPECT_TRUE(writer.Busy());
+    EXPECT_EQ(ReadFile(path), "old");
+
+    // Disk recovered, next retry writes what was submitted.
+    disk.fault = Fault::None;
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (writer.Written() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    EXPECT_EQ(writer.Written(), 1u);
+    EXPECT_GE(writer.Failed(), 3u);
+    EXPECT_EQ(ReadFile(path), "new");
+    EXPECT_TRUE(writer.Flush());
+}
+
+TEST(DebouncedWriter, FlushReportsEarlierFailure)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+    auto       disk = FaultyDisk();
+
+    WriteFile(path, "old");
+
+    auto desc       = DebouncedWriter::Desc{ path, 1ms, 5ms, disk.Writer() };
+    desc.retryDelay = 10s;
+
+    auto writer = DebouncedWriter(desc);
+
+    // Write fails on its own before anyone flushes.
+    disk.fault = Fault::Fail;
+    writer.Submit(Content("new"));
+    ASSERT_TRUE(disk.WaitForWrites(1, 5s));
+
+    // Nothing new was submitted, yet content is still not on disk.
+    EXPECT_FALSE(writer.Flush());
+    EXPECT_EQ(disk.writes.load(), 2u);
+    EXPECT_EQ(ReadFile(path), "old");
+
+    // Flush doesn't wait out the retry delay and writes the kept content.
+    disk.fault = Fault::None;
+    EXPECT_TRUE(writer.Flush());
+    EXPECT_EQ(ReadFile(path), "new");
+}
@@ -0,0 +1,190 @@
+#include "DeviceRecovery.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Device that fails to come back a number of times, logs what was done to
+// it. Widgets and settings stand in for CPU side state that must survive.
+struct FakeDevice
+{
+    int         failures   = 0;     // creations that fail before one succeeds
+    bool        throws     = false; // fail by exception instead of false
+    bool        alive      = true;
+    int         created    = 0;
+    int         discarded  = 0;
+    int         restored   = 0;
+    std::string log;
+
+    DeviceRecovery::Clock::time_point now = DeviceRecovery::Clock::time_point(1h);
+
+    auto Recovery () -> DeviceRecovery
+    {
+        auto desc    = DeviceRecovery::Desc();
+        desc.discard = [this]
+        {
+            alive      = false;
+            discarded += 1;
+            log       += "d";
+        };
+        desc.create = [this]
+        {
+            created += 1;
+            log     += "c";
+
+            if (failures > 0)
+            {
+                failures -= 1;
+                if (throws)
+                {
+                    throw std::runtime_error("device removed");
+                }
+                return false;
+            }
+
+            alive = true;
+            return true;
+        };
+        desc.restored = [this]
+        {
+            restored += 1;
+            log      += "r";
+        };
+
+        auto recovery = DeviceRecovery(desc);
+        recovery.SetTimeSource([this] { return now; });
+        return recovery;
+    }
+};
+
+}
+
+TEST(DeviceRecovery, NothingHappensWhileDeviceIsFine)
+{
+    auto device   = FakeDevice();
+    auto recovery = device.Recovery();
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(recovery.Recover());
+    }
+
+    EXPECT_EQ(recovery.Attempts(), 0u);
+    EXPECT_EQ(device.log, "");
+}
+
+TEST(DeviceRecovery, RebuildsRightAwayAfterLoss)
+{
+    auto device   = FakeDevice();
+    auto recovery = device.Recovery();
+
+    recovery.Lost();
+    EXPECT_TRUE(recovery.IsLost());
+
+    EXPECT_TRUE(recovery.Recover());
+    EXPECT_FALSE(recovery.IsLost());
+    EXPECT_TRUE(device.alive);
+
+    // Old device goes first, resources are rebuilt only on the new one.
+    EXPECT_EQ(device.log, "dcr");
+    EXPECT_EQ(recovery.Attempts(), 1u);
+    EXPECT_EQ(recovery.Recoveries(), 1u);
+}
+
+TEST(DeviceRecovery, RetriesOncePerInterval)
+{
+    auto device     = FakeDevice();
+    device.failures = 3;
+
+    auto recovery = device.Recovery();
+    recovery.Lost();
+
+    EXPECT_FALSE(recovery.Recover());
+    EXPECT_EQ(device.created, 1);
+
+    // Frames inside retry interval don't touch the driver.
+    for (auto i = 0; i < 10; ++i)
+    {
+        device.now += 20ms;
+        EXPECT_FALSE(recovery.Recover());
+    }
+    EXPECT_EQ(device.created, 1);
+
+    device.now += 50ms;
+    EXPECT_FALSE(recovery.Recover());
+    EXPECT_EQ(device.created, 2);
+
+    device.now += 250ms;
+    EXPECT_FALSE(recovery.Recover());
+
+    device.now += 250ms;
+    EXPECT_TRUE(recovery.Recover());
+
+    EXPECT_EQ(device.created, 4);
+    EXPECT_EQ(device.restored, 1);
+    EXPECT_EQ(recovery.Attempts(), 4u);
+    EXPECT_EQ(recovery.Recoveries(), 1u);
+
+    // Half created device is released after each failed attempt.
+    EXPECT_EQ(device.log, "dcd" "dcd" "dcd" "dcr");
+}
+
+TEST(DeviceRecovery, ExceptionCountsAsFailedAttempt)
+{
+    auto device     = FakeDevice();
+    device.failures = 1;
+    device.throws   = true;
+
+    auto recovery = device.Recovery();
+    recovery.Lost();
+
+    EXPECT_FALSE(recovery.Recover());
+    EXPECT_TRUE(recovery.IsLost());
+    EXPECT_FALSE(device.alive);
+
+    device.now += 250ms;
+    EXPECT_TRUE(recovery.Recover());
+    EXPECT_TRUE(device.alive);
+    EXPECT_EQ(device.restored, 1);
+}
+
+TEST(DeviceRecovery, LossDuringRecoveryKeepsRetryInterval)
+{
+    auto device     = FakeDevice();
+    device.failures = 1;
+
+    auto recovery = device.Recovery();
+    recovery.Lost();
+    EXPECT_FALSE(recovery.Recover());
+
+    // Swap chain resize reports loss again while already recovering.
+    recovery.Lost();
+    EXPECT_FALSE(recovery.Recover());
+    EXPECT_EQ(device.created, 1);
+
+    device.now += 250ms;
+    EXPECT_TRUE(recovery.Recover());
+}
+
+TEST(DeviceRecovery, LossAfterRecoveryRebuildsRightAway)
+{
+    auto device   = FakeDevice();
+    auto recovery = device.Recovery();
+
+    recovery.Lost();
+    EXPECT_TRUE(recovery.Recover());
+
+    // Second removal in the same frame interval is not throttled, only
+    // failed attempts are.
+    recovery.Lost();
+    EXPECT_TRUE(recovery.Recover());
+
+    EXPECT_EQ(device.restored, 2);
+    EXPECT_EQ(recovery.Recoveries(), 2u);
+}
@@ -0,0 +1,97 @@
+#include "AtomicFile.hpp"
+#include "FileWatcher.hpp"
+#include "TempDirectory.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Counts OnChange calls of a started watcher.
+struct Changes
+{
+    std::mutex                   mutex;
+    std::condition_variable      changed;
+    uint32_t                     count = 0;
+    std::unique_ptr<FileWatcher> watcher;
+
+    explicit Changes (const std::filesystem::path& path)
+        : watcher (FileWatcher::Create(path))
+    {
+        if (watcher)
+        {
+            watcher->OnChange = [this]
+            {
+                auto guard = std::lock_guard<std::mutex>(mutex);
+                count += 1;
+                changed.notify_all();
+            };
+            watcher->Start();
+        }
+    }
+
+    auto WaitFor (uint32_t n, std::chrono::milliseconds timeout) -> bool
+    {
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        return changed.wait_for(lock, timeout, [&] { return count >= n; });
+    }
+};
+
+}
+
+TEST(FileWatcher, ReportsAtomicReplace)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+
+    WriteFile(path, "old");
+
+    auto changes = Changes(path);
+    ASSERT_TRUE(changes.watcher);
+
+    ASSERT_TRUE(WriteFileAtomic(path, "new"));
+    EXPECT_TRUE(changes.WaitFor(1, 5s));
+}
+
+TEST(FileWatcher, IgnoresOtherFilesInDirectory)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+
+    WriteFile(path, "old");
+
+    auto changes = Changes(path);
+    ASSERT_TRUE(changes.watcher);
+
+    WriteFile(dir.path / "Impulse.stats", "stats");
+    EXPECT_FALSE(changes.WaitFor(1, 200ms));
+
+    // Watcher still works after skipping them.
+    WriteFile(path, "new");
+    EXPECT_TRUE(changes.WaitFor(1, 5s));
+}
+
+TEST(FileWatcher, MissingDirectoryFails)
+{
+    const auto dir = TempDirectory();
+
+    EXPECT_FALSE(FileWatcher::Create(dir.path / "missing" / "Impulse.json"));
+}
+
+TEST(FileWatcher, DestructorStopsWatching)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / "Impulse.json";
+
+    {
+        auto changes = Changes(path);
+        ASSERT_TRUE(changes.watcher);
+    }
+
+    WriteFile(path, "after");
+}
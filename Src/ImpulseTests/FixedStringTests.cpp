@@ -0,0 +1,89 @@
+#include "FixedString.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+TEST(FixedString, KeepsTextThatFits)
+{
+    auto text = FixedString<8>("pomodoro");
+
+    EXPECT_EQ(text, "pomodoro");
+    EXPECT_EQ(text.size(), 8u);
+    EXPECT_EQ(text.c_str()[8], '\0');
+}
+
+TEST(FixedString, TruncatesUtf8AtCodePoint)
+{
+    // "ab" followed by U+20AC (3 bytes) doesn't fit in 4 bytes.
+    auto text = FixedString<4>("ab\xE2\x82\xAC");
+    EXPECT_EQ(text, "ab");
+
+    text.Assign("a\xE2\x82\xAC");
+    EXPECT_EQ(text, "a\xE2\x82\xAC");
+
+    text.Append("\xC3\xA9");
+    EXPECT_EQ(text, "a\xE2\x82\xAC");
+}
+
+TEST(FixedString, TruncatesUtf16AtSurrogatePair)
+{
+    // U+1F345 is a surrogate pair, capacity ends between its halves.
+    const auto tomato = std::u16string(u"abc\U0001F345");
+    ASSERT_EQ(tomato.size(), 5u);
+
+    auto text = BasicFixedString<char16_t, 4>(tomato);
+    EXPECT_EQ(text, u"abc");
+
+    text.Assign(u"ab\U0001F345");
+    EXPECT_EQ(text, u"ab\U0001F345");
+
+    text.Assign(u"abc");
+    text.Append(u"\U0001F345");
+    EXPECT_EQ(text, u"abc");
+
+    EXPECT_EQ(CodePointPrefix<char16_t>(u"\U0001F345x", 1), 0u);
+    EXPECT_EQ(CodePointPrefix<char16_t>(u"\U0001F345x", 2), 2u);
+}
+
+TEST(FixedString, FormatsMinutesAndSeconds)
+{
+    auto text = FixedWString<16>();
+
+    AppendMinutesSeconds(text, 25min);
+    EXPECT_EQ(text, L"25:00");
+
+    text.Clear();
+    AppendMinutesSeconds(text, 65s);
+    EXPECT_EQ(text, L"01:05");
+
+    text.Clear();
+    AppendMinutesSeconds(text, -7s);
+    EXPECT_EQ(text, L"-00:07");
+
+    text.Clear();
+    AppendMinutesSeconds(text, 100min);
+    EXPECT_EQ(text, L"100:00");
+}
+
+TEST(SmallString, MovesToHeapPastCapacity)
+{
+    const auto longText = std::wstring(300, L'x') + L"end";
+
+    auto text = SmallWString<128>(L"short");
+    EXPECT_FALSE(text.OnHeap());
+    EXPECT_EQ(text, L"short");
+
+    // Nothing is cut off.
+    text.Assign(longText);
+    EXPECT_TRUE(text.OnHeap());
+    EXPECT_EQ(text.view(), longText);
+    EXPECT_EQ(text.c_str()[text.size()], L'\0');
+
+    text.Assign(L"short again");
+    EXPECT_FALSE(text.OnHeap());
+    EXPECT_EQ(text, L"short again");
+}
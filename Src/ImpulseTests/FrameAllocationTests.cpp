@@ -0,0 +1,246 @@
+#include "AllocationCounter.hpp"
+#include "Animation.hpp"
+#include "ClockFace.hpp"
+#include "FixedString.hpp"
+#include "MainLayout.hpp"
+#include "PointerCoalescer.hpp"
+#include "PomodoroEngine.hpp"
+#include "SpatialGrid.hpp"
+#include "TaskListView.hpp"
+#include "TaskStore.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+// CPU side of a main window frame, the way ImpulseApp runs it: layout
+// tree of the app with its per-dpi cache, coalesced hover hit test over
+// where layout put widgets, clock texts and ring step, task list rows and
+// static texts. Widgets themselves draw with Direct2D, here they only keep
+// rect layout gave them and text they would draw.
+struct AppFrame
+{
+    enum Item { Settings, Close, Pause, Info, State, Task, List, Timer, Top, Bottom, Items };
+
+    AnimationClock::time_point now        = AnimationClock::time_point(1h);
+    AnimationClock::time_point phaseEnd   = AnimationClock::time_point();
+    AnimationScheduler         scheduler;
+    AnimatedValue              hover      = AnimatedValue(1.0f);
+
+    std::unique_ptr<MainLayout> layout;
+    std::vector<LayoutRect>     rects     = std::vector<LayoutRect>(Items);
+    SpatialGrid                 grid;
+    bool                        indexDirty = true;
+    PointerCoalescer            pointer;
+    int                         hovered   = -1;
+    uint32_t                    hoveredTask = TaskListView::NO_TASK;
+
+    PomodoroEngine              engine;
+    ClockFace                   face;
+    SteppedProgress             progress;
+
+    TaskStore                   tasks;
+    TaskListView                list;
+    std::wstring                longTask  = std::wstring(200, L't');
+
+    // What StaticText::Text() keeps.
+    std::array<SmallWString<128>, Items> texts;
+
+    uint64_t                    rowsPrepared = 0;
+
+    AppFrame ()
+    {
+        const auto place = [this](Item item)
+        {
+            return [this, item](const LayoutRect& rect)
+            {
+                rects[item] = rect;
+                indexDirty  = true;
+            };
+        };
+
+        auto desc = MainLayout::Desc();
+
+        desc.settingsButton = place(Settings);
+        desc.closeButton    = place(Close);
+        desc.pauseButton    = place(Pause);
+        desc.infoButton     = place(Info);
+        desc.stateText      = place(State);
+        desc.taskText       = place(Task);
+
+        desc.taskList = [this](const LayoutRect& rect)
+        {
+            rects[List] = rect;
+            indexDirty  = true;
+            list.Size(rect.Width(), rect.Height());
+        };
+
+        desc.clock = [this](const ClockPlacement& clock)
+        {
+            rects[Timer]  = clock.timerText;
+            rects[Top]    = clock.topText;
+            rects[Bottom] = clock.bottomText;
+            indexDirty    = true;
+        };
+
+        layout = std::make_unique<MainLayout>(desc);
+
+        for (auto i = 0; i < 500; ++i)
+        {
+            auto name = std::wstring(L"Task ");
+            name += std::to_wstring(i);
+            tasks.Add(name);
+        }
+
+        list.Store(&tasks);
+        list.RowHeight(24.0f);
+
+        scheduler.SetTimeSource([this] { return now; });
+
+        engine.Handle(PomodoroEvent::Start);
+        phaseEnd = now + engine.PhaseDuration();
+    }
+
+    // ImpulseApp::ResolvePointer(), widget tree hit test over layout rects.
+    auto HitTest (int x, int y) -> bool
+    {
+        if (indexDirty)
+        {
+            grid.Build(rects);
+            indexDirty = false;
+        }
+
+        auto hit = -1;
+        grid.Query(static_cast<float>(x), static_cast<float>(y), [&](uint32_t item)
+        {
+            const auto& rect = rects[item];
+            if (x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom)
+            {
+                hit = static_cast<int>(item);
+                return true;
+            }
+
+            return false;
+        });
+
+        const auto task = hit == List ? list.TaskAt(y - rects[List].top) : TaskListView::NO_TASK;
+        const auto changed = hit != hovered || task != hoveredTask;
+
+        hovered     = hit;
+        hoveredTask = task;
+
+        return changed;
+    }
+
+    auto Frame (int index) -> void
+    {
+        now += 16667us;
+
+        // Moving between two monitors now and then, both scales are in
+        // layout cache after the first switch.
+        if (index % 300 == 0)
+        {
+            const auto scale = index % 600 == 0 ? 1.0f : 1.5f;
+            layout->Update(LayoutSize{ 450.0f * scale, 330.0f * scale }, scale);
+            list.RowHeight(24.0f * scale);
+        }
+
+        // ImpulseApp::OnUpdate(), several mouse reports between frames and
+        // one hit test.
+        for (auto i = 0; i < 8; ++i)
+        {
+            pointer.Move(10 + index % 400, 5 + (index * 7 + i) % 300);
+        }
+
+        if (pointer.Update(now, [&](int x, int y) { return HitTest(x, y); }) && index % 50 == 0)
+        {
+            hover.AnimateTo(hover.Target() > 1.05f ? 1.0f : 1.1f, 150ms, &scheduler);
+        }
+
+        scheduler.Tick();
+
+        // Wheel over task list.
+        if (index % 10 == 0)
+        {
+            list.Scroll(index % 40 < 20 ? -60.0f : 60.0f);
+        }
+
+        // TaskList::Draw().
+        const auto [first, last] = list.VisibleRange();
+        list.PrepareRows(first, last, [&](size_t, uint32_t task)
+        {
+            rowsPrepared += tasks.Get(task).size() > 0 ? 1 : 0;
+        });
+
+        // Clock::Draw(), phase restarts when it runs out.
+        if (now >= phaseEnd)
+        {
+            engine.Handle(PomodoroEvent::Timeout);
+            phaseEnd = now + engine.PhaseDuration();
+        }
+
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(phaseEnd - now);
+
+        progress = ClockFace::Progress(engine, remaining);
+        face.Format(engine, remaining);
+
+        texts[Timer].Assign(face.TimerText());
+        texts[Bottom].Assign(face.BottomText());
+
+        // UpdateStateStatic() and UpdateTaskStatic(), long task name lives
+        // on heap, switching back and forth reuses it.
+        texts[State].Assign(engine.State() == ImpulseState::WorkShift ? L"Work Time" : L"Break Time");
+        texts[Task].Assign(index % 2 == 0 ? std::wstring_view(longTask) : std::wstring_view(L"Write report"));
+    }
+};
+
+}
+
+TEST(FrameAllocation, CounterCountsAllocations)
+{
+    const auto before = AllocationCount();
+
+    auto values = std::make_unique<std::vector<int>>(100);
+    values->push_back(1);
+
+    EXPECT_GE(AllocationCount() - before, 2u);
+}
+
+TEST(FrameAllocation, ThousandSteadyStateFramesDontAllocate)
+{
+    auto frame = AppFrame();
+
+    // First frames grow buffers to their working size and fill layout
+    // cache at both scales.
+    for (auto i = 0; i < 700; ++i)
+    {
+        frame.Frame(i);
+    }
+
+    const auto before = AllocationCount();
+    const auto rows   = frame.rowsPrepared;
+
+    for (auto i = 700; i < 1700; ++i)
+    {
+        frame.Frame(i);
+    }
+
+    EXPECT_EQ(AllocationCount() - before, 0u);
+
+    // Frames did the work, it just didn't allocate.
+    EXPECT_GT(frame.rowsPrepared, rows);
+    EXPECT_EQ(frame.pointer.Resolved(), 1700u);
+    EXPECT_NE(frame.rects[AppFrame::List].Width(), 0.0f);
+    EXPECT_EQ(frame.layout->Stats().measured, 0u);
+    EXPECT_FALSE(frame.texts[AppFrame::Timer].empty());
+    EXPECT_EQ(frame.texts[AppFrame::Bottom], L"1/4");
+    EXPECT_GT(frame.progress.step, 0);
+}
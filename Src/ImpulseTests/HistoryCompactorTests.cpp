@@ -0,0 +1,212 @@
+#include "HistoryCompactor.hpp"
+#include "HistoryJournal.hpp"
+#include "HistoryReader.hpp"
+#include "HistorySegments.hpp"
+#include "TempDirectory.hpp"
+
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto JOURNAL_RECORDS = uint32_t(2500);
+constexpr auto SEALED          = uint32_t(4);
+constexpr auto ACTIVE_RECORDS  = uint32_t(7);
+constexpr auto TOTAL_RECORDS   = SEALED * JOURNAL_RECORDS + ACTIVE_RECORDS;
+
+// Four sealed journals and an active one.
+auto WriteJournals (const std::filesystem::path& directory) -> void
+{
+    auto desc           = HistoryJournal::Desc();
+    desc.directory      = directory;
+    desc.commitDelay    = 10s;
+    desc.maxSegmentSize = sizeof(HistoryHeader) + JOURNAL_RECORDS * sizeof(HistoryRecord);
+
+    auto journal = HistoryJournal::Open(desc);
+    ASSERT_TRUE(journal);
+
+    for (auto i = uint32_t(0); i < TOTAL_RECORDS; ++i)
+    {
+        auto record = HistoryRecord();
+        record.time = 1000 + int64_t(i);
+        journal->Append(record);
+
+        if ((i + 1) % JOURNAL_RECORDS == 0)
+        {
+            ASSERT_TRUE(journal->Commit());
+        }
+    }
+
+    ASSERT_TRUE(journal->Commit());
+}
+
+// What a reader would find in history right now: sequences in order, each
+// one once, and which kinds of segments hold them.
+struct Snapshot
+{
+    std::vector<uint32_t>       sequences;
+    std::vector<HistorySegment> segments;
+};
+
+auto TakeSnapshot (const std::filesystem::path& directory) -> Snapshot
+{
+    auto snapshot = Snapshot();
+    snapshot.segments = ListHistorySegments(directory);
+
+    const auto reader = HistoryReader::OpenDirectory(directory);
+    reader->ForEach([&](HistorySpan span)
+    {
+        for (const auto& record : span)
+        {
+            snapshot.sequences.push_back(record.sequence);
+        }
+
+        return true;
+    });
+
+    return snapshot;
+}
+
+auto ExpectEveryRecordOnce (const Snapshot& snapshot, const std::string& where) -> void
+{
+    ASSERT_EQ(snapshot.sequences.size(), TOTAL_RECORDS) << where;
+
+    for (auto i = uint32_t(0); i < TOTAL_RECORDS; ++i)
+    {
+        ASSERT_EQ(snapshot.sequences[i], i) << where;
+    }
+}
+
+auto StepName (CompactionStep step) -> std::string
+{
+    switch (step)
+    {
+    case CompactionStep::WriteArchive:   return "WriteArchive";
+    case CompactionStep::PublishArchive: return "PublishArchive";
+    case CompactionStep::RemoveSource:   return "RemoveSource";
+    default:                             return "Unknown";
+    }
+}
+
+}
+
+TEST(HistoryCompactor, MergesSealedJournals)
+{
+    const auto dir = TempDirectory();
+    WriteJournals(dir.path);
+
+    auto desc        = HistoryCompactor::Desc();
+    desc.directory   = dir.path;
+    desc.minSegments = 2;
+
+    {
+        auto compactor = HistoryCompactor::Open(desc);
+        EXPECT_TRUE(compactor->Compact());
+    }
+
+    const auto snapshot = TakeSnapshot(dir.path);
+    ExpectEveryRecordOnce(snapshot, "after compaction");
+
+    ASSERT_EQ(snapshot.segments.size(), 2u);
+    EXPECT_EQ(snapshot.segments[0].kind, HistorySegmentKind::Archive);
+    EXPECT_EQ(snapshot.segments[0].first, 0u);
+    EXPECT_EQ(snapshot.segments[0].last, SEALED * JOURNAL_RECORDS - 1);
+    EXPECT_EQ(snapshot.segments[1].kind, HistorySegmentKind::Journal);
+}
+
+// Process dies right before @occurrence-th time a step is reached. What
+// readers see at that moment, and after next Compact() cleans up, must
+// hold every record exactly once.
+TEST(HistoryCompactor, CrashAtAnyStepLosesAndDuplicatesNothing)
+{
+    struct Crash
+    {
+        CompactionStep step;
+        uint32_t       occurrence;
+    };
+
+    // Archive is written in chunks of 4096 records, 10000 records take
+    // three writes.
+    const Crash crashes[] = {
+        { CompactionStep::WriteArchive,   1 },
+        { CompactionStep::WriteArchive,   2 },
+        { CompactionStep::WriteArchive,   3 },
+        { CompactionStep::PublishArchive, 1 },
+        { CompactionStep::RemoveSource,   1 },
+        { CompactionStep::RemoveSource,   3 },
+        { CompactionStep::RemoveSource,   SEALED },
+    };
+
+    for (const auto& crash : crashes)
+    {
+        const auto where = StepName(crash.step) + " #" + std::to_string(crash.occurrence);
+
+        const auto dir = TempDirectory();
+        WriteJournals(dir.path);
+
+        auto mutex     = std::mutex();
+        auto reached   = uint32_t(0);
+        auto snapshots = std::vector<Snapshot>();
+
+        // Dead process doesn't continue, every round stops at same point.
+        auto desc        = HistoryCompactor::Desc();
+        desc.directory   = dir.path;
+        desc.minSegments = 2;
+        desc.onStep      = [&](CompactionStep step)
+        {
+            auto guard = std::lock_guard<std::mutex>(mutex);
+            if (step != crash.step || ++reached < crash.occurrence)
+            {
+                return true;
+            }
+
+            snapshots.push_back(TakeSnapshot(dir.path));
+            return false;
+        };
+
+        // Worker's first round and this one both run before compactor is
+        // gone, whichever comes first dies.
+        {
+            auto compactor = HistoryCompactor::Open(desc);
+            compactor->Compact();
+        }
+
+        ASSERT_FALSE(snapshots.empty()) << where;
+        for (const auto& snapshot : snapshots)
+        {
+            ExpectEveryRecordOnce(snapshot, where);
+        }
+
+        // Restarted process finishes the job.
+        auto restart        = HistoryCompactor::Desc();
+        restart.directory   = dir.path;
+        restart.minSegments = 2;
+
+        {
+            auto compactor = HistoryCompactor::Open(restart);
+            EXPECT_TRUE(compactor->Compact()) << where;
+        }
+
+        const auto after = TakeSnapshot(dir.path);
+        ExpectEveryRecordOnce(after, where + ", after restart");
+
+        ASSERT_EQ(after.segments.size(), 2u) << where;
+        EXPECT_EQ(after.segments[0].kind, HistorySegmentKind::Archive) << where;
+        EXPECT_EQ(after.segments[1].kind, HistorySegmentKind::Journal) << where;
+
+        // Nothing left behind: no unfinished archive, no covered journal.
+        auto files = size_t(0);
+        for (const auto& entry : std::filesystem::directory_iterator(dir.path))
+        {
+            EXPECT_NE(entry.path().extension(), ".tmp") << where;
+            files += 1;
+        }
+
+        EXPECT_EQ(files, 2u) << where;
+    }
+}
@@ -0,0 +1,122 @@
+#include "HistoryExporter.hpp"
+#include "HistoryJournal.hpp"
+#include "TempDirectory.hpp"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto MakeRecord (int64_t time, uint32_t task) -> HistoryRecord
+{
+    auto record     = HistoryRecord();
+    record.time     = time;
+    record.task     = task;
+    record.duration = 1'500'000;
+    record.event    = HistoryEvent::End;
+    record.from     = ImpulseState::WorkShift;
+    record.to       = ImpulseState::ShortBreak;
+    return record;
+}
+
+// History of @count records, task alternating between 1 and 2. Journal
+// stays open so export can ask it to commit.
+auto WriteHistory (const std::filesystem::path& directory, int count) -> std::unique_ptr<HistoryJournal>
+{
+    auto desc        = HistoryJournal::Desc();
+    desc.directory   = directory;
+    desc.commitDelay = 10s;
+
+    auto journal = HistoryJournal::Open(desc);
+    for (auto i = 0; journal && i < count; ++i)
+    {
+        journal->Append(MakeRecord(int64_t(1'600'000'000'000) + i * 60'000, 1 + i % 2));
+    }
+
+    return journal;
+}
+
+auto Lines (const std::string& text) -> size_t
+{
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+}
+
+TEST(HistoryExporter, FormatsCsvAndJsonLines)
+{
+    auto record     = MakeRecord(0, 3);
+    record.sequence = 5;
+
+    auto csv = std::string();
+    FormatHistoryRecord(record, ExportFormat::Csv, "Review, \"quoted\"", csv);
+    EXPECT_EQ(csv, "5,1970-01-01T00:00:00.000Z,End,WorkShift,ShortBreak,3,\"Review, \"\"quoted\"\"\",1500000,0\r\n");
+
+    auto json = std::string();
+    FormatHistoryRecord(record, ExportFormat::JsonLines, "Review, \"quoted\"", json);
+    EXPECT_EQ(json,
+        "{\"sequence\":5,\"time\":\"1970-01-01T00:00:00.000Z\",\"event\":\"End\",\"from\":\"WorkShift\","
+        "\"to\":\"ShortBreak\",\"task\":3,\"taskName\":\"Review, \\\"quoted\\\"\",\"duration\":1500000,\"workShift\":0}\n"
+    );
+}
+
+TEST(HistoryExporter, ExportsUncommittedRecordsThroughCommit)
+{
+    const auto dir     = TempDirectory();
+    const auto history = dir.path / "History";
+    std::filesystem::create_directories(history);
+
+    const auto journal = WriteHistory(history, 1000);
+    ASSERT_TRUE(journal);
+
+    auto committed = uint32_t(0);
+
+    auto desc      = HistoryExporter::Desc();
+    desc.directory = history;
+    desc.path      = dir.path / "History.csv";
+    desc.sequence  = journal->Size();
+    desc.commit    = [&](uint32_t sequence) { committed = sequence; return journal->Commit(sequence); };
+    desc.taskNames = { { 1, "Write report" } };
+
+    ASSERT_TRUE(HistoryExporter::Start(std::move(desc))->Wait());
+    EXPECT_EQ(committed, 1000u);
+
+    const auto text = ReadFile(dir.path / "History.csv");
+    EXPECT_EQ(text.rfind(HistoryExportHeader(ExportFormat::Csv), 0), 0u);
+    EXPECT_EQ(Lines(text), 1001u);
+    EXPECT_NE(text.find(",1,Write report,"), std::string::npos);
+    EXPECT_FALSE(std::filesystem::exists(dir.path / "History.csv.tmp"));
+}
+
+TEST(HistoryExporter, TaskFilterKeepsProgressTotal)
+{
+    const auto dir     = TempDirectory();
+    const auto history = dir.path / "History";
+    std::filesystem::create_directories(history);
+
+    const auto journal = WriteHistory(history, 100);
+    ASSERT_TRUE(journal);
+    ASSERT_TRUE(journal->Commit());
+
+    auto last = std::pair<uint64_t, uint64_t>();
+
+    auto desc           = HistoryExporter::Desc();
+    desc.directory      = history;
+    desc.path           = dir.path / "History.jsonl";
+    desc.format         = ExportFormat::JsonLines;
+    desc.query.allTasks = false;
+    desc.query.task     = 2;
+    desc.onProgress     = [&](uint64_t done, uint64_t total) { last = { done, total }; };
+
+    ASSERT_TRUE(HistoryExporter::Start(std::move(desc))->Wait());
+
+    const auto text = ReadFile(dir.path / "History.jsonl");
+    EXPECT_EQ(Lines(text), 50u);
+    EXPECT_EQ(text.find("\"task\":1,"), std::string::npos);
+    EXPECT_EQ(last.first, 100u);
+    EXPECT_EQ(last.second, 100u);
+}
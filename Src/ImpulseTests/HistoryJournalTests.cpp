@@ -0,0 +1,244 @@
+#include "HistoryJournal.hpp"
+#include "HistorySegments.hpp"
+#include "TempDirectory.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto MakeRecord (int64_t time) -> HistoryRecord
+{
+    auto record  = HistoryRecord();
+    record.time  = time;
+    record.task  = 7;
+    record.event = HistoryEvent::End;
+    record.from  = ImpulseState::WorkShift;
+    record.to    = ImpulseState::ShortBreak;
+    return record;
+}
+
+auto FastDesc (const std::filesystem::path& directory) -> HistoryJournal::Desc
+{
+    auto desc        = HistoryJournal::Desc();
+    desc.directory   = directory;
+    desc.commitDelay = 1ms;
+    desc.retryDelay  = 1ms;
+    return desc;
+}
+
+// Records of active journal as they are on disk, header checked.
+auto ReadJournal (const std::filesystem::path& directory) -> std::vector<HistoryRecord>
+{
+    const auto data = ReadFile(directory / JournalSegmentName(0));
+
+    auto header = HistoryHeader();
+    EXPECT_GE(data.size(), sizeof(header));
+    if (data.size() < sizeof(header))
+    {
+        return {};
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+    EXPECT_TRUE(IsValid(header));
+
+    auto records = std::vector<HistoryRecord>((data.size() - sizeof(header)) / sizeof(HistoryRecord));
+    std::memcpy(records.data(), data.data() + sizeof(header), records.size() * sizeof(HistoryRecord));
+    return records;
+}
+
+}
+
+TEST(HistoryJournal, AppendedRecordsSurviveReopen)
+{
+    const auto dir = TempDirectory();
+
+    {
+        auto journal = HistoryJournal::Open(FastDesc(dir.path));
+        ASSERT_TRUE(journal);
+
+        for (auto i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(journal->Append(MakeRecord(1000 + i)), uint32_t(i));
+        }
+
+        EXPECT_TRUE(journal->Commit());
+    }
+
+    const auto records = ReadJournal(dir.path);
+    ASSERT_EQ(records.size(), 100u);
+    EXPECT_EQ(ValidHistoryPrefix(records.data(), records.size()), 100u);
+    EXPECT_EQ(records[42].sequence, 42u);
+    EXPECT_EQ(records[42].time, 1042);
+
+    auto journal = HistoryJournal::Open(FastDesc(dir.path));
+    ASSERT_TRUE(journal);
+    EXPECT_EQ(journal->Size(), 100u);
+    EXPECT_EQ(journal->Recovered(), 0u);
+}
+
+TEST(HistoryJournal, TornWriteIsCutOffAtOpen)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / JournalSegmentName(0);
+
+    {
+        auto journal = HistoryJournal::Open(FastDesc(dir.path));
+        ASSERT_TRUE(journal);
+
+        for (auto i = 0; i < 10; ++i)
+        {
+            journal->Append(MakeRecord(1000 + i));
+        }
+
+        EXPECT_TRUE(journal->Commit());
+    }
+
+    // Crash in the middle of next group: last record damaged, one after it
+    // only half written.
+    auto data = ReadFile(path);
+    data[data.size() - 20] ^= 0x5A;
+
+    auto torn = MakeRecord(2000);
+    torn.sequence = 10;
+    Seal(torn);
+    data.append(reinterpret_cast<const char*>(&torn), sizeof(torn) / 2);
+
+    WriteFile(path, data);
+
+    {
+        auto journal = HistoryJournal::Open(FastDesc(dir.path));
+        ASSERT_TRUE(journal);
+
+        EXPECT_EQ(journal->Recovered(), sizeof(HistoryRecord) + sizeof(HistoryRecord) / 2);
+        EXPECT_EQ(journal->Size(), 9u);
+
+        // Sequence continues right after last good record.
+        EXPECT_EQ(journal->Append(MakeRecord(3000)), 9u);
+        EXPECT_TRUE(journal->Commit());
+    }
+
+    const auto records = ReadJournal(dir.path);
+    ASSERT_EQ(records.size(), 10u);
+    EXPECT_EQ(ValidHistoryPrefix(records.data(), records.size()), 10u);
+    EXPECT_EQ(records[8].time, 1008);
+    EXPECT_EQ(records[9].time, 3000);
+    EXPECT_EQ(records[9].sequence, 9u);
+}
+
+TEST(HistoryJournal, DamagedHeaderIsLeftAlone)
+{
+    const auto dir  = TempDirectory();
+    const auto path = dir.path / JournalSegmentName(0);
+
+    WriteFile(path, std::string(sizeof(HistoryHeader) + sizeof(HistoryRecord), 'x'));
+
+    EXPECT_FALSE(HistoryJournal::Open(FastDesc(dir.path)));
+    EXPECT_EQ(ReadFile(path).size(), sizeof(HistoryHeader) + sizeof(HistoryRecord));
+}
+
+TEST(HistoryJournal, FailedGroupIsRetriedBeforeNewerRecords)
+{
+    const auto dir  = TempDirectory();
+    auto       disk = std::atomic<bool>(false);
+    auto       desc = FastDesc(dir.path);
+
+    // Retries only when asked to, so none races with disk coming back.
+    desc.retryDelay = 10s;
+    desc.onWrite    = [&] { return disk.load(); };
+
+    auto journal = HistoryJournal::Open(desc);
+    ASSERT_TRUE(journal);
+
+    for (auto i = 0; i < 5; ++i)
+    {
+        journal->Append(MakeRecord(1000 + i));
+    }
+
+    EXPECT_FALSE(journal->Commit());
+    EXPECT_GE(journal->Failed(), 1u);
+    EXPECT_TRUE(ReadJournal(dir.path).empty());
+
+    // Records appended while disk is gone queue up behind failed ones.
+    for (auto i = 5; i < 10; ++i)
+    {
+        journal->Append(MakeRecord(1000 + i));
+    }
+
+    disk = true;
+    EXPECT_TRUE(journal->Commit());
+
+    const auto records = ReadJournal(dir.path);
+    ASSERT_EQ(records.size(), 10u);
+    EXPECT_EQ(ValidHistoryPrefix(records.data(), records.size()), 10u);
+
+    for (auto i = 0u; i < records.size(); ++i)
+    {
+        EXPECT_EQ(records[i].sequence, i);
+    }
+}
+
+TEST(HistoryJournal, CommitWaitsForGivenSequence)
+{
+    const auto dir = TempDirectory();
+
+    auto journal = HistoryJournal::Open(FastDesc(dir.path));
+    ASSERT_TRUE(journal);
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        journal->Append(MakeRecord(1000 + i));
+    }
+
+    EXPECT_TRUE(journal->Commit(3));
+    EXPECT_GE(ReadJournal(dir.path).size(), 3u);
+
+    // Nothing to wait for.
+    EXPECT_TRUE(journal->Commit(2));
+}
+
+TEST(HistoryJournal, FullSegmentIsRotated)
+{
+    const auto dir  = TempDirectory();
+    auto       desc = FastDesc(dir.path);
+
+    // Only Commit() ends a group, so every group is exactly one segment.
+    desc.commitDelay    = 10s;
+    desc.maxSegmentSize = sizeof(HistoryHeader) + 4 * sizeof(HistoryRecord);
+
+    auto rotations = std::atomic<uint32_t>(0);
+
+    {
+        auto journal = HistoryJournal::Open(desc);
+        ASSERT_TRUE(journal);
+
+        journal->OnRotate = [&] { rotations += 1; };
+
+        for (auto i = 0; i < 3; ++i)
+        {
+            for (auto j = 0; j < 4; ++j)
+            {
+                journal->Append(MakeRecord(1000 + i * 4 + j));
+            }
+
+            EXPECT_TRUE(journal->Commit());
+        }
+    }
+
+    EXPECT_EQ(rotations.load(), 3u);
+
+    const auto segments = ListHistorySegments(dir.path);
+    ASSERT_EQ(segments.size(), 4u);
+    EXPECT_EQ(segments[1].first, 4u);
+    EXPECT_EQ(segments[3].first, 12u);
+
+    auto journal = HistoryJournal::Open(desc);
+    ASSERT_TRUE(journal);
+    EXPECT_EQ(journal->Size(), 12u);
+}
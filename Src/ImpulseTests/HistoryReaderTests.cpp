@@ -0,0 +1,139 @@
+#include "HistoryJournal.hpp"
+#include "HistoryReader.hpp"
+#include "HistorySegments.hpp"
+#include "TempDirectory.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Journal with @count records a second apart, starting at 1000 s,
+// committed in groups of 64.
+auto WriteHistory (const std::filesystem::path& directory, uint32_t count, uint64_t maxSegmentSize = 1 << 20) -> void
+{
+    auto desc           = HistoryJournal::Desc();
+    desc.directory      = directory;
+    desc.commitDelay    = 10s;
+    desc.maxSegmentSize = maxSegmentSize;
+
+    auto journal = HistoryJournal::Open(desc);
+    ASSERT_TRUE(journal);
+
+    for (auto i = uint32_t(0); i < count; ++i)
+    {
+        auto record  = HistoryRecord();
+        record.time  = (1000 + int64_t(i)) * 1000;
+        record.task  = i % 3;
+        record.event = HistoryEvent::End;
+        journal->Append(record);
+
+        if (i % 64 == 63)
+        {
+            ASSERT_TRUE(journal->Commit());
+        }
+    }
+
+    ASSERT_TRUE(journal->Commit());
+}
+
+}
+
+TEST(HistoryReader, RangeFindsRecordsByTime)
+{
+    const auto dir = TempDirectory();
+    WriteHistory(dir.path, 1000);
+
+    const auto reader = HistoryReader::OpenDirectory(dir.path);
+    ASSERT_TRUE(reader);
+
+    EXPECT_EQ(reader->Size(), 1000u);
+    EXPECT_EQ(reader->FirstTime(), 1000000);
+    EXPECT_EQ(reader->LastTime(), 1999000);
+
+    // [1100 s, 1200 s) holds records 100..199.
+    EXPECT_EQ(reader->Count(1100000, 1200000), 100u);
+    EXPECT_EQ(reader->Count(1100001, 1200000), 99u);
+    EXPECT_EQ(reader->Count(0, 1000000), 0u);
+    EXPECT_EQ(reader->Count(0, INT64_MAX), 1000u);
+
+    auto sequences = std::vector<uint32_t>();
+    reader->Range(1500000, 1503000, [&](HistorySpan span)
+    {
+        for (const auto& record : span)
+        {
+            sequences.push_back(record.sequence);
+        }
+
+        return true;
+    });
+
+    EXPECT_EQ(sequences, (std::vector<uint32_t>{ 500, 501, 502 }));
+}
+
+TEST(HistoryReader, TornRecordsAtEndAreIgnored)
+{
+    const auto dir = TempDirectory();
+    WriteHistory(dir.path, 10);
+
+    // Last record damaged, another half written after it.
+    const auto path = dir.path / JournalSegmentName(0);
+
+    auto data = ReadFile(path);
+    data[data.size() - 20] ^= 0x5A;
+    data.append(sizeof(HistoryRecord) / 2, '\x7F');
+    WriteFile(path, data);
+
+    const auto reader = HistoryReader::OpenDirectory(dir.path);
+    ASSERT_TRUE(reader);
+
+    EXPECT_EQ(reader->Size(), 9u);
+    EXPECT_EQ(reader->LastTime(), 1008000);
+    EXPECT_EQ(reader->Count(0, INT64_MAX), 9u);
+}
+
+TEST(HistoryReader, SegmentsAreReadInSequenceOrder)
+{
+    const auto dir = TempDirectory();
+
+    // Segment is full after every group.
+    WriteHistory(dir.path, 300, sizeof(HistoryHeader) + 64 * sizeof(HistoryRecord));
+
+    const auto reader = HistoryReader::OpenDirectory(dir.path);
+    ASSERT_TRUE(reader);
+
+    EXPECT_EQ(reader->Segments(), 5u);
+    EXPECT_EQ(reader->Size(), 300u);
+    EXPECT_EQ(reader->Count(1060000, 1070000), 10u);
+
+    auto next = uint32_t(250);
+    reader->Since(250, [&](HistorySpan span)
+    {
+        for (const auto& record : span)
+        {
+            EXPECT_EQ(record.sequence, next);
+            next += 1;
+        }
+
+        return true;
+    });
+
+    EXPECT_EQ(next, 300u);
+}
+
+TEST(HistoryReader, EmptyHistory)
+{
+    const auto dir = TempDirectory();
+
+    const auto reader = HistoryReader::OpenDirectory(dir.path);
+    ASSERT_TRUE(reader);
+
+    EXPECT_EQ(reader->Size(), 0u);
+    EXPECT_EQ(reader->FirstTime(), 0);
+    EXPECT_EQ(reader->LastTime(), 0);
+    EXPECT_EQ(reader->Count(0, INT64_MAX), 0u);
+}
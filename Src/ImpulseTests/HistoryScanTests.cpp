@@ -0,0 +1,147 @@
+#include "HistoryScan.hpp"
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+auto RandomRecords (size_t count, uint32_t seed) -> std::vector<HistoryRecord>
+{
+    constexpr ImpulseState STATES[] = {
+        ImpulseState::Inactive, ImpulseState::WorkShift, ImpulseState::ShortBreak,
+        ImpulseState::LongBreak, ImpulseState::Paused
+    };
+
+    auto random  = std::mt19937(seed);
+    auto records = std::vector<HistoryRecord>(count);
+    auto time    = int64_t(-5000);
+
+    for (auto i = size_t(0); i < count; ++i)
+    {
+        auto& record = records[i];
+        time += random() % 2000;
+
+        record.time      = time;
+        record.sequence  = static_cast<uint32_t>(i);
+        record.task      = random() % 3;
+        record.duration  = random() % 2 ? random() : random() % 1500000;
+        record.workShift = static_cast<uint16_t>(random());
+        record.event     = static_cast<HistoryEvent>(random() % 5);
+        record.from      = STATES[random() % 5];
+        record.to        = STATES[random() % 5];
+        Seal(record);
+    }
+
+    return records;
+}
+
+auto Queries () -> std::vector<HistoryQuery>
+{
+    auto queries = std::vector<HistoryQuery>();
+
+    queries.push_back(HistoryQuery());
+
+    auto task = HistoryQuery();
+    task.task     = 1;
+    task.allTasks = false;
+    queries.push_back(task);
+
+    auto range = HistoryQuery();
+    range.from = -2000;
+    range.to   = 6000;
+    queries.push_back(range);
+
+    auto empty = HistoryQuery();
+    empty.from = 100;
+    empty.to   = 100;
+    queries.push_back(empty);
+
+    return queries;
+}
+
+}
+
+// Every record count up to two AVX2 steps plus a tail, so lane handling
+// and the scalar remainder both get exercised.
+TEST(HistoryScan, Avx2MatchesScalarForAnyCount)
+{
+    if (!HistoryScanUsesAvx2())
+    {
+        GTEST_SKIP() << "Processor has no AVX2";
+    }
+
+    for (auto count = size_t(0); count <= 17; ++count)
+    {
+        for (auto seed = 0u; seed < 20; ++seed)
+        {
+            const auto records = RandomRecords(count, seed);
+            const auto span    = HistorySpan{ records.data(), records.data() + records.size() };
+
+            // Bounds exactly on record times.
+            auto queries = Queries();
+            if (count > 2)
+            {
+                auto exact = HistoryQuery();
+                exact.from     = records[1].time;
+                exact.to       = records[count - 1].time;
+                exact.task     = records[1].task;
+                exact.allTasks = seed % 2 == 0;
+                queries.push_back(exact);
+            }
+
+            for (const auto& query : queries)
+            {
+                const auto fast  = ScanHistory(span, query);
+                const auto plain = ScanHistoryScalar(span, query);
+
+                EXPECT_EQ(fast.focus,     plain.focus)     << count << " records, seed " << seed;
+                EXPECT_EQ(fast.pause,     plain.pause)     << count << " records, seed " << seed;
+                EXPECT_EQ(fast.pomodoros, plain.pomodoros) << count << " records, seed " << seed;
+            }
+        }
+    }
+}
+
+TEST(HistoryScan, ScalarFollowsStatsRules)
+{
+    auto records = std::vector<HistoryRecord>(3);
+
+    records[0].time     = 10;
+    records[0].from     = ImpulseState::WorkShift;
+    records[0].event    = HistoryEvent::End;
+    records[0].duration = 1500;
+    records[0].task     = 1;
+
+    records[1].time     = 20;
+    records[1].from     = ImpulseState::Paused;
+    records[1].event    = HistoryEvent::Resume;
+    records[1].duration = 300;
+    records[1].task     = 2;
+
+    records[2].time     = 30;
+    records[2].from     = ImpulseState::WorkShift;
+    records[2].event    = HistoryEvent::Stop;
+    records[2].duration = 700;
+    records[2].task     = 1;
+
+    const auto span = HistorySpan{ records.data(), records.data() + records.size() };
+
+    const auto all = ScanHistoryScalar(span, HistoryQuery());
+    EXPECT_EQ(all.focus, 2200u);
+    EXPECT_EQ(all.pause, 300u);
+    EXPECT_EQ(all.pomodoros, 1u);
+
+    auto query = HistoryQuery();
+    query.from     = 15;
+    query.task     = 1;
+    query.allTasks = false;
+
+    const auto some = ScanHistory(span, query);
+    EXPECT_EQ(some.focus, 700u);
+    EXPECT_EQ(some.pause, 0u);
+    EXPECT_EQ(some.pomodoros, 0u);
+}
@@ -0,0 +1,127 @@
+#include "HistoryStats.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+constexpr auto HOUR = int64_t(60) * 60 * 1000;
+constexpr auto DAY  = 24 * HOUR;
+
+auto WorkRecord (uint32_t sequence, int64_t time, uint32_t task, uint32_t duration) -> HistoryRecord
+{
+    auto record     = HistoryRecord();
+    record.sequence = sequence;
+    record.time     = time;
+    record.task     = task;
+    record.duration = duration;
+    record.event    = HistoryEvent::End;
+    record.from     = ImpulseState::WorkShift;
+    record.to       = ImpulseState::ShortBreak;
+    return record;
+}
+
+}
+
+TEST(HistoryStats, PeriodsStartOnLocalMidnightMondayAndFirstOfMonth)
+{
+    // 1970-01-01 was Thursday.
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Day, 0, 0), 0);
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Day, -1, 0), -1);
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Week, 3 * DAY, 0), 0);
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Week, 4 * DAY, 0), 1);
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Month, 31 * DAY, 0), 1);
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Month, 59 * DAY, 0), 2);
+
+    // 23:00 UTC is next day two hours east.
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Day, 23 * HOUR, 2 * HOUR), 1);
+    EXPECT_EQ(HistoryStats::PeriodOf(StatsPeriod::Day, 1 * HOUR, -2 * HOUR), -1);
+}
+
+TEST(HistoryStats, RollupsFollowRecords)
+{
+    auto stats = HistoryStats();
+
+    stats.Add(WorkRecord(0, 10 * HOUR, 1, 1500));
+    stats.Add(WorkRecord(1, 11 * HOUR, 2, 1000));
+    stats.Add(WorkRecord(2, DAY + HOUR, 1, 500));
+
+    // Already counted.
+    stats.Add(WorkRecord(1, 11 * HOUR, 2, 1000));
+
+    EXPECT_EQ(stats.NextSequence(), 3u);
+    EXPECT_EQ(stats.Totals(StatsPeriod::Day, 0, 1).focus, 1500u);
+    EXPECT_EQ(stats.AllTasks(StatsPeriod::Day, 0).focus, 2500u);
+    EXPECT_EQ(stats.AllTasks(StatsPeriod::Day, 0).pomodoros, 2u);
+    EXPECT_EQ(stats.Totals(StatsPeriod::Week, 0, 1).focus, 2000u);
+    EXPECT_EQ(stats.AllTasks(StatsPeriod::Month, 0).focus, 3000u);
+    EXPECT_EQ(stats.AllTasks(StatsPeriod::Day, 5).focus, 0u);
+}
+
+TEST(HistoryStats, SerializedStatsKeepTheirOffset)
+{
+    auto stats = HistoryStats(2 * HOUR);
+    stats.Add(WorkRecord(0, 23 * HOUR, 1, 1500));
+
+    // Offset is what records without their own one were counted with, it
+    // comes back with periods so later old records agree.
+    auto loaded = HistoryStats(-5 * HOUR);
+    ASSERT_TRUE(loaded.Deserialize(stats.Serialize()));
+
+    EXPECT_EQ(loaded.UtcOffset(), 2 * HOUR);
+    EXPECT_EQ(loaded.NextSequence(), 1u);
+    EXPECT_EQ(loaded.AllTasks(StatsPeriod::Day, 1).focus, 1500u);
+
+    loaded.Add(WorkRecord(1, 23 * HOUR, 1, 500));
+    EXPECT_EQ(loaded.AllTasks(StatsPeriod::Day, 1).focus, 2000u);
+}
+
+TEST(HistoryStats, RecordsKeepOffsetTheyWereWrittenAt)
+{
+    // Summer records written at UTC+2, winter ones at UTC+1, stats were
+    // created in winter.
+    auto stats = HistoryStats(1 * HOUR);
+
+    // 22:30 UTC is 00:30 next day in summer, but 23:30 same day in winter.
+    auto summer = WorkRecord(0, 22 * HOUR + HOUR / 2, 1, 1500);
+    SetUtcOffset(summer, 2 * HOUR);
+    auto winter = WorkRecord(1, 100 * DAY + 22 * HOUR + HOUR / 2, 1, 1000);
+    SetUtcOffset(winter, 1 * HOUR);
+
+    stats.Add(summer);
+    stats.Add(winter);
+
+    EXPECT_EQ(stats.AllTasks(StatsPeriod::Day, 1).focus, 1500u);
+    EXPECT_EQ(stats.AllTasks(StatsPeriod::Day, 0).focus, 0u);
+    EXPECT_EQ(stats.AllTasks(StatsPeriod::Day, 100).focus, 1000u);
+}
+
+TEST(HistoryStats, UtcOffsetIsStoredInQuarterHours)
+{
+    auto record = HistoryRecord();
+    EXPECT_EQ(UtcOffsetOf(record, 3 * HOUR), 3 * HOUR);
+
+    for (const auto offset : { int64_t(0), -12 * HOUR, 14 * HOUR, 5 * HOUR + 45 * 60 * 1000, -(3 * HOUR + HOUR / 2) })
+    {
+        SetUtcOffset(record, offset);
+        EXPECT_EQ(UtcOffsetOf(record, 3 * HOUR), offset);
+    }
+
+    // Nearest step.
+    SetUtcOffset(record, -(HOUR / 4 + 60 * 1000));
+    EXPECT_EQ(UtcOffsetOf(record, 0), -HOUR / 4);
+}
+
+TEST(HistoryStats, DamagedDataIsRejected)
+{
+    auto stats = HistoryStats();
+    stats.Add(WorkRecord(0, HOUR, 1, 1500));
+
+    auto data = stats.Serialize();
+    data[data.size() - 1] ^= 1;
+
+    auto loaded = HistoryStats();
+    EXPECT_FALSE(loaded.Deserialize(data));
+    EXPECT_FALSE(loaded.Deserialize(data.substr(0, 8)));
+}
@@ -0,0 +1,302 @@
+#include "PointerCoalescer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Stands in for widget collection: one button, hover changes redraw it.
+struct FakeWidgets
+{
+    int      hovered   = -1;
+    uint64_t hitTests  = 0;
+
+    struct Press
+    {
+        bool down;
+        int  x;
+        int  y;
+        int  hovered;
+    };
+    std::vector<Press> presses;
+
+    static auto HitTest (int x, int y) -> int
+    {
+        return x >= 100 && x < 200 && y >= 100 && y < 150 ? 0 : -1;
+    }
+
+    auto MouseMove (int x, int y) -> bool
+    {
+        hitTests += 1;
+
+        const auto hit     = HitTest(x, y);
+        const auto changed = hit != hovered;
+        hovered = hit;
+        return changed;
+    }
+
+    auto MouseButton (bool down, int x, int y) -> bool
+    {
+        presses.push_back(Press{ down, x, y, hovered });
+        return hovered >= 0;
+    }
+};
+
+using Clock = PointerCoalescer::Clock;
+
+struct Input
+{
+    Clock::time_point time;
+    bool              move = true;  // else button
+    bool              down = false;
+    int               x    = 0;
+    int               y    = 0;
+};
+
+// D2DApp::GfxLoop with ImpulseApp handlers, on simulated time. Each wake up
+// dispatches queued input, runs OnUpdate() and draws when asked to. Idle
+// loop sleeps like MsgWaitForMultipleObjectsEx(): until next input, or
+// while a move is pending until UpdateTime() or next input that isn't a
+// move. Without coalescing every move is hit tested when dispatched.
+struct Loop
+{
+    bool             coalesce = true;
+    PointerCoalescer pointer;
+    FakeWidgets      widgets;
+    bool             redraw   = false;
+    uint64_t         wakeups  = 0;
+    uint64_t         frames   = 0;
+
+    auto Resolve () -> void
+    {
+        redraw |= pointer.Flush([&](int x, int y) { return widgets.MouseMove(x, y); });
+    }
+
+    auto Dispatch (const Input& input) -> void
+    {
+        if (input.move && coalesce)
+        {
+            pointer.Move(input.x, input.y);
+        }
+        else if (input.move)
+        {
+            redraw |= widgets.MouseMove(input.x, input.y);
+        }
+        else
+        {
+            Resolve();
+            redraw |= widgets.MouseButton(input.down, input.x, input.y);
+        }
+    }
+
+    auto Run (const std::vector<Input>& inputs) -> void
+    {
+        auto now  = inputs.front().time;
+        auto next = size_t(0);
+
+        while (true)
+        {
+            while (next < inputs.size() && inputs[next].time <= now)
+            {
+                Dispatch(inputs[next++]);
+            }
+
+            // OnUpdate() and Draw().
+            redraw |= pointer.Update(now, [&](int x, int y) { return widgets.MouseMove(x, y); });
+
+            if (redraw)
+            {
+                redraw  = false;
+                frames += 1;
+            }
+
+            auto wake = pointer.UpdateTime(now);
+            for (auto i = next; i < inputs.size() && inputs[i].time < wake; ++i)
+            {
+                if (!inputs[i].move || wake == Clock::time_point::max())
+                {
+                    wake = inputs[i].time;
+                    break;
+                }
+            }
+
+            if (wake == Clock::time_point::max())
+            {
+                break;
+            }
+
+            now      = std::max(now, wake);
+            wakeups += 1;
+        }
+    }
+};
+
+// 8 kHz mouse sweeping back and forth over the button. Button is pressed
+// and released now and then between two moves.
+constexpr auto MOVE_RATE  = 8000;
+constexpr auto FRAME_RATE = 60;
+
+auto Stream (int seconds) -> std::vector<Input>
+{
+    const auto moves  = MOVE_RATE * seconds;
+    const auto period = std::chrono::microseconds(1000000 / MOVE_RATE);
+
+    auto inputs = std::vector<Input>();
+    auto time   = Clock::time_point() + std::chrono::hours(1);
+
+    for (auto i = 0; i < moves; ++i)
+    {
+        // Triangle wave across the button, 1 px per report.
+        const auto phase = i % 400;
+        const auto x     = 50 + (phase < 200 ? phase : 400 - phase);
+        const auto y     = 120 + (i / 400) % 10;
+
+        time += period;
+        inputs.push_back(Input{ time, true, false, x, y });
+
+        if (i % 997 == 500 || i % 997 == 510)
+        {
+            inputs.push_back(Input{ time, false, i % 997 == 500, x, y });
+        }
+    }
+
+    return inputs;
+}
+
+}
+
+TEST(PointerCoalescer, EightKhzStreamHitTestsOncePerFrame)
+{
+    const auto inputs = Stream(5);
+
+    auto loop = Loop();
+    loop.pointer.FrameInterval(std::chrono::microseconds(1000000 / FRAME_RATE));
+    loop.Run(inputs);
+
+    // Frame boundaries at both ends of the stream.
+    const auto frames  = uint64_t(5 * FRAME_RATE) + 1;
+    const auto presses = loop.widgets.presses.size();
+
+    EXPECT_EQ(loop.pointer.Moves(), uint64_t(5 * MOVE_RATE));
+
+    // Loop isn't woken up by every move, only by frames and buttons. After
+    // last move it resolves it at next frame and wakes once more to find
+    // nothing to do.
+    EXPECT_LE(loop.wakeups, frames + presses + 2);
+
+    // One per frame plus one per button whose moves weren't resolved yet.
+    EXPECT_LE(loop.widgets.hitTests, frames + presses + 1);
+    EXPECT_GE(loop.widgets.hitTests, frames - 1);
+    EXPECT_EQ(loop.widgets.hitTests, loop.pointer.Resolved());
+
+    EXPECT_LE(loop.frames, frames + presses + 1);
+    EXPECT_GT(loop.frames, 0u);
+}
+
+TEST(PointerCoalescer, FirstMoveAfterPauseIsResolvedRightAway)
+{
+    const auto start    = Clock::time_point() + std::chrono::hours(1);
+    const auto interval = std::chrono::milliseconds(16);
+
+    auto pointer = PointerCoalescer();
+    pointer.FrameInterval(interval);
+
+    auto hits     = 0;
+    auto hitTest  = [&](int, int) { hits += 1; return true; };
+
+    EXPECT_EQ(pointer.UpdateTime(start), Clock::time_point::max());
+
+    pointer.Move(1, 1);
+    EXPECT_TRUE(pointer.Update(start, hitTest));
+
+    // Loop sleeps through moves until next frame, even with none pending.
+    EXPECT_EQ(pointer.UpdateTime(start), start + interval);
+    EXPECT_EQ(pointer.UpdateTime(start + interval), Clock::time_point::max());
+
+    // Next one waits for its frame.
+    pointer.Move(2, 2);
+    EXPECT_EQ(pointer.UpdateTime(start), start + interval);
+    EXPECT_FALSE(pointer.Update(start + interval / 2, hitTest));
+    EXPECT_TRUE(pointer.Update(start + interval, hitTest));
+
+    // Vsync paced wake up slightly early still resolves, frames stay on grid.
+    pointer.Move(3, 3);
+    EXPECT_TRUE(pointer.Update(start + 2 * interval - interval / 16, hitTest));
+    pointer.Move(4, 4);
+    EXPECT_EQ(pointer.UpdateTime(start + 2 * interval), start + 3 * interval);
+
+    // After a pause it is immediate again.
+    EXPECT_TRUE(pointer.Update(start + 10 * interval, hitTest));
+    pointer.Move(5, 5);
+    EXPECT_TRUE(pointer.Update(start + 20 * interval, hitTest));
+
+    EXPECT_EQ(hits, 5);
+}
+
+TEST(PointerCoalescer, ButtonsSeeSameHoverAsUncoalesced)
+{
+    const auto inputs = Stream(5);
+
+    auto coalesced   = Loop();
+    auto uncoalesced = Loop();
+    uncoalesced.coalesce = false;
+
+    coalesced.Run(inputs);
+    uncoalesced.Run(inputs);
+
+    // Every move was hit tested without coalescing.
+    EXPECT_EQ(uncoalesced.widgets.hitTests, uint64_t(5 * MOVE_RATE));
+    EXPECT_LT(coalesced.widgets.hitTests * 20, uncoalesced.widgets.hitTests);
+
+    // Presses and releases arrive in same order, at same place, over same
+    // widget.
+    const auto& a = coalesced.widgets.presses;
+    const auto& b = uncoalesced.widgets.presses;
+    ASSERT_EQ(a.size(), b.size());
+    ASSERT_FALSE(a.empty());
+
+    auto overButton = 0;
+    for (auto i = size_t(0); i < a.size(); ++i)
+    {
+        EXPECT_EQ(a[i].down, b[i].down)       << i;
+        EXPECT_EQ(a[i].x, b[i].x)             << i;
+        EXPECT_EQ(a[i].y, b[i].y)             << i;
+        EXPECT_EQ(a[i].hovered, b[i].hovered) << i;
+
+        overButton += a[i].hovered >= 0 ? 1 : 0;
+    }
+
+    // Stream is built so some presses land on the button and some don't.
+    EXPECT_GT(overButton, 0);
+    EXPECT_LT(overButton, static_cast<int>(a.size()));
+
+    // Last frame shows the same final hover state.
+    EXPECT_EQ(coalesced.widgets.hovered, uncoalesced.widgets.hovered);
+}
+
+TEST(PointerCoalescer, FlushWithoutMoveDoesNothing)
+{
+    auto pointer = PointerCoalescer();
+    auto calls   = 0;
+
+    EXPECT_FALSE(pointer.Flush([&](int, int) { calls += 1; return true; }));
+
+    pointer.Move(1, 2);
+    pointer.Move(3, 4);
+    EXPECT_TRUE(pointer.Flush([&](int x, int y) { calls += 1; return x == 3 && y == 4; }));
+    EXPECT_FALSE(pointer.Flush([&](int, int) { calls += 1; return true; }));
+
+    pointer.Move(5, 6);
+    pointer.Discard();
+    EXPECT_FALSE(pointer.HasPending());
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(pointer.Moves(), 3u);
+    EXPECT_EQ(pointer.Resolved(), 1u);
+}
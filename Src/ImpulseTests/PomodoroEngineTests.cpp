@@ -0,0 +1,159 @@
+#include "PomodoroEngine.hpp"
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+TEST(PomodoroEngine, CyclesThroughBreaks)
+{
+    auto engine = PomodoroEngine();
+    ASSERT_TRUE(engine.Handle(PomodoroEvent::Start));
+
+    const ImpulseState expected[] = {
+        ImpulseState::ShortBreak, ImpulseState::WorkShift,
+        ImpulseState::ShortBreak, ImpulseState::WorkShift,
+        ImpulseState::ShortBreak, ImpulseState::WorkShift,
+        ImpulseState::LongBreak,  ImpulseState::WorkShift,
+        ImpulseState::ShortBreak,
+    };
+
+    const uint32_t counts[] = { 1, 2, 2, 3, 3, 4, 4, 1, 1 };
+
+    for (auto i = 0; i < 9; ++i)
+    {
+        EXPECT_TRUE(engine.Handle(PomodoroEvent::Timeout));
+        EXPECT_EQ(engine.State(), expected[i])        << i;
+        EXPECT_EQ(engine.WorkShiftCount(), counts[i]) << i;
+    }
+
+    EXPECT_EQ(engine.Transitions(), 10u);
+}
+
+TEST(PomodoroEngine, PauseResumesSamePhase)
+{
+    auto engine = PomodoroEngine();
+    engine.Handle(PomodoroEvent::Start);
+    engine.Handle(PomodoroEvent::Timeout);
+    ASSERT_EQ(engine.State(), ImpulseState::ShortBreak);
+
+    EXPECT_TRUE(engine.Handle(PomodoroEvent::Pause));
+    EXPECT_EQ(engine.State(), ImpulseState::Paused);
+    EXPECT_EQ(engine.PhaseDuration(), 5min);
+
+    // Paused phase doesn't time out.
+    EXPECT_FALSE(engine.Handle(PomodoroEvent::Timeout));
+    EXPECT_FALSE(engine.Handle(PomodoroEvent::Pause));
+
+    EXPECT_TRUE(engine.Handle(PomodoroEvent::Resume));
+    EXPECT_EQ(engine.State(), ImpulseState::ShortBreak);
+    EXPECT_FALSE(engine.Handle(PomodoroEvent::Resume));
+}
+
+TEST(PomodoroEngine, ToggleStartsPausesAndResumes)
+{
+    auto engine = PomodoroEngine();
+
+    EXPECT_TRUE(engine.Handle(PomodoroEvent::Toggle));
+    EXPECT_EQ(engine.State(), ImpulseState::WorkShift);
+
+    EXPECT_TRUE(engine.Handle(PomodoroEvent::Toggle));
+    EXPECT_EQ(engine.State(), ImpulseState::Paused);
+
+    EXPECT_TRUE(engine.Handle(PomodoroEvent::Toggle));
+    EXPECT_EQ(engine.State(), ImpulseState::WorkShift);
+}
+
+TEST(PomodoroEngine, StopCountsWorkShiftsFromOne)
+{
+    auto engine = PomodoroEngine();
+
+    EXPECT_FALSE(engine.Handle(PomodoroEvent::Stop));
+    EXPECT_FALSE(engine.Handle(PomodoroEvent::Pause));
+    EXPECT_FALSE(engine.Handle(PomodoroEvent::Timeout));
+    EXPECT_EQ(engine.Transitions(), 0u);
+
+    engine.Handle(PomodoroEvent::Start);
+    engine.Handle(PomodoroEvent::Timeout);
+    engine.Handle(PomodoroEvent::Timeout);
+    ASSERT_EQ(engine.WorkShiftCount(), 2u);
+
+    EXPECT_TRUE(engine.Handle(PomodoroEvent::Stop));
+    EXPECT_EQ(engine.State(), ImpulseState::Inactive);
+    EXPECT_EQ(engine.WorkShiftCount(), 1u);
+
+    EXPECT_TRUE(engine.Handle(PomodoroEvent::Start));
+    EXPECT_EQ(engine.WorkShiftCount(), 1u);
+}
+
+TEST(PomodoroEngine, ConfigureKeepsLongBreakReachable)
+{
+    auto config = PomodoroConfig();
+    config.longBreakAfter = 4;
+
+    auto engine = PomodoroEngine(config);
+    engine.Handle(PomodoroEvent::Start);
+    for (auto i = 0; i < 4; ++i)
+    {
+        engine.Handle(PomodoroEvent::Timeout);
+    }
+    ASSERT_EQ(engine.WorkShiftCount(), 3u);
+
+    config.longBreakAfter = 2;
+    config.workDuration   = 50 * 60;
+    engine.Configure(config);
+
+    EXPECT_EQ(engine.WorkShiftCount(), 1u);
+    EXPECT_EQ(engine.PhaseDuration(), 50min);
+
+    engine.Handle(PomodoroEvent::Timeout);
+    engine.Handle(PomodoroEvent::Timeout);
+    engine.Handle(PomodoroEvent::Timeout);
+    EXPECT_EQ(engine.State(), ImpulseState::LongBreak);
+}
+
+TEST(PomodoroEngine, ReportsTransitions)
+{
+    auto engine      = PomodoroEngine();
+    auto transitions = std::vector<std::pair<ImpulseState, ImpulseState>>();
+
+    engine.OnTransition = [&](ImpulseState from, ImpulseState to)
+    {
+        transitions.emplace_back(from, to);
+    };
+
+    engine.Handle(PomodoroEvent::Start);
+    engine.Handle(PomodoroEvent::Pause);
+    engine.Handle(PomodoroEvent::Pause);
+    engine.Handle(PomodoroEvent::Resume);
+    engine.Handle(PomodoroEvent::Stop);
+
+    const auto expected = std::vector<std::pair<ImpulseState, ImpulseState>>{
+        { ImpulseState::Inactive,  ImpulseState::WorkShift },
+        { ImpulseState::WorkShift, ImpulseState::Paused },
+        { ImpulseState::Paused,    ImpulseState::WorkShift },
+        { ImpulseState::WorkShift, ImpulseState::Inactive },
+    };
+
+    EXPECT_EQ(transitions, expected);
+}
+
+TEST(PomodoroEngine, NextAndDurationOfEachState)
+{
+    auto config = PomodoroConfig();
+
+    EXPECT_EQ(PomodoroDuration(config, ImpulseState::Inactive), 25u * 60);
+    EXPECT_EQ(PomodoroDuration(config, ImpulseState::WorkShift), 25u * 60);
+    EXPECT_EQ(PomodoroDuration(config, ImpulseState::ShortBreak), 5u * 60);
+    EXPECT_EQ(PomodoroDuration(config, ImpulseState::LongBreak), 15u * 60);
+
+    EXPECT_EQ(PomodoroNext(ImpulseState::WorkShift, 3, 4).state, ImpulseState::ShortBreak);
+    EXPECT_EQ(PomodoroNext(ImpulseState::WorkShift, 4, 4).state, ImpulseState::LongBreak);
+    EXPECT_EQ(PomodoroNext(ImpulseState::LongBreak, 4, 4).workShiftCount, 1u);
+    EXPECT_EQ(PomodoroNext(ImpulseState::ShortBreak, 2, 4).workShiftCount, 3u);
+    EXPECT_EQ(PomodoroNext(ImpulseState::Paused, 2, 4).state, ImpulseState::Paused);
+    EXPECT_EQ(PomodoroNext(ImpulseState::Inactive, 2, 4).state, ImpulseState::Inactive);
+}
@@ -0,0 +1,212 @@
+#include "ScheduleProjection.hpp"
+#include "SessionHost.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Milliseconds = std::chrono::milliseconds;
+
+// Small deterministic generator, same configs on every run.
+struct Random
+{
+    uint32_t state = 12345;
+
+    auto Next (uint32_t bound) -> uint32_t
+    {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) % bound;
+    }
+};
+
+auto RandomConfig (Random& random) -> PomodoroConfig
+{
+    auto config = PomodoroConfig();
+    config.workDuration       = 1 + random.Next(3600);
+    config.shortBreakDuration = random.Next(900);
+    config.longBreakDuration  = random.Next(1800);
+    config.longBreakAfter     = random.Next(9);
+    return config;
+}
+
+// Transitions as stepping the state machine would make them.
+auto Step (const PomodoroConfig& config, ImpulseState state, uint32_t count, Milliseconds end, int n)
+    -> std::vector<ProjectedPhase>
+{
+    auto phases = std::vector<ProjectedPhase>();
+    auto at     = end;
+
+    for (auto i = 0; i < n; ++i)
+    {
+        const auto next = PomodoroNext(state, count, config.longBreakAfter);
+        phases.push_back(ProjectedPhase{ next.state, next.workShiftCount, at });
+
+        state = next.state;
+        count = next.workShiftCount;
+        at   += Milliseconds(std::max<int64_t>(PomodoroDuration(config, state), 1) * 1000);
+    }
+
+    return phases;
+}
+
+}
+
+TEST(ScheduleProjection, MatchesSteppedSchedule)
+{
+    auto random = Random();
+
+    for (auto i = 0; i < 500; ++i)
+    {
+        const auto config = RandomConfig(random);
+        const auto limit  = std::max<uint32_t>(config.longBreakAfter, 1);
+        const auto count  = 1 + random.Next(limit);
+        const auto end    = Milliseconds(random.Next(1u << 30));
+
+        const ImpulseState states[] = { ImpulseState::WorkShift, ImpulseState::ShortBreak, ImpulseState::LongBreak };
+        const auto state = states[random.Next(3)];
+
+        // Short break after last work shift and long break after any other
+        // don't happen.
+        if ((state == ImpulseState::ShortBreak) == (count == limit) && state != ImpulseState::WorkShift)
+        {
+            continue;
+        }
+
+        const auto projection = ScheduleProjection(config, state, count, end);
+        const auto expected   = Step(config, state, count, end, 40);
+
+        for (auto n = 0; n < 40; ++n)
+        {
+            const auto phase = projection.Transition(n);
+
+            ASSERT_EQ(phase.state, expected[n].state)                   << i << " " << n;
+            ASSERT_EQ(phase.workShiftCount, expected[n].workShiftCount) << i << " " << n;
+            ASSERT_EQ(phase.start, expected[n].start)                   << i << " " << n;
+
+            // Any time inside the phase finds it.
+            ASSERT_EQ(projection.PhaseAt(phase.start).start, phase.start) << i << " " << n;
+            ASSERT_EQ(projection.TransitionsUntil(phase.start), uint64_t(n + 1)) << i << " " << n;
+        }
+    }
+}
+
+TEST(ScheduleProjection, NextLongBreakAndPausedEngine)
+{
+    auto engine = PomodoroEngine();
+    engine.Handle(PomodoroEvent::Start);
+    engine.Handle(PomodoroEvent::Timeout);
+    engine.Handle(PomodoroEvent::Timeout);
+
+    // Work shift 2 paused with 10 minutes left, at 9:00.
+    engine.Handle(PomodoroEvent::Pause);
+    const auto end        = Milliseconds(9h + 10min);
+    const auto projection = ScheduleProjection::From(engine, end);
+
+    // Short break, W3, short break, W4 (5 + 25 + 5 + 25 minutes), long break.
+    EXPECT_EQ(projection.Transition(0).state, ImpulseState::ShortBreak);
+    EXPECT_EQ(projection.NextLongBreak(), Milliseconds(9h + 10min + 60min));
+    EXPECT_EQ(projection.Transition(4).state, ImpulseState::LongBreak);
+
+    // Cycle later, a million transitions away, still O(1).
+    const auto far = projection.Transition(1000000);
+    EXPECT_EQ(far.start - projection.Transition(999992).start, Milliseconds((4 * 25 + 3 * 5 + 15) * 60 * 1000));
+}
+
+TEST(ScheduleProjection, SessionHostProjectsEverySession)
+{
+    auto random = Random();
+    auto host   = SessionHost();
+    auto now    = 0ms;
+
+    for (auto i = 0; i < 300; ++i)
+    {
+        const auto id = host.Add(RandomConfig(random));
+        if (i % 7 != 0)
+        {
+            host.Start(id, Milliseconds(random.Next(100000)));
+        }
+    }
+
+    // Get sessions into every phase, pause some of them.
+    for (auto step = 0; step < 50; ++step)
+    {
+        now += Milliseconds(random.Next(600000));
+        host.Advance(now);
+
+        const auto id = random.Next(host.Size());
+        if (!host.Pause(id, now))
+        {
+            host.Resume(id, now);
+        }
+    }
+
+    auto out = std::vector<Milliseconds>();
+    for (auto n : { 0u, 1u, 2u, 7u, 17u, 1000u, 1000000007u })
+    {
+        host.ProjectTransitions(n, now, out);
+        ASSERT_EQ(out.size(), host.Size());
+
+        for (auto id = SessionId(0); id < host.Size(); ++id)
+        {
+            const auto state = host.State(id);
+            if (state == ImpulseState::Inactive)
+            {
+                EXPECT_EQ(out[id], Milliseconds::max());
+                continue;
+            }
+
+            const auto paused = state == ImpulseState::Paused;
+            const auto end    = paused ? now + host.Remaining(id, now) : host.Deadline(id);
+            const auto phase  = paused ? host.PreviousState(id) : state;
+
+            const auto projection = ScheduleProjection(host.Config(id), phase, host.WorkShiftCount(id), end);
+
+            ASSERT_EQ(out[id], projection.Transition(n).start) << id << " " << n;
+        }
+    }
+}
+
+TEST(ScheduleProjection, SessionHostFollowsProjection)
+{
+    auto host = SessionHost();
+    auto config = PomodoroConfig();
+    config.workDuration       = 60;
+    config.shortBreakDuration = 20;
+    config.longBreakDuration  = 45;
+    config.longBreakAfter     = 3;
+
+    const auto id = host.Add(config);
+    host.Start(id, 0ms);
+
+    // Pause already taken moves the whole schedule.
+    host.Pause(id, 30s);
+    host.Resume(id, 100s);
+    host.Advance(100s);
+
+    auto projected = std::vector<Milliseconds>();
+    auto out       = std::vector<Milliseconds>();
+    for (auto n = 0u; n < 20; ++n)
+    {
+        host.ProjectTransitions(n, 100s, out);
+        projected.push_back(out[id]);
+    }
+
+    auto actual = std::vector<Milliseconds>();
+    host.OnTransitions = [&](const std::vector<SessionTransition>& batch)
+    {
+        for (const auto& transition : batch)
+        {
+            actual.push_back(transition.at);
+        }
+    };
+
+    host.Advance(projected.back());
+
+    EXPECT_EQ(actual, projected);
+    EXPECT_EQ(projected.front(), 130s);
+}
@@ -0,0 +1,207 @@
+#include "SessionHost.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto Config (uint32_t work, uint32_t shortBreak, uint32_t longBreak, uint32_t longBreakAfter) -> PomodoroConfig
+{
+    auto config = PomodoroConfig();
+    config.workDuration       = work;
+    config.shortBreakDuration = shortBreak;
+    config.longBreakDuration  = longBreak;
+    config.longBreakAfter     = longBreakAfter;
+    return config;
+}
+
+}
+
+TEST(SessionHost, PlaysSameScheduleAsPomodoroEngine)
+{
+    auto host = SessionHost();
+
+    const PomodoroConfig configs[] = {
+        Config(25 * 60, 5 * 60, 15 * 60, 4),
+        Config(50 * 60, 10 * 60, 30 * 60, 2),
+        Config(60, 30, 90, 1),
+    };
+
+    auto engines = std::vector<PomodoroEngine>();
+    for (const auto& config : configs)
+    {
+        const auto id = host.Add(config);
+        host.Start(id, 0ms);
+
+        engines.emplace_back(config);
+        engines.back().Handle(PomodoroEvent::Start);
+    }
+
+    // Each timeout of the host must be the one engine makes next.
+    host.OnTransitions = [&](const std::vector<SessionTransition>& batch)
+    {
+        for (const auto& transition : batch)
+        {
+            auto& engine = engines[transition.session];
+            if (transition.from == ImpulseState::Inactive)
+            {
+                continue;
+            }
+
+            ASSERT_EQ(transition.from, engine.State());
+            engine.Handle(PomodoroEvent::Timeout);
+            EXPECT_EQ(transition.to, engine.State());
+            EXPECT_EQ(host.WorkShiftCount(transition.session), engine.WorkShiftCount());
+        }
+    };
+
+    for (auto now = 0ms; now < 24h; now += 1min)
+    {
+        host.Advance(now);
+    }
+
+    for (auto id = SessionId(0); id < host.Size(); ++id)
+    {
+        EXPECT_EQ(host.State(id), engines[id].State());
+        EXPECT_GT(engines[id].Transitions(), 10u);
+    }
+}
+
+TEST(SessionHost, BatchesTransitionsOfOneWake)
+{
+    auto host = SessionHost();
+    host.Reserve(1000);
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        host.Start(host.Add(Config(60, 30, 60, 4)), 0ms);
+    }
+
+    auto batches = std::vector<size_t>();
+    host.OnTransitions = [&](const std::vector<SessionTransition>& batch)
+    {
+        batches.push_back(batch.size());
+    };
+
+    // Starts are reported with the first wake.
+    EXPECT_EQ(host.Advance(0ms), 1000u);
+    EXPECT_EQ(host.NextDeadline(), 60s);
+
+    EXPECT_EQ(host.Advance(59s), 0u);
+    EXPECT_EQ(host.Advance(60s), 1000u);
+
+    EXPECT_EQ(batches, (std::vector<size_t>{ 1000, 1000 }));
+    EXPECT_EQ(host.Wakes(), 2u);
+    EXPECT_EQ(host.Transitions(), 2000u);
+}
+
+TEST(SessionHost, LateWakeGoesThroughMissedPhases)
+{
+    auto host = SessionHost();
+    const auto id = host.Add(Config(60, 30, 90, 2));
+    host.Start(id, 0ms);
+    host.Advance(0ms);
+
+    auto transitions = std::vector<SessionTransition>();
+    host.OnTransitions = [&](const std::vector<SessionTransition>& batch)
+    {
+        transitions = batch;
+    };
+
+    // W 60, S 30, W 60, L 90: all four deadlines passed.
+    EXPECT_EQ(host.Advance(245s), 4u);
+    ASSERT_EQ(transitions.size(), 4u);
+
+    EXPECT_EQ(transitions[0].at, 60s);
+    EXPECT_EQ(transitions[1].at, 90s);
+    EXPECT_EQ(transitions[2].at, 150s);
+    EXPECT_EQ(transitions[3].at, 240s);
+    EXPECT_EQ(transitions[2].to, ImpulseState::LongBreak);
+
+    // Schedule is kept, late wake doesn't stretch it.
+    EXPECT_EQ(host.State(id), ImpulseState::WorkShift);
+    EXPECT_EQ(host.Deadline(id), 300s);
+}
+
+TEST(SessionHost, PauseKeepsRemainingTime)
+{
+    auto host = SessionHost();
+    const auto id = host.Add(Config(60, 30, 90, 4));
+    host.Start(id, 0ms);
+
+    EXPECT_TRUE(host.Pause(id, 20s));
+    EXPECT_FALSE(host.Pause(id, 21s));
+    EXPECT_EQ(host.Remaining(id, 100s), 40s);
+    EXPECT_EQ(host.NextDeadline(), decltype(host.NextDeadline())::max());
+
+    // Nothing fires while paused.
+    EXPECT_EQ(host.Advance(100s), 2u);
+    EXPECT_EQ(host.Advance(500s), 0u);
+
+    EXPECT_TRUE(host.Resume(id, 500s));
+    EXPECT_EQ(host.State(id), ImpulseState::WorkShift);
+    EXPECT_EQ(host.Deadline(id), 540s);
+
+    host.Advance(540s);
+    EXPECT_EQ(host.State(id), ImpulseState::ShortBreak);
+}
+
+TEST(SessionHost, StopDropsDeadline)
+{
+    auto host = SessionHost();
+    const auto a = host.Add(Config(60, 30, 90, 4));
+    const auto b = host.Add(Config(120, 30, 90, 4));
+
+    host.Start(a, 0ms);
+    host.Start(b, 0ms);
+    host.Advance(60s);
+    ASSERT_EQ(host.WorkShiftCount(a), 1u);
+
+    EXPECT_TRUE(host.Stop(a, 61s));
+    EXPECT_FALSE(host.Stop(a, 62s));
+    EXPECT_EQ(host.State(a), ImpulseState::Inactive);
+    EXPECT_EQ(host.NextDeadline(), 120s);
+
+    // Restarted session gets a fresh deadline, old one (90 s) is skipped.
+    // Batch has stop, start and both timeouts of b (120 s, 150 s).
+    host.Start(a, 100s);
+    EXPECT_EQ(host.Advance(150s), 4u);
+    EXPECT_EQ(host.State(a), ImpulseState::WorkShift);
+    EXPECT_EQ(host.State(b), ImpulseState::WorkShift);
+    EXPECT_EQ(host.NextDeadline(), 160s);
+}
+
+TEST(SessionHost, ConfigureKeepsLongBreakReachable)
+{
+    auto host = SessionHost();
+    const auto id = host.Add(Config(60, 30, 90, 4));
+    host.Start(id, 0ms);
+    host.Advance(90s);
+    ASSERT_EQ(host.WorkShiftCount(id), 2u);
+
+    host.Configure(id, Config(60, 30, 90, 1));
+    EXPECT_EQ(host.WorkShiftCount(id), 1u);
+    EXPECT_EQ(host.Config(id).longBreakAfter, 1u);
+
+    host.Advance(150s);
+    EXPECT_EQ(host.State(id), ImpulseState::LongBreak);
+}
+
+TEST(SessionHost, ManySessionsStaySmall)
+{
+    auto host = SessionHost();
+    host.Reserve(10000);
+
+    for (auto i = 0; i < 10000; ++i)
+    {
+        host.Start(host.Add(PomodoroConfig()), std::chrono::milliseconds(i));
+    }
+    host.Advance(0ms);
+
+    // Session arrays, one heap entry and one batch slot each.
+    EXPECT_LE(host.MemoryUsage() / host.Size(), 128u);
+}
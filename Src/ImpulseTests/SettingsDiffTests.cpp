@@ -0,0 +1,103 @@
+#include "SettingsDiff.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+auto CreateStore (std::initializer_list<const wchar_t*> names) -> TaskStore
+{
+    auto store = TaskStore();
+    for (const auto name : names)
+    {
+        store.Add(name);
+    }
+
+    return store;
+}
+
+// Diff of @loaded against default settings and same tasks.
+auto DiffOf (const Settings& loaded) -> SettingsDiff
+{
+    const auto tasks = CreateStore({ L"A", L"B" });
+    return DiffSettings(Settings(), tasks, loaded, tasks);
+}
+
+}
+
+TEST(SettingsDiff, SameSettingsAreEmpty)
+{
+    const auto tasks = CreateStore({ L"A", L"B" });
+    const auto same  = CreateStore({ L"A", L"B" });
+
+    EXPECT_TRUE(DiffSettings(Settings(), tasks, Settings(), same).Empty());
+    EXPECT_TRUE(DiffSettings(Settings(), TaskStore(), Settings(), TaskStore()).Empty());
+}
+
+TEST(SettingsDiff, EveryDurationFieldCountsAsDurations)
+{
+    auto loaded = Settings();
+
+    loaded.WorkDuration += 1;
+    EXPECT_TRUE(DiffOf(loaded).durations);
+
+    loaded = Settings();
+    loaded.ShortBreakDuration += 1;
+    EXPECT_TRUE(DiffOf(loaded).durations);
+
+    loaded = Settings();
+    loaded.LongBreakDuration += 1;
+    EXPECT_TRUE(DiffOf(loaded).durations);
+
+    loaded = Settings();
+    loaded.LongBreakAfter += 1;
+
+    const auto diff = DiffOf(loaded);
+    EXPECT_TRUE(diff.durations);
+    EXPECT_FALSE(diff.autoStartTimer);
+    EXPECT_FALSE(diff.taskName);
+    EXPECT_FALSE(diff.tasks);
+    EXPECT_FALSE(diff.windowPosition);
+}
+
+TEST(SettingsDiff, OtherFieldsOnlyMarkTheirGroup)
+{
+    auto loaded = Settings();
+    loaded.AutoStartTimer = !loaded.AutoStartTimer;
+
+    auto diff = DiffOf(loaded);
+    EXPECT_TRUE(diff.autoStartTimer);
+    EXPECT_FALSE(diff.durations || diff.taskName || diff.tasks || diff.windowPosition);
+
+    loaded = Settings();
+    loaded.TaskName = L"Write report";
+
+    diff = DiffOf(loaded);
+    EXPECT_TRUE(diff.taskName);
+    EXPECT_FALSE(diff.durations || diff.autoStartTimer || diff.tasks || diff.windowPosition);
+
+    loaded = Settings();
+    loaded.WindowPosition = WindowPosition::RightTop;
+
+    diff = DiffOf(loaded);
+    EXPECT_TRUE(diff.windowPosition);
+    EXPECT_FALSE(diff.durations || diff.autoStartTimer || diff.taskName || diff.tasks);
+}
+
+TEST(SettingsDiff, TasksDifferInSizeOrContent)
+{
+    const auto current = CreateStore({ L"A", L"B" });
+
+    EXPECT_TRUE(DiffSettings(Settings(), current, Settings(), CreateStore({ L"A" })).tasks);
+    EXPECT_TRUE(DiffSettings(Settings(), current, Settings(), CreateStore({ L"A", L"B", L"C" })).tasks);
+    EXPECT_TRUE(DiffSettings(Settings(), current, Settings(), CreateStore({ L"A", L"b" })).tasks);
+    EXPECT_TRUE(DiffSettings(Settings(), current, Settings(), CreateStore({ L"B", L"A" })).tasks);
+    EXPECT_TRUE(DiffSettings(Settings(), current, Settings(), TaskStore()).tasks);
+
+    const auto diff = DiffSettings(Settings(), current, Settings(), CreateStore({ L"A", L"C" }));
+    EXPECT_TRUE(diff.tasks);
+    EXPECT_FALSE(diff.durations || diff.autoStartTimer || diff.taskName || diff.windowPosition);
+}
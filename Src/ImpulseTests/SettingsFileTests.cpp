@@ -0,0 +1,245 @@
+#include "SettingsFile.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+struct Read
+{
+    Settings           settings;
+    TaskStore          tasks;
+    SettingsReadResult result;
+};
+
+auto ReadJson (std::string_view json) -> Read
+{
+    auto read = Read();
+    read.result = ReadSettings(json, read.settings, read.tasks);
+    return read;
+}
+
+// Settings file whose @field holds @value, LongBreakAfter is there to see
+// fields after a rejected one are still read.
+auto WithField (std::string_view field, std::string_view value) -> std::string
+{
+    return "{ \"Version\": 1, \"" + std::string(field) + "\": " + std::string(value) + ", \"LongBreakAfter\": 7 }";
+}
+
+}
+
+TEST(SettingsFile, WrittenSettingsReadBack)
+{
+    auto settings = Settings();
+    settings.WorkDuration       = 1500;
+    settings.ShortBreakDuration = 300;
+    settings.LongBreakDuration  = 900;
+    settings.LongBreakAfter     = 3;
+    settings.AutoStartTimer     = false;
+    settings.TaskName           = L"Write report é中";
+    settings.WindowPosition     = WindowPosition::CenterBottom;
+
+    auto tasks = TaskStore();
+    tasks.Add(L"Write report é中");
+    tasks.Add(L"Call \"Bob\"");
+
+    const auto read = ReadJson(WriteSettings(settings, tasks));
+    ASSERT_TRUE(read.result.valid);
+    EXPECT_EQ(read.result.version, SETTINGS_VERSION);
+    EXPECT_EQ(read.result.rejected, 0u);
+
+    EXPECT_EQ(read.settings.WorkDuration, 1500u);
+    EXPECT_EQ(read.settings.ShortBreakDuration, 300u);
+    EXPECT_EQ(read.settings.LongBreakDuration, 900u);
+    EXPECT_EQ(read.settings.LongBreakAfter, 3u);
+    EXPECT_FALSE(read.settings.AutoStartTimer);
+    EXPECT_EQ(read.settings.TaskName, settings.TaskName);
+    EXPECT_EQ(read.settings.WindowPosition, WindowPosition::CenterBottom);
+
+    ASSERT_EQ(read.tasks.Size(), 2u);
+    EXPECT_EQ(read.tasks.Get(0), tasks.Get(0));
+    EXPECT_EQ(read.tasks.Get(1), tasks.Get(1));
+}
+
+TEST(SettingsFile, DefaultSettingsReadBackWithoutRejects)
+{
+    // No current task is an empty string.
+    const auto read = ReadJson(WriteSettings(Settings(), TaskStore()));
+    ASSERT_TRUE(read.result.valid);
+    EXPECT_EQ(read.result.rejected, 0u);
+    EXPECT_EQ(read.settings.TaskName, L"");
+    EXPECT_EQ(read.tasks.Size(), 0u);
+}
+
+TEST(SettingsFile, EveryWindowPositionRoundTripsByName)
+{
+    for (auto i = 0; i <= static_cast<int>(WindowPosition::RightBottom); ++i)
+    {
+        auto settings = Settings();
+        settings.WindowPosition = static_cast<WindowPosition>(i);
+
+        const auto read = ReadJson(WriteSettings(settings, TaskStore()));
+        ASSERT_TRUE(read.result.valid) << i;
+        EXPECT_EQ(read.result.rejected, 0u) << i;
+        EXPECT_EQ(read.settings.WindowPosition, settings.WindowPosition) << i;
+    }
+
+    const auto named = ReadJson(WithField("WindowPosition", "\"RightTop\""));
+    EXPECT_EQ(named.settings.WindowPosition, WindowPosition::RightTop);
+
+    // Names are case sensitive, unknown one keeps default.
+    const auto unknown = ReadJson(WithField("WindowPosition", "\"righttop\""));
+    EXPECT_EQ(unknown.result.rejected, 1u);
+    EXPECT_EQ(unknown.settings.WindowPosition, WindowPosition::Auto);
+}
+
+TEST(SettingsFile, BadDurationKeepsDefaultAndRestIsRead)
+{
+    const auto defaults = Settings();
+
+    const char* values[] = {
+        "\"25\"",          // wrong type
+        "true",            // wrong type
+        "0",               // below range
+        "86401",           // above range, a day at most
+        "-5",              // negative
+        "25.5",            // float
+        "null",
+        "{ \"min\": 25 }", // nested object
+        "[ 25 ]",          // array
+    };
+
+    for (const auto value : values)
+    {
+        const auto read = ReadJson(WithField("WorkDuration", value));
+
+        ASSERT_TRUE(read.result.valid) << value;
+        EXPECT_EQ(read.result.rejected, 1u) << value;
+        EXPECT_EQ(read.settings.WorkDuration, defaults.WorkDuration) << value;
+        EXPECT_EQ(read.settings.LongBreakAfter, 7u) << value;
+    }
+
+    EXPECT_EQ(ReadJson(WithField("WorkDuration", "86400")).settings.WorkDuration, 86400u);
+    EXPECT_EQ(ReadJson(WithField("ShortBreakDuration", "0")).result.rejected, 1u);
+    EXPECT_EQ(ReadJson(WithField("LongBreakDuration", "-1")).result.rejected, 1u);
+}
+
+TEST(SettingsFile, BadValuesOfOtherFieldsAreRejected)
+{
+    const auto defaults = Settings();
+
+    // Zero disables long breaks, too many is a typo.
+    EXPECT_EQ(ReadJson("{ \"LongBreakAfter\": 0 }").settings.LongBreakAfter, 0u);
+    EXPECT_EQ(ReadJson("{ \"LongBreakAfter\": 1001 }").result.rejected, 1u);
+    EXPECT_EQ(ReadJson("{ \"LongBreakAfter\": 2.0 }").result.rejected, 1u);
+
+    for (const auto value : { "1", "\"true\"", "null", "[]", "{}" })
+    {
+        const auto read = ReadJson(WithField("AutoStartTimer", value));
+        EXPECT_EQ(read.result.rejected, 1u) << value;
+        EXPECT_EQ(read.settings.AutoStartTimer, defaults.AutoStartTimer) << value;
+        EXPECT_EQ(read.settings.LongBreakAfter, 7u) << value;
+    }
+
+    for (const auto value : { "42", "false", "null", "[\"a\"]", "{\"a\": 1}" })
+    {
+        EXPECT_EQ(ReadJson(WithField("TaskName", value)).result.rejected, 1u) << value;
+        EXPECT_EQ(ReadJson(WithField("WindowPosition", value)).result.rejected, 1u) << value;
+    }
+
+    for (const auto value : { "\"1\"", "false", "null", "-1", "1.5", "[1]" })
+    {
+        const auto read = ReadJson("{ \"Version\": " + std::string(value) + " }");
+        EXPECT_EQ(read.result.rejected, 1u) << value;
+        EXPECT_EQ(read.result.version, 0u) << value;
+    }
+
+    // Unknown fields are skipped whatever they hold.
+    const auto unknown = ReadJson("{ \"Theme\": { \"Dark\": [1, 2] }, \"Volume\": -1, \"WorkDuration\": 60 }");
+    EXPECT_TRUE(unknown.result.valid);
+    EXPECT_EQ(unknown.result.rejected, 0u);
+    EXPECT_EQ(unknown.settings.WorkDuration, 60u);
+}
+
+TEST(SettingsFile, VersionZeroIsMigrated)
+{
+    // Version 0 had neither "Version" nor "WindowPosition".
+    const auto read = ReadJson(R"({
+        "WorkDuration": 1500,
+        "ShortBreakDuration": 300,
+        "LongBreakDuration": 900,
+        "LongBreakAfter": 4,
+        "AutoStartTimer": false,
+        "TaskName": "Old task",
+        "Tasks": ["Old task"]
+    })");
+
+    ASSERT_TRUE(read.result.valid);
+    EXPECT_EQ(read.result.version, 0u);
+    EXPECT_EQ(read.result.rejected, 0u);
+    EXPECT_EQ(read.settings.WorkDuration, 1500u);
+    EXPECT_EQ(read.settings.TaskName, L"Old task");
+    EXPECT_EQ(read.settings.WindowPosition, WindowPosition::Auto);
+    EXPECT_EQ(read.tasks.Size(), 1u);
+}
+
+TEST(SettingsFile, NewerVersionReadsKnownFields)
+{
+    // Comments are allowed, file is edited by hand.
+    const auto read = ReadJson(R"({
+        // Written by a later release.
+        "Version": 7,
+        "WorkDuration": 1200,
+        "Sounds": { "Tick": true },
+        "WindowPosition": "LeftEdge"
+    })");
+
+    ASSERT_TRUE(read.result.valid);
+    EXPECT_EQ(read.result.version, 7u);
+    EXPECT_EQ(read.result.rejected, 0u);
+    EXPECT_EQ(read.settings.WorkDuration, 1200u);
+    EXPECT_EQ(read.settings.WindowPosition, WindowPosition::LeftEdge);
+}
+
+TEST(SettingsFile, TasksReplaceStoreAndSkipInvalidUTF8)
+{
+    auto settings = Settings();
+    auto tasks    = TaskStore();
+    tasks.Add(L"Stale");
+
+    // File without "Tasks" leaves store alone.
+    ASSERT_TRUE(ReadSettings("{ \"WorkDuration\": 60 }", settings, tasks).valid);
+    ASSERT_EQ(tasks.Size(), 1u);
+
+    // Second task has a lone continuation byte, last one is cut short.
+    const auto json   = std::string("{ \"Tasks\": [ \"First\", \"Bad \x80 byte\", 42, [\"nested\"], \"Last\", \"Cut \xE4\xB8\" ] }");
+    const auto result = ReadSettings(json, settings, tasks);
+
+    ASSERT_TRUE(result.valid);
+    ASSERT_EQ(tasks.Size(), 2u);
+    EXPECT_EQ(tasks.Get(0), L"First");
+    EXPECT_EQ(tasks.Get(1), L"Last");
+
+    // Invalid current task is rejected, not the whole file.
+    const auto name = ReadJson("{ \"TaskName\": \"Bad \xC0\xAF\", \"WorkDuration\": 60 }");
+    ASSERT_TRUE(name.result.valid);
+    EXPECT_EQ(name.result.rejected, 1u);
+    EXPECT_EQ(name.settings.TaskName, L"");
+    EXPECT_EQ(name.settings.WorkDuration, 60u);
+}
+
+TEST(SettingsFile, NonObjectOrBrokenJsonIsInvalid)
+{
+    for (const auto json : { "[ { \"WorkDuration\": 60 } ]", "\"settings\"", "42", "null", "" })
+    {
+        EXPECT_FALSE(ReadJson(json).result.valid) << json;
+    }
+
+    for (const auto json : { "{ \"WorkDuration\": 60", "{ \"WorkDuration\": }", "{ WorkDuration: 60 }", "{} {}" })
+    {
+        EXPECT_FALSE(ReadJson(json).result.valid) << json;
+    }
+}
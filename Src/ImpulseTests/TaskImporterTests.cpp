@@ -0,0 +1,87 @@
+#include "TaskImporter.hpp"
+#include "TempDirectory.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+TEST(TaskImporter, CsvUsesTaskColumnAndSkipsDuplicates)
+{
+    auto tasks = TaskStore();
+    tasks.Add(L"Existing");
+
+    const auto text = std::string(
+        "\xEF\xBB\xBFId,Title,Due\r\n"
+        "1,Write report,2024-01-01\r\n"
+        "2,\"Review, \"\"quoted\"\"\",\r\n"
+        "3,Existing,\r\n"
+        "4,Write report,\r\n"
+        "5,\"broken,\r\n"
+    );
+
+    const auto result = ImportTasks(text, TaskFormat::Csv, tasks);
+
+    EXPECT_EQ(result.lines, 5u);
+    EXPECT_EQ(result.added, 2u);
+    EXPECT_EQ(result.duplicates, 2u);
+    EXPECT_EQ(result.invalid, 1u);
+
+    ASSERT_EQ(tasks.Size(), 3u);
+    EXPECT_EQ(tasks.Get(1), L"Write report");
+    EXPECT_EQ(tasks.Get(2), L"Review, \"quoted\"");
+}
+
+TEST(TaskImporter, TodoTxtDropsPriorityDatesAndDoneTasks)
+{
+    auto tasks = TaskStore();
+
+    const auto result = ImportTasks("(A) 2024-01-01 Call Bob\nx 2024-01-02 Done already\nPlain task\n", TaskFormat::TodoTxt, tasks);
+
+    EXPECT_EQ(result.added, 2u);
+    ASSERT_EQ(tasks.Size(), 2u);
+    EXPECT_EQ(tasks.Get(0), L"Call Bob");
+    EXPECT_EQ(tasks.Get(1), L"Plain task");
+}
+
+TEST(TaskImporter, ImportRunsOnCopyAndAppendsAfterFirst)
+{
+    const auto dir = TempDirectory();
+    WriteFile(dir.path / "Tasks.txt", "Existing\nNew one\nNew two\n");
+
+    auto store = TaskStore();
+    store.Add(L"Existing");
+
+    const auto tasks = std::make_shared<const TaskStore>(std::move(store));
+
+    auto done = std::atomic<bool>(false);
+
+    auto desc   = TaskImport::Desc();
+    desc.paths  = { dir.path / "Tasks.csv", dir.path / "Tasks.txt" };
+    desc.tasks  = tasks;
+    desc.onDone = [&] { done = true; };
+
+    const auto job = TaskImport::Start(std::move(desc));
+    job->Wait();
+
+    EXPECT_TRUE(done.load());
+    EXPECT_EQ(job->First(), 1u);
+    EXPECT_EQ(job->Source(), tasks);
+    EXPECT_EQ(job->Added(), 2u);
+
+    ASSERT_EQ(job->Tasks().Size(), 3u);
+    EXPECT_EQ(job->Tasks().Get(1), L"New one");
+    EXPECT_EQ(job->Tasks().Get(2), L"New two");
+
+    // Caller's store is untouched, result is moved out to replace it.
+    EXPECT_EQ(tasks->Size(), 1u);
+
+    const auto result = job->Take();
+    ASSERT_EQ(result.Size(), 3u);
+    EXPECT_EQ(result.Get(0), L"Existing");
+    EXPECT_EQ(result.Get(2), L"New two");
+    EXPECT_EQ(job->Tasks().Size(), 0u);
+}
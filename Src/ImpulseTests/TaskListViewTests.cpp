@@ -0,0 +1,171 @@
+#include "TaskListView.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+auto CreateStore (uint32_t tasks) -> TaskStore
+{
+    auto store = TaskStore();
+    for (auto i = uint32_t(0); i < tasks; ++i)
+    {
+        store.Add(L"Task " + std::to_wstring(i));
+    }
+
+    return store;
+}
+
+// Slot contents as the widget keeps them.
+struct Rows
+{
+    std::vector<uint32_t> slots;
+    int                   laidOut = 0;
+
+    auto Prepare (TaskListView& view) -> void
+    {
+        const auto [first, last] = view.VisibleRange();
+        view.PrepareRows(first, last, [&](size_t slot, uint32_t task)
+        {
+            slots.resize(view.Slots(), TaskListView::NO_TASK);
+            slots[slot] = task;
+            laidOut    += 1;
+        });
+    }
+};
+
+}
+
+TEST(TaskListView, ShowsOnlyRowsInView)
+{
+    auto store = CreateStore(100000);
+    auto view  = TaskListView();
+    view.Store(&store);
+    view.Size(200.0f, 100.0f);
+    view.RowHeight(20.0f);
+
+    EXPECT_EQ(view.VisibleRange(), std::make_pair(0u, 5u));
+    EXPECT_EQ(view.MaxScroll(), 100000 * 20.0f - 100.0f);
+
+    // Half a row down, six rows are partially visible.
+    view.Scroll(-1.0f / 6.0f);
+    EXPECT_EQ(view.ScrollOffset(), 10.0f);
+    EXPECT_EQ(view.VisibleRange(), std::make_pair(0u, 6u));
+    EXPECT_EQ(view.TaskAt(5.0f), 0u);
+    EXPECT_EQ(view.TaskAt(15.0f), 1u);
+    EXPECT_EQ(view.TaskAt(101.0f), TaskListView::NO_TASK);
+    EXPECT_EQ(view.RowTop(1), 10.0f);
+}
+
+TEST(TaskListView, ScrollingLaysOutOnlyNewRows)
+{
+    auto store = CreateStore(100000);
+    auto view  = TaskListView();
+    view.Store(&store);
+    view.Size(200.0f, 100.0f);
+    view.RowHeight(20.0f);
+
+    auto rows = Rows();
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 5);
+
+    // Same frame again reuses everything.
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 5);
+
+    // One notch is three rows.
+    view.Scroll(-1.0f);
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 8);
+
+    const auto [first, last] = view.VisibleRange();
+    for (auto task = first; task < last; ++task)
+    {
+        EXPECT_EQ(rows.slots[view.Slot(task)], task);
+    }
+
+    // Jump far away, only a screen full of rows is laid out.
+    view.ScrollTo(90000);
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 8 + 5);
+    EXPECT_EQ(view.RowsLaidOut(), 13u);
+}
+
+TEST(TaskListView, ClampsScrollAtEnds)
+{
+    auto store = CreateStore(10);
+    auto view  = TaskListView();
+    view.Store(&store);
+    view.Size(200.0f, 100.0f);
+    view.RowHeight(20.0f);
+
+    EXPECT_FALSE(view.Scroll(1.0f));
+    EXPECT_TRUE(view.Scroll(-10.0f));
+    EXPECT_EQ(view.ScrollOffset(), 100.0f);
+    EXPECT_FALSE(view.Scroll(-1.0f));
+
+    // Taller list can't be scrolled as far.
+    view.Size(200.0f, 150.0f);
+    EXPECT_EQ(view.ScrollOffset(), 50.0f);
+    EXPECT_EQ(view.VisibleRange(), std::make_pair(2u, 10u));
+}
+
+TEST(TaskListView, StoreChangeAndWidthRebuildRows)
+{
+    auto store = CreateStore(100);
+    auto view  = TaskListView();
+    view.Store(&store);
+    view.Size(200.0f, 100.0f);
+    view.RowHeight(20.0f);
+
+    auto rows = Rows();
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 5);
+
+    // Appending doesn't change visible rows.
+    store.Add(L"New task");
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 5);
+
+    store.Clear();
+    for (auto i = 0; i < 10; ++i)
+    {
+        store.Add(L"Imported");
+    }
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 10);
+
+    view.Size(300.0f, 100.0f);
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 15);
+
+    // Other height needs other number of slots, visible rows are laid out again.
+    view.Size(300.0f, 60.0f);
+    rows.Prepare(view);
+    EXPECT_EQ(rows.laidOut, 18);
+}
+
+TEST(TaskListView, ShorterStoreClampsScrollAndPointer)
+{
+    auto store = CreateStore(100);
+    auto view  = TaskListView();
+    view.Store(&store);
+    view.Size(200.0f, 100.0f);
+    view.RowHeight(20.0f);
+
+    view.ScrollTo(99);
+    EXPECT_EQ(view.TaskAt(90.0f), 99u);
+
+    // Reloaded settings came with a much shorter list.
+    const auto reloaded = CreateStore(3);
+
+    view.Store(&reloaded);
+    EXPECT_EQ(view.ScrollOffset(), 0.0f);
+    EXPECT_EQ(view.VisibleRange(), std::make_pair(0u, 3u));
+    EXPECT_EQ(view.TaskAt(90.0f), TaskListView::NO_TASK);
+    EXPECT_EQ(view.TaskAt(50.0f), 2u);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+// Fresh directory named after current test, removed afterwards.
+struct TempDirectory
+{
+    std::filesystem::path path;
+
+    TempDirectory ()
+    {
+        const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+        path = std::filesystem::temp_directory_path() / (std::string("ImpulseTests-") + test->test_suite_name() + "-" + test->name());
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+
+    ~TempDirectory ()
+    {
+        auto error = std::error_code();
+        std::filesystem::remove_all(path, error);
+    }
+};
+
+inline auto ReadFile (const std::filesystem::path& path) -> std::string
+{
+    auto file   = std::ifstream(path, std::ios::binary);
+    auto stream = std::ostringstream();
+    stream << file.rdbuf();
+    return stream.str();
+}
+
+inline auto WriteFile (const std::filesystem::path& path, std::string_view data) -> void
+{
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
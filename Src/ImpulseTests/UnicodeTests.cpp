@@ -0,0 +1,33 @@
+#include "Unicode.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+TEST(Unicode, RoundTripsAllPlanes)
+{
+    // ASCII, Latin, CJK and emoji outside basic plane.
+    const auto utf8 = std::string("Task \xC3\xA9t\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x8D\x85");
+
+    const auto wide = UTF8ToUTF16(utf8);
+    ASSERT_TRUE(wide);
+    EXPECT_EQ(wide->substr(0, 5), L"Task ");
+
+    const auto back = UTF16ToUTF8(*wide);
+    ASSERT_TRUE(back);
+    EXPECT_EQ(*back, utf8);
+}
+
+TEST(Unicode, InvalidSequencesBecomeReplacement)
+{
+    // Lone continuation, overlong '/', truncated sequence at the end.
+    const auto wide = UTF8ToUTF16("a\x80" "b\xC0\xAF" "c\xE6\x97");
+    ASSERT_TRUE(wide);
+    EXPECT_EQ(*wide, L"a\xFFFD" L"b\xFFFD\xFFFD" L"c\xFFFD\xFFFD");
+}
+
+TEST(Unicode, EmptyIsNullopt)
+{
+    EXPECT_FALSE(UTF8ToUTF16(""));
+    EXPECT_FALSE(UTF16ToUTF8(L""));
+}
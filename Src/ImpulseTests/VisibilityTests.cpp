@@ -0,0 +1,193 @@
+#include "Visibility.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+// Stands in for DXGI and window messages. Window content is occluded while
+// `occluded` is set, Present() reports it like DXGI_STATUS_OCCLUDED does.
+struct FakePlatform
+{
+    bool                 occluded = false;
+    bool                 canWatch = true;
+    bool                 watching = false;
+    int                  catchUps = 0;
+    std::vector<bool>    changes;
+
+    int                  redraws  = 0;
+    int                  presents = 0;
+
+    VisibilityController visibility;
+
+    FakePlatform ()
+    {
+        auto desc             = VisibilityController::Desc();
+        desc.watchOcclusion   = [this] { watching = canWatch; return canWatch; };
+        desc.unwatchOcclusion = [this] { watching = false; };
+        desc.stillOccluded    = [this] { return occluded; };
+        desc.catchUp          = [this] { catchUps += 1; redraws += 1; };
+        desc.changed          = [this] (bool visible) { changes.push_back(visible); };
+
+        visibility = VisibilityController(desc);
+    }
+
+    // One loop iteration, same order as D2DApp::Draw().
+    auto Frame () -> void
+    {
+        if (!visibility.IsVisible() || redraws == 0)
+        {
+            redraws = 0;
+            return;
+        }
+
+        redraws   = 0;
+        presents += 1;
+        visibility.Presented(occluded);
+    }
+
+    // Occlusion notification arrives only while it's registered.
+    auto OcclusionChanged (bool value) -> void
+    {
+        occluded = value;
+        if (watching)
+        {
+            visibility.OcclusionStatus();
+        }
+    }
+};
+
+}
+
+TEST(Visibility, MinimizeStopsPresentingUntilRestored)
+{
+    auto platform = FakePlatform();
+
+    platform.visibility.Minimized(true);
+    EXPECT_EQ(platform.visibility.State(), Visibility::Minimized);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        platform.redraws += 1;
+        platform.Frame();
+    }
+
+    EXPECT_EQ(platform.presents, 0);
+
+    platform.visibility.Minimized(false);
+    EXPECT_EQ(platform.catchUps, 1);
+
+    platform.Frame();
+    platform.Frame();
+
+    EXPECT_EQ(platform.presents, 1);
+    EXPECT_EQ(platform.changes, (std::vector<bool>{ false, true }));
+}
+
+TEST(Visibility, OccludedPresentWaitsForStatusNotification)
+{
+    auto platform = FakePlatform();
+
+    platform.occluded = true;
+    platform.redraws  = 1;
+    platform.Frame();
+
+    EXPECT_EQ(platform.visibility.State(), Visibility::Occluded);
+    EXPECT_TRUE(platform.watching);
+
+    platform.redraws = 1;
+    platform.Frame();
+    EXPECT_EQ(platform.presents, 1);
+
+    // Notification while still covered (e.g. other window moved) changes nothing.
+    platform.OcclusionChanged(true);
+    EXPECT_FALSE(platform.visibility.IsVisible());
+    EXPECT_TRUE(platform.watching);
+    EXPECT_EQ(platform.catchUps, 0);
+
+    platform.OcclusionChanged(false);
+    EXPECT_TRUE(platform.visibility.IsVisible());
+    EXPECT_FALSE(platform.watching);
+    EXPECT_EQ(platform.catchUps, 1);
+
+    platform.Frame();
+    EXPECT_EQ(platform.presents, 2);
+}
+
+TEST(Visibility, KeepsPresentingWhenOcclusionCantBeWatched)
+{
+    auto platform = FakePlatform();
+    platform.canWatch = false;
+    platform.occluded = true;
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        platform.redraws = 1;
+        platform.Frame();
+    }
+
+    // Without the notification there would be no way back.
+    EXPECT_TRUE(platform.visibility.IsVisible());
+    EXPECT_EQ(platform.presents, 3);
+    EXPECT_TRUE(platform.changes.empty());
+}
+
+TEST(Visibility, OverlappingConditionsReportMostRestrictive)
+{
+    auto platform = FakePlatform();
+
+    platform.visibility.Minimized(true);
+    platform.visibility.SessionLocked(true);
+    EXPECT_EQ(platform.visibility.State(), Visibility::SessionLocked);
+
+    // Still minimized, nothing to catch up yet.
+    platform.visibility.SessionLocked(false);
+    EXPECT_EQ(platform.visibility.State(), Visibility::Minimized);
+    EXPECT_EQ(platform.catchUps, 0);
+
+    platform.visibility.Minimized(false);
+    EXPECT_EQ(platform.visibility.State(), Visibility::Visible);
+    EXPECT_EQ(platform.catchUps, 1);
+    EXPECT_EQ(platform.changes, (std::vector<bool>{ false, true }));
+}
+
+TEST(Visibility, ReleasedSwapChainDropsOcclusion)
+{
+    auto platform = FakePlatform();
+
+    platform.occluded = true;
+    platform.redraws  = 1;
+    platform.Frame();
+    ASSERT_EQ(platform.visibility.State(), Visibility::Occluded);
+
+    // New swap chain reports occlusion again on first present.
+    platform.visibility.SwapChainReleased();
+    EXPECT_TRUE(platform.visibility.IsVisible());
+    EXPECT_FALSE(platform.watching);
+    EXPECT_EQ(platform.catchUps, 1);
+
+    platform.Frame();
+    EXPECT_EQ(platform.visibility.State(), Visibility::Occluded);
+    EXPECT_TRUE(platform.watching);
+}
+
+TEST(Visibility, RepeatedEventsDontRequestFrames)
+{
+    auto platform = FakePlatform();
+
+    platform.visibility.Minimized(false);
+    platform.visibility.SessionLocked(false);
+    platform.visibility.OcclusionStatus();
+    platform.visibility.SwapChainReleased();
+
+    platform.visibility.SessionLocked(true);
+    platform.visibility.SessionLocked(true);
+    platform.visibility.SessionLocked(false);
+    platform.visibility.SessionLocked(false);
+
+    EXPECT_EQ(platform.catchUps, 1);
+    EXPECT_EQ(platform.changes, (std::vector<bool>{ false, true }));
+}
@@ -0,0 +1,198 @@
+#include "WindowPlacement.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Impulse;
+
+namespace {
+
+// 1920x1080 primary monitor with taskbar 40 px high or 60 px wide.
+auto Geometry (TaskbarEdge edge) -> DisplayGeometry
+{
+    auto geometry = DisplayGeometry();
+    geometry.valid       = true;
+    geometry.monitor     = DisplayRect{ 0, 0, 1920, 1080 };
+    geometry.taskbarEdge = edge;
+
+    switch (edge)
+    {
+    case TaskbarEdge::Left:   geometry.taskbar = DisplayRect{ 0, 0, 60, 1080 };       break;
+    case TaskbarEdge::Top:    geometry.taskbar = DisplayRect{ 0, 0, 1920, 40 };       break;
+    case TaskbarEdge::Right:  geometry.taskbar = DisplayRect{ 1860, 0, 1920, 1080 };  break;
+    case TaskbarEdge::Bottom: geometry.taskbar = DisplayRect{ 0, 1040, 1920, 1080 };  break;
+    case TaskbarEdge::None:   break;
+    }
+
+    return geometry;
+}
+
+// Same size and padding ImpulseApp uses.
+auto Place (DisplayInfo& display, WindowPosition position, float dpi = 96.f) -> WindowPlacement
+{
+    return CalculateWindowPlacement(position, display.Geometry(), 450.f, 330.f, 20.f, dpi);
+}
+
+struct Expected
+{
+    WindowPosition position;
+    long           x;
+    long           y;
+};
+
+}
+
+TEST(WindowPlacement, AllPositionsWithBottomTaskbar)
+{
+    auto display = FakeDisplayInfo(Geometry(TaskbarEdge::Bottom));
+
+    const Expected expected[] = {
+        { WindowPosition::Auto,         1450, 690 },
+        { WindowPosition::LeftTop,        20,  20 },
+        { WindowPosition::LeftEdge,       20, 375 },
+        { WindowPosition::LeftBottom,     20, 690 },
+        { WindowPosition::CenterTop,     735,  20 },
+        { WindowPosition::Center,        735, 375 },
+        { WindowPosition::CenterBottom,  735, 690 },
+        { WindowPosition::RightTop,     1450,  20 },
+        { WindowPosition::RightEdge,    1450, 375 },
+        { WindowPosition::RightBottom,  1450, 690 },
+    };
+
+    for (const auto& e : expected)
+    {
+        const auto placement = Place(display, e.position);
+
+        EXPECT_EQ(placement.x, e.x)          << static_cast<int>(e.position);
+        EXPECT_EQ(placement.y, e.y)          << static_cast<int>(e.position);
+        EXPECT_EQ(placement.width, 450u)     << static_cast<int>(e.position);
+        EXPECT_EQ(placement.height, 330u)    << static_cast<int>(e.position);
+    }
+}
+
+TEST(WindowPlacement, AllPositionsWithLeftTaskbar)
+{
+    auto display = FakeDisplayInfo(Geometry(TaskbarEdge::Left));
+
+    const Expected expected[] = {
+        { WindowPosition::Auto,           80, 730 },
+        { WindowPosition::LeftTop,        80,  20 },
+        { WindowPosition::LeftEdge,       80, 375 },
+        { WindowPosition::LeftBottom,     80, 730 },
+        { WindowPosition::CenterTop,     735,  20 },
+        { WindowPosition::Center,        735, 375 },
+        { WindowPosition::CenterBottom,  735, 730 },
+        { WindowPosition::RightTop,     1450,  20 },
+        { WindowPosition::RightEdge,    1450, 375 },
+        { WindowPosition::RightBottom,  1450, 730 },
+    };
+
+    for (const auto& e : expected)
+    {
+        const auto placement = Place(display, e.position);
+
+        EXPECT_EQ(placement.x, e.x) << static_cast<int>(e.position);
+        EXPECT_EQ(placement.y, e.y) << static_cast<int>(e.position);
+    }
+}
+
+TEST(WindowPlacement, AllPositionsWithTopTaskbar)
+{
+    auto display = FakeDisplayInfo(Geometry(TaskbarEdge::Top));
+
+    const Expected expected[] = {
+        { WindowPosition::Auto,         1450,  60 },
+        { WindowPosition::LeftTop,        20,  60 },
+        { WindowPosition::LeftEdge,       20, 375 },
+        { WindowPosition::LeftBottom,     20, 730 },
+        { WindowPosition::CenterTop,     735,  60 },
+        { WindowPosition::Center,        735, 375 },
+        { WindowPosition::CenterBottom,  735, 730 },
+        { WindowPosition::RightTop,     1450,  60 },
+        { WindowPosition::RightEdge,    1450, 375 },
+        { WindowPosition::RightBottom,  1450, 730 },
+    };
+
+    for (const auto& e : expected)
+    {
+        const auto placement = Place(display, e.position);
+
+        EXPECT_EQ(placement.x, e.x) << static_cast<int>(e.position);
+        EXPECT_EQ(placement.y, e.y) << static_cast<int>(e.position);
+    }
+}
+
+TEST(WindowPlacement, AllPositionsWithRightTaskbar)
+{
+    auto display = FakeDisplayInfo(Geometry(TaskbarEdge::Right));
+
+    const Expected expected[] = {
+        { WindowPosition::Auto,         1390, 730 },
+        { WindowPosition::LeftTop,        20,  20 },
+        { WindowPosition::LeftEdge,       20, 375 },
+        { WindowPosition::LeftBottom,     20, 730 },
+        { WindowPosition::CenterTop,     735,  20 },
+        { WindowPosition::Center,        735, 375 },
+        { WindowPosition::CenterBottom,  735, 730 },
+        { WindowPosition::RightTop,     1390,  20 },
+        { WindowPosition::RightEdge,    1390, 375 },
+        { WindowPosition::RightBottom,  1390, 730 },
+    };
+
+    for (const auto& e : expected)
+    {
+        const auto placement = Place(display, e.position);
+
+        EXPECT_EQ(placement.x, e.x) << static_cast<int>(e.position);
+        EXPECT_EQ(placement.y, e.y) << static_cast<int>(e.position);
+    }
+}
+
+TEST(WindowPlacement, AutoWithoutTaskbarFallsBackToRightBottom)
+{
+    auto display   = FakeDisplayInfo(Geometry(TaskbarEdge::None));
+    auto placement = Place(display, WindowPosition::Auto);
+
+    EXPECT_EQ(placement.x, 1450);
+    EXPECT_EQ(placement.y, 730);
+}
+
+TEST(WindowPlacement, ScalesWithDpi)
+{
+    auto display = FakeDisplayInfo(Geometry(TaskbarEdge::Bottom));
+
+    auto placement = Place(display, WindowPosition::RightBottom, 144.f);
+    EXPECT_EQ(placement.width, 675u);
+    EXPECT_EQ(placement.height, 495u);
+    EXPECT_EQ(placement.x, 1215);
+    EXPECT_EQ(placement.y, 515);
+
+    placement = Place(display, WindowPosition::Center, 144.f);
+    EXPECT_EQ(placement.x, 622);
+    EXPECT_EQ(placement.y, 292);
+}
+
+TEST(WindowPlacement, UnknownMonitorUsesPadding)
+{
+    auto display   = FakeDisplayInfo();
+    auto placement = Place(display, WindowPosition::RightBottom, 144.f);
+
+    EXPECT_EQ(placement.x, 20);
+    EXPECT_EQ(placement.y, 20);
+    EXPECT_EQ(placement.width, 450u);
+    EXPECT_EQ(placement.height, 330u);
+}
+
+TEST(WindowPlacement, FollowsGeometryAfterDisplayChange)
+{
+    auto display = FakeDisplayInfo(Geometry(TaskbarEdge::Bottom));
+    EXPECT_EQ(Place(display, WindowPosition::Auto).x, 1450);
+
+    // Taskbar moved to the left, app invalidates and places again.
+    display.Set(Geometry(TaskbarEdge::Left));
+    display.Invalidate();
+
+    const auto placement = Place(display, WindowPosition::Auto);
+    EXPECT_EQ(placement.x, 80);
+    EXPECT_EQ(placement.y, 730);
+    EXPECT_EQ(display.Invalidations(), 1u);
+}